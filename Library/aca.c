@@ -174,14 +174,93 @@ decomp_fullaca_rkmatrix(pamatrix A, const real accur, uint ** ridx,
 
 }
 
+/* ------------------------------------------------------------
+ Workspace for partial ACA
+ ------------------------------------------------------------ */
+
+pacaworkspace
+new_acaworkspace()
+{
+  pacaworkspace ws;
+
+  ws = (pacaworkspace) allocmem(sizeof(acaworkspace));
+
+  ws->a = NULL;
+  ws->asize = 0;
+  ws->b = NULL;
+  ws->bsize = 0;
+  ws->idx = NULL;
+  ws->isize = 0;
+
+  return ws;
+}
+
+void
+del_acaworkspace(pacaworkspace ws)
+{
+  if (ws->a)
+    freemem(ws->a);
+  if (ws->b)
+    freemem(ws->b);
+  if (ws->idx)
+    freemem(ws->idx);
+  freemem(ws);
+}
+
+/* Ensure that the buffer holds at least "size" entries while preserving
+ * the first "used" entries. The capacity is at least doubled to keep the
+ * number of reallocations logarithmic in the final rank. */
+static    pfield
+grow_acaworkspace(pfield buf, size_t * bufsize, size_t size, size_t used)
+{
+  pfield    nbuf;
+  size_t    nsize;
+  size_t    i;
+
+  if (size <= *bufsize)
+    return buf;
+
+  nsize = 2 * (*bufsize);
+  if (nsize < size)
+    nsize = size;
+
+  nbuf = allocfield(nsize);
+  for (i = 0; i < used; i++)
+    nbuf[i] = buf[i];
+
+  if (buf)
+    freemem(buf);
+  *bufsize = nsize;
+
+  return nbuf;
+}
+
 void
 decomp_partialaca_rkmatrix(matrixentry_t entry, void *data,
 			   const uint * ridx, const uint rows,
 			   const uint * cidx, const uint cols, real accur,
 			   uint ** rpivot, uint ** cpivot, prkmatrix R)
 {
+  pacaworkspace ws;
+
+  ws = new_acaworkspace();
+
+  decomp_partialaca_workspace_rkmatrix(entry, data, ridx, rows, cidx, cols,
+				       accur, rpivot, cpivot, ws, R);
+
+  del_acaworkspace(ws);
+}
+
+void
+decomp_partialaca_workspace_rkmatrix(matrixentry_t entry, void *data,
+				     const uint * ridx, const uint rows,
+				     const uint * cidx, const uint cols,
+				     real accur, uint ** rpivot,
+				     uint ** cpivot, pacaworkspace ws,
+				     prkmatrix R)
+{
+  amatrix   Atmp, Btmp, A_k, B_k;
   pamatrix  A, B;
-  amatrix   A_k, B_k;
   uint     *rperm, *cperm, *rpiv, *cpiv;
   uint      i, j, mu, k, i_k, j_k;
   real      error, error2, starterror, M;
@@ -190,10 +269,16 @@ decomp_partialaca_rkmatrix(matrixentry_t entry, void *data,
 
   k = 0;
 
-  rperm = allocmem(rows * sizeof(uint));
-  cperm = allocmem(cols * sizeof(uint));
-  rpiv = allocmem(rows * sizeof(uint));
-  cpiv = allocmem(cols * sizeof(uint));
+  if (ws->isize < 2 * ((size_t) rows + cols)) {
+    if (ws->idx)
+      freemem(ws->idx);
+    ws->isize = 2 * ((size_t) rows + cols);
+    ws->idx = allocuint(ws->isize);
+  }
+  rperm = ws->idx;
+  cperm = rperm + rows;
+  rpiv = cperm + cols;
+  cpiv = rpiv + rows;
 
   for (i = 0; i < rows; ++i) {
     rpiv[i] = ridx[i];
@@ -203,17 +288,24 @@ decomp_partialaca_rkmatrix(matrixentry_t entry, void *data,
     cpiv[j] = cidx[j];
   }
 
-  A = &R->A;
-  B = &R->B;
+  aa = ws->a;
+  bb = ws->b;
 
   error = 1.0;
   starterror = 1.0;
 
   while (error > accur && k < rows && k < cols) {
-    resizecopy_amatrix(A, rows, k + 1);
-    resizecopy_amatrix(B, cols, k + 1);
-    aa = A->a;
-    bb = B->a;
+    /* Columns of A and B are stored consecutively in the workspace,
+     * so growing it only has to preserve the leading k columns. */
+    aa = ws->a = grow_acaworkspace(ws->a, &ws->asize,
+				   (size_t) rows * (k + 1),
+				   (size_t) rows * k);
+    bb = ws->b = grow_acaworkspace(ws->b, &ws->bsize,
+				   (size_t) cols * (k + 1),
+				   (size_t) cols * k);
+
+    A = init_pointer_amatrix(&Atmp, aa, rows, k + 1);
+    B = init_pointer_amatrix(&Btmp, bb, cols, k + 1);
 
     (void) init_sub_amatrix(&A_k, A, rows - k, k, 1, k);
     (void) init_sub_amatrix(&B_k, B, cols - k, k, 1, k);
@@ -329,13 +421,11 @@ decomp_partialaca_rkmatrix(matrixentry_t entry, void *data,
 
     uninit_amatrix(&A_k);
     uninit_amatrix(&B_k);
+    uninit_amatrix(A);
+    uninit_amatrix(B);
   }
 
-  R->k = k;
-
   /* Reverse pivot permutations */
-  aa = A->a;
-  bb = B->a;
   for (i = k; i-- > 0;) {
     for (j = 0; j < k; j++) {
       Aij = aa[i + j * rows];
@@ -348,7 +438,17 @@ decomp_partialaca_rkmatrix(matrixentry_t entry, void *data,
     }
   }
 
-  conjugate_amatrix(B);
+  /* Copy the factors from the workspace to the result */
+  resize_rkmatrix(R, rows, cols, k);
+
+  A = init_pointer_amatrix(&Atmp, aa, rows, k);
+  B = init_pointer_amatrix(&Btmp, bb, cols, k);
+  copy_amatrix(false, A, &R->A);
+  copy_amatrix(false, B, &R->B);
+  uninit_amatrix(A);
+  uninit_amatrix(B);
+
+  conjugate_amatrix(&R->B);
 
   if (rpivot != NULL) {
     *rpivot = allocuint(k);
@@ -363,11 +463,237 @@ decomp_partialaca_rkmatrix(matrixentry_t entry, void *data,
       (*cpivot)[i] = cpiv[i];
     }
   }
+}
 
-  freemem(rperm);
-  freemem(cperm);
-  freemem(rpiv);
-  freemem(cpiv);
+void
+decomp_blockaca_rkmatrix(matrixentry_t entry, void *data,
+			 const uint * ridx, const uint rows,
+			 const uint * cidx, const uint cols, real accur,
+			 uint bsize, uint ** rpivot, uint ** cpivot,
+			 pacaworkspace ws, prkmatrix R)
+{
+  pacaworkspace ws0;
+  amatrix   Atmp, Btmp, Rr, Cc;
+  pamatrix  A, B;
+  uint     *rflag, *rp, *cp, *ri, *cj, *tp;
+  uint      b, m, n, k, i, j, l, p, t, tmax, jmax, imax;
+  real      error, starterror, normA, normB, M, Mmax, Mfirst;
+  field     Aij, Bij;
+  pfield    aa, bb;
+
+  assert(bsize > 0);
+
+  ws0 = NULL;
+  if (ws == NULL)
+    ws = ws0 = new_acaworkspace();
+
+  if (ws->isize < 2 * (size_t) rows + cols + 3 * (size_t) bsize) {
+    if (ws->idx)
+      freemem(ws->idx);
+    ws->isize = 2 * (size_t) rows + cols + 3 * (size_t) bsize;
+    ws->idx = allocuint(ws->isize);
+  }
+  rflag = ws->idx;
+  rp = rflag + rows;
+  cp = rp + rows;
+  ri = cp + cols;
+  cj = ri + bsize;
+  tp = cj + bsize;
+
+  for (i = 0; i < rows; i++)
+    rflag[i] = 0;
+
+  aa = ws->a;
+  bb = ws->b;
+
+  k = 0;
+  n = 0;
+  Mfirst = 0.0;
+  error = 1.0;
+  starterror = 1.0;
+
+  while (error > accur && k < rows && k < cols) {
+    b = UINT_MIN3(bsize, rows - k, cols - k);
+
+    aa = ws->a = grow_acaworkspace(ws->a, &ws->asize,
+				   (size_t) rows * (k + b),
+				   (size_t) rows * k);
+    bb = ws->b = grow_acaworkspace(ws->b, &ws->bsize,
+				   (size_t) cols * (k + b),
+				   (size_t) cols * k);
+
+    /* Choose the next block of row pivot candidates */
+    if (k == 0) {
+      for (t = 0; t < b; t++)
+	ri[t] = (uint) (((size_t) rows * (2 * t + 1)) / (2 * b));
+    }
+    else {
+      /* Rows with the largest entries in the last block of columns,
+       * skipping rows that are already pivots */
+      for (t = 0; t < b; t++) {
+	Mmax = -1.0;
+	imax = 0;
+	for (i = 0; i < rows; i++) {
+	  if (rflag[i])
+	    continue;
+	  M = 0.0;
+	  for (l = k - n; l < k; l++)
+	    M = REAL_MAX(M, ABSSQR(aa[i + l * rows]));
+	  if (M > Mmax) {
+	    Mmax = M;
+	    imax = i;
+	  }
+	}
+	ri[t] = imax;
+	rflag[imax] = 2;
+      }
+      for (t = 0; t < b; t++)
+	rflag[ri[t]] = 0;
+    }
+
+    /* Get all rows of the block with one call */
+    for (t = 0; t < b; t++)
+      tp[t] = ridx[ri[t]];
+    (void) init_pointer_amatrix(&Rr, bb + (size_t) cols * k, cols, b);
+    entry(tp, cidx, data, true, &Rr);
+    conjugate_amatrix(&Rr);
+    uninit_amatrix(&Rr);
+
+    /* Subtract current rank-k-approximation. */
+    for (t = 0; t < b; t++)
+      for (p = 0; p < k; p++) {
+	Aij = aa[ri[t] + p * rows];
+	for (j = 0; j < cols; j++)
+	  bb[j + (k + t) * cols] -= bb[j + p * cols] * Aij;
+      }
+
+    /* Cross approximation with full pivoting within the row block,
+     * this only requires the entries of the block itself */
+    for (t = 0; t < b; t++)
+      tp[t] = t;
+    for (m = 0; m < b; m++) {
+      Mmax = 0.0;
+      tmax = m;
+      jmax = 0;
+      for (t = m; t < b; t++)
+	for (j = 0; j < cols; j++)
+	  if (ABSSQR(bb[j + (k + tp[t]) * cols]) > Mmax) {
+	    Mmax = ABSSQR(bb[j + (k + tp[t]) * cols]);
+	    tmax = t;
+	    jmax = j;
+	  }
+      if (Mmax <= 0.0)
+	break;
+
+      if (m == 0)
+	Mfirst = Mmax;
+      else if (Mmax <= H2_MACH_EPS * H2_MACH_EPS * Mfirst)
+	break;
+
+      l = tp[m];
+      tp[m] = tp[tmax];
+      tp[tmax] = l;
+      cj[m] = jmax;
+
+      Aij = 1.0 / bb[jmax + (k + tp[m]) * cols];
+      for (t = m + 1; t < b; t++) {
+	Bij = bb[jmax + (k + tp[t]) * cols] * Aij;
+	for (j = 0; j < cols; j++)
+	  bb[j + (k + tp[t]) * cols] -= bb[j + (k + tp[m]) * cols] * Bij;
+	bb[jmax + (k + tp[t]) * cols] = 0.0;
+      }
+    }
+
+    if (m == 0)
+      break;
+
+    /* Move the pivot rows to the front of the block */
+    for (l = 0; l < m; l++) {
+      if (tp[l] != l) {
+	t = ri[l];
+	ri[l] = ri[tp[l]];
+	ri[tp[l]] = t;
+	for (j = 0; j < cols; j++) {
+	  Aij = bb[j + (k + l) * cols];
+	  bb[j + (k + l) * cols] = bb[j + (k + tp[l]) * cols];
+	  bb[j + (k + tp[l]) * cols] = Aij;
+	}
+	for (t = l + 1; t < m; t++)
+	  if (tp[t] == l)
+	    tp[t] = tp[l];
+      }
+    }
+
+    /* Get all pivot columns with one call */
+    for (l = 0; l < m; l++)
+      tp[l] = cidx[cj[l]];
+    (void) init_pointer_amatrix(&Cc, aa + (size_t) rows * k, rows, m);
+    entry(ridx, tp, data, false, &Cc);
+    uninit_amatrix(&Cc);
+
+    /* Subtract current approximation, including the new columns,
+     * and compute the relative error of every new rank-one term */
+    n = 0;
+    for (l = 0; l < m && error > accur; l++) {
+      for (p = 0; p < k + l; p++) {
+	Aij = bb[cj[l] + p * cols];
+	for (i = 0; i < rows; i++)
+	  aa[i + (k + l) * rows] -= aa[i + p * rows] * Aij;
+      }
+
+      Aij = 1.0 / bb[cj[l] + (k + l) * cols];
+      for (i = 0; i < rows; i++)
+	aa[i + (k + l) * rows] *= Aij;
+
+      rp[k + l] = ri[l];
+      cp[k + l] = cj[l];
+      rflag[ri[l]] = 1;
+
+      normA = 0.0;
+      for (i = 0; i < rows; i++)
+	normA += ABSSQR(aa[i + (k + l) * rows]);
+      normB = 0.0;
+      for (j = 0; j < cols; j++)
+	normB += ABSSQR(bb[j + (k + l) * cols]);
+
+      if (k + l == 0)
+	starterror = REAL_RSQRT(normA * normB);
+      error = REAL_SQRT(normA * normB) * starterror;
+
+      n++;
+    }
+
+    k += n;
+  }
+
+  /* Copy the factors from the workspace to the result */
+  resize_rkmatrix(R, rows, cols, k);
+
+  A = init_pointer_amatrix(&Atmp, aa, rows, k);
+  B = init_pointer_amatrix(&Btmp, bb, cols, k);
+  copy_amatrix(false, A, &R->A);
+  copy_amatrix(false, B, &R->B);
+  uninit_amatrix(A);
+  uninit_amatrix(B);
+
+  conjugate_amatrix(&R->B);
+
+  if (rpivot != NULL) {
+    *rpivot = allocuint(k);
+    for (i = 0; i < k; ++i) {
+      (*rpivot)[i] = ridx[rp[i]];
+    }
+  }
+
+  if (cpivot != NULL) {
+    *cpivot = allocuint(k);
+    for (i = 0; i < k; ++i) {
+      (*cpivot)[i] = cidx[cp[i]];
+    }
+  }
+
+  if (ws0)
+    del_acaworkspace(ws0);
 }
 
 void
@@ -50,6 +50,53 @@
 typedef void (*matrixentry_t)(const uint *ridx, const uint *cidx, void *data,
     const bool ntrans, pamatrix N);
 
+/** @brief Reusable workspace for the partial adaptive cross approximation.
+ *
+ *  The partial ACA builds its factors one column at a time. Keeping
+ *  the storage in a workspace that survives between calls avoids
+ *  reallocating and copying the factors in every step. Each thread
+ *  should use its own workspace. */
+typedef struct _acaworkspace acaworkspace;
+
+/** @brief Pointer to an @ref acaworkspace object. */
+typedef acaworkspace *pacaworkspace;
+
+/** @brief Pointer to a constant @ref acaworkspace object. */
+typedef const acaworkspace *pcacaworkspace;
+
+/** @brief Representation of an ACA workspace. */
+struct _acaworkspace {
+  /** @brief Storage for the columns of the left factor. */
+  pfield a;
+  /** @brief Number of entries available in <tt>a</tt>. */
+  size_t asize;
+
+  /** @brief Storage for the columns of the right factor. */
+  pfield b;
+  /** @brief Number of entries available in <tt>b</tt>. */
+  size_t bsize;
+
+  /** @brief Storage for pivot indices and permutations. */
+  uint *idx;
+  /** @brief Number of entries available in <tt>idx</tt>. */
+  size_t isize;
+};
+
+/** @brief Create an empty ACA workspace.
+ *
+ *  Storage is allocated on demand by the approximation routines
+ *  and kept for subsequent calls.
+ *
+ *  @returns New workspace. */
+HEADER_PREFIX pacaworkspace
+new_acaworkspace();
+
+/** @brief Delete an ACA workspace.
+ *
+ *  @param ws Workspace to be deleted. */
+HEADER_PREFIX void
+del_acaworkspace(pacaworkspace ws);
+
 /**
  * @brief This routine computes the adaptive cross approximation using full
  * pivoting of a given matrix @f$ A @f$.
@@ -116,6 +163,67 @@ decomp_partialaca_rkmatrix(matrixentry_t entry, void *data, const uint *ridx,
     const uint rows, const uint *cidx, const uint cols, real accur,
     uint **rpivot, uint **cpivot, prkmatrix R);
 
+/**
+ * @brief Partial adaptive cross approximation using a reusable workspace.
+ *
+ * Computes the same approximation as @ref decomp_partialaca_rkmatrix, but
+ * takes the storage for the factors and pivot indices from <tt>ws</tt>.
+ * Once the workspace has grown to the size of the largest block, no
+ * further memory is allocated apart from the result <tt>R</tt>.
+ *
+ * @param entry Callback function implicitly defining the matrix @f$ A @f$.
+ * @param data Additional data passed to <tt>entry</tt>.
+ * @param ridx Array of all row indices.
+ * @param rows Number of rows, i.e., length of <tt>ridx</tt>.
+ * @param cidx Array of all column indices.
+ * @param cols Number of columns, i.e., length of <tt>cidx</tt>.
+ * @param accur Relative accuracy of the approximation.
+ * @param rpivot Returns an array of row pivot indices, if not <tt>NULL</tt>.
+ * @param cpivot Returns an array of column pivot indices, if not <tt>NULL</tt>.
+ * @param ws Workspace, must not be used by other threads at the same time.
+ * @param R The resulting low rank matrix is returned via <tt>R</tt> .
+ */
+HEADER_PREFIX void
+decomp_partialaca_workspace_rkmatrix(matrixentry_t entry, void *data,
+    const uint *ridx, const uint rows, const uint *cidx, const uint cols,
+    real accur, uint **rpivot, uint **cpivot, pacaworkspace ws, prkmatrix R);
+
+/**
+ * @brief Adaptive cross approximation with blocks of partial pivots.
+ *
+ * Works like @ref decomp_partialaca_rkmatrix, but in every step
+ * <tt>bsize</tt> rows of the residual are requested from <tt>entry</tt>
+ * with a single call. A cross approximation with full pivoting
+ * on these rows selects up to <tt>bsize</tt> column pivots, and the
+ * corresponding columns are again requested with a single call.
+ * This reduces the number of callbacks by a factor of up to
+ * <tt>bsize</tt> and gives the matrix entry routines wider panels
+ * to work on.
+ *
+ * The stopping criterion is the same as for the partial ACA: the
+ * rank-one terms are added in pivot order until the estimated relative
+ * error of the last term drops below <tt>accur</tt>.
+ * For <tt>bsize=1</tt> the pivoting strategy is that of
+ * @ref decomp_partialaca_rkmatrix up to ties.
+ *
+ * @param entry Callback function implicitly defining the matrix @f$ A @f$.
+ * @param data Additional data passed to <tt>entry</tt>.
+ * @param ridx Array of all row indices.
+ * @param rows Number of rows, i.e., length of <tt>ridx</tt>.
+ * @param cidx Array of all column indices.
+ * @param cols Number of columns, i.e., length of <tt>cidx</tt>.
+ * @param accur Relative accuracy of the approximation.
+ * @param bsize Number of rows requested per step.
+ * @param rpivot Returns an array of row pivot indices, if not <tt>NULL</tt>.
+ * @param cpivot Returns an array of column pivot indices, if not <tt>NULL</tt>.
+ * @param ws Workspace, if <tt>NULL</tt> a temporary workspace is used.
+ * @param R The resulting low rank matrix is returned via <tt>R</tt> .
+ */
+HEADER_PREFIX void
+decomp_blockaca_rkmatrix(matrixentry_t entry, void *data, const uint *ridx,
+    const uint rows, const uint *cidx, const uint cols, real accur,
+    uint bsize, uint **rpivot, uint **cpivot, pacaworkspace ws, prkmatrix R);
+
 /**
  * @brief Copies the lower triangular part of a matrix <tt>A</tt> to a matrix <tt>B</tt>
  * after applying the row pivoting denoted by <tt>xi</tt>.
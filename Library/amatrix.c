@@ -91,7 +91,7 @@ init_pointer_amatrix(pamatrix a, pfield src, uint rows, uint cols)
   a->a = src;
   a->rows = rows;
   a->ld = rows;
-  a->cols = rows;
+  a->cols = cols;
   a->owner = src;
 
 #ifdef USE_OPENMP
@@ -850,6 +850,25 @@ normfrob2_amatrix(pcamatrix a)
 }
 #endif
 
+real
+norm1_amatrix(pcamatrix a)
+{
+  real      sum, norm;
+  longindex lda = a->ld;
+  uint      i, j;
+
+  norm = 0.0;
+  for (j = 0; j < a->cols; j++) {
+    sum = 0.0;
+    for (i = 0; i < a->rows; i++) {
+      sum += ABS(a->a[i + j * lda]);
+    }
+    norm = REAL_MAX(norm, sum);
+  }
+
+  return norm;
+}
+
 real
 norm2diff_amatrix(pcamatrix a, pcamatrix b)
 {
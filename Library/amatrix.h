@@ -593,6 +593,16 @@ normfrob_amatrix(pcamatrix a);
 HEADER_PREFIX real
 normfrob2_amatrix(pcamatrix a);
 
+/** @brief Compute the column sum norm @f$\|A\|_1@f$ of a matrix @f$A@f$.
+ *
+ *  The column sum norm is given by
+ *  @f$\|A\|_1 = \max_j \sum_i |a_{ij}|@f$.
+ *
+ *  @param a Matrix @f$A@f$.
+ *  @returns Column sum norm @f$\|A\|_1@f$. */
+HEADER_PREFIX real
+norm1_amatrix(pcamatrix a);
+
 /** @brief Approximate the spectral norm @f$\|A-B\|_2@f$ of the difference
  *  of two matrices @f$A@f$ and @f$B@f$.
  *
@@ -326,10 +326,15 @@ scale_avector(field alpha, pavector v)
 void
 scale_avector(field alpha, pavector v)
 {
+  pfield    vv = v->v;
+  uint      n = v->dim;
   uint      i;
 
-  for (i = 0; i < v->dim; i++)
-    v->v[i] *= alpha;
+#ifdef USE_OPENMP
+#pragma omp parallel for simd schedule(static) if(n >= AVECTOR_PARALLEL_DIM)
+#endif
+  for (i = 0; i < n; i++)
+    vv[i] *= alpha;
 }
 #endif
 
@@ -343,12 +348,17 @@ norm2_avector(pcavector v)
 real
 norm2_avector(pcavector v)
 {
+  pcfield   vv = v->v;
+  uint      n = v->dim;
   real      sum;
   uint      i;
 
   sum = 0.0;
-  for (i = 0; i < v->dim; i++)
-    sum += ABSSQR(v->v[i]);
+#ifdef USE_OPENMP
+#pragma omp parallel for simd schedule(static) reduction(+:sum) if(n >= AVECTOR_PARALLEL_DIM)
+#endif
+  for (i = 0; i < n; i++)
+    sum += ABSSQR(vv[i]);
 
   return REAL_SQRT(sum);
 }
@@ -366,14 +376,20 @@ dotprod_avector(pcavector x, pcavector y)
 field
 dotprod_avector(pcavector x, pcavector y)
 {
-  register field alpha;
+  pcfield   xv = x->v;
+  pcfield   yv = y->v;
+  uint      n = x->dim;
+  field     alpha;
   uint      i;
 
   assert(x->dim == y->dim);
 
   alpha = 0.0;
-  for (i = 0; i < x->dim; i++)
-    alpha += CONJ(x->v[i]) * y->v[i];
+#ifdef USE_OPENMP
+#pragma omp parallel for simd schedule(static) reduction(+:alpha) if(n >= AVECTOR_PARALLEL_DIM)
+#endif
+  for (i = 0; i < n; i++)
+    alpha += CONJ(xv[i]) * yv[i];
 
   return alpha;
 }
@@ -391,12 +407,144 @@ add_avector(field alpha, pcavector x, pavector y)
 void
 add_avector(field alpha, pcavector x, pavector y)
 {
+  pcfield   xv = x->v;
+  pfield    yv = y->v;
+  uint      n = x->dim;
   uint      i;
 
   assert(y->dim >= x->dim);
 
-  for (i = 0; i < x->dim; i++) {
-    y->v[i] += alpha * x->v[i];
+#ifdef USE_OPENMP
+#pragma omp parallel for simd schedule(static) if(n >= AVECTOR_PARALLEL_DIM)
+#endif
+  for (i = 0; i < n; i++) {
+    yv[i] += alpha * xv[i];
   }
 }
 #endif
+
+/* ------------------------------------------------------------
+ * Fused operations
+ * ------------------------------------------------------------ */
+
+void
+scaleadd_avector(field alpha, pcavector x, field beta, pavector y)
+{
+  pcfield   xv = x->v;
+  pfield    yv = y->v;
+  uint      n = x->dim;
+  uint      i;
+
+  assert(y->dim == x->dim);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for simd schedule(static) if(n >= AVECTOR_PARALLEL_DIM)
+#endif
+  for (i = 0; i < n; i++)
+    yv[i] = alpha * xv[i] + beta * yv[i];
+}
+
+field
+adddotprod_avector(field alpha, pcavector x, pavector y, pcavector z)
+{
+  pcfield   xv = x->v;
+  pfield    yv = y->v;
+  pcfield   zv = z->v;
+  uint      n = x->dim;
+  field     sum;
+  uint      i;
+
+  assert(y->dim == x->dim);
+  assert(z->dim == x->dim);
+
+  sum = 0.0;
+#ifdef USE_OPENMP
+#pragma omp parallel for simd schedule(static) reduction(+:sum) if(n >= AVECTOR_PARALLEL_DIM)
+#endif
+  for (i = 0; i < n; i++) {
+    yv[i] += alpha * xv[i];
+    sum += CONJ(zv[i]) * yv[i];
+  }
+
+  return sum;
+}
+
+real
+addnorm2_avector(field alpha, pcavector x, pavector y)
+{
+  pcfield   xv = x->v;
+  pfield    yv = y->v;
+  uint      n = x->dim;
+  real      sum;
+  uint      i;
+
+  assert(y->dim == x->dim);
+
+  sum = 0.0;
+#ifdef USE_OPENMP
+#pragma omp parallel for simd schedule(static) reduction(+:sum) if(n >= AVECTOR_PARALLEL_DIM)
+#endif
+  for (i = 0; i < n; i++) {
+    yv[i] += alpha * xv[i];
+    sum += ABSSQR(yv[i]);
+  }
+
+  return REAL_SQRT(sum);
+}
+
+void
+dotprod2_avector(pcavector x, pcavector y1, pcavector y2, pfield d)
+{
+  pcfield   xv = x->v;
+  pcfield   y1v = y1->v;
+  pcfield   y2v = y2->v;
+  uint      n = x->dim;
+  field     sum1, sum2, xi;
+  uint      i;
+
+  assert(y1->dim == x->dim);
+  assert(y2->dim == x->dim);
+
+  sum1 = 0.0;
+  sum2 = 0.0;
+#ifdef USE_OPENMP
+#pragma omp parallel for simd schedule(static) private(xi) reduction(+:sum1,sum2) if(n >= AVECTOR_PARALLEL_DIM)
+#endif
+  for (i = 0; i < n; i++) {
+    xi = CONJ(xv[i]);
+    sum1 += xi * y1v[i];
+    sum2 += xi * y2v[i];
+  }
+
+  d[0] = sum1;
+  d[1] = sum2;
+}
+
+void
+dotprodmulti_avector(pcavector x, uint k, pcavector *y, pfield d)
+{
+  pcfield   xv = x->v;
+  pcfield   yv;
+  uint      n = x->dim;
+  field     sum;
+  uint      i, j;
+
+  /* Pairs of products with a single pass over x each */
+  for (j = 0; j + 1 < k; j += 2)
+    dotprod2_avector(x, y[j], y[j + 1], d + j);
+
+  if (j < k) {
+    yv = y[j]->v;
+
+    assert(y[j]->dim == n);
+
+    sum = 0.0;
+#ifdef USE_OPENMP
+#pragma omp parallel for simd schedule(static) reduction(+:sum) if(n >= AVECTOR_PARALLEL_DIM)
+#endif
+    for (i = 0; i < n; i++)
+      sum += CONJ(xv[i]) * yv[i];
+
+    d[j] = sum;
+  }
+}
@@ -35,6 +35,10 @@ typedef const avector *pcavector;
 #include "amatrix.h"
 #include "settings.h"
 
+/** @brief Minimal dimension for using several threads in
+ *  vector operations. */
+#define AVECTOR_PARALLEL_DIM 8192
+
 /** Representation of a vector as an array. */
 struct _avector {
   /** @brief Vector coefficients. */
@@ -416,6 +420,66 @@ dotprod_avector(pcavector x, pcavector y);
 HEADER_PREFIX void
 add_avector(field alpha, pcavector x, pavector y);
 
+/* ------------------------------------------------------------
+ Fused operations
+ ------------------------------------------------------------ */
+
+/** @brief Scale a vector and add another one,
+ *  @f$y \gets \alpha x + \beta y@f$.
+ *
+ *  Requires only one pass over both vectors, compared to two for
+ *  @ref scale_avector followed by @ref add_avector.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param x Source vector @f$x@f$.
+ *  @param beta Scaling factor @f$\beta@f$.
+ *  @param y Target vector @f$y@f$. */
+HEADER_PREFIX void
+scaleadd_avector(field alpha, pcavector x, field beta, pavector y);
+
+/** @brief Add two vectors and compute an inner product with the result,
+ *  @f$y \gets y + \alpha x@f$, returning @f$\langle z, y\rangle_2@f$.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param x Source vector @f$x@f$.
+ *  @param y Target vector @f$y@f$.
+ *  @param z Vector @f$z@f$.
+ *  @returns Inner product @f$\langle z, y\rangle_2@f$ of @f$z@f$ and
+ *         the updated @f$y@f$. */
+HEADER_PREFIX field
+adddotprod_avector(field alpha, pcavector x, pavector y, pcavector z);
+
+/** @brief Add two vectors and compute the norm of the result,
+ *  @f$y \gets y + \alpha x@f$, returning @f$\|y\|_2@f$.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param x Source vector @f$x@f$.
+ *  @param y Target vector @f$y@f$.
+ *  @returns Euclidean norm of the updated @f$y@f$. */
+HEADER_PREFIX real
+addnorm2_avector(field alpha, pcavector x, pavector y);
+
+/** @brief Compute two inner products with the same vector,
+ *  @f$d_1 = \langle x, y_1\rangle_2@f$ and
+ *  @f$d_2 = \langle x, y_2\rangle_2@f$, in one pass.
+ *
+ *  @param x Vector @f$x@f$.
+ *  @param y1 Vector @f$y_1@f$.
+ *  @param y2 Vector @f$y_2@f$.
+ *  @param d Array of length two receiving @f$d_1@f$ and @f$d_2@f$. */
+HEADER_PREFIX void
+dotprod2_avector(pcavector x, pcavector y1, pcavector y2, pfield d);
+
+/** @brief Compute inner products of one vector with several others,
+ *  @f$d_j = \langle x, y_j\rangle_2@f$ for @f$j\in\{0,\ldots,k-1\}@f$.
+ *
+ *  @param x Vector @f$x@f$.
+ *  @param k Number of vectors @f$y_j@f$.
+ *  @param y Array of @f$k@f$ vectors @f$y_j@f$.
+ *  @param d Array of length @f$k@f$ receiving the inner products. */
+HEADER_PREFIX void
+dotprodmulti_avector(pcavector x, uint k, pcavector *y, pfield d);
+
 /** @} */
 
 #endif
@@ -188,6 +188,11 @@ struct _aprxbem3d {
    */
   real      accur_aca;
 
+  /*
+   * @brief Number of rows fetched per step by blocked ACA
+   */
+  uint      bsize_aca;
+
   /*
    * @brief This flag indicated if blockwise recompression technique should be used or
    * not.
@@ -262,6 +267,7 @@ struct _parbem3d {
   uint      grbnn;
   pgreenclusterbasis3d *gcbn;
   uint      gcbnn;
+  pacaworkspace *acaws;		/* temporary ACA workspaces, one per thread */
 };
 
 struct _greencluster3d {
@@ -328,6 +334,7 @@ static void
 uninit_aca_bem3d(paprxbem3d aprx)
 {
   aprx->accur_aca = 0.0;
+  aprx->bsize_aca = 0;
 }
 
 static void
@@ -478,6 +485,7 @@ new_aprxbem3d()
 
   /* ACA */
   aprx->accur_aca = 0.0;
+  aprx->bsize_aca = 0;
 
   /* Recompression */
   aprx->recomp = false;
@@ -558,6 +566,7 @@ new_parbem3d()
   par->grbnn = 0;
   par->gcbn = NULL;
   par->gcbnn = 0;
+  par->acaws = NULL;
 
   return par;
 }
@@ -5842,11 +5851,57 @@ assemble_bem3d_PACA_rkmatrix(pccluster rc, uint rname, pccluster cc,
   const uint rows = rc->size;
   const uint cols = cc->size;
 
+  pacaworkspace ws;
+
   (void) rname;
   (void) cname;
 
-  decomp_partialaca_rkmatrix(entry, (void *) bem, ridx, rows, cidx, cols,
-			     accur, NULL, NULL, R);
+  ws = NULL;
+  if (bem->par->acaws) {
+#ifdef USE_OPENMP
+    ws = bem->par->acaws[omp_get_thread_num()];
+#else
+    ws = bem->par->acaws[0];
+#endif
+  }
+
+  if (ws)
+    decomp_partialaca_workspace_rkmatrix(entry, (void *) bem, ridx, rows,
+					 cidx, cols, accur, NULL, NULL, ws, R);
+  else
+    decomp_partialaca_rkmatrix(entry, (void *) bem, ridx, rows, cidx, cols,
+			       accur, NULL, NULL, R);
+}
+
+static void
+assemble_bem3d_BPACA_rkmatrix(pccluster rc, uint rname, pccluster cc,
+			      uint cname, pcbem3d bem, prkmatrix R)
+{
+  paprxbem3d aprx = bem->aprx;
+  const real accur = aprx->accur_aca;
+  const uint bsize = aprx->bsize_aca;
+  matrixentry_t entry = (matrixentry_t) bem->nearfield_far;
+  const uint *ridx = rc->idx;
+  const uint *cidx = cc->idx;
+  const uint rows = rc->size;
+  const uint cols = cc->size;
+
+  pacaworkspace ws;
+
+  (void) rname;
+  (void) cname;
+
+  ws = NULL;
+  if (bem->par->acaws) {
+#ifdef USE_OPENMP
+    ws = bem->par->acaws[omp_get_thread_num()];
+#else
+    ws = bem->par->acaws[0];
+#endif
+  }
+
+  decomp_blockaca_rkmatrix(entry, (void *) bem, ridx, rows, cidx, cols,
+			   accur, bsize, NULL, NULL, ws, R);
 }
 
 static void
@@ -6076,22 +6131,18 @@ assemble_bem3d_inter_transfer_col_clusterbasis(uint cname, pcbem3d bem)
 }
 
 static void
-assemble_bem3d_inter_uniform(uint rname, uint cname, uint bname, pcbem3d bem)
+assemble_bem3d_inter_coupling(pcclusterbasis rb, pcclusterbasis cb,
+			      void *data, pamatrix S)
 {
+  pcbem3d   bem = (pcbem3d) data;
   pkernelbem3d kernels = bem->kernels;
-  pparbem3d par = bem->par;
-  puniform  U = par->h2n[bname]->u;
-  pccluster rc = U->rb->t;
-  pccluster cc = U->cb->t;
-  const uint kr = U->rb->k;
-  const uint kc = U->cb->k;
-  pamatrix  S = &U->S;
+  pccluster rc = rb->t;
+  pccluster cc = cb->t;
+  const uint kr = rb->k;
+  const uint kc = cb->k;
 
   real(*xi_r)[3], (*xi_c)[3];
 
-  (void) rname;
-  (void) cname;
-
   resize_amatrix(S, kr, kc);
 
   xi_r = (real(*)[3]) allocreal(3 * kr);
@@ -6107,6 +6158,20 @@ assemble_bem3d_inter_uniform(uint rname, uint cname, uint bname, pcbem3d bem)
   freemem(xi_c);
 }
 
+static void
+assemble_bem3d_inter_uniform(uint rname, uint cname, uint bname, pcbem3d bem)
+{
+  pparbem3d par = bem->par;
+  puniform  U = par->h2n[bname]->u;
+
+  (void) rname;
+  (void) cname;
+
+  assert(U->coupling == NULL);
+
+  assemble_bem3d_inter_coupling(U->rb, U->cb, (void *) bem, &U->S);
+}
+
 static void
 update_pivotelements_greenclusterbasis3d(pgreenclusterbasis3d * grbn,
 					 pcclusterbasis cb, uint * I_t,
@@ -6507,6 +6572,7 @@ assemble_bem3d_greenhybrid_uniform(uint rname, uint cname,
 
   assert(grb != NULL);
   assert(gcb != NULL);
+  assert(U->coupling == NULL);
 
   xihatV = grb->xihat;
   xihatW = gcb->xihat;
@@ -6920,6 +6986,7 @@ assemble_bem3d_greenhybrid_ortho_uniform(uint rname, uint cname,
 
   assert(grb != NULL);
   assert(gcb != NULL);
+  assert(U->coupling == NULL);
 
   xihatV = grb->xihat;
   xihatW = gcb->xihat;
@@ -9602,6 +9669,37 @@ setup_hmatrix_aprx_paca_bem3d(pbem3d bem, pccluster rc, pccluster cc,
   bem->transfer_wave_wave_col = NULL;
 }
 
+void
+setup_hmatrix_aprx_bpaca_bem3d(pbem3d bem, pccluster rc, pccluster cc,
+			       pcblock tree, real accur, uint bsize)
+{
+
+  (void) rc;
+  (void) cc;
+  (void) tree;
+
+  assert(bem->nearfield_far != NULL);
+  assert(bsize > 0);
+
+  setup_aca_bem3d(bem->aprx, accur);
+  bem->aprx->bsize_aca = bsize;
+
+  bem->farfield_rk = assemble_bem3d_BPACA_rkmatrix;
+  bem->farfield_u = NULL;
+  bem->farfield_wave_u = NULL;
+
+  bem->leaf_row = NULL;
+  bem->leaf_wave_row = NULL;
+  bem->leaf_col = NULL;
+  bem->leaf_wave_col = NULL;
+  bem->transfer_row = NULL;
+  bem->transfer_wave_row = NULL;
+  bem->transfer_wave_wave_row = NULL;
+  bem->transfer_col = NULL;
+  bem->transfer_wave_col = NULL;
+  bem->transfer_wave_wave_col = NULL;
+}
+
 /* ------------------------------------------------------------
  HCA
  ------------------------------------------------------------ */
@@ -10014,86 +10112,317 @@ assemble_bem3d_amatrix(pbem3d bem, pamatrix G)
 }
 
 /* ------------------------------------------------------------
- Fill hmatrix
+ Dynamic scheduling of leaf blocks
  ------------------------------------------------------------ */
 
+/* Leaf block of an H- or H2-matrix that can be filled independently
+ * of all other leaves, together with an estimate of its cost. */
+typedef struct {
+  pccluster rc;			/* Row cluster */
+  uint      rname;		/* Number of the row cluster */
+  pccluster cc;			/* Column cluster */
+  uint      cname;		/* Number of the column cluster */
+  pamatrix  f;			/* Nearfield matrix to be filled */
+  prkmatrix r;			/* Farfield matrix to be filled */
+  real      cost;		/* Estimated number of kernel evaluations */
+} leafbem3d;
+
+typedef struct {
+  leafbem3d *leaf;		/* Array of leaf blocks */
+  uint      n;			/* Number of leaf blocks */
+} leaflistbem3d;
+
+/* The number of kernel evaluations for a nearfield block is roughly
+ * rows*cols*nq with the regular quadrature order nq. Blocks with touching
+ * bounding boxes additionally contain pairs of elements that require
+ * singular quadrature, which is considerably more expensive. */
+static    real
+nearfield_cost_bem3d(pcbem3d bem, pccluster rc, pccluster cc)
+{
+  pcsingquad2d sq = bem->sq;
+  real      cost;
+
+  if (sq == NULL)
+    return (real) rc->size * cc->size;
+
+  cost = (real) rc->size * cc->size * sq->n_dist;
+  if (getdist_max_cluster(rc, cc) <= 0.0)
+    cost += (real) UINT_MIN(rc->size, cc->size)
+      * (sq->n_id + sq->n_edge + sq->n_vert);
+
+  return cost;
+}
+
+static    uint
+count_nearfield_hmatrix(pchmatrix G)
+{
+  uint      i, n;
+
+  if (G->son) {
+    n = 0;
+    for (i = 0; i < G->rsons * G->csons; i++)
+      n += count_nearfield_hmatrix(G->son[i]);
+    return n;
+  }
+
+  return (G->f ? 1 : 0);
+}
+
 static void
-assemble_bem3d_block_hmatrix(pcblock b, uint bname, uint rname,
-			     uint cname, uint pardepth, void *data)
+collect_nearfield_hmatrix(pcbem3d bem, phmatrix G, leaflistbem3d * ll)
 {
-  pbem3d    bem = (pbem3d) data;
-  paprxbem3d aprx = bem->aprx;
-  pparbem3d par = bem->par;
-  phmatrix *hn = par->hn;
-  phmatrix  G = hn[bname];
+  leafbem3d *l;
+  uint      i;
 
-  (void) b;
-  (void) pardepth;
+  if (G->son) {
+    for (i = 0; i < G->rsons * G->csons; i++)
+      collect_nearfield_hmatrix(bem, G->son[i], ll);
+  }
+  else if (G->f) {
+    l = ll->leaf + ll->n;
+    l->rc = G->rc;
+    l->cc = G->cc;
+    l->f = G->f;
+    l->cost = nearfield_cost_bem3d(bem, G->rc, G->cc);
+    ll->n++;
+  }
+}
 
-  if (G->r) {
-    bem->farfield_rk(G->rc, rname, G->cc, cname, bem, G->r);
-    if (aprx->recomp == true) {
-      trunc_rkmatrix(0, aprx->accur_recomp, G->r);
+/* The cost of an adaptive farfield approximation depends on the rank
+ * that is only known after the fact. For a fixed rank it grows like
+ * (rows+cols)*nq, so this is used to order the blocks. */
+static    real
+farfield_cost_bem3d(pcbem3d bem, pccluster rc, pccluster cc)
+{
+  pcsingquad2d sq = bem->sq;
+
+  return ((real) rc->size + cc->size) * (sq ? sq->n_dist : 1);
+}
+
+static    uint
+count_farfield_hmatrix(pchmatrix G)
+{
+  uint      i, n;
+
+  if (G->son) {
+    n = 0;
+    for (i = 0; i < G->rsons * G->csons; i++)
+      n += count_farfield_hmatrix(G->son[i]);
+    return n;
+  }
+
+  return (G->r ? 1 : 0);
+}
+
+/* The cluster numbers follow the same convention as
+ * iterate_byrow_block: sons are numbered consecutively after their
+ * father, and a cluster that is not subdivided keeps its number. */
+static void
+collect_farfield_hmatrix(pcbem3d bem, phmatrix G, uint rname, uint cname,
+			 leaflistbem3d * ll)
+{
+  leafbem3d *l;
+  uint      rname1, cname1;
+  uint      i, j;
+
+  if (G->son) {
+    cname1 = (G->son[0]->cc == G->cc ? cname : cname + 1);
+    for (j = 0; j < G->csons; j++) {
+      rname1 = (G->son[0]->rc == G->rc ? rname : rname + 1);
+      for (i = 0; i < G->rsons; i++) {
+	collect_farfield_hmatrix(bem, G->son[i + j * G->rsons], rname1,
+				 cname1, ll);
+	rname1 += G->son[i]->rc->desc;
+      }
+      cname1 += G->son[j * G->rsons]->cc->desc;
     }
   }
+  else if (G->r) {
+    l = ll->leaf + ll->n;
+    l->rc = G->rc;
+    l->rname = rname;
+    l->cc = G->cc;
+    l->cname = cname;
+    l->r = G->r;
+    l->cost = farfield_cost_bem3d(bem, G->rc, G->cc);
+    ll->n++;
+  }
+}
+
+static    uint
+count_nearfield_h2matrix(pch2matrix G)
+{
+  uint      i, n;
+
+  if (G->son) {
+    n = 0;
+    for (i = 0; i < G->rsons * G->csons; i++)
+      n += count_nearfield_h2matrix(G->son[i]);
+    return n;
+  }
+
+  return (G->f ? 1 : 0);
+}
+
+static void
+collect_nearfield_h2matrix(pcbem3d bem, ph2matrix G, leaflistbem3d * ll)
+{
+  leafbem3d *l;
+  uint      i;
+
+  if (G->son) {
+    for (i = 0; i < G->rsons * G->csons; i++)
+      collect_nearfield_h2matrix(bem, G->son[i], ll);
+  }
   else if (G->f) {
-    bem->nearfield(G->rc->idx, G->cc->idx, bem, false, G->f);
+    l = ll->leaf + ll->n;
+    l->rc = G->rb->t;
+    l->cc = G->cb->t;
+    l->f = G->f;
+    l->cost = nearfield_cost_bem3d(bem, G->rb->t, G->cb->t);
+    ll->n++;
   }
 }
 
+static    bool
+geq_leaf(uint i, uint j, void *data)
+{
+  leafbem3d *leaf = (leafbem3d *) data;
+
+  return leaf[i].cost >= leaf[j].cost;
+}
+
 static void
-assemblecoarsen_bem3d_block_hmatrix(pcblock b, uint bname,
-				    uint rname, uint cname, uint pardepth,
-				    void *data)
+swap_leaf(uint i, uint j, void *data)
+{
+  leafbem3d *leaf = (leafbem3d *) data;
+  leafbem3d h;
+
+  h = leaf[i];
+  leaf[i] = leaf[j];
+  leaf[j] = h;
+}
+
+/* Fill all leaves from a flat task queue. The leaves are sorted by
+ * decreasing cost, so the expensive blocks are started first and the
+ * cheap ones fill the gaps at the end ("longest processing time first").
+ * Idle threads fetch the next block from the queue as soon as they have
+ * finished their current one, so no thread waits for a static partition
+ * of the block tree to complete. Since the queue is processed inside a
+ * parallel region, the nearfield callbacks do not open nested regions. */
+static void
+fill_nearfield_leaflist_bem3d(pcbem3d bem, leaflistbem3d * ll)
+{
+  leafbem3d *leaf = ll->leaf;
+  int       n = ll->n;
+  int       i;
+
+  heapsort(ll->n, geq_leaf, swap_leaf, leaf);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic,1) if(max_pardepth > 0 && n > 1)
+#endif
+  for (i = 0; i < n; i++)
+    bem->nearfield(leaf[i].rc->idx, leaf[i].cc->idx, bem, false, leaf[i].f);
+}
+
+/* Same as above for admissible leaves. Partial ACA converges at very
+ * different ranks, so the actual costs vary much more than the estimate
+ * and dynamic scheduling is essential. Every thread gets its own ACA
+ * workspace that is reused for all blocks it handles. */
+static void
+fill_farfield_leaflist_bem3d(pcbem3d bem, leaflistbem3d * ll)
 {
-  pbem3d    bem = (pbem3d) data;
   paprxbem3d aprx = bem->aprx;
   pparbem3d par = bem->par;
-  phmatrix *hn = par->hn;
-  phmatrix  G = hn[bname];
+  leafbem3d *leaf = ll->leaf;
+  int       n = ll->n;
+  uint      nthreads, j;
+  int       i;
 
-  (void) b;
-  (void) pardepth;
+  heapsort(ll->n, geq_leaf, swap_leaf, leaf);
 
-  if (G->r) {
-    bem->farfield_rk(G->rc, rname, G->cc, cname, bem, G->r);
+#ifdef USE_OPENMP
+  nthreads = omp_get_max_threads();
+#else
+  nthreads = 1;
+#endif
+
+  par->acaws = (pacaworkspace *) allocmem((size_t) sizeof(pacaworkspace) *
+					  nthreads);
+  for (j = 0; j < nthreads; j++)
+    par->acaws[j] = new_acaworkspace();
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic,1) if(max_pardepth > 0 && n > 1) num_threads(nthreads)
+#endif
+  for (i = 0; i < n; i++) {
+    bem->farfield_rk(leaf[i].rc, leaf[i].rname, leaf[i].cc, leaf[i].cname,
+		     bem, leaf[i].r);
     if (aprx->recomp == true) {
-      trunc_rkmatrix(NULL, aprx->accur_recomp, G->r);
+      trunc_rkmatrix(0, aprx->accur_recomp, leaf[i].r);
     }
   }
-  else if (G->f) {
-    bem->nearfield(G->rc->idx, G->cc->idx, bem, false, G->f);
-  }
-  else {
-    assert(G->son != NULL);
-    coarsen_hmatrix(G, NULL, aprx->accur_coarsen, false);
-  }
+
+  for (j = 0; j < nthreads; j++)
+    del_acaworkspace(par->acaws[j]);
+  freemem(par->acaws);
+  par->acaws = NULL;
 }
 
 static void
-assemble_bem3d_nearfield_block_hmatrix(pcblock b, uint bname,
-				       uint rname, uint cname, uint pardepth,
-				       void *data)
+assemble_bem3d_nearfield_leaves_hmatrix(pcbem3d bem, phmatrix G)
 {
-  pbem3d    bem = (pbem3d) data;
-  pparbem3d par = bem->par;
-  phmatrix *hn = par->hn;
-  phmatrix  G = hn[bname];
+  leaflistbem3d ll;
 
-  (void) b;
-  (void) rname;
-  (void) cname;
-  (void) pardepth;
+  ll.leaf = (leafbem3d *) allocmem((size_t) sizeof(leafbem3d) *
+				   count_nearfield_hmatrix(G));
+  ll.n = 0;
+  collect_nearfield_hmatrix(bem, G, &ll);
 
-  if (G->f) {
-    bem->nearfield(G->rc->idx, G->cc->idx, bem, false, G->f);
-  }
+  fill_nearfield_leaflist_bem3d(bem, &ll);
+
+  freemem(ll.leaf);
 }
 
 static void
-assemble_bem3d_farfield_block_hmatrix(pcblock b, uint bname,
-				      uint rname, uint cname, uint pardepth,
-				      void *data)
+assemble_bem3d_farfield_leaves_hmatrix(pcbem3d bem, phmatrix G)
+{
+  leaflistbem3d ll;
+
+  ll.leaf = (leafbem3d *) allocmem((size_t) sizeof(leafbem3d) *
+				   count_farfield_hmatrix(G));
+  ll.n = 0;
+  collect_farfield_hmatrix(bem, G, 0, 0, &ll);
+
+  fill_farfield_leaflist_bem3d(bem, &ll);
+
+  freemem(ll.leaf);
+}
+
+static void
+assemble_bem3d_nearfield_leaves_h2matrix(pcbem3d bem, ph2matrix G)
+{
+  leaflistbem3d ll;
+
+  ll.leaf = (leafbem3d *) allocmem((size_t) sizeof(leafbem3d) *
+				   count_nearfield_h2matrix(G));
+  ll.n = 0;
+  collect_nearfield_h2matrix(bem, G, &ll);
+
+  fill_nearfield_leaflist_bem3d(bem, &ll);
+
+  freemem(ll.leaf);
+}
+
+/* ------------------------------------------------------------
+ Fill hmatrix
+ ------------------------------------------------------------ */
+
+static void
+assemblecoarsen_bem3d_block_hmatrix(pcblock b, uint bname,
+				    uint rname, uint cname, uint pardepth,
+				    void *data)
 {
   pbem3d    bem = (pbem3d) data;
   paprxbem3d aprx = bem->aprx;
@@ -10107,22 +10436,25 @@ assemble_bem3d_farfield_block_hmatrix(pcblock b, uint bname,
   if (G->r) {
     bem->farfield_rk(G->rc, rname, G->cc, cname, bem, G->r);
     if (aprx->recomp == true) {
-      trunc_rkmatrix(0, aprx->accur_recomp, G->r);
+      trunc_rkmatrix(NULL, aprx->accur_recomp, G->r);
     }
   }
+  else if (G->f) {
+    bem->nearfield(G->rc->idx, G->cc->idx, bem, false, G->f);
+  }
+  else {
+    assert(G->son != NULL);
+    coarsen_hmatrix(G, NULL, aprx->accur_coarsen, false);
+  }
 }
 
 void
 assemble_bem3d_hmatrix(pbem3d bem, pblock b, phmatrix G)
 {
-  pparbem3d par = bem->par;
-  par->hn = enumerate_hmatrix(b, G);
-
-  iterate_byrow_block(b, 0, 0, 0, max_pardepth, NULL,
-		      assemble_bem3d_block_hmatrix, bem);
+  (void) b;
 
-  freemem(par->hn);
-  par->hn = NULL;
+  assemble_bem3d_nearfield_leaves_hmatrix(bem, G);
+  assemble_bem3d_farfield_leaves_hmatrix(bem, G);
 }
 
 void
@@ -10141,66 +10473,23 @@ assemblecoarsen_bem3d_hmatrix(pbem3d bem, pblock b, phmatrix G)
 void
 assemble_bem3d_nearfield_hmatrix(pbem3d bem, pblock b, phmatrix G)
 {
-  pparbem3d par = bem->par;
-  par->hn = enumerate_hmatrix(b, G);
-
-  iterate_byrow_block(b, 0, 0, 0, max_pardepth, NULL,
-		      assemble_bem3d_nearfield_block_hmatrix, bem);
+  (void) b;
 
-  freemem(par->hn);
-  par->hn = NULL;
+  assemble_bem3d_nearfield_leaves_hmatrix(bem, G);
 }
 
 void
 assemble_bem3d_farfield_hmatrix(pbem3d bem, pblock b, phmatrix G)
 {
-  pparbem3d par = bem->par;
-  par->hn = enumerate_hmatrix(b, G);
-
-  iterate_byrow_block(b, 0, 0, 0, max_pardepth, NULL,
-		      assemble_bem3d_farfield_block_hmatrix, bem);
+  (void) b;
 
-  freemem(par->hn);
-  par->hn = NULL;
+  assemble_bem3d_farfield_leaves_hmatrix(bem, G);
 }
 
 /* ------------------------------------------------------------
  Fill h2-matrix
  ------------------------------------------------------------ */
 
-static void
-assemble_bem3d_block_h2matrix(ph2matrix G, uint bname, uint rname,
-			      uint cname, uint pardepth, void *data)
-{
-  pbem3d    bem = (pbem3d) data;
-
-  (void) pardepth;
-
-  if (G->u) {
-    bem->farfield_u(rname, cname, bname, bem);
-  }
-  else if (G->f) {
-    bem->nearfield(G->rb->t->idx, G->cb->t->idx, bem, false, G->f);
-  }
-}
-
-static void
-assemble_bem3d_nearfield_block_h2matrix(ph2matrix G, uint bname,
-					uint rname, uint cname, uint pardepth,
-					void *data)
-{
-  pbem3d    bem = (pbem3d) data;
-
-  (void) bname;
-  (void) rname;
-  (void) cname;
-  (void) pardepth;
-
-  if (G->f) {
-    bem->nearfield(G->rb->t->idx, G->cb->t->idx, bem, false, G->f);
-  }
-}
-
 static void
 assemble_bem3d_farfield_block_h2matrix(ph2matrix G, uint bname,
 				       uint rname, uint cname, uint pardepth,
@@ -10214,6 +10503,8 @@ assemble_bem3d_farfield_block_h2matrix(ph2matrix G, uint bname,
   (void) pardepth;
 
   if (G->u) {
+    if (G->u->coupling)
+      clear_uniform(G->u);
     bem->farfield_u(rname, cname, bname, bem);
   }
 }
@@ -10312,10 +10603,12 @@ assemblehiercomp_bem3d_block_h2matrix(pcblock b, uint bname,
 void
 assemble_bem3d_h2matrix(pbem3d bem, ph2matrix G)
 {
+  assemble_bem3d_nearfield_leaves_h2matrix(bem, G);
+
   bem->par->h2n = enumerate_h2matrix(G);
 
   iterate_h2matrix(G, 0, 0, 0, max_pardepth, NULL,
-		   assemble_bem3d_block_h2matrix, bem);
+		   assemble_bem3d_farfield_block_h2matrix, bem);
 
   freemem(bem->par->h2n);
   bem->par->h2n = NULL;
@@ -10324,13 +10617,7 @@ assemble_bem3d_h2matrix(pbem3d bem, ph2matrix G)
 void
 assemble_bem3d_nearfield_h2matrix(pbem3d bem, ph2matrix G)
 {
-  bem->par->h2n = enumerate_h2matrix(G);
-
-  iterate_h2matrix(G, 0, 0, 0, max_pardepth, NULL,
-		   assemble_bem3d_nearfield_block_h2matrix, bem);
-
-  freemem(bem->par->h2n);
-  bem->par->h2n = NULL;
+  assemble_bem3d_nearfield_leaves_h2matrix(bem, G);
 }
 
 void
@@ -10345,6 +10632,37 @@ assemble_bem3d_farfield_h2matrix(pbem3d bem, ph2matrix G)
   bem->par->h2n = NULL;
 }
 
+static void
+assemble_bem3d_implicit_farfield_block_h2matrix(ph2matrix G, pbem3d bem)
+{
+  uint      i, j;
+
+  if (G->son) {
+    for (j = 0; j < G->csons; j++)
+      for (i = 0; i < G->rsons; i++)
+	assemble_bem3d_implicit_farfield_block_h2matrix(G->son[i + j *
+							       G->rsons],
+							bem);
+  }
+  else if (G->u)
+    setimplicit_uniform(G->u, assemble_bem3d_inter_coupling, (void *) bem);
+}
+
+void
+assemble_bem3d_implicit_farfield_h2matrix(pbem3d bem, ph2matrix G)
+{
+  assert(bem->farfield_u == assemble_bem3d_inter_uniform);
+
+  assemble_bem3d_implicit_farfield_block_h2matrix(G, bem);
+}
+
+void
+assemble_bem3d_implicit_h2matrix(pbem3d bem, ph2matrix G)
+{
+  assemble_bem3d_nearfield_leaves_h2matrix(bem, G);
+  assemble_bem3d_implicit_farfield_h2matrix(bem, G);
+}
+
 void
 assemblehiercomp_bem3d_h2matrix(pbem3d bem, pblock b, ph2matrix G)
 {
@@ -10445,6 +10763,287 @@ assemble_bem3d_h2matrix_col_clusterbasis(pcbem3d bem, pclusterbasis cb)
   bem->par->cbn = NULL;
 }
 
+/* ------------------------------------------------------------
+ Evaluation of potentials in field points
+ ------------------------------------------------------------ */
+
+pcluster
+build_bem3d_points_cluster(uint points, const real(*Z)[3], uint clf)
+{
+  pclustergeometry cg;
+  pcluster  c;
+  uint     *idx;
+  uint      i;
+
+  cg = new_clustergeometry(3, points);
+  idx = allocuint(points);
+
+  for (i = 0; i < points; ++i) {
+    idx[i] = i;
+
+    /* Points are their own characteristic points and bounding boxes */
+    cg->x[i][0] = cg->smin[i][0] = cg->smax[i][0] = Z[i][0];
+    cg->x[i][1] = cg->smin[i][1] = cg->smax[i][1] = Z[i][1];
+    cg->x[i][2] = cg->smin[i][2] = cg->smax[i][2] = Z[i][2];
+  }
+
+  c = build_adaptive_cluster(cg, points, idx, clf);
+
+  del_clustergeometry(cg);
+
+  return c;
+}
+
+static real(*gather_points_bem3d(const real(*Z)[3], pccluster t))[3]
+{
+  real(*Zt)[3];
+  uint      i;
+
+  Zt = (real(*)[3]) allocreal((size_t) (3 * t->size));
+  for (i = 0; i < t->size; i++) {
+    Zt[i][0] = Z[t->idx[i]][0];
+    Zt[i][1] = Z[t->idx[i]][1];
+    Zt[i][2] = Z[t->idx[i]][2];
+  }
+
+  return Zt;
+}
+
+/* Nearfield block of the potential operator: the kernel is integrated
+ * over the boundary for every field point by kernel_col, which yields
+ * the transposed block. */
+static void
+assemble_bem3d_potential_nearfield(pcbem3d bem, const real(*Z)[3],
+				   pccluster rc, pccluster cc, pamatrix f)
+{
+  pkernelbem3d kernels = bem->kernels;
+  real(*Zt)[3];
+  amatrix   tmp;
+  pamatrix  B;
+  uint      i, j;
+
+  Zt = gather_points_bem3d(Z, rc);
+
+  B = init_amatrix(&tmp, cc->size, rc->size);
+  kernels->kernel_col(cc->idx, (const real(*)[3]) Zt, bem, B);
+
+  for (j = 0; j < cc->size; j++)
+    for (i = 0; i < rc->size; i++)
+      f->a[i + j * f->ld] = B->a[j + i * B->ld];
+
+  uninit_amatrix(B);
+  freemem(Zt);
+}
+
+/* Admissible block of the potential operator: interpolation in the
+ * field points, i.e., the Lagrange polynomials of the target cluster
+ * are evaluated in the field points and the kernel is integrated for
+ * the interpolation points, as in assemble_bem3d_inter_row_rkmatrix. */
+static void
+assemble_bem3d_potential_farfield(pcbem3d bem, const real(*Z)[3],
+				  pccluster rc, pccluster cc, prkmatrix R)
+{
+  paprxbem3d aprx = bem->aprx;
+  pkernelbem3d kernels = bem->kernels;
+  const uint m = aprx->m_inter;
+  const uint k = aprx->k_inter;
+  real(*Zt)[3], (*z)[3];
+  prealavector px, py, pz;
+
+  Zt = gather_points_bem3d(Z, rc);
+  z = (real(*)[3]) allocreal((size_t) (3 * k));
+  px = new_realavector(m);
+  py = new_realavector(m);
+  pz = new_realavector(m);
+
+  assemble_interpoints3d_array(bem, rc->bmin, rc->bmax, z);
+  assemble_interpoints3d_realavector(bem, rc->bmin, rc->bmax, px, py, pz);
+
+  resize_rkmatrix(R, rc->size, cc->size, k);
+
+  kernels->kernel_col(cc->idx, (const real(*)[3]) z, bem, &R->B);
+  conjugate_amatrix(&R->B);
+  assemble_bem3d_lagrange_amatrix((const real(*)[3]) Zt, px, py, pz, bem,
+				  &R->A);
+
+  if (aprx->recomp == true)
+    trunc_rkmatrix(0, aprx->accur_recomp, R);
+
+  del_realavector(px);
+  del_realavector(py);
+  del_realavector(pz);
+  freemem(z);
+  freemem(Zt);
+}
+
+/* Near- and farfield leaves share one task queue, since for large point
+ * sets both parts are of comparable size. */
+static void
+fill_potential_leaflist_bem3d(pcbem3d bem, const real(*Z)[3],
+			      leaflistbem3d * ll)
+{
+  leafbem3d *leaf = ll->leaf;
+  int       n = ll->n;
+  int       i;
+
+  heapsort(ll->n, geq_leaf, swap_leaf, leaf);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic,1) if(max_pardepth > 0 && n > 1)
+#endif
+  for (i = 0; i < n; i++) {
+    if (leaf[i].f)
+      assemble_bem3d_potential_nearfield(bem, Z, leaf[i].rc, leaf[i].cc,
+					 leaf[i].f);
+    else
+      assemble_bem3d_potential_farfield(bem, Z, leaf[i].rc, leaf[i].cc,
+					leaf[i].r);
+  }
+}
+
+void
+assemble_bem3d_potential_hmatrix(pcbem3d bem, const real(*Z)[3], phmatrix P)
+{
+  leaflistbem3d ll;
+  uint      nnear, nfar, i;
+
+  assert(bem->kernels->kernel_col != NULL);
+  assert(bem->aprx->k_inter > 0);
+
+  nnear = count_nearfield_hmatrix(P);
+  nfar = count_farfield_hmatrix(P);
+
+  ll.leaf = (leafbem3d *) allocmem((size_t) sizeof(leafbem3d) *
+				   (nnear + nfar));
+  ll.n = 0;
+  collect_nearfield_hmatrix(bem, P, &ll);
+  for (i = 0; i < ll.n; i++)
+    ll.leaf[i].r = NULL;
+  collect_farfield_hmatrix(bem, P, 0, 0, &ll);
+  for (i = nnear; i < ll.n; i++)
+    ll.leaf[i].f = NULL;
+
+  fill_potential_leaflist_bem3d(bem, Z, &ll);
+
+  freemem(ll.leaf);
+}
+
+typedef struct {
+  pcbem3d   bem;
+  const real(*Z)[3];
+  pclusterbasis *rbn;
+} potentialbasisbem3d;
+
+static void
+assemble_bem3d_potential_cluster_row_clusterbasis(pcclusterbasis rb0,
+						  uint rname, void *data)
+{
+  potentialbasisbem3d *pb = (potentialbasisbem3d *) data;
+  pcbem3d   bem = pb->bem;
+  paprxbem3d aprx = bem->aprx;
+  pclusterbasis rb = pb->rbn[rname];
+  pccluster t = rb->t;
+  const uint m = aprx->m_inter;
+  const uint k = aprx->k_inter;
+
+  real(*X)[3];
+  prealavector px, py, pz;
+  uint      s;
+
+  (void) rb0;
+
+  px = new_realavector(m);
+  py = new_realavector(m);
+  pz = new_realavector(m);
+
+  assemble_interpoints3d_realavector(bem, t->bmin, t->bmax, px, py, pz);
+
+  if (rb->sons > 0) {
+    X = (real(*)[3]) allocreal((size_t) (3 * k));
+
+    resize_clusterbasis(rb, k);
+
+    for (s = 0; s < rb->sons; ++s) {
+      assemble_interpoints3d_array(bem, rb->son[s]->t->bmin,
+				   rb->son[s]->t->bmax, X);
+      assemble_bem3d_lagrange_amatrix((const real(*)[3]) X, px, py, pz, bem,
+				      &rb->son[s]->E);
+    }
+  }
+  else {
+    X = gather_points_bem3d(pb->Z, t);
+
+    resize_amatrix(&rb->V, t->size, k);
+    rb->k = k;
+    update_clusterbasis(rb);
+
+    assemble_bem3d_lagrange_amatrix((const real(*)[3]) X, px, py, pz, bem,
+				    &rb->V);
+  }
+
+  del_realavector(px);
+  del_realavector(py);
+  del_realavector(pz);
+  freemem(X);
+}
+
+void
+assemble_bem3d_potential_row_clusterbasis(pcbem3d bem, const real(*Z)[3],
+					  pclusterbasis rb)
+{
+  potentialbasisbem3d pb;
+
+  assert(bem->aprx->k_inter > 0);
+
+  pb.bem = bem;
+  pb.Z = Z;
+  pb.rbn = enumerate_clusterbasis(rb->t, rb);
+
+  iterate_parallel_clusterbasis((pcclusterbasis) rb, 0, max_pardepth, NULL,
+				assemble_bem3d_potential_cluster_row_clusterbasis,
+				(void *) &pb);
+
+  freemem(pb.rbn);
+}
+
+static void
+assemble_bem3d_potential_coupling_h2matrix(pcbem3d bem, ph2matrix P)
+{
+  uint      i;
+
+  if (P->son) {
+    for (i = 0; i < P->rsons * P->csons; i++)
+      assemble_bem3d_potential_coupling_h2matrix(bem, P->son[i]);
+  }
+  else if (P->u)
+    assemble_bem3d_inter_coupling(P->u->rb, P->u->cb, (void *) bem,
+				  &P->u->S);
+  else
+    assert(P->f == NULL || (P->rb->sons == 0 && P->cb->sons == 0));
+}
+
+void
+assemble_bem3d_potential_h2matrix(pcbem3d bem, const real(*Z)[3],
+				  ph2matrix P)
+{
+  leaflistbem3d ll;
+
+  assert(bem->kernels->kernel_col != NULL);
+  assert(bem->kernels->fundamental != NULL);
+  assert(bem->aprx->k_inter > 0);
+
+  ll.leaf = (leafbem3d *) allocmem((size_t) sizeof(leafbem3d) *
+				   count_nearfield_h2matrix(P));
+  ll.n = 0;
+  collect_nearfield_h2matrix(bem, P, &ll);
+
+  fill_potential_leaflist_bem3d(bem, Z, &ll);
+
+  freemem(ll.leaf);
+
+  assemble_bem3d_potential_coupling_h2matrix(bem, P);
+}
+
 /* ------------------------------------------------------------
  Fill DH2-matrix
  ------------------------------------------------------------ */
@@ -11723,21 +12322,23 @@ build_bem3d_curl_sparsematrix(pcbem3d bm, psparsematrix * C0,
   const real *g = (const real *) gr->g;
   uint      vertices = gr->vertices;
   uint      triangles = gr->triangles;
-  psparsepattern sp;
   psparsematrix lC0, lC1, lC2;
+  uint     *rdof;
   uint      i, j;
 
-  sp = new_sparsepattern(triangles, vertices);
-
+  /* Every triangle couples with its three vertices */
+  rdof = allocuint(triangles);
   for (i = 0; i < triangles; i++)
-    for (j = 0; j < 3; j++)
-      addnz_sparsepattern(sp, i, t[i][j]);
+    rdof[i] = i;
 
-  *C0 = lC0 = new_zero_sparsematrix(sp);
-  *C1 = lC1 = new_zero_sparsematrix(sp);
-  *C2 = lC2 = new_zero_sparsematrix(sp);
+  *C0 = lC0 = new_elements_sparsematrix(triangles, vertices, triangles,
+					1, rdof, 3, (const uint *) t);
+  *C1 = lC1 = new_elements_sparsematrix(triangles, vertices, triangles,
+					1, rdof, 3, (const uint *) t);
+  *C2 = lC2 = new_elements_sparsematrix(triangles, vertices, triangles,
+					1, rdof, 3, (const uint *) t);
 
-  del_sparsepattern(sp);
+  freemem(rdof);
 
   for (i = 0; i < triangles; i++) {
     for (j = 0; j < 3; j++) {
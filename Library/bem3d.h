@@ -2628,6 +2628,27 @@ HEADER_PREFIX void
 setup_hmatrix_aprx_paca_bem3d(pbem3d bem, pccluster rc, pccluster cc,
     pcblock tree, real accur);
 
+/**
+ * @brief Approximate matrix block with ACA using blocks of partial pivots.
+ *
+ * Like @ref setup_hmatrix_aprx_paca_bem3d, but every step of the adaptive
+ * cross approximation fetches <tt>bsize</tt> rows and up to <tt>bsize</tt>
+ * columns of the matrix block at once, see @ref decomp_blockaca_rkmatrix.
+ * The nearfield quadrature routines then work on wider panels and the
+ * number of callbacks is reduced.
+ *
+ * @param bem All needed callback functions and parameters for this approximation
+ * scheme are set within the bem object.
+ * @param rc Root of the row @ref _cluster "clustertree".
+ * @param cc Root of the column @ref _cluster "clustertree".
+ * @param tree Root of the @ref _block "blocktree".
+ * @param accur Assesses the minimum accuracy for the ACA approximation.
+ * @param bsize Number of rows fetched per step.
+ */
+HEADER_PREFIX void
+setup_hmatrix_aprx_bpaca_bem3d(pbem3d bem, pccluster rc, pccluster cc,
+    pcblock tree, real accur, uint bsize);
+
 /* ------------------------------------------------------------
  * HCA
  * ------------------------------------------------------------ */
@@ -3090,11 +3111,15 @@ assemblecoarsen_bem3d_hmatrix(pbem3d bem, pblock b, phmatrix G);
 /**
  * @brief Fills the nearfield blocks of a @ref _hmatrix "hmatrix".
  *
- * This will traverse the block tree until it reaches its leafs.
+ * This will collect all leafs of the block tree.
  * For an inadmissible leaf block the full matrix @f$
  * G_{|t \times s} @f$ is computed. In case of an admissible leaf no operations
  * are performed.
  *
+ * The inadmissible leaves are sorted by an estimate of their cost
+ * and processed from a common task queue, so that threads
+ * dynamically pick up the next block once they have finished the last one.
+ *
  * @param bem @ref _bem3d "bem3d" object containing all necessary information
  * for computing the entries of @ref _hmatrix "hmatrix" <tt>G</tt> .
  * @param b Root of the @ref _block "blocktree".
@@ -3218,10 +3243,11 @@ assemble_bem3d_h2matrix(pbem3d bem, ph2matrix G);
 /**
  * @brief Fills the nearfield part of a @ref _h2matrix "h2matrix".
  *
- * This will traverse the block tree until it reaches its leafs.
+ * This will collect all leafs of the block tree.
  * For an inadmissible leaf block the full matrix @f$
- * G_{|t \times s} @f$ is computed.
- *
+ * G_{|t \times s} @f$ is computed. As in
+ * @ref assemble_bem3d_nearfield_hmatrix, the leaves are processed
+ * from a task queue ordered by decreasing estimated cost.
  *
  * @param bem @ref _bem3d "bem3d" object containing all necessary information
  * for computing the entries of @ref _h2matrix "h2matrix" <tt>G</tt> .
@@ -3257,6 +3283,45 @@ assemble_bem3d_nearfield_h2matrix(pbem3d bem, ph2matrix G);
 HEADER_PREFIX void
 assemble_bem3d_farfield_h2matrix(pbem3d bem, ph2matrix G);
 
+/**
+ * @brief Fills a @ref _h2matrix "h2matrix" without storing the
+ * coupling matrices of its admissible leaves.
+ *
+ * The nearfield is assembled as in @ref assemble_bem3d_nearfield_h2matrix,
+ * the farfield is prepared by @ref assemble_bem3d_implicit_farfield_h2matrix.
+ *
+ * @param bem @ref _bem3d "bem3d" object containing all necessary information
+ * for computing the entries of @ref _h2matrix "h2matrix" <tt>G</tt> .
+ * @param G @ref _h2matrix "h2matrix" to be filled.
+ */
+HEADER_PREFIX void
+assemble_bem3d_implicit_h2matrix(pbem3d bem, ph2matrix G);
+
+/**
+ * @brief Switches the admissible leaves of a @ref _h2matrix "h2matrix"
+ * to an implicit representation.
+ *
+ * Instead of storing @f$ S_b @f$, every @ref _uniform "uniform" leaf
+ * recomputes it from the kernel function evaluated in the interpolation
+ * points whenever it is needed, e.g., by @ref addeval_h2matrix_avector.
+ * This removes the storage for the coupling matrices, which usually
+ * dominates the farfield, at the cost of kernel evaluations in every
+ * matrix-vector multiplication.
+ *
+ * @attention Only interpolation is supported, i.e., the @ref _bem3d "bem3d"
+ * object has to be initialized by @ref setup_h2matrix_aprx_inter_bem3d,
+ * and the @ref _clusterbasis "clusterbasis" @f$ V_t @f$ and @f$ W_s @f$
+ * have to be computed before calling this function.
+ * @attention <tt>bem</tt> is referenced by the leaves of <tt>G</tt> and
+ * has to remain valid as long as <tt>G</tt> is used.
+ *
+ * @param bem @ref _bem3d "bem3d" object containing all necessary information
+ * for computing the coupling matrices of <tt>G</tt>.
+ * @param G @ref _h2matrix "h2matrix" to be prepared.
+ */
+HEADER_PREFIX void
+assemble_bem3d_implicit_farfield_h2matrix(pbem3d bem, ph2matrix G);
+
 /**
  * @brief Fills an @ref _h2matrix "h2matrix" with a predefined approximation
  * technique using hierarchical recompression.
@@ -3501,6 +3566,108 @@ assemble_bem3d_nearfield_dh2matrix(pbem3d bem, pdh2matrix G);
 HEADER_PREFIX void
 assemble_bem3d_farfield_dh2matrix(pbem3d bem, pdh2matrix G);
 
+/* ------------------------------------------------------------
+ * Evaluation of potentials in field points
+ * ------------------------------------------------------------ */
+
+/**
+ * @brief Creates a @ref _cluster "cluster" tree for a set of field points.
+ *
+ * The points are used as their own characteristic points and bounding
+ * boxes, so the resulting tree can be combined with the boundary
+ * cluster tree by @ref build_nonstrict_block to obtain the block tree
+ * of the rectangular potential operator.
+ *
+ * @remark The array <tt>idx</tt> of the root cluster is allocated by this
+ * function and has to be released by the caller, as for
+ * @ref build_bem3d_cluster.
+ *
+ * @param points Number of field points.
+ * @param Z Array of field points.
+ * @param clf Maximal number of points in a leaf cluster.
+ * @return Root of the new @ref _cluster "cluster" tree.
+ */
+HEADER_PREFIX pcluster
+build_bem3d_points_cluster(uint points, const real (*Z)[3], uint clf);
+
+/**
+ * @brief Fills an @ref _hmatrix "hmatrix" approximating the potential
+ * operator that maps coefficients of a boundary function to the values of
+ * its layer potential in a set of field points.
+ *
+ * The entries are
+ * @f[
+ * P_{ij} = \int_\Gamma \gamma(\vec z_i, \vec y) \, \psi_j(\vec y)
+ *   \, \mathrm d \vec y
+ * @f]
+ * with the kernel @f$ \gamma @f$ of <tt>bem</tt>, e.g., the single or double
+ * layer potential. Inadmissible blocks are computed by <tt>kernel_col</tt>,
+ * admissible blocks by interpolation in the field points, as in
+ * @ref setup_hmatrix_aprx_inter_row_bem3d. All leaves are filled in
+ * parallel from a common task queue.
+ *
+ * The result can be applied by @ref addeval_parallel_hmatrix_avector.
+ *
+ * @attention <tt>bem</tt> has to be prepared by an interpolation scheme
+ * such as @ref setup_hmatrix_aprx_inter_row_bem3d, whose order is used for
+ * the admissible blocks.
+ *
+ * @param bem @ref _bem3d "bem3d" object describing the potential.
+ * @param Z Array of field points, indexed by the row cluster tree of
+ *        <tt>P</tt>, see @ref build_bem3d_points_cluster.
+ * @param P @ref _hmatrix "hmatrix" to be filled.
+ */
+HEADER_PREFIX void
+assemble_bem3d_potential_hmatrix(pcbem3d bem, const real (*Z)[3],
+    phmatrix P);
+
+/**
+ * @brief Computes the nested row @ref _clusterbasis "clusterbasis"
+ * @f$ V_t @f$ for a set of field points.
+ *
+ * The leaf matrices contain the Lagrange polynomials of the cluster
+ * evaluated in the field points, the transfer matrices are the same as
+ * for @ref assemble_bem3d_h2matrix_row_clusterbasis with interpolation.
+ *
+ * @attention <tt>bem</tt> has to be prepared by
+ * @ref setup_h2matrix_aprx_inter_bem3d.
+ *
+ * @param bem @ref _bem3d "bem3d" object describing the potential.
+ * @param Z Array of field points, indexed by the cluster tree of
+ *        <tt>rb</tt>.
+ * @param rb Row @ref _clusterbasis "clusterbasis" to be filled.
+ */
+HEADER_PREFIX void
+assemble_bem3d_potential_row_clusterbasis(pcbem3d bem, const real (*Z)[3],
+    pclusterbasis rb);
+
+/**
+ * @brief Fills an @ref _h2matrix "h2matrix" approximating the potential
+ * operator described in @ref assemble_bem3d_potential_hmatrix.
+ *
+ * The row @ref _clusterbasis "clusterbasis" has to be computed by
+ * @ref assemble_bem3d_potential_row_clusterbasis, the column
+ * @ref _clusterbasis "clusterbasis" by
+ * @ref assemble_bem3d_h2matrix_col_clusterbasis. The coupling matrices
+ * are kernel evaluations in the interpolation points.
+ *
+ * The result can be applied by @ref addeval_parallel_h2matrix_avector.
+ *
+ * @attention <tt>bem</tt> has to be prepared by
+ * @ref setup_h2matrix_aprx_inter_bem3d.
+ * @attention Inadmissible leaves have to consist of leaf clusters, i.e.,
+ * the block tree should be constructed by @ref build_strict_block, since
+ * the field point tree and the boundary tree usually differ in depth.
+ *
+ * @param bem @ref _bem3d "bem3d" object describing the potential.
+ * @param Z Array of field points, indexed by the row cluster tree of
+ *        <tt>P</tt>.
+ * @param P @ref _h2matrix "h2matrix" to be filled.
+ */
+HEADER_PREFIX void
+assemble_bem3d_potential_h2matrix(pcbem3d bem, const real (*Z)[3],
+    ph2matrix P);
+
 /* ------------------------------------------------------------
  * Lagrange polynomials
  * ------------------------------------------------------------ */
@@ -0,0 +1,510 @@
+/* ------------------------------------------------------------
+ * This is the file "gcrodr.c" of the H2Lib package.
+ * All rights reserved, Steffen Boerm 2016
+ * ------------------------------------------------------------ */
+
+/** @file gcrodr.c
+ *  @author Steffen B&ouml;rm */
+
+#include "gcrodr.h"
+#include "basic.h"
+#include "factorizations.h"
+#include "krylovschur.h"
+
+/* ------------------------------------------------------------
+ * Constructors and destructors
+ * ------------------------------------------------------------ */
+
+pgcrodr
+new_gcrodr(uint n, uint m, uint k)
+{
+  pgcrodr   gd;
+
+  assert(k > 0);
+  assert(k < m);
+
+  gd = (pgcrodr) allocmem(sizeof(gcrodr));
+  gd->m = m;
+  gd->k = k;
+  gd->kr = 0;
+  gd->U = new_amatrix(n, k);
+  gd->C = new_amatrix(n, k);
+
+  return gd;
+}
+
+void
+del_gcrodr(pgcrodr gd)
+{
+  del_amatrix(gd->C);
+  del_amatrix(gd->U);
+  freemem(gd);
+}
+
+void
+reset_gcrodr(pgcrodr gd)
+{
+  gd->kr = 0;
+}
+
+/* ------------------------------------------------------------
+ * Auxiliary functions
+ * ------------------------------------------------------------ */
+
+/* Orthonormalize the columns of X, X = Q R, X is overwritten by Q */
+static void
+orthonormalize(pamatrix X, pamatrix R)
+{
+  pamatrix  QR;
+  pavector  tau;
+  uint      i, j;
+
+  QR = new_amatrix(X->rows, X->cols);
+  copy_amatrix(false, X, QR);
+  tau = new_avector(X->cols);
+  qrdecomp_amatrix(QR, tau);
+  clear_amatrix(R);
+  for (j = 0; j < X->cols; j++)
+    for (i = 0; i <= j; i++)
+      R->a[i + j * R->ld] = QR->a[i + j * QR->ld];
+  qrexpand_amatrix(QR, tau, X);
+  del_avector(tau);
+  del_amatrix(QR);
+}
+
+/* Orthogonalize v against the columns of C and V(:,0:j) by two passes of
+ * classical Gram-Schmidt, the coefficients are added to c and h */
+static void
+orthogonalize(pcamatrix C, pcamatrix V, pavector v, pavector c, pavector h)
+{
+  pavector  s;
+  uint      pass;
+
+  s = new_avector(UINT_MAX(C->cols, V->cols));
+
+  for (pass = 0; pass < 2; pass++) {
+    if (C->cols > 0) {
+      s->dim = C->cols;
+      clear_avector(s);
+      addevaltrans_amatrix_avector(1.0, C, v, s);
+      addeval_amatrix_avector(-1.0, C, s, v);
+      add_avector(1.0, s, c);
+    }
+
+    s->dim = V->cols;
+    clear_avector(s);
+    addevaltrans_amatrix_avector(1.0, V, v, s);
+    addeval_amatrix_avector(-1.0, V, s, v);
+    add_avector(1.0, s, h);
+  }
+
+  s->dim = UINT_MAX(C->cols, V->cols);
+  del_avector(s);
+}
+
+/* Find the harmonic Ritz vectors P belonging to the k harmonic Ritz
+ * values of smallest magnitude, i.e., G^* G z = theta G^* W^* Vh z with
+ * W = [C V] and Vh = [U V(:,0:steps-1)].  The rotations cs, sn and the
+ * triangular matrix T form the QR factorization of G, so 1/theta is an
+ * eigenvalue of T^{-1} Q^* W^* Vh.  Returns false if T is singular or
+ * the Schur form could not be computed. */
+static    bool
+harmonic_ritz(pcamatrix C, pcamatrix U, pcamatrix V, pcamatrix T,
+	      pcfield cs, pcfield sn, pamatrix P)
+{
+  amatrix   tmp;
+  pamatrix  Z, Zs;
+  field     x1, x2;
+  uint      kr, mm;
+  uint      i, j;
+  bool      ok;
+
+  kr = U->cols;
+  mm = T->cols;
+  assert(V->cols == mm - kr + 1);
+  assert(P->rows == mm);
+
+  for (i = 0; i < mm; i++)
+    if (T->a[i + i * T->ld] == 0.0)
+      return false;
+
+  /* Z = W^* Vh = [ C^* U  0 ]
+   *              [ V^* U  I ] */
+  Z = new_zero_amatrix(mm + 1, mm);
+  if (kr > 0) {
+    Zs = init_sub_amatrix(&tmp, Z, kr, 0, kr, 0);
+    addmul_amatrix(1.0, true, C, false, U, Zs);
+    uninit_amatrix(Zs);
+    Zs = init_sub_amatrix(&tmp, Z, V->cols, kr, kr, 0);
+    addmul_amatrix(1.0, true, V, false, U, Zs);
+    uninit_amatrix(Zs);
+  }
+  for (i = kr; i < mm; i++)
+    Z->a[i + i * Z->ld] = 1.0;
+
+  /* Apply the rotations of the least-squares problem and solve with T */
+  for (j = 0; j < mm; j++)
+    for (i = kr; i < mm; i++) {
+      x1 = Z->a[i + j * Z->ld];
+      x2 = Z->a[(i + 1) + j * Z->ld];
+      Z->a[i + j * Z->ld] = CONJ(cs[i]) * x1 + CONJ(sn[i]) * x2;
+      Z->a[(i + 1) + j * Z->ld] = -sn[i] * x1 + cs[i] * x2;
+    }
+  Zs = init_sub_amatrix(&tmp, Z, mm, 0, mm, 0);
+  triangularsolve_amatrix(false, false, false, T, false, Zs);
+
+  ok = schurbasis_amatrix(Zs, H2_EIG_LARGEST_MAGNITUDE, P);
+  uninit_amatrix(Zs);
+
+  del_amatrix(Z);
+
+  return ok;
+}
+
+/* ------------------------------------------------------------
+ * Solvers
+ * ------------------------------------------------------------ */
+
+uint
+solve_gcrodr_avector(pgcrodr gd, void *A, addeval_t addeval_A, pcavector b,
+		     pavector x, real eps, uint maxiter)
+{
+  amatrix   tmp1, tmp2, tmp3, tmp4, tmp5;
+  avector   tmp6, tmp7, tmp8, tmp9, tmp10;
+  pamatrix  U, C, V, G, T, P, GP, R, Ut, Ct, Ck, Vj, Vs, Ts, Gs, Pk;
+  pavector  r, u, v, g, c, h, rhs, y, t, d;
+  pfield    cs, sn;
+  field     beta, rho, x1, x2;
+  real      norm, error;
+  uint      n, m, k, kr, steps, mm;
+  uint      i, j, iter;
+  bool      regular;
+
+  n = x->dim;
+  m = gd->m;
+  k = gd->k;
+
+  assert(b->dim == n);
+  assert(gd->U->rows == n);
+
+  U = gd->U;
+  C = gd->C;
+
+  r = new_avector(n);
+  V = new_amatrix(n, m + 1);
+  G = new_amatrix(m + 1, m);
+  T = new_amatrix(m + 1, m);
+  rhs = new_avector(m + 1);
+  y = new_avector(m + 1);
+  t = new_avector(m + 1);
+  d = new_avector(k);
+  cs = allocfield(m);
+  sn = allocfield(m);
+  P = new_amatrix(m, k);
+  GP = new_amatrix(m + 1, k);
+  R = new_amatrix(k, k);
+  Ut = new_amatrix(n, k);
+  Ct = new_amatrix(n, k);
+
+  norm = norm2_avector(b);
+
+  copy_avector(b, r);
+  addeval_A(-1.0, A, x, r);
+
+  /* Adapt the recycled space to the current matrix, C = A U orthonormal */
+  if (gd->kr > 0) {
+    clear_amatrix(C);
+    for (j = 0; j < k; j++) {
+      u = init_column_avector(&tmp6, U, j);
+      v = init_column_avector(&tmp7, C, j);
+      addeval_A(1.0, A, u, v);
+      uninit_avector(v);
+      uninit_avector(u);
+    }
+    orthonormalize(C, R);
+    triangularsolve_amatrix(false, false, true, R, true, U);
+
+    /* Minimize the residual over the recycled space */
+    clear_avector(d);
+    addevaltrans_amatrix_avector(1.0, C, r, d);
+    addeval_amatrix_avector(1.0, U, d, x);
+    addeval_amatrix_avector(-1.0, C, d, r);
+  }
+
+  error = norm2_avector(r);
+
+  iter = 0;
+  while (error > eps * norm && (maxiter == 0 || iter < maxiter)) {
+    kr = gd->kr;
+    Ck = init_sub_amatrix(&tmp1, C, n, 0, kr, 0);
+
+    /* The projected matrix
+     *   G = [ D  B ]   with D = diag(1/|u_j|) and B = C^* A V
+     *       [ 0  H ]
+     * is upper Hessenberg, its QR factorization T is computed by
+     * Givens rotations */
+    clear_amatrix(G);
+    clear_amatrix(T);
+    clear_avector(rhs);
+
+    /* Scale the recycled vectors to unit length, A U D = C D */
+    for (j = 0; j < kr; j++) {
+      u = init_column_avector(&tmp6, U, j);
+      G->a[j + j * G->ld] = 1.0 / norm2_avector(u);
+      T->a[j + j * T->ld] = G->a[j + j * G->ld];
+      scale_avector(G->a[j + j * G->ld], u);
+      uninit_avector(u);
+      cs[j] = 1.0;
+      sn[j] = 0.0;
+    }
+
+    /* Right-hand side [C^* r; beta e_1] and starting vector */
+    c = init_sub_avector(&tmp6, rhs, kr, 0);
+    addevaltrans_amatrix_avector(1.0, Ck, r, c);
+    v = init_column_avector(&tmp7, V, 0);
+    copy_avector(r, v);
+    addeval_amatrix_avector(-1.0, Ck, c, v);
+    beta = norm2_avector(v);
+    scale_avector(1.0 / beta, v);
+    uninit_avector(v);
+    uninit_avector(c);
+    rhs->v[kr] = beta;
+
+    /* Arnoldi process for (I - C C^*) A */
+    steps = 0;
+    while (kr + steps < m && error > eps * norm
+	   && (maxiter == 0 || iter < maxiter)) {
+      j = kr + steps;
+
+      u = init_column_avector(&tmp6, V, steps);
+      v = init_column_avector(&tmp7, V, steps + 1);
+      clear_avector(v);
+      addeval_A(1.0, A, u, v);
+
+      g = init_column_avector(&tmp8, G, j);
+      c = init_sub_avector(&tmp9, g, kr, 0);
+      h = init_sub_avector(&tmp10, g, steps + 1, kr);
+      Vj = init_sub_amatrix(&tmp2, V, n, 0, steps + 1, 0);
+      orthogonalize(Ck, Vj, v, c, h);
+      uninit_amatrix(Vj);
+      uninit_avector(h);
+      uninit_avector(c);
+      uninit_avector(g);
+
+      G->a[(j + 1) + j * G->ld] = norm2_avector(v);
+      if (G->a[(j + 1) + j * G->ld] != 0.0)
+	scale_avector(1.0 / G->a[(j + 1) + j * G->ld], v);
+      uninit_avector(v);
+      uninit_avector(u);
+
+      /* Apply previous rotations to the new column */
+      for (i = 0; i <= j + 1; i++)
+	T->a[i + j * T->ld] = G->a[i + j * G->ld];
+      for (i = kr; i < j; i++) {
+	x1 = T->a[i + j * T->ld];
+	x2 = T->a[(i + 1) + j * T->ld];
+	T->a[i + j * T->ld] = CONJ(cs[i]) * x1 + CONJ(sn[i]) * x2;
+	T->a[(i + 1) + j * T->ld] = -sn[i] * x1 + cs[i] * x2;
+      }
+
+      /* Compute new rotation eliminating the subdiagonal entry */
+      x1 = T->a[j + j * T->ld];
+      x2 = T->a[(j + 1) + j * T->ld];
+      rho = REAL_SQRT(ABSSQR(x1) + ABSSQR(x2));
+      if (rho == 0.0) {
+	cs[j] = 1.0;
+	sn[j] = 0.0;
+      }
+      else {
+	cs[j] = x1 / rho;
+	sn[j] = x2 / rho;
+      }
+      T->a[j + j * T->ld] = rho;
+      T->a[(j + 1) + j * T->ld] = 0.0;
+
+      x1 = rhs->v[j];
+      x2 = rhs->v[j + 1];
+      rhs->v[j] = CONJ(cs[j]) * x1 + CONJ(sn[j]) * x2;
+      rhs->v[j + 1] = -sn[j] * x1 + cs[j] * x2;
+
+      /* Residual norm of the least-squares problem, the component
+       * outside of the range of [C V] vanishes by construction */
+      error = ABS(rhs->v[j + 1]);
+
+      steps++;
+      iter++;
+    }
+
+    mm = kr + steps;
+
+    /* Solve the least-squares problem */
+    y->dim = mm;
+    for (i = 0; i < mm; i++)
+      y->v[i] = rhs->v[i];
+    Gs = init_sub_amatrix(&tmp2, T, mm, 0, mm, 0);
+    triangularsolve_amatrix_avector(false, false, false, Gs, y);
+    uninit_amatrix(Gs);
+
+    /* x <- x + [U V] y */
+    u = init_sub_avector(&tmp6, y, kr, 0);
+    Vj = init_sub_amatrix(&tmp3, U, n, 0, kr, 0);
+    addeval_amatrix_avector(1.0, Vj, u, x);
+    uninit_amatrix(Vj);
+    uninit_avector(u);
+    u = init_sub_avector(&tmp6, y, steps, kr);
+    Vj = init_sub_amatrix(&tmp3, V, n, 0, steps, 0);
+    addeval_amatrix_avector(1.0, Vj, u, x);
+    uninit_amatrix(Vj);
+    uninit_avector(u);
+
+    /* r <- r - [C V] G y */
+    Gs = init_sub_amatrix(&tmp2, G, mm + 1, 0, mm, 0);
+    t->dim = mm + 1;
+    clear_avector(t);
+    addeval_amatrix_avector(1.0, Gs, y, t);
+    u = init_sub_avector(&tmp6, t, kr, 0);
+    addeval_amatrix_avector(-1.0, Ck, u, r);
+    uninit_avector(u);
+    u = init_sub_avector(&tmp6, t, steps + 1, kr);
+    Vj = init_sub_amatrix(&tmp3, V, n, 0, steps + 1, 0);
+    addeval_amatrix_avector(-1.0, Vj, u, r);
+    uninit_amatrix(Vj);
+    uninit_avector(u);
+    t->dim = m + 1;
+    y->dim = m + 1;
+
+    error = norm2_avector(r);
+
+    /* New recycled space: the harmonic Ritz vectors P belonging to the
+     * harmonic Ritz values of smallest magnitude, U = [U V] P R^{-1} and
+     * C = [C V] Q with G P = Q R */
+    regular = false;
+    if (mm >= k) {
+      P->rows = mm;
+      Vj = init_sub_amatrix(&tmp3, U, n, 0, kr, 0);
+      Vs = init_sub_amatrix(&tmp4, V, n, 0, steps + 1, 0);
+      Ts = init_sub_amatrix(&tmp5, T, mm, 0, mm, 0);
+      regular = harmonic_ritz(Ck, Vj, Vs, Ts, cs, sn, P);
+      uninit_amatrix(Ts);
+      uninit_amatrix(Vs);
+      uninit_amatrix(Vj);
+    }
+
+    if (regular) {
+      clear_amatrix(Ut);
+      Vj = init_sub_amatrix(&tmp3, U, n, 0, kr, 0);
+      Pk = init_sub_amatrix(&tmp4, P, kr, 0, k, 0);
+      addmul_amatrix(1.0, false, Vj, false, Pk, Ut);
+      uninit_amatrix(Pk);
+      uninit_amatrix(Vj);
+      Vj = init_sub_amatrix(&tmp3, V, n, 0, steps, 0);
+      Pk = init_sub_amatrix(&tmp4, P, steps, kr, k, 0);
+      addmul_amatrix(1.0, false, Vj, false, Pk, Ut);
+      uninit_amatrix(Pk);
+      uninit_amatrix(Vj);
+
+      GP->rows = mm + 1;
+      clear_amatrix(GP);
+      addmul_amatrix(1.0, false, Gs, false, P, GP);
+      orthonormalize(GP, R);
+
+      clear_amatrix(Ct);
+      Pk = init_sub_amatrix(&tmp4, GP, kr, 0, k, 0);
+      addmul_amatrix(1.0, false, Ck, false, Pk, Ct);
+      uninit_amatrix(Pk);
+      Vj = init_sub_amatrix(&tmp3, V, n, 0, steps + 1, 0);
+      Pk = init_sub_amatrix(&tmp4, GP, steps + 1, kr, k, 0);
+      addmul_amatrix(1.0, false, Vj, false, Pk, Ct);
+      uninit_amatrix(Pk);
+      uninit_amatrix(Vj);
+
+      for (i = 0; i < k; i++)
+	if (R->a[i + i * R->ld] == 0.0)
+	  regular = false;
+
+      if (regular) {
+	triangularsolve_amatrix(false, false, true, R, true, Ut);
+	copy_amatrix(false, Ut, U);
+	copy_amatrix(false, Ct, C);
+	gd->kr = k;
+      }
+
+      GP->rows = m + 1;
+    }
+    P->rows = m;
+
+    /* Undo the scaling if the recycled space has been kept, A U = C */
+    if (!regular)
+      for (j = 0; j < kr; j++) {
+	u = init_column_avector(&tmp6, U, j);
+	scale_avector(1.0 / G->a[j + j * G->ld], u);
+	uninit_avector(u);
+      }
+
+    uninit_amatrix(Gs);
+    uninit_amatrix(Ck);
+  }
+
+  del_amatrix(Ct);
+  del_amatrix(Ut);
+  del_amatrix(R);
+  del_amatrix(GP);
+  del_amatrix(P);
+  freemem(sn);
+  freemem(cs);
+  del_avector(d);
+  del_avector(t);
+  del_avector(y);
+  del_avector(rhs);
+  del_amatrix(T);
+  del_amatrix(G);
+  del_amatrix(V);
+  del_avector(r);
+
+  return iter;
+}
+
+uint
+solve_gcrodr_amatrix_avector(pgcrodr gd, pcamatrix A, pcavector b, pavector x,
+			     real eps, uint maxiter)
+{
+  return solve_gcrodr_avector(gd, (void *) A,
+			      (addeval_t) addeval_amatrix_avector, b, x, eps,
+			      maxiter);
+}
+
+uint
+solve_gcrodr_sparsematrix_avector(pgcrodr gd, pcsparsematrix A, pcavector b,
+				  pavector x, real eps, uint maxiter)
+{
+  return solve_gcrodr_avector(gd, (void *) A,
+			      (addeval_t) addeval_sparsematrix_avector, b, x,
+			      eps, maxiter);
+}
+
+uint
+solve_gcrodr_hmatrix_avector(pgcrodr gd, pchmatrix A, pcavector b, pavector x,
+			     real eps, uint maxiter)
+{
+  return solve_gcrodr_avector(gd, (void *) A,
+			      (addeval_t) addeval_hmatrix_avector, b, x, eps,
+			      maxiter);
+}
+
+uint
+solve_gcrodr_h2matrix_avector(pgcrodr gd, pch2matrix A, pcavector b,
+			      pavector x, real eps, uint maxiter)
+{
+  return solve_gcrodr_avector(gd, (void *) A,
+			      (addeval_t) addeval_h2matrix_avector, b, x, eps,
+			      maxiter);
+}
+
+uint
+solve_gcrodr_dh2matrix_avector(pgcrodr gd, pcdh2matrix A, pcavector b,
+			       pavector x, real eps, uint maxiter)
+{
+  return solve_gcrodr_avector(gd, (void *) A,
+			      (addeval_t) addeval_dh2matrix_avector, b, x,
+			      eps, maxiter);
+}
@@ -0,0 +1,196 @@
+/* ------------------------------------------------------------
+ * This is the file "gcrodr.h" of the H2Lib package.
+ * All rights reserved, Steffen Boerm 2016
+ * ------------------------------------------------------------ */
+
+/** @file gcrodr.h
+ *  @author Steffen B&ouml;rm */
+
+#ifndef GCRODR_H
+#define GCRODR_H
+
+/** @defgroup gcrodr gcrodr
+ *  @brief GMRES with Krylov subspace recycling for sequences of
+ *  linear systems.
+ *
+ *  The GCRO-DR method keeps a small subspace @f$U@f$ from one solve to
+ *  the next one. Every cycle minimizes the residual over the span of
+ *  @f$U@f$ and a Krylov space of @f$(I-CC^*)A@f$ with @f$C = AU@f$, so
+ *  the components of the solution related to the recycled space do not
+ *  have to be found again. This is useful for slowly changing matrices,
+ *  e.g., in frequency sweeps or time-stepping schemes.
+ *
+ *  The recycled space is spanned by harmonic Ritz vectors belonging to
+ *  the harmonic Ritz values of smallest magnitude, i.e., approximate
+ *  eigenvectors for the eigenvalues closest to zero, extracted from the
+ *  projected matrix of each cycle.
+ *  @{ */
+
+/** @brief Recycling GMRES solver. */
+typedef struct _gcrodr gcrodr;
+
+/** @brief Pointer to @ref gcrodr object. */
+typedef gcrodr *pgcrodr;
+
+/** @brief Pointer to constant @ref gcrodr object. */
+typedef const gcrodr *pcgcrodr;
+
+#include "krylovsolvers.h"
+
+/** @brief Recycling GMRES solver. */
+struct _gcrodr {
+  /** @brief Maximal dimension of the search space of one cycle,
+   *  including the recycled space. */
+  uint m;
+
+  /** @brief Dimension of the recycled space. */
+  uint k;
+
+  /** @brief Number of recycled vectors currently available,
+   *  either <tt>0</tt> or <tt>k</tt>. */
+  uint kr;
+
+  /** @brief Recycled space @f$U@f$. */
+  pamatrix U;
+
+  /** @brief Orthonormal basis @f$C = AU@f$ for the current matrix. */
+  pamatrix C;
+};
+
+/* ------------------------------------------------------------
+ * Constructors and destructors
+ * ------------------------------------------------------------ */
+
+/** @brief Create a recycling GMRES solver.
+ *
+ *  @param n Dimension of the linear systems.
+ *  @param m Maximal dimension of the search space of one cycle.
+ *  @param k Dimension of the recycled space, has to be smaller than
+ *    <tt>m</tt>.
+ *  @returns New @ref gcrodr object without recycled space. */
+HEADER_PREFIX pgcrodr
+new_gcrodr(uint n, uint m, uint k);
+
+/** @brief Delete a recycling GMRES solver.
+ *
+ *  @param gd Object to be deleted. */
+HEADER_PREFIX void
+del_gcrodr(pgcrodr gd);
+
+/** @brief Discard the recycled space, e.g., if the next system is
+ *  unrelated to the previous ones.
+ *
+ *  @param gd Recycling GMRES solver. */
+HEADER_PREFIX void
+reset_gcrodr(pgcrodr gd);
+
+/* ------------------------------------------------------------
+ * Solvers
+ * ------------------------------------------------------------ */
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the recycling GMRES
+ *  method and a general matrix type <tt>A</tt>.
+ *
+ *  If a recycled space is available, it is first adapted to the
+ *  current matrix, which requires <tt>k</tt> additional matrix-vector
+ *  multiplications. After the solve, the recycled space is updated
+ *  for the next system.
+ *
+ *  @param gd Recycling GMRES solver.
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_gcrodr_avector(pgcrodr gd, void *A, addeval_t addeval_A, pcavector b,
+    pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the recycling GMRES
+ *  method.
+ *
+ *  @param gd Recycling GMRES solver.
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_gcrodr_amatrix_avector(pgcrodr gd, pcamatrix A, pcavector b,
+    pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the recycling GMRES
+ *  method.
+ *
+ *  @param gd Recycling GMRES solver.
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_gcrodr_sparsematrix_avector(pgcrodr gd, pcsparsematrix A, pcavector b,
+    pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the recycling GMRES
+ *  method.
+ *
+ *  @param gd Recycling GMRES solver.
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_gcrodr_hmatrix_avector(pgcrodr gd, pchmatrix A, pcavector b,
+    pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the recycling GMRES
+ *  method.
+ *
+ *  @param gd Recycling GMRES solver.
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_gcrodr_h2matrix_avector(pgcrodr gd, pch2matrix A, pcavector b,
+    pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the recycling GMRES
+ *  method.
+ *
+ *  @param gd Recycling GMRES solver.
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_gcrodr_dh2matrix_avector(pgcrodr gd, pcdh2matrix A, pcavector b,
+    pavector x, real eps, uint maxiter);
+
+/** @} */
+
+#endif
@@ -375,9 +375,12 @@ convert_uniform_rkmatrix(bool utrans, pcuniform u)
   prkmatrix r;
 
   pamatrix  Yt;
-  amatrix   tmp;
+  pcamatrix S;
+  amatrix   tmp, tmp2;
   uint      k;
 
+  S = getcoupling_uniform(u, init_amatrix(&tmp2, 0, 0));
+
   if (krow <= kcol) {
     k = krow;
     r = new_rkmatrix(rows, cols, k);
@@ -388,7 +391,7 @@ convert_uniform_rkmatrix(bool utrans, pcuniform u)
     uninit_amatrix(Yt);
     /* r->B = cb->W * u->S^T */
     Yt = init_zero_amatrix(&tmp, cb->kbranch, k);
-    copy_sub_amatrix(true, &u->S, Yt);
+    copy_sub_amatrix(true, S, Yt);
     clear_amatrix(&r->B);
     fastaddmul_clusterbasis_amatrix(cb, Yt, &r->B);
     uninit_amatrix(Yt);
@@ -398,7 +401,7 @@ convert_uniform_rkmatrix(bool utrans, pcuniform u)
     r = new_rkmatrix(rows, cols, k);
     /* r->A = rb->V * u->S */
     Yt = init_zero_amatrix(&tmp, rb->kbranch, k);
-    copy_sub_amatrix(false, &u->S, Yt);
+    copy_sub_amatrix(false, S, Yt);
     clear_amatrix(&r->A);
     fastaddmul_clusterbasis_amatrix(rb, Yt, &r->A);
     uninit_amatrix(Yt);
@@ -409,6 +412,8 @@ convert_uniform_rkmatrix(bool utrans, pcuniform u)
     uninit_amatrix(Yt);
   }
 
+  uninit_amatrix(&tmp2);
+
   if (utrans) {
     tmp = r->A;
     r->A = r->B;
@@ -860,7 +865,7 @@ addmul_1_h2matrix(field alpha, pch2matrix A, pch2matrix B, ph2matrix C,
   /*eighth case: C is admissible zero block and A and B are not */
   else if (A->son && B->son) {
     C->u = new_uniform(C->rb, C->cb);
-    clear_amatrix(&C->u->S);
+    clear_uniform(C->u);
 
     R = mul_h2matrix_rkmatrix(A, false, B, tol);
     scale_amatrix(alpha, &R->A);
@@ -1011,7 +1016,7 @@ addmul_2_h2matrix(field alpha, pch2matrix A, pch2matrix B, ph2matrix C,
   /*eighth case: C is admissible zero block and A and B are not */
   else if (A->son && B->son) {
     C->u = new_uniform(C->rb, C->cb);
-    clear_amatrix(&C->u->S);
+    clear_uniform(C->u);
 
     R = mul_h2matrix_rkmatrix(A, true, B, tol);
     scale_amatrix(alpha, &R->A);
@@ -1731,7 +1736,7 @@ lowersolve_amatrix_2_h2matrix(bool unit, pcamatrix L, pch2matrix X,
   }
   else if (X->u != 0) {
     r = convert_uniform_rkmatrix(false, X->u);
-    clear_amatrix(&X->u->S);
+    clear_uniform(X->u);
     triangularsolve_amatrix(true, unit, false, L, false, &r->B);
     rkupdate_h2matrix(r, R, rwfup, cwfup, tm, tol);
     del_rkmatrix(r);
@@ -149,6 +149,8 @@ norm2_fast_uniform(pcuniform u, pcclusteroperator rw, pcclusteroperator cw)
   pamatrix  ur, urc;
   real      norm;
 
+  assert(u->coupling == NULL);
+
   if (rw) {
     if (cw) {
       ur = init_amatrix(&tmp1, rw->krow, u->cb->k);
@@ -194,6 +196,8 @@ normfrob_fast_uniform(pcuniform u, pcclusteroperator rw, pcclusteroperator cw)
   pamatrix  ur, urc;
   real      norm;
 
+  assert(u->coupling == NULL);
+
   if (rw) {
     if (cw) {
       ur = init_amatrix(&tmp1, rw->krow, u->cb->k);
@@ -295,6 +299,8 @@ localweights1(pccluster t, uint tname, uint pardepth,
       cbw = cbwn[hl0->cname];
 
       if (G->u) {
+	assert(G->u->coupling == NULL);
+
 	/* Compute weight factor */
 	alpha = 1.0;
 	if (tm && tm->blocks) {
@@ -361,6 +367,8 @@ localweights1(pccluster t, uint tname, uint pardepth,
       cbw = cbwn[hl0->cname];
 
       if (G->u) {
+	assert(G->u->coupling == NULL);
+
 	/* Compute weight factor */
 	alpha = 1.0;
 	if (tm && tm->blocks) {
@@ -494,6 +502,7 @@ localweights2(ph2matrix G, uint bname, uint rname, uint cname,
 
   assert(rb == G->u->rb);
   assert(cb == G->u->cb);
+  assert(G->u->coupling == NULL);
   assert(rlw->t == rb->t);
   assert(clw->t == cb->t);
 
@@ -1327,6 +1336,7 @@ computebasis_pre(pccluster t, uint tname, uint pardepth,
     if (rbw) {
       for (hl0 = hl; hl0; hl0 = hl0->next)
 	if (hl0->G->u) {
+	  assert(hl0->G->u->coupling == NULL);
 	  Zhat1 = init_sub_amatrix(&tmp2, Zhat, rbw[hl0->rname].rows, off,
 				   cbold->k, 0);
 	  clear_amatrix(Zhat1);
@@ -1353,6 +1363,7 @@ computebasis_pre(pccluster t, uint tname, uint pardepth,
     else {
       for (hl0 = hl; hl0; hl0 = hl0->next)
 	if (hl0->G->u) {
+	  assert(hl0->G->u->coupling == NULL);
 	  Zhat1 = init_sub_amatrix(&tmp2, Zhat, hl0->G->rb->k, off, cbold->k,
 				   0);
 	  copy_amatrix(false, &hl0->G->u->S, Zhat1);
@@ -1411,6 +1422,7 @@ computebasis_pre(pccluster t, uint tname, uint pardepth,
     if (cbw) {
       for (hl0 = hl; hl0; hl0 = hl0->next)
 	if (hl0->G->u) {
+	  assert(hl0->G->u->coupling == NULL);
 	  Zhat1 = init_sub_amatrix(&tmp2, Zhat, cbw[hl0->cname].rows, off,
 				   cbold->k, 0);
 	  clear_amatrix(Zhat1);
@@ -1437,6 +1449,7 @@ computebasis_pre(pccluster t, uint tname, uint pardepth,
     else {
       for (hl0 = hl; hl0; hl0 = hl0->next)
 	if (hl0->G->u) {
+	  assert(hl0->G->u->coupling == NULL);
 	  Zhat1 = init_sub_amatrix(&tmp2, Zhat, hl0->G->cb->k, off, cbold->k,
 				   0);
 	  copy_amatrix(true, &hl0->G->u->S, Zhat1);
@@ -1988,6 +2001,7 @@ totalweight_row_clusteroperator(pclusterbasis rb, pclusteroperator rw,
 	}
 	Z = u->cb->Z;
 
+	assert(u->coupling == NULL);
 	assert(Z->cols == u->S.cols);
 	Yhat1 = init_sub_amatrix(&tmp2, Yhat, Z->rows, off, son->k, 0);
 	clear_amatrix(Yhat1);
@@ -2081,6 +2095,7 @@ totalweight_col_clusteroperator(pclusterbasis cb, pclusteroperator cw,
 	}
 	Z = u->rb->Z;
 
+	assert(u->coupling == NULL);
 	assert(Z->cols == u->S.rows);
 	Yhat1 = init_sub_amatrix(&tmp2, Yhat, Z->rows, off, son->k, 0);
 	clear_amatrix(Yhat1);
@@ -199,7 +199,10 @@ clone_h2matrix(pch2matrix h2, pclusterbasis rb, pclusterbasis cb)
   }
   else if (h2->u != NULL) {
     h2clone = new_uniform_h2matrix(rb, cb);
-    copy_amatrix(false, &h2->u->S, &h2clone->u->S);
+    if (h2->u->coupling)
+      setimplicit_uniform(h2clone->u, h2->u->coupling, h2->u->cdata);
+    else
+      copy_amatrix(false, &h2->u->S, &h2clone->u->S);
   }
   else if (h2->f != NULL) {
     h2clone = new_full_h2matrix(rb, cb);
@@ -389,7 +392,7 @@ clear_h2matrix(ph2matrix h2)
 	clear_h2matrix(h2->son[i + j * rsons]);
   }
   else if (h2->u)
-    clear_amatrix(&h2->u->S);
+    clear_uniform(h2->u);
   else if (h2->f)
     clear_amatrix(h2->f);
 }
@@ -1207,9 +1210,9 @@ mvm_h2matrix_avector(field alpha, bool h2trans, pch2matrix h2, pcavector x,
     addeval_h2matrix_avector(alpha, h2, x, y);
 }
 
-void
-fastaddeval_h2matrix_avector(field alpha, pch2matrix h2, pavector xt,
-			     pavector yt)
+static void
+fastaddeval(field alpha, pch2matrix h2, pavector xt, pavector yt,
+	    pamatrix tmp)
 {
   avector   loc1, loc2;
   pavector  xp, yp, xt1, yt1;
@@ -1221,7 +1224,7 @@ fastaddeval_h2matrix_avector(field alpha, pch2matrix h2, pavector xt,
   uint      i, j;
 
   if (h2->u) {
-    addeval_amatrix_avector(alpha, &h2->u->S, xt, yt);
+    addeval_amatrix_avector(alpha, getcoupling_uniform(h2->u, tmp), xt, yt);
   }
   else if (h2->f) {
     xp = init_sub_avector(&loc1, xt, cb->t->size, cb->k);
@@ -1249,7 +1252,7 @@ fastaddeval_h2matrix_avector(field alpha, pch2matrix h2, pavector xt,
 	       init_sub_avector(&loc2, yt, rb->son[i]->ktree, ytoff) :
 	       init_sub_avector(&loc2, yt, rb->ktree, 0));
 
-	fastaddeval_h2matrix_avector(alpha, h2->son[i + j * rsons], xt1, yt1);
+	fastaddeval(alpha, h2->son[i + j * rsons], xt1, yt1, tmp);
 
 	uninit_avector(yt1);
 
@@ -1265,6 +1268,20 @@ fastaddeval_h2matrix_avector(field alpha, pch2matrix h2, pavector xt,
   }
 }
 
+void
+fastaddeval_h2matrix_avector(field alpha, pch2matrix h2, pavector xt,
+			     pavector yt)
+{
+  amatrix   tmp;
+
+  /* Buffer for coupling matrices that are computed on the fly */
+  init_amatrix(&tmp, 0, 0);
+
+  fastaddeval(alpha, h2, xt, yt, &tmp);
+
+  uninit_amatrix(&tmp);
+}
+
 void
 addeval_h2matrix_avector(field alpha, pch2matrix h2, pcavector x, pavector y)
 {
@@ -1285,9 +1302,116 @@ addeval_h2matrix_avector(field alpha, pch2matrix h2, pcavector x, pavector y)
   del_avector(xt);
 }
 
+/* Row-parallel version of fastaddeval: the row sons of a block write to
+ * disjoint parts of yt, so each of them is handled by its own thread
+ * together with all of its column sons. Every thread uses its own buffer
+ * for implicitly represented coupling matrices. */
+static void
+fastaddeval_parallel(field alpha, pch2matrix h2, pavector xt, pavector yt,
+		     pamatrix tmp, uint pardepth)
+{
+  avector   loc1, loc2;
+  pavector  xp, yp;
+  pcclusterbasis rb = h2->rb;
+  pcclusterbasis cb = h2->cb;
+  uint      rsons = h2->rsons;
+  uint      csons = h2->csons;
+  uint     *ytoff;
+  uint      i;
+#ifdef USE_OPENMP
+  uint      nthreads;
+#endif
+
+  if (h2->u) {
+    addeval_amatrix_avector(alpha, getcoupling_uniform(h2->u, tmp), xt, yt);
+  }
+  else if (h2->f) {
+    xp = init_sub_avector(&loc1, xt, cb->t->size, cb->k);
+    yp = init_sub_avector(&loc2, yt, rb->t->size, rb->k);
+
+    addeval_amatrix_avector(alpha, h2->f, xp, yp);
+
+    uninit_avector(yp);
+    uninit_avector(xp);
+  }
+  else if (h2->son) {
+    ytoff = allocuint(rsons);
+    ytoff[0] = rb->k;
+    for (i = 1; i < rsons; i++)
+      ytoff[i] = ytoff[i - 1] + rb->son[i - 1]->ktree;
+
+#ifdef USE_OPENMP
+    nthreads = rsons;
+    (void) nthreads;
+#pragma omp parallel for if(pardepth > 0), num_threads(nthreads)
+#endif
+    for (i = 0; i < rsons; i++) {
+      avector   loc3, loc4;
+      amatrix   tmp1;
+      pamatrix  tmp2;
+      pavector  xt1, yt1;
+      uint      xtoff, j;
+
+      tmp2 = (pardepth > 0 && rsons > 1 ? init_amatrix(&tmp1, 0, 0) : tmp);
+
+      assert(rsons == 1 || rb->sons > 0);
+      yt1 = (rb->sons > 0 ?
+	     init_sub_avector(&loc4, yt, rb->son[i]->ktree, ytoff[i]) :
+	     init_sub_avector(&loc4, yt, rb->ktree, 0));
+
+      xtoff = cb->k;
+      for (j = 0; j < csons; j++) {
+	assert(csons == 1 || cb->sons > 0);
+	xt1 = (cb->sons > 0 ?
+	       init_sub_avector(&loc3, xt, cb->son[j]->ktree, xtoff) :
+	       init_sub_avector(&loc3, xt, cb->ktree, 0));
+
+	fastaddeval_parallel(alpha, h2->son[i + j * rsons], xt1, yt1, tmp2,
+			     (pardepth > 0 ? pardepth - 1 : 0));
+
+	uninit_avector(xt1);
+
+	xtoff += (cb->sons > 0 ? cb->son[j]->ktree : cb->t->size);
+      }
+      assert(xtoff == cb->ktree);
+
+      uninit_avector(yt1);
+
+      if (tmp2 != tmp)
+	uninit_amatrix(tmp2);
+    }
+
+    freemem(ytoff);
+  }
+}
+
 void
-fastaddevaltrans_h2matrix_avector(field alpha, pch2matrix h2, pavector xt,
-				  pavector yt)
+addeval_parallel_h2matrix_avector(field alpha, pch2matrix h2, pcavector x,
+				  pavector y, uint pardepth)
+{
+  amatrix   tmp;
+  pavector  xt, yt;
+
+  xt = new_coeffs_clusterbasis_avector(h2->cb);
+  yt = new_coeffs_clusterbasis_avector(h2->rb);
+
+  clear_avector(yt);
+
+  forward_parallel_clusterbasis_avector(h2->cb, x, xt, pardepth);
+
+  init_amatrix(&tmp, 0, 0);
+  fastaddeval_parallel(alpha, h2, xt, yt, &tmp, pardepth);
+  uninit_amatrix(&tmp);
+
+  backward_parallel_clusterbasis_avector(h2->rb, yt, y, pardepth);
+
+  del_avector(yt);
+  del_avector(xt);
+}
+
+static void
+fastaddevaltrans(field alpha, pch2matrix h2, pavector xt, pavector yt,
+		 pamatrix tmp)
 {
   avector   loc1, loc2;
   pavector  xp, yp, xt1, yt1;
@@ -1299,7 +1423,8 @@ fastaddevaltrans_h2matrix_avector(field alpha, pch2matrix h2, pavector xt,
   uint      i, j;
 
   if (h2->u) {
-    addevaltrans_amatrix_avector(alpha, &h2->u->S, xt, yt);
+    addevaltrans_amatrix_avector(alpha, getcoupling_uniform(h2->u, tmp), xt,
+				 yt);
   }
   else if (h2->f) {
     xp = init_sub_avector(&loc1, xt, rb->t->size, rb->k);
@@ -1325,8 +1450,7 @@ fastaddevaltrans_h2matrix_avector(field alpha, pch2matrix h2, pavector xt,
 	       init_sub_avector(&loc1, xt, rb->son[i]->ktree, xtoff) :
 	       init_sub_avector(&loc1, xt, rb->ktree, 0));
 
-	fastaddevaltrans_h2matrix_avector(alpha, h2->son[i + j * rsons], xt1,
-					  yt1);
+	fastaddevaltrans(alpha, h2->son[i + j * rsons], xt1, yt1, tmp);
 
 	uninit_avector(xt1);
 
@@ -1342,6 +1466,19 @@ fastaddevaltrans_h2matrix_avector(field alpha, pch2matrix h2, pavector xt,
   }
 }
 
+void
+fastaddevaltrans_h2matrix_avector(field alpha, pch2matrix h2, pavector xt,
+				  pavector yt)
+{
+  amatrix   tmp;
+
+  init_amatrix(&tmp, 0, 0);
+
+  fastaddevaltrans(alpha, h2, xt, yt, &tmp);
+
+  uninit_amatrix(&tmp);
+}
+
 void
 addevaltrans_h2matrix_avector(field alpha, pch2matrix h2, pcavector x,
 			      pavector y)
@@ -1365,8 +1502,9 @@ addevaltrans_h2matrix_avector(field alpha, pch2matrix h2, pcavector x,
 
 static void
 addevalsymm_offdiag(field alpha, pch2matrix h2, pavector xt,
-		    pavector xta, pavector yt, pavector yta)
+		    pavector xta, pavector yt, pavector yta, pamatrix tmp)
 {
+  pcamatrix S;
   avector   tmp1, tmp2, tmp3, tmp4;
   pavector  xp, yp;
   pavector  xt1, xta1, yt1, yta1;
@@ -1399,8 +1537,9 @@ addevalsymm_offdiag(field alpha, pch2matrix h2, pavector xt,
     uninit_avector(xp);
   }
   else if (h2->u) {
-    addeval_amatrix_avector(alpha, &h2->u->S, xt, yt);
-    addevaltrans_amatrix_avector(alpha, &h2->u->S, xta, yta);
+    S = getcoupling_uniform(h2->u, tmp);
+    addeval_amatrix_avector(alpha, S, xt, yt);
+    addevaltrans_amatrix_avector(alpha, S, xta, yta);
   }
   else {
     assert(h2->son != 0);
@@ -1443,7 +1582,7 @@ addevalsymm_offdiag(field alpha, pch2matrix h2, pavector xt,
 	}
 
 	addevalsymm_offdiag(alpha, h2->son[i + j * rsons], xt1, xta1, yt1,
-			    yta1);
+			    yta1, tmp);
 
 	uninit_avector(xta1);
 	uninit_avector(yt1);
@@ -1459,7 +1598,7 @@ addevalsymm_offdiag(field alpha, pch2matrix h2, pavector xt,
 
 static void
 addevalsymm_diag(field alpha, pch2matrix h2, pavector xt,
-		 pavector xta, pavector yt, pavector yta)
+		 pavector xta, pavector yt, pavector yta, pamatrix tmp)
 {
   avector   tmp1, tmp2, tmp3, tmp4;
   pavector  xt1, xta1, yt1, yta1;
@@ -1540,7 +1679,8 @@ addevalsymm_diag(field alpha, pch2matrix h2, pavector xt,
 	ytoff += rb->son[i]->ktree;
       }
 
-      addevalsymm_diag(alpha, h2->son[j + j * sons], xt1, xta1, yt1, yta1);
+      addevalsymm_diag(alpha, h2->son[j + j * sons], xt1, xta1, yt1, yta1,
+		       tmp);
 
       uninit_avector(xta1);
       uninit_avector(yt1);
@@ -1553,7 +1693,7 @@ addevalsymm_diag(field alpha, pch2matrix h2, pavector xt,
 	ytoff += rb->son[i]->ktree;
 
 	addevalsymm_offdiag(alpha, h2->son[i + j * sons], xt1, xta1, yt1,
-			    yta1);
+			    yta1, tmp);
 
 	uninit_avector(xta1);
 	uninit_avector(yt1);
@@ -1571,6 +1711,7 @@ void
 addevalsymm_h2matrix_avector(field alpha, pch2matrix h2, pcavector x,
 			     pavector y)
 {
+  amatrix   tmp;
   pavector  xt, yt, xta, yta;
 
   assert(h2->rb->t == h2->cb->t);
@@ -1590,7 +1731,9 @@ addevalsymm_h2matrix_avector(field alpha, pch2matrix h2, pcavector x,
   forward_clusterbasis_avector(h2->rb, x, xta);
 
   /* Multiplication step */
-  addevalsymm_diag(alpha, h2, xt, xta, yt, yta);
+  init_amatrix(&tmp, 0, 0);
+  addevalsymm_diag(alpha, h2, xt, xta, yt, yta, &tmp);
+  uninit_amatrix(&tmp);
 
   /* Row coefficients added to result by backward transformation */
   backward_clusterbasis_avector(h2->rb, yt, y);
@@ -1607,9 +1750,9 @@ addevalsymm_h2matrix_avector(field alpha, pch2matrix h2, pcavector x,
  * Addmul H2-Matrices and Amatrix
  * ------------------------------------------------------------ */
 
-void
-fastaddmul_h2matrix_amatrix_amatrix(field alpha, bool h2trans,
-				    pch2matrix h2, pcamatrix Xt, pamatrix Yt)
+static void
+fastaddmul(field alpha, bool h2trans, pch2matrix h2, pcamatrix Xt,
+	   pamatrix Yt, pamatrix tmp)
 {
   amatrix   loc1, loc2;
   pamatrix  Xp, Yp, Xt1, Yt1;
@@ -1624,7 +1767,8 @@ fastaddmul_h2matrix_amatrix_amatrix(field alpha, bool h2trans,
   if (h2->u) {
     Xt1 = init_sub_amatrix(&loc1, (pamatrix) Xt, cb->k, 0, Xt->cols, 0);
     Yt1 = init_sub_amatrix(&loc2, Yt, rb->k, 0, Yt->cols, 0);
-    addmul_amatrix(alpha, h2trans, &h2->u->S, false, Xt1, Yt1);
+    addmul_amatrix(alpha, h2trans, getcoupling_uniform(h2->u, tmp), false,
+		   Xt1, Yt1);
     uninit_amatrix(Yt1);
     uninit_amatrix(Xt1);
   }
@@ -1653,8 +1797,7 @@ fastaddmul_h2matrix_amatrix_amatrix(field alpha, bool h2trans,
 				0) : init_sub_amatrix(&loc2, Yt, rb->ktree, 0,
 						      cols, 0));
 	k = (h2trans ? i * csons + j : i + j * rsons);
-	fastaddmul_h2matrix_amatrix_amatrix(alpha, h2trans, h2->son[k], Xt1,
-					    Yt1);
+	fastaddmul(alpha, h2trans, h2->son[k], Xt1, Yt1, tmp);
 	uninit_amatrix(Yt1);
 
 	ytoff += (rb->sons > 0 ? rb->son[i]->ktree : rb->t->size);
@@ -1668,6 +1811,19 @@ fastaddmul_h2matrix_amatrix_amatrix(field alpha, bool h2trans,
   }
 }
 
+void
+fastaddmul_h2matrix_amatrix_amatrix(field alpha, bool h2trans,
+				    pch2matrix h2, pcamatrix Xt, pamatrix Yt)
+{
+  amatrix   tmp;
+
+  init_amatrix(&tmp, 0, 0);
+
+  fastaddmul(alpha, h2trans, h2, Xt, Yt, &tmp);
+
+  uninit_amatrix(&tmp);
+}
+
 void
 addmul_h2matrix_amatrix_amatrix(field alpha, bool h2trans, pch2matrix h2,
 				bool xtrans, pcamatrix X, pamatrix Y)
@@ -1918,8 +2074,11 @@ project_amatrix_h2matrix(ph2matrix h2, pcamatrix a)
 	setentry_amatrix(h2->f, i, j,
 			 getentry_amatrix(a, row->idx[i], col->idx[j]));
   }
-  else
+  else {
+    /* The projection replaces an implicit coupling matrix */
+    clear_uniform(h2->u);
     collectdense_h2matrix(a, h2->rb, h2->cb, &h2->u->S);
+  }
 }
 
 void
@@ -1950,7 +2109,7 @@ project_hmatrix_h2matrix(ph2matrix h2, phmatrix h)
     compress_clusterbasis_amatrix(h2->cb, &h->r->B, B);
     B->rows = h2->cb->k;
 
-    clear_amatrix(&h2->u->S);
+    clear_uniform(h2->u);
     addmul_amatrix(1.0, false, A, true, B, &h2->u->S);
 
     uninit_amatrix(B);
@@ -2018,7 +2177,8 @@ write_cdf(pch2matrix G,
 {
   size_t    start, count;
   ptrdiff_t stride;
-  pcamatrix f;
+  pcamatrix f, S;
+  amatrix   tmp;
   pcuniform u;
   uint      rsons, csons;
   uint      rows, cols;
@@ -2080,11 +2240,13 @@ write_cdf(pch2matrix G,
     start = *coeffidx;
     count = kr;
     assert(start + kr * kc <= coeffs);
+    S = getcoupling_uniform(u, init_amatrix(&tmp, 0, 0));
     for (j = 0; j < kc; j++) {
       nc_put_vars(nc_file, nc_coeff, &start, &count, &stride,
-		  u->S.a + j * u->S.ld);
+		  S->a + j * S->ld);
       start += kr;
     }
+    uninit_amatrix(&tmp);
     (*coeffidx) = start;
 
     /* Increase submatrix counter */
@@ -2314,6 +2476,7 @@ read_cdf_part(int nc_file, pclusterbasis rb, pclusterbasis cb,
     /* Create uniform matrix */
     G = new_uniform_h2matrix(rb, cb);
     u = G->u;
+    assert(u->coupling == NULL);
 
     kr = u->rb->k;
     kc = u->cb->k;
@@ -545,6 +545,22 @@ fastaddeval_h2matrix_avector(field alpha, pch2matrix h2, pavector xt,
 HEADER_PREFIX void
 addeval_h2matrix_avector(field alpha, pch2matrix h2, pcavector x, pavector y);
 
+/** @brief Parallel matrix-vector multiplication
+ *  @f$y \gets y + \alpha A x@f$.
+ *
+ *  Same as @ref addeval_h2matrix_avector, but the forward and backward
+ *  transformations use the parallel versions and the row sons of each
+ *  block are handled by separate threads up to the given depth.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param h2 Matrix @f$A@f$.
+ *  @param x Source vector @f$x@f$.
+ *  @param y Target vector @f$y@f$.
+ *  @param pardepth Parallelization depth, e.g., <tt>max_pardepth</tt>. */
+HEADER_PREFIX void
+addeval_parallel_h2matrix_avector(field alpha, pch2matrix h2, pcavector x,
+    pavector y, uint pardepth);
+
 /** @brief Interaction phase of the adjoint matrix-vector multiplication.
  *
  *  Nearfield blocks are added directly
@@ -9,6 +9,54 @@
 #include "laplacebem2d.h"
 #include "laplacebem3d.h"
 
+/* Stop if an update would have to change implicit coupling matrices */
+static void
+check_explicit(bool ok, const char *name)
+{
+  if (!ok) {
+    (void) fprintf(stderr,
+		   "%s: implicit coupling matrices have to be made explicit "
+		   "by setexplicit_uniform first.\n", name);
+    abort();
+  }
+}
+
+/* Check the blocks using the row basis rb or one of its descendants */
+static bool
+explicit_row_clusterbasis(pcclusterbasis rb)
+{
+  puniform  u;
+  uint      i;
+
+  for (u = rb->rlist; u != NULL; u = u->rnext)
+    if (u->coupling != NULL)
+      return false;
+
+  for (i = 0; i < rb->sons; i++)
+    if (!explicit_row_clusterbasis(rb->son[i]))
+      return false;
+
+  return true;
+}
+
+/* Check the blocks using the column basis cb or one of its descendants */
+static bool
+explicit_col_clusterbasis(pcclusterbasis cb)
+{
+  puniform  u;
+  uint      i;
+
+  for (u = cb->clist; u != NULL; u = u->cnext)
+    if (u->coupling != NULL)
+      return false;
+
+  for (i = 0; i < cb->sons; i++)
+    if (!explicit_col_clusterbasis(cb->son[i]))
+      return false;
+
+  return true;
+}
+
 real
 norm2_rkupdate_uniform(puniform u, uint k)
 {
@@ -19,6 +67,8 @@ norm2_rkupdate_uniform(puniform u, uint k)
   pamatrix  uz, zuz, Z1, Z2;
   real      norm = 0.0;
 
+  check_explicit(u->coupling == NULL, "norm2_rkupdate_uniform");
+
   /* zuz = rb->Z * u->S * cb->Z */
   if (cb->Z) {
     uz = init_zero_amatrix(&tmp1, u->S.rows, cb->Z->rows);
@@ -67,6 +117,8 @@ normfrob_rkupdate_uniform(puniform u, uint k)
   pamatrix  uz, zuz, Z1, Z2;
   real      norm = 0.0;
 
+  check_explicit(u->coupling == NULL, "normfrob_rkupdate_uniform");
+
   /* zuz = rb->Z * u->S * cb->Z */
   if (cb->Z) {
     uz = init_zero_amatrix(&tmp1, u->S.rows, cb->Z->rows);
@@ -989,6 +1041,9 @@ rkupdate_h2matrix(prkmatrix R, ph2matrix Gh2, pclusteroperator rwf,
   assert(rwf->son);
   assert(cwf->son);
 
+  check_explicit(explicit_row_clusterbasis(rb)
+		 && explicit_col_clusterbasis(cb), "rkupdate_h2matrix");
+
   zeta_age = (tm ? tm->zeta_age : 1.0);
 
   rkupdate_adduniform_h2matrix(Gh2);
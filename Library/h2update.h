@@ -18,6 +18,11 @@
  *  for @f$\mathcal{H}^2@f$-matrices.
  *  The module also provides functions to initialise the auxilliary structures
  *  required by the low rank update and the arithmetic functions in @ref h2arith.
+ *
+ *  The updates change the cluster bases and therefore all coupling
+ *  matrices using them, so these have to be stored explicitly. Blocks
+ *  set up by @ref setimplicit_uniform have to be converted by
+ *  @ref setexplicit_uniform first, otherwise the functions abort.
  *  @{ */
 
 #include "rkmatrix.h"
@@ -6144,6 +6144,120 @@ lrdecomp_hmatrix(phmatrix a, pctruncmode tm, real eps)
   }
 }
 
+static void
+lrdecomp_dd(phmatrix a, pctruncmode tm, real eps)
+{
+  uint      sons, domains;
+  uint      i, j, k;
+  uint      res;
+
+  if (a->f) {
+    res = lrdecomp_amatrix(a->f);
+    assert(res == 0);
+    (void) res;
+    return;
+  }
+
+  assert(a->son != 0);
+  assert(a->rsons == a->csons);
+
+  sons = a->rsons;
+
+  /* Leading domain clusters are decoupled from each other */
+  for (domains = 0;
+       domains < sons && a->son[domains + domains * sons]->rc->type == 1;
+       domains++);
+
+  /* Factorize the domain blocks and their couplings with the
+   * interfaces independently */
+  for (k = 0; k < domains; k++) {
+#ifdef USE_OPENMP
+#pragma omp task firstprivate(k) private(i,j)
+#endif
+    {
+      lrdecomp_dd(a->son[k + k * sons], tm, eps);
+
+      for (j = domains; j < sons; j++)
+	lowersolve_hmatrix(true, false, a->son[k + k * sons], tm, eps, false,
+			   a->son[k + j * sons]);
+
+      for (i = domains; i < sons; i++)
+	uppersolve_hmatrix(false, true, a->son[k + k * sons], tm, eps, true,
+			   a->son[i + k * sons]);
+    }
+  }
+#ifdef USE_OPENMP
+#pragma omp taskwait
+#endif
+
+  /* Schur complements for the interfaces, one task per target block */
+  if (domains > 0) {
+    for (j = domains; j < sons; j++)
+      for (i = domains; i < sons; i++) {
+#ifdef USE_OPENMP
+#pragma omp task firstprivate(i,j) private(k)
+#endif
+	for (k = 0; k < domains; k++)
+	  addmul_hmatrix(-1.0, false, a->son[i + k * sons], false,
+			 a->son[k + j * sons], tm, eps, a->son[i + j * sons]);
+      }
+#ifdef USE_OPENMP
+#pragma omp taskwait
+#endif
+  }
+
+  /* Factorize the interfaces, the domain clusters all precede them,
+   * so the remaining blocks are not structurally zero */
+  for (k = domains; k < sons; k++) {
+    assert(a->son[k + k * sons]->rc->type != 1);
+
+    lrdecomp_dd(a->son[k + k * sons], tm, eps);
+
+    for (j = k + 1; j < sons; j++) {
+#ifdef USE_OPENMP
+#pragma omp task firstprivate(j)
+#endif
+      lowersolve_hmatrix(true, false, a->son[k + k * sons], tm, eps, false,
+			 a->son[k + j * sons]);
+    }
+
+    for (i = k + 1; i < sons; i++) {
+#ifdef USE_OPENMP
+#pragma omp task firstprivate(i)
+#endif
+      uppersolve_hmatrix(false, true, a->son[k + k * sons], tm, eps, true,
+			 a->son[i + k * sons]);
+    }
+#ifdef USE_OPENMP
+#pragma omp taskwait
+#endif
+
+    for (j = k + 1; j < sons; j++)
+      for (i = k + 1; i < sons; i++) {
+#ifdef USE_OPENMP
+#pragma omp task firstprivate(i,j)
+#endif
+	addmul_hmatrix(-1.0, false, a->son[i + k * sons], false,
+		       a->son[k + j * sons], tm, eps, a->son[i + j * sons]);
+      }
+#ifdef USE_OPENMP
+#pragma omp taskwait
+#endif
+  }
+}
+
+void
+lrdecomp_dd_hmatrix(phmatrix a, pctruncmode tm, real eps)
+{
+  assert(a->rc == a->cc);
+
+#ifdef USE_OPENMP
+#pragma omp parallel
+#pragma omp single
+#endif
+  lrdecomp_dd(a, tm, eps);
+}
+
 void
 lrsolve_n_hmatrix_avector(pchmatrix a, pavector x)
 {
@@ -598,6 +598,27 @@ triangularmul_hmatrix(bool alower, bool aunit, bool atrans, pchmatrix a,
 HEADER_PREFIX void
 lrdecomp_hmatrix(phmatrix a, pctruncmode tm, real eps);
 
+/** @brief Compute the LR decomposition of a hierarchical matrix
+ *  with a domain decomposition cluster tree.
+ *
+ *  Like @ref lrdecomp_hmatrix, but uses the <tt>type</tt> of the
+ *  clusters constructed by, e.g., @ref build_adaptive_dd_cluster:
+ *  leading domain sons of a cluster are factorized in parallel, blocks
+ *  coupling two different domain clusters are assumed to be zero and
+ *  skipped, and the Schur complements of the interface clusters are
+ *  formed afterwards.
+ *  The result can be used with @ref lrsolve_hmatrix_avector.
+ *
+ *  @param a Source matrix @f$A@f$, will be overwritten
+ *     by @f$L@f$ and @f$R@f$. Blocks coupling different domain clusters
+ *     have to be zero, e.g., if @f$A@f$ has been constructed by
+ *     @ref copy_sparsematrix_hmatrix from the sparse matrix used to
+ *     build the cluster tree.
+ *  @param tm Truncation mode.
+ *  @param eps Truncation accuracy. */
+HEADER_PREFIX void
+lrdecomp_dd_hmatrix(phmatrix a, pctruncmode tm, real eps);
+
 /** @brief Solve the linear systems @f$A x = b@f$
  *  using the LR factorization provided by @ref lrdecomp_hmatrix.
  *
@@ -633,6 +633,109 @@ addeval_hmatrix_avector(field alpha, pchmatrix hm, pcavector x, pavector y)
   uninit_avector(xp);
 }
 
+/* Row-parallel version of fastaddeval_hmatrix_avector: the row sons of
+ * a block write to disjoint parts of y, so each of them can be handled
+ * by its own thread together with all of its column sons. */
+static void
+fastaddeval_parallel(field alpha, pchmatrix hm, pcavector x, pavector y,
+		     uint pardepth)
+{
+  uint     *yoff;
+  uint      rsons, csons;
+  uint      i;
+#ifdef USE_OPENMP
+  uint      nthreads;
+#endif
+
+  if (hm->r) {
+    addeval_rkmatrix_avector(alpha, hm->r, x, y);
+  }
+  else if (hm->f) {
+    mvm_amatrix_avector(alpha, false, hm->f, x, y);
+  }
+  else {
+    rsons = hm->rsons;
+    csons = hm->csons;
+
+    yoff = allocuint(rsons);
+    yoff[0] = 0;
+    for (i = 1; i < rsons; i++)
+      yoff[i] = yoff[i - 1] + hm->son[i - 1]->rc->size;
+
+#ifdef USE_OPENMP
+    nthreads = rsons;
+    (void) nthreads;
+#pragma omp parallel for if(pardepth > 0), num_threads(nthreads)
+#endif
+    for (i = 0; i < rsons; i++) {
+      pavector  x1, y1;
+      avector   xtmp, ytmp;
+      uint      xoff, j;
+
+      y1 = init_sub_avector(&ytmp, y, hm->son[i]->rc->size, yoff[i]);
+
+      xoff = 0;
+      for (j = 0; j < csons; j++) {
+	x1 = init_sub_avector(&xtmp, (pavector) x,
+			      hm->son[j * rsons]->cc->size, xoff);
+
+	fastaddeval_parallel(alpha, hm->son[i + j * rsons], x1, y1,
+			     (pardepth > 0 ? pardepth - 1 : 0));
+
+	uninit_avector(x1);
+
+	xoff += hm->son[j * rsons]->cc->size;
+      }
+      assert(xoff == hm->cc->size);
+
+      uninit_avector(y1);
+    }
+
+    freemem(yoff);
+  }
+}
+
+void
+addeval_parallel_hmatrix_avector(field alpha, pchmatrix hm, pcavector x,
+				 pavector y, uint pardepth)
+{
+  pavector  xp, yp;
+  avector   xtmp, ytmp;
+  uint      i, ip;
+
+  assert(x->dim == hm->cc->size);
+  assert(y->dim == hm->rc->size);
+
+  /* Permutation of x */
+  xp = init_avector(&xtmp, x->dim);
+  for (i = 0; i < xp->dim; i++) {
+    ip = hm->cc->idx[i];
+    assert(ip < x->dim);
+    xp->v[i] = x->v[ip];
+  }
+
+  /* Permutation of y */
+  yp = init_avector(&ytmp, y->dim);
+  for (i = 0; i < yp->dim; i++) {
+    ip = hm->rc->idx[i];
+    assert(ip < y->dim);
+    yp->v[i] = y->v[ip];
+  }
+
+  /* Matrix-vector multiplication */
+  fastaddeval_parallel(alpha, hm, xp, yp, pardepth);
+
+  /* Reverse permutation of y */
+  for (i = 0; i < yp->dim; i++) {
+    ip = hm->rc->idx[i];
+    assert(ip < y->dim);
+    y->v[ip] = yp->v[i];
+  }
+
+  uninit_avector(yp);
+  uninit_avector(xp);
+}
+
 void
 fastaddevaltrans_hmatrix_avector(field alpha, pchmatrix hm, pcavector x,
 				 pavector y)
@@ -2470,51 +2573,98 @@ draw_cairo_hmatrix(cairo_t * cr, pchmatrix hm, bool storage, uint levels)
 }
 #endif
 
-void
-copy_sparsematrix_hmatrix(psparsematrix sp, phmatrix hm)
+static    uint
+count_leaves(pchmatrix hm)
 {
+  uint      i, n;
 
-  uint      i, j, k, l, m, rsize, csize;
-  uint     *ridx, *cidx, *row, *col;
-  pfield    coeff;
-  pamatrix  f;
+  if (hm->son == 0)
+    return 1;
 
-  if (hm->son) {
-    for (j = 0; j < hm->csons; j++) {
-      for (i = 0; i < hm->rsons; i++) {
-	copy_sparsematrix_hmatrix(sp, hm->son[i + j * (hm->rsons)]);
-      }
-    }
-  }
-  else if (hm->r) {		/*hm->r is defined, but hm->r->A = hm->r->B = NulL => all entries are 0 */
+  n = 0;
+  for (i = 0; i < hm->rsons * hm->csons; i++)
+    n += count_leaves(hm->son[i]);
 
-  }
-  else if (hm->f) {
-    rsize = hm->rc->size;
-    csize = hm->cc->size;
-    ridx = hm->rc->idx;
-    cidx = hm->cc->idx;
-    row = sp->row;
-    col = sp->col;
-    coeff = sp->coeff;
-    f = hm->f;
+  return n;
+}
 
-    for (j = 0; j < f->cols; j++)
-      for (i = 0; i < f->rows; i++)
-	f->a[i + j * f->rows] = 0.0;
+static void
+collect_leaves(phmatrix hm, phmatrix * leaves, uint * n)
+{
+  uint      i;
 
-    for (k = 0; k < rsize; k++) {
-      i = ridx[k];
-      for (m = row[i]; m < row[i + 1]; m++) {
-	for (l = 0; l < csize; l++) {
+  if (hm->son == 0) {
+    leaves[*n] = hm;
+    (*n)++;
+    return;
+  }
 
-	  if (col[m] == cidx[l]) {
+  for (i = 0; i < hm->rsons * hm->csons; i++)
+    collect_leaves(hm->son[i], leaves, n);
+}
 
-	    setentry_amatrix(hm->f, k, l, coeff[m]);
+void
+copy_sparsematrix_hmatrix(psparsematrix sp, phmatrix hm)
+{
+  phmatrix *leaves;
+  uint     *cpos;
+  const uint *row = sp->row;
+  const uint *col = sp->col;
+  pcfield   coeff = sp->coeff;
+  uint      csize = hm->cc->size;
+  uint      n, nleaves;
+
+  /* Position of each column index in the permutation of the root
+   * column cluster, csize for indices not contained in it */
+  cpos = allocuint(sp->cols);
+  for (n = 0; n < sp->cols; n++)
+    cpos[n] = csize;
+  for (n = 0; n < csize; n++)
+    cpos[hm->cc->idx[n]] = n;
+
+  nleaves = count_leaves(hm);
+  leaves = (phmatrix *) allocmem(sizeof(phmatrix) * nleaves);
+  n = 0;
+  collect_leaves(hm, leaves, &n);
+  assert(n == nleaves);
+
+  /* The index sets of the leaf clusters are contiguous parts of the
+   * permutation of the root, so every near-field leaf can pick its
+   * entries directly from its rows */
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+  for (n = 0; n < nleaves; n++) {
+    phmatrix  hl = leaves[n];
+    pamatrix  f;
+    const uint *ridx;
+    uint      coff, i, j, k, m, p;
+
+    if (hl->r) {
+      /* Admissible blocks are zero */
+      setrank_rkmatrix(hl->r, 0);
+    }
+    else if (hl->f) {
+      f = hl->f;
+      ridx = hl->rc->idx;
+      coff = hl->cc->idx - hm->cc->idx;
+      assert(coff + hl->cc->size <= csize);
+
+      clear_amatrix(f);
+
+      for (k = 0; k < f->rows; k++) {
+	i = ridx[k];
+	for (m = row[i]; m < row[i + 1]; m++) {
+	  p = cpos[col[m]];
+	  if (coff <= p && p < coff + f->cols) {
+	    j = p - coff;
+	    f->a[k + j * f->ld] = coeff[m];
 	  }
 	}
       }
     }
-
   }
+
+  freemem(leaves);
+  freemem(cpos);
 }
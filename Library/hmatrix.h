@@ -418,6 +418,23 @@ fastaddeval_hmatrix_avector(field alpha, pchmatrix hm, pcavector xp,
 HEADER_PREFIX void
 addeval_hmatrix_avector(field alpha, pchmatrix hm, pcavector x, pavector y);
 
+/** @brief Parallel matrix-vector multiplication
+ *  @f$y \gets y + \alpha A x@f$.
+ *
+ *  Same as @ref addeval_hmatrix_avector, but the row sons of each block
+ *  are handled by separate threads up to the given depth of the block
+ *  tree. Since row sons write to disjoint parts of @f$y@f$, no
+ *  synchronization is required.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param hm Matrix @f$A@f$.
+ *  @param x Source vector @f$x@f$.
+ *  @param y Target vector @f$y@f$.
+ *  @param pardepth Parallelization depth, e.g., <tt>max_pardepth</tt>. */
+HEADER_PREFIX void
+addeval_parallel_hmatrix_avector(field alpha, pchmatrix hm, pcavector x,
+    pavector y, uint pardepth);
+
 /** @brief Adjoint matrix-vector multiplication
  *  @f$y \gets y + \alpha A^* x@f$.
  *
@@ -669,8 +686,12 @@ draw_cairo_hmatrix(cairo_t *cr, pchmatrix hm, bool storage, uint levels);
  * 
  * @remark This function is can only be used for a @ref sparsematrix descending of
  * a discretization with FEM and a hierarchical matrix with admissible blocks,
- * which only content zero entries (i.e. no storage is allocated for the rank k 
- * matrices).
+ * which only content zero entries. The ranks of these blocks are set to zero
+ * without looking at the sparse matrix.
+ *
+ * The leaves are filled in parallel, each using the rows of its row cluster
+ * and the inverse of the column permutation, so the cost is proportional to
+ * the number of non-zero entries times the number of leaves per block row.
  * 
  * @param sp source matrix.
  * @param hm target matrix.
@@ -6,6 +6,7 @@
 
 #include "krylov.h"
 #include "factorizations.h"
+#include "eigensolvers.h"
 
 /* ------------------------------------------------------------
  * Vector iteration for norm2 and norm2diff estimation
@@ -155,6 +156,403 @@ norm2diff_id_pre_matrix(mvm_t mvmA, void *A, prcd_t solveB,
   return REAL_SQRT(norm);
 }
 
+/* ------------------------------------------------------------
+ * Randomized block estimators for norm2 and norm2diff
+ * ------------------------------------------------------------ */
+
+typedef struct {
+  mvmblock_t mvmA;
+  void     *A;
+  mvmblock_t mvmB;
+  void     *B;
+  prcd_t    solveB;
+  prcd_t    solvetransB;
+} randop;
+
+static void
+eval_randop(const randop * op, bool trans, pcamatrix X, pamatrix Y)
+{
+  amatrix   tmp;
+  pamatrix  T;
+  avector   ctmp;
+  pavector  y;
+  uint      j;
+
+  if (op->solveB == 0) {
+    /* Y = (A - B) X or Y = (A - B)^* X */
+    clear_amatrix(Y);
+    op->mvmA(1.0, trans, op->A, X, Y);
+    if (op->mvmB)
+      op->mvmB(-1.0, trans, op->B, X, Y);
+  }
+  else if (!trans) {
+    /* Y = X - B^{-1} A X */
+    clear_amatrix(Y);
+    op->mvmA(1.0, false, op->A, X, Y);
+    for (j = 0; j < Y->cols; j++) {
+      y = init_column_avector(&ctmp, Y, j);
+      op->solveB(op->B, y);
+      uninit_avector(y);
+    }
+    scale_amatrix(-1.0, Y);
+    add_amatrix(1.0, false, X, Y);
+  }
+  else {
+    /* Y = X - A^* B^{-*} X */
+    T = init_amatrix(&tmp, X->rows, X->cols);
+    copy_amatrix(false, X, T);
+    for (j = 0; j < T->cols; j++) {
+      y = init_column_avector(&ctmp, T, j);
+      op->solvetransB(op->B, y);
+      uninit_avector(y);
+    }
+    copy_amatrix(false, X, Y);
+    op->mvmA(-1.0, true, op->A, T, Y);
+    uninit_amatrix(T);
+  }
+}
+
+static void
+gaussian_amatrix(pamatrix X)
+{
+  real      u1, u2;
+  uint      i, j;
+
+  /* Box-Muller transformation of uniformly distributed numbers */
+  for (j = 0; j < X->cols; j++)
+    for (i = 0; i < X->rows; i++) {
+      do {
+	u1 = 0.5 * (REAL_RAND() + 1.0);
+      } while (u1 <= 0.0);
+      u2 = 0.5 * (REAL_RAND() + 1.0);
+
+      X->a[i + j * X->ld] =
+	REAL_SQRT(-2.0 * REAL_LOG(u1)) * REAL_COS(2.0 * M_PI * u2);
+    }
+}
+
+static    real
+orthonormalize_block(pamatrix Y, pamatrix Q)
+{
+  avector   tmp1;
+  amatrix   tmp2;
+  realavector tmp3;
+  pavector  tau;
+  pamatrix  R;
+  prealavector sigma;
+  real      norm;
+  uint      k = Y->cols;
+  uint      i, j;
+
+  assert(Y->rows >= k);
+
+  tau = init_avector(&tmp1, k);
+  qrdecomp_amatrix(Y, tau);
+
+  /* The singular values of A X coincide with those of R */
+  R = init_amatrix(&tmp2, k, k);
+  clear_amatrix(R);
+  for (j = 0; j < k; j++)
+    for (i = 0; i <= j; i++)
+      R->a[i + j * R->ld] = Y->a[i + j * Y->ld];
+
+  sigma = init_realavector(&tmp3, k);
+  svd_amatrix(R, sigma, 0, 0);
+  norm = 0.0;
+  for (i = 0; i < k; i++)
+    norm = REAL_MAX(norm, sigma->v[i]);
+
+  if (Q)
+    qrexpand_amatrix(Y, tau, Q);
+
+  uninit_realavector(sigma);
+  uninit_amatrix(R);
+  uninit_avector(tau);
+
+  return norm;
+}
+
+static    real
+norm2_randomized(const randop * op, uint rows, uint cols, uint k, uint q,
+		 preal bound)
+{
+  amatrix   tmp1, tmp2, tmp3, tmp4;
+  avector   ctmp;
+  pamatrix  X, P, Y, Q;
+  pavector  col;
+  real      norm, cnorm, ynorm, ymax;
+  uint      i, j;
+
+  k = UINT_MIN(k, UINT_MIN(rows, cols));
+  if (k == 0) {
+    if (bound)
+      *bound = 0.0;
+    return 0.0;
+  }
+
+  X = init_amatrix(&tmp1, cols, k);
+  P = init_amatrix(&tmp2, cols, k);
+  Y = init_amatrix(&tmp3, rows, k);
+  Q = init_amatrix(&tmp4, rows, k);
+
+  gaussian_amatrix(X);
+  eval_randop(op, false, X, Y);
+
+  /* Lower bound and probabilistic upper bound from the Gaussian vectors */
+  norm = 0.0;
+  ymax = 0.0;
+  for (j = 0; j < k; j++) {
+    col = init_column_avector(&ctmp, X, j);
+    cnorm = norm2_avector(col);
+    uninit_avector(col);
+
+    col = init_column_avector(&ctmp, Y, j);
+    ynorm = norm2_avector(col);
+    uninit_avector(col);
+
+    ymax = REAL_MAX(ymax, ynorm);
+    if (cnorm > 0.0)
+      norm = REAL_MAX(norm, ynorm / cnorm);
+  }
+  if (bound)
+    *bound = 10.0 * REAL_SQRT(2.0 / M_PI) * ymax;
+
+  /* Subspace iteration for A^* A, Y = A P with orthonormal P for i > 0 */
+  for (i = 0; i < q && norm > 0.0; i++) {
+    ynorm = orthonormalize_block(Y, Q);
+    if (i > 0)
+      norm = ynorm;
+    eval_randop(op, true, Q, X);
+    orthonormalize_block(X, P);
+    eval_randop(op, false, P, Y);
+  }
+  if (i > 0)
+    norm = orthonormalize_block(Y, 0);
+
+  uninit_amatrix(Q);
+  uninit_amatrix(Y);
+  uninit_amatrix(P);
+  uninit_amatrix(X);
+
+  return norm;
+}
+
+real
+norm2_randomized_matrix(mvmblock_t mvm, void *A, uint rows, uint cols,
+			uint k, uint q, preal bound)
+{
+  randop    op;
+
+  op.mvmA = mvm;
+  op.A = A;
+  op.mvmB = 0;
+  op.B = 0;
+  op.solveB = 0;
+  op.solvetransB = 0;
+
+  return norm2_randomized(&op, rows, cols, k, q, bound);
+}
+
+real
+norm2diff_randomized_matrix(mvmblock_t mvmA, void *A, mvmblock_t mvmB,
+			    void *B, uint rows, uint cols, uint k, uint q,
+			    preal bound)
+{
+  randop    op;
+
+  op.mvmA = mvmA;
+  op.A = A;
+  op.mvmB = mvmB;
+  op.B = B;
+  op.solveB = 0;
+  op.solvetransB = 0;
+
+  return norm2_randomized(&op, rows, cols, k, q, bound);
+}
+
+real
+norm2diff_id_pre_randomized_matrix(mvmblock_t mvmA, void *A, prcd_t solveB,
+				   prcd_t solvetransB, void *B, uint rows,
+				   uint cols, uint k, uint q, preal bound)
+{
+  randop    op;
+
+  assert(rows == cols);
+
+  op.mvmA = mvmA;
+  op.A = A;
+  op.mvmB = 0;
+  op.B = B;
+  op.solveB = solveB;
+  op.solvetransB = solvetransB;
+
+  return norm2_randomized(&op, rows, cols, k, q, bound);
+}
+
+/* ------------------------------------------------------------
+ * Estimation of the 1-norm
+ * ------------------------------------------------------------ */
+
+typedef struct {
+  mvm_t     mvm;
+  prcd_t    eval;
+  prcd_t    evaltrans;
+  void     *A;
+} norm1op;
+
+static void
+eval_norm1op(const norm1op * op, bool trans, pcavector x, pavector y)
+{
+  if (op->mvm) {
+    clear_avector(y);
+    op->mvm(1.0, trans, op->A, x, y);
+  }
+  else {
+    copy_avector(x, y);
+    if (trans)
+      op->evaltrans(op->A, y);
+    else
+      op->eval(op->A, y);
+  }
+}
+
+static    real
+norm1_avector(pcavector x)
+{
+  real      sum;
+  uint      i;
+
+  sum = 0.0;
+  for (i = 0; i < x->dim; i++)
+    sum += ABS(x->v[i]);
+
+  return sum;
+}
+
+static    uint
+maxabs_avector(pcavector x)
+{
+  real      val, maxval;
+  uint      i, j;
+
+  j = 0;
+  maxval = -1.0;
+  for (i = 0; i < x->dim; i++) {
+    val = ABS(x->v[i]);
+    if (val > maxval) {
+      maxval = val;
+      j = i;
+    }
+  }
+
+  return j;
+}
+
+static    real
+norm1_estimate(const norm1op * op, uint rows, uint cols)
+{
+  avector   tmp1, tmp2, tmp3, tmp4;
+  pavector  x, y, xi, z;
+  real      est, estold, alt;
+  uint      i, j, jlast, iter;
+#ifndef USE_COMPLEX
+  bool      repeated;
+#endif
+
+  if (rows == 0 || cols == 0)
+    return 0.0;
+
+  x = init_avector(&tmp1, cols);
+  y = init_avector(&tmp2, rows);
+  xi = init_avector(&tmp3, rows);
+  z = init_avector(&tmp4, cols);
+
+  /* Start with x = (1/n, ..., 1/n) */
+  fill_avector(x, 1.0 / cols);
+  eval_norm1op(op, false, x, y);
+  est = norm1_avector(y);
+
+  if (cols > 1) {
+    for (i = 0; i < rows; i++)
+      xi->v[i] = SIGN1(y->v[i]);
+    eval_norm1op(op, true, xi, z);
+    j = maxabs_avector(z);
+
+    /* Gradient steps along unit vectors */
+    for (iter = 1; iter < 5; iter++) {
+      clear_avector(x);
+      x->v[j] = 1.0;
+      eval_norm1op(op, false, x, y);
+
+      estold = est;
+      est = norm1_avector(y);
+
+#ifndef USE_COMPLEX
+      /* Stop if the sign vector is repeated */
+      repeated = true;
+      for (i = 0; i < rows && repeated; i++)
+	repeated = (SIGN1(y->v[i]) == xi->v[i]);
+      if (repeated)
+	break;
+#endif
+
+      if (est <= estold) {
+	est = estold;
+	break;
+      }
+
+      for (i = 0; i < rows; i++)
+	xi->v[i] = SIGN1(y->v[i]);
+      eval_norm1op(op, true, xi, z);
+
+      jlast = j;
+      j = maxabs_avector(z);
+      if (ABS(z->v[jlast]) == ABS(z->v[j]))
+	break;
+    }
+
+    /* Higham's additional test with an alternating vector */
+    for (i = 0; i < cols; i++)
+      x->v[i] = (i % 2 ? -1.0 : 1.0) * (1.0 + (real) i / (cols - 1));
+    eval_norm1op(op, false, x, y);
+    alt = 2.0 * norm1_avector(y) / (3.0 * cols);
+    est = REAL_MAX(est, alt);
+  }
+
+  uninit_avector(z);
+  uninit_avector(xi);
+  uninit_avector(y);
+  uninit_avector(x);
+
+  return est;
+}
+
+real
+norm1_matrix(mvm_t mvm, void *A, uint rows, uint cols)
+{
+  norm1op   op;
+
+  op.mvm = mvm;
+  op.eval = 0;
+  op.evaltrans = 0;
+  op.A = A;
+
+  return norm1_estimate(&op, rows, cols);
+}
+
+real
+norm1_pre_matrix(prcd_t evalB, prcd_t evaltransB, void *B, uint n)
+{
+  norm1op   op;
+
+  op.mvm = 0;
+  op.eval = evalB;
+  op.evaltrans = evaltransB;
+  op.A = B;
+
+  return norm1_estimate(&op, n, n);
+}
+
 /* ------------------------------------------------------------
  * Standard conjugate gradient method
  * ------------------------------------------------------------ */
@@ -175,6 +573,7 @@ void
 step_cg(addeval_t addeval, void *matrix, pcavector b, pavector x,
 	pavector r, pavector p, pavector a)
 {
+  field     d[2];
   field     gamma, lambda, mu;
 
   (void) b;
@@ -182,16 +581,16 @@ step_cg(addeval_t addeval, void *matrix, pcavector b, pavector x,
   clear_avector(a);		/* a = A p */
   addeval(1.0, matrix, p, a);
 
-  gamma = dotprod_avector(p, a);	/* lambda = <p, r> / <p, a> */
-  lambda = dotprod_avector(p, r) / gamma;
+  dotprod2_avector(p, a, r, d);	/* lambda = <p, r> / <p, a> */
+  gamma = d[0];
+  lambda = d[1] / gamma;
 
   add_avector(lambda, p, x);	/* x = x + lambda p */
 
-  add_avector(-lambda, a, r);	/* r = r - lambda a */
+  /* r = r - lambda a, mu = <a, r> / <p, a> */
+  mu = adddotprod_avector(-lambda, a, r, a) / gamma;
 
-  mu = dotprod_avector(a, r) / gamma; /* p = r - mu p */
-  scale_avector(-mu, p);
-  add_avector(1.0, r, p);
+  scaleadd_avector(1.0, r, -mu, p);	/* p = r - mu p */
 }
 
 real
@@ -237,6 +636,7 @@ step_pcg(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata, pcavector b,
 	 pavector p,		/* Search direction */
 	 pavector a)
 {
+  field     d[2];
   field     gamma, lambda, mu;
 
   (void) b;
@@ -244,8 +644,9 @@ step_pcg(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata, pcavector b,
   clear_avector(a);		/* a = A p */
   addeval(1.0, matrix, p, a);
 
-  gamma = dotprod_avector(p, a);	/* lambda = <p, r> / <p, a> */
-  lambda = dotprod_avector(p, r) / gamma;
+  dotprod2_avector(p, a, r, d);	/* lambda = <p, r> / <p, a> */
+  gamma = d[0];
+  lambda = d[1] / gamma;
 
   add_avector(lambda, p, x);	/* x = x + lambda p */
 
@@ -256,9 +657,145 @@ step_pcg(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata, pcavector b,
     prcd(pdata, q);
 
   mu = dotprod_avector(a, q) / gamma; /* mu = <a, q> / <p, a> */
-  
-  scale_avector(-mu, p);	/* p = r - mu p */
-  add_avector(1.0, q, p);
+
+  scaleadd_avector(1.0, q, -mu, p);	/* p = q - mu p */
+}
+
+/* ------------------------------------------------------------
+ * Pipelined conjugate gradient method
+ * ------------------------------------------------------------ */
+
+/* Fused reduction: <u, r>, <u, w> and |r|^2 in one pass */
+static void
+fused_dotprod_pipecg(pcavector r, pcavector u, pcavector w, pfield ur,
+		     pfield uw, preal rr)
+{
+  pcfield   rv = r->v;
+  pcfield   uv = u->v;
+  pcfield   wv = w->v;
+  field     sum_ur, sum_uw;
+  real      sum_rr;
+  uint      i;
+
+  sum_ur = 0.0;
+  sum_uw = 0.0;
+  sum_rr = 0.0;
+#ifdef USE_OPENMP
+#pragma omp parallel for simd schedule(static) reduction(+:sum_ur,sum_uw,sum_rr) if(r->dim >= AVECTOR_PARALLEL_DIM)
+#endif
+  for (i = 0; i < r->dim; i++) {
+    sum_ur += CONJ(uv[i]) * rv[i];
+    sum_uw += CONJ(uv[i]) * wv[i];
+    sum_rr += ABSSQR(rv[i]);
+  }
+
+  *ur = sum_ur;
+  *uw = sum_uw;
+  *rr = sum_rr;
+}
+
+void
+init_pipecg(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata,
+	    pcavector b, pavector x, pavector r, pavector u, pavector w,
+	    pavector p, pavector s, pavector q, pavector z, pavector m,
+	    pavector n, pfield gamma, pfield alpha)
+{
+  (void) m;
+  (void) n;
+
+  copy_avector(b, r);		/* r = b - A x */
+  addeval(-1.0, matrix, x, r);
+
+  copy_avector(r, u);		/* u = N r */
+  if (prcd)
+    prcd(pdata, u);
+
+  clear_avector(w);		/* w = A u */
+  addeval(1.0, matrix, u, w);
+
+  clear_avector(p);		/* No previous directions */
+  clear_avector(s);
+  clear_avector(q);
+  clear_avector(z);
+
+  *gamma = 0.0;
+  *alpha = 0.0;
+}
+
+real
+step_pipecg(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata,
+	    pcavector b, pavector x, pavector r, pavector u, pavector w,
+	    pavector p, pavector s, pavector q, pavector z, pavector m,
+	    pavector n, pfield gamma, pfield alpha)
+{
+  field     gamma_new, delta, lambda, mu;
+  real      rr;
+
+  (void) b;
+
+  /* Single reduction, independent of the following products */
+  fused_dotprod_pipecg(r, u, w, &gamma_new, &delta, &rr);
+  if (rr == 0.0)
+    return 0.0;
+
+  copy_avector(w, m);		/* m = N w */
+  if (prcd)
+    prcd(pdata, m);
+
+  clear_avector(n);		/* n = A m */
+  addeval(1.0, matrix, m, n);
+
+  if (*gamma == 0.0) {		/* First step */
+    mu = 0.0;
+    lambda = gamma_new / delta;
+  }
+  else {
+    mu = gamma_new / *gamma;
+    lambda = gamma_new / (delta - mu * gamma_new / *alpha);
+  }
+
+  scaleadd_avector(1.0, n, mu, z);	/* z = n + mu z */
+  scaleadd_avector(1.0, m, mu, q);	/* q = m + mu q */
+  scaleadd_avector(1.0, w, mu, s);	/* s = w + mu s */
+  scaleadd_avector(1.0, u, mu, p);	/* p = u + mu p */
+
+  add_avector(lambda, p, x);	/* x = x + lambda p */
+  add_avector(-lambda, s, r);	/* r = r - lambda s */
+  add_avector(-lambda, q, u);	/* u = u - lambda q */
+  add_avector(-lambda, z, w);	/* w = w - lambda z */
+
+  *gamma = gamma_new;
+  *alpha = lambda;
+
+  return REAL_SQRT(rr);
+}
+
+real
+replace_pipecg(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata,
+	       pcavector b, pcavector x, pavector r, pavector u, pavector w,
+	       pcavector p, pavector s, pavector q, pavector z)
+{
+  copy_avector(b, r);		/* r = b - A x */
+  addeval(-1.0, matrix, x, r);
+
+  copy_avector(r, u);		/* u = N r */
+  if (prcd)
+    prcd(pdata, u);
+
+  clear_avector(w);		/* w = A u */
+  addeval(1.0, matrix, u, w);
+
+  clear_avector(s);		/* s = A p */
+  addeval(1.0, matrix, p, s);
+
+  copy_avector(s, q);		/* q = N s */
+  if (prcd)
+    prcd(pdata, q);
+
+  clear_avector(z);		/* z = A q */
+  addeval(1.0, matrix, q, z);
+
+  return norm2_avector(r);
 }
 
 /* ------------------------------------------------------------
@@ -516,6 +1053,7 @@ step_bicgstab(addeval_t addeval, void *matrix, pcavector b,	/* Right-hand side *
 	      pavector p,	/* Search direction */
 	      pavector a, pavector as)
 {
+  field     d[2];
   field     alpha, beta, omega, mu;
 
   (void) b;
@@ -523,25 +1061,100 @@ step_bicgstab(addeval_t addeval, void *matrix, pcavector b,	/* Right-hand side *
   clear_avector(a);		/* a = A p */
   addeval(1.0, matrix, p, a);
 
-  mu = dotprod_avector(r, rt);
-  alpha = mu / dotprod_avector(a, rt);
+  dotprod2_avector(rt, r, a, d);	/* mu = <r, rt>, alpha = mu / <a, rt> */
+  mu = CONJ(d[0]);
+  alpha = mu / CONJ(d[1]);
 
   add_avector(-alpha, a, r);	/* r = r - alpha a */
 
   clear_avector(as);		/* as = A r */
   addeval(1.0, matrix, r, as);
 
-  omega = dotprod_avector(as, r) / dotprod_avector(as, as);
+  dotprod2_avector(as, r, as, d);	/* omega = <as, r> / <as, as> */
+  omega = d[0] / d[1];
 
   add_avector(alpha, p, x);	/* x = x + alpha p + omega s */
   add_avector(omega, r, x);
 
-  add_avector(-omega, as, r);	/* r = r - omega as */
+  /* r = r - omega as, beta = <r, rt> / mu * alpha / omega */
+  beta = CONJ(adddotprod_avector(-omega, as, r, rt)) / mu * alpha / omega;
+
+  scaleadd_avector(1.0, r, beta, p);	/* p = r + beta (p - omega a) */
+  add_avector(-beta * omega, a, p);
+}
+
+/* ------------------------------------------------------------
+ * Preconditioned stabilized biconjugate gradient method
+ * ------------------------------------------------------------ */
 
-  beta = dotprod_avector(r, rt) / mu * alpha / omega;
+/* cf. Henk van der Vorst, Bi-CGSTAB: A fast and smoothly converging
+ variant of Bi-CG for the solution of nonsymmetric linear systems,
+ preconditioner applied from the right, so r is the true residual. */
 
-  scale_avector(beta, p);	/* p = r + beta (p - omega a) */
-  add_avector(1.0, r, p);
+void
+init_pbicgstab(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata, pcavector b,	/* Right-hand side */
+	       pavector x,	/* Approximate solution */
+	       pavector r,	/* Residual b-Ax */
+	       pavector rt,	/* Adjoint residual */
+	       pavector p,	/* Search direction */
+	       pavector a, pavector as, pavector np, pavector ns)
+{
+  (void) prcd;
+  (void) pdata;
+  (void) a;
+  (void) as;
+  (void) np;
+  (void) ns;
+
+  copy_avector(b, r);		/* r = b - A x */
+  addeval(-1.0, matrix, x, r);
+
+  copy_avector(r, rt);		/* r^* = r */
+
+  copy_avector(r, p);		/* p = r */
+}
+
+void
+step_pbicgstab(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata, pcavector b,	/* Right-hand side */
+	       pavector x,	/* Approximate solution */
+	       pavector r,	/* Residual b-Ax */
+	       pavector rt,	/* Adjoint residual */
+	       pavector p,	/* Search direction */
+	       pavector a, pavector as, pavector np, pavector ns)
+{
+  field     d[2];
+  field     alpha, beta, omega, mu;
+
+  (void) b;
+
+  copy_avector(p, np);		/* np = N p */
+  prcd(pdata, np);
+
+  clear_avector(a);		/* a = A N p */
+  addeval(1.0, matrix, np, a);
+
+  dotprod2_avector(rt, r, a, d);	/* mu = <r, rt>, alpha = mu / <a, rt> */
+  mu = CONJ(d[0]);
+  alpha = mu / CONJ(d[1]);
+
+  add_avector(-alpha, a, r);	/* r = r - alpha a */
+
+  copy_avector(r, ns);		/* ns = N r */
+  prcd(pdata, ns);
+
+  clear_avector(as);		/* as = A N r */
+  addeval(1.0, matrix, ns, as);
+
+  dotprod2_avector(as, r, as, d);	/* omega = <as, r> / <as, as> */
+  omega = d[0] / d[1];
+
+  add_avector(alpha, np, x);	/* x = x + alpha N p + omega N s */
+  add_avector(omega, ns, x);
+
+  /* r = r - omega as, beta = <r, rt> / mu * alpha / omega */
+  beta = CONJ(adddotprod_avector(-omega, as, r, rt)) / mu * alpha / omega;
+
+  scaleadd_avector(1.0, r, beta, p);	/* p = r + beta (p - omega a) */
   add_avector(-beta * omega, a, p);
 }
 
@@ -989,3 +1602,140 @@ residualnorm_pgmres(pcavector rhat, uint k)
 {
   return REAL_ABS(rhat->v[k]);
 }
+
+/* ------------------------------------------------------------
+ * Flexible GMRES method with Householder QR
+ * ------------------------------------------------------------ */
+
+void
+init_fgmres(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata, pcavector b,	/* Right-hand side */
+	    pavector x,		/* Approximate solution */
+	    pavector rhat,	/* Transformed residual */
+	    pavector q,		/* Next search direction */
+	    uint * kk,		/* Dimension of Krylov space */
+	    pamatrix qr,	/* QR factorization of Krylov matrix */
+	    pavector tau,	/* Scaling factors for elementary reflectors */
+	    pamatrix z)
+{				/* Preconditioned search directions */
+  (void) prcd;
+  (void) pdata;
+
+  assert(z->rows == x->dim);
+  assert(z->cols + 1 >= qr->cols);
+
+  /* The residual is not preconditioned, the initialization of
+   * the standard GMRES method can be used */
+  init_gmres(addeval, matrix, b, x, rhat, q, kk, qr, tau);
+}
+
+void
+step_fgmres(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata, pcavector b,	/* Right-hand side */
+	    pavector x,		/* Approximate solution */
+	    pavector rhat,	/* Transformed residual */
+	    pavector q,		/* Next search direction */
+	    uint * kk,		/* Dimension of Krylov space */
+	    pamatrix qr,	/* QR factorization of Krylov matrix */
+	    pavector tau,	/* Scaling factors for elementary reflectors */
+	    pamatrix z)
+{				/* Preconditioned search directions */
+  avector   tmp1, tmp2, tmp4;
+  amatrix   tmp3;
+  pavector  a, zk, tau_k;
+  pamatrix  qr_k;
+  field     rho;
+  uint      k = *kk;
+  uint      kmax = qr->cols;
+  uint      i;
+
+  (void) b;
+  (void) x;
+
+  if (k + 1 >= kmax)
+    return;
+
+  /* Preconditioned direction z_k = N_k q_k, kept for the update */
+  zk = init_column_avector(&tmp4, z, k);
+  copy_avector(q, zk);
+  prcd(pdata, zk);
+
+  /* (k+1)-th Krylov vector A z_k in the (k+1)-th column of qr */
+  a = init_column_avector(&tmp1, qr, k + 1);
+  clear_avector(a);
+  addeval(1.0, matrix, zk, a);
+  uninit_avector(zk);
+
+  /* Apply previous reflections */
+  qr_k = init_sub_amatrix(&tmp3, qr, qr->rows, 0, k + 1, 0);
+  qreval_amatrix_avector(true, qr_k, tau, a);
+  uninit_amatrix(qr_k);
+  uninit_avector(a);
+
+  /* Compute next reflection */
+  qr_k = init_sub_amatrix(&tmp3, qr, qr->rows - (k + 1), k + 1, 1, k + 1);
+  tau_k = init_sub_avector(&tmp2, tau, 1, k + 1);
+  qrdecomp_amatrix(qr_k, tau_k);
+  uninit_avector(tau_k);
+  uninit_amatrix(qr_k);
+
+  /* Construct next orthogonal direction */
+  qr_k = init_sub_amatrix(&tmp3, qr, qr->rows, 0, k + 2, 0);
+  clear_avector(q);
+  q->v[k + 1] = 1.0;
+  qreval_amatrix_avector(false, qr_k, tau, q);
+  uninit_amatrix(qr_k);
+
+  /* Apply preceding Givens rotations */
+  for (i = 0; i < k; i++) {
+    rho = qr->a[(i + 1) + (i + 1) * qr->ld];
+    apply_givens(rho, qr->a + i + (k + 1) * qr->ld,
+		 qr->a + (i + 1) + (k + 1) * qr->ld);
+  }
+
+  /* Eliminate subdiagonal */
+  rho = findapply_givens(qr->a + k + (k + 1) * qr->ld,
+			 qr->a + (k + 1) + (k + 1) * qr->ld);
+  qr->a[(k + 1) + (k + 1) * qr->ld] = rho;
+  apply_givens(rho, rhat->v + k, rhat->v + (k + 1));
+
+  /* Increase dimension */
+  *kk = k + 1;
+}
+
+void
+finish_fgmres(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata, pcavector b,	/* Right-hand side */
+	      pavector x,	/* Approximate solution */
+	      pavector rhat,	/* Transformed residual */
+	      pavector q,	/* Next search direction */
+	      uint * kk,	/* Dimension of Krylov space */
+	      pamatrix qr,	/* QR factorization of Krylov matrix */
+	      pavector tau,	/* Scaling factors for elementary reflectors */
+	      pamatrix z)
+{				/* Preconditioned search directions */
+  avector   tmp1;
+  amatrix   tmp2;
+  pamatrix  qr_k, z_k;
+  pavector  rhat_k;
+  uint      k = *kk;
+
+  rhat_k = init_sub_avector(&tmp1, rhat, k, 0);
+  qr_k = init_sub_amatrix(&tmp2, qr, k, 0, k, 1);
+
+  triangularsolve_amatrix_avector(false, false, false, qr_k, rhat_k);
+
+  uninit_amatrix(qr_k);
+
+  /* Update with the preconditioned directions instead of the
+   * Arnoldi basis */
+  z_k = init_sub_amatrix(&tmp2, z, z->rows, 0, k, 0);
+  addeval_amatrix_avector(1.0, z_k, rhat_k, x);
+  uninit_amatrix(z_k);
+  uninit_avector(rhat_k);
+
+  init_fgmres(addeval, matrix, prcd, pdata, b, x, rhat, q, kk, qr, tau, z);
+}
+
+real
+residualnorm_fgmres(pcavector rhat, uint k)
+{
+  return REAL_ABS(rhat->v[k]);
+}
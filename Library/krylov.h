@@ -40,6 +40,21 @@
  *  @param y Target vector @f$y@f$. */
 typedef void (*addeval_t)(field alpha, void *matrix, pcavector x, pavector y);
 
+/** @brief Block matrix callback.
+ *
+ *  Used to evaluate the system matrix @f$A@f$ for several vectors
+ *  simultaneously, i.e., to perform @f$Y \gets Y + \alpha A X@f$.
+ *
+ *  Functions like @ref addeval_sparsematrix_amatrix can be cast to
+ *  <tt>addevalblock_t</tt>.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param matrix Matrix data describing @f$A@f$.
+ *  @param X Source matrix @f$X@f$.
+ *  @param Y Target matrix @f$Y@f$. */
+typedef void (*addevalblock_t)(field alpha, void *matrix, pcamatrix X,
+    pamatrix Y);
+
 /** @brief Matrix callback.
  *
  *  Used to evaluate the system matrix @f$A@f$ or its adjoint,
@@ -60,6 +75,23 @@ typedef void (*addeval_t)(field alpha, void *matrix, pcavector x, pavector y);
 typedef void (*mvm_t)(field alpha, bool trans, void *matrix, pcavector x,
     pavector y);
 
+/** @brief Block matrix callback.
+ *
+ *  Used to evaluate the matrix @f$A@f$ or its adjoint for several
+ *  vectors simultaneously, i.e., to perform
+ *  @f$Y \gets Y + \alpha A X@f$ or @f$Y \gets Y + \alpha A^* X@f$.
+ *
+ *  Functions like @ref mvmblock_amatrix or @ref mvmblock_hmatrix
+ *  can be cast to <tt>mvmblock_t</tt>.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param trans Set if @f$A^*@f$ is to be used instead of @f$A@f$.
+ *  @param matrix Matrix data describing @f$A@f$.
+ *  @param X Source matrix @f$X@f$.
+ *  @param Y Target matrix @f$Y@f$. */
+typedef void (*mvmblock_t)(field alpha, bool trans, void *matrix,
+    pcamatrix X, pamatrix Y);
+
 /** @brief Preconditioner callback.
  *
  *  Used to apply a precondtioner to a vector, i.e., to perform
@@ -155,6 +187,130 @@ HEADER_PREFIX real
 norm2diff_id_pre_matrix(mvm_t mvmA, void *A, prcd_t solveB, prcd_t solvetransB,
     void *B, uint rows, uint cols);
 
+/* ------------------------------------------------------------
+ * Randomized block estimators for norm2 and norm2diff
+ * ------------------------------------------------------------ */
+
+/** @brief Approximate the spectral norm @f$\|A\|_2@f$ of a matrix @f$A@f$
+ *  by randomized block subspace iteration.
+ *
+ *  A Gaussian random matrix @f$X@f$ with @p k columns is multiplied
+ *  by @f$A@f$, followed by @p q steps of the subspace iteration
+ *  for @f$A^* A@f$ with orthonormalization.
+ *  All matrix products are carried out for the entire block, so
+ *  the matrix is traversed only twice per step.
+ *  The result is the largest singular value of @f$A X@f$ with
+ *  orthonormal @f$X@f$ and therefore never exceeds @f$\|A\|_2@f$.
+ *
+ *  If @p bound is not null, it is set to
+ *  @f$10 \sqrt{2/\pi} \max_j \|A x_j\|_2@f$ computed from the initial
+ *  Gaussian vectors @f$x_j@f$.
+ *  This is an upper bound for @f$\|A\|_2@f$ with probability
+ *  at least @f$1-10^{-k}@f$.
+ *
+ *  @param mvm Callback function for evaluating @p A and its adjoint
+ *         for a block of vectors.
+ *  @param A Matrix @f$A@f$.
+ *  @param rows Number of rows of @p A.
+ *  @param cols Number of columns of @p A.
+ *  @param k Number of random vectors, i.e., block size.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by a probabilistic
+ *         upper bound for @f$\|A\|_2@f$.
+ *  @returns Approximation of @f$\|A\|_2@f$. */
+HEADER_PREFIX real
+norm2_randomized_matrix(mvmblock_t mvm, void *A, uint rows, uint cols,
+    uint k, uint q, preal bound);
+
+/** @brief Approximate the spectral norm @f$\|A-B\|_2@f$ of the difference
+ *  of two matrices @f$A@f$ and @f$B@f$ by randomized block subspace
+ *  iteration.
+ *
+ *  See @ref norm2_randomized_matrix for details and the meaning of
+ *  @p bound.
+ *
+ *  @param mvmA Callback function for evaluating @p A and its adjoint
+ *         for a block of vectors.
+ *  @param A Matrix @f$A@f$.
+ *  @param mvmB Callback function for evaluating @p B and its adjoint
+ *         for a block of vectors.
+ *  @param B Matrix @f$B@f$.
+ *  @param rows Number of rows of either @p A and @p B.
+ *  @param cols Number of columns of either @p A and @p B.
+ *  @param k Number of random vectors, i.e., block size.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by a probabilistic
+ *         upper bound for @f$\|A-B\|_2@f$.
+ *  @returns Approximation of @f$\|A-B\|_2@f$. */
+HEADER_PREFIX real
+norm2diff_randomized_matrix(mvmblock_t mvmA, void *A, mvmblock_t mvmB,
+    void *B, uint rows, uint cols, uint k, uint q, preal bound);
+
+/** @brief Approximate the spectral norm @f$\|I - B^{-1}A\|_2@f$ by
+ *  randomized block subspace iteration.
+ *  The matrix @f$B@f$ is given as a factorization and can be applied
+ *  to some vector.
+ *
+ *  The products with @f$A@f$ are carried out for the entire block,
+ *  the solves with @f$B@f$ are applied column by column.
+ *  See @ref norm2_randomized_matrix for details and the meaning of
+ *  @p bound.
+ *
+ *  @param mvmA Callback function for evaluating @p A and its adjoint
+ *         for a block of vectors.
+ *  @param A Matrix @f$A@f$.
+ *  @param solveB Callback function for solving a linear system with @p B.
+ *  @param solvetransB Callback function for solving a linear system with the
+ *         adjoint of @p B.
+ *  @param B Factorized matrix @f$B@f$.
+ *  @param rows Number of rows of either @p A and @p B.
+ *  @param cols Number of columns of either @p A and @p B.
+ *  @param k Number of random vectors, i.e., block size.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by a probabilistic
+ *         upper bound for @f$\|I - B^{-1}A\|_2@f$.
+ *  @returns Approximation of @f$\|I - B^{-1}A\|_2@f$. */
+HEADER_PREFIX real
+norm2diff_id_pre_randomized_matrix(mvmblock_t mvmA, void *A, prcd_t solveB,
+    prcd_t solvetransB, void *B, uint rows, uint cols, uint k, uint q,
+    preal bound);
+
+/* ------------------------------------------------------------
+ * Estimation of the 1-norm
+ * ------------------------------------------------------------ */
+
+/** @brief Estimate the 1-norm @f$\|A\|_1@f$ of a matrix @f$A@f$.
+ *
+ *  Uses Hager's method with Higham's refinements: at most five
+ *  steps of a gradient ascent for the convex function
+ *  @f$x \mapsto \|A x\|_1@f$ on the unit ball of the 1-norm,
+ *  each requiring one product with @f$A@f$ and one with @f$A^*@f$,
+ *  followed by an additional test with an alternating vector.
+ *  The result is a lower bound for @f$\|A\|_1@f$ and usually
+ *  exact or within a factor of three.
+ *
+ *  @param mvm Callback function for evaluating @p A and its adjoint.
+ *  @param A Matrix @f$A@f$.
+ *  @param rows Number of rows of @p A.
+ *  @param cols Number of columns of @p A.
+ *  @returns Estimate of @f$\|A\|_1@f$. */
+HEADER_PREFIX real
+norm1_matrix(mvm_t mvm, void *A, uint rows, uint cols);
+
+/** @brief Estimate the 1-norm @f$\|B\|_1@f$ of a square matrix @f$B@f$
+ *  that can only be applied in place, e.g., the inverse of a factorized
+ *  matrix.
+ *
+ *  See @ref norm1_matrix for details.
+ *
+ *  @param evalB Callback function for evaluating @p B.
+ *  @param evaltransB Callback function for evaluating the adjoint of @p B.
+ *  @param B Matrix data describing @f$B@f$.
+ *  @param n Number of rows and columns of @p B.
+ *  @returns Estimate of @f$\|B\|_1@f$. */
+HEADER_PREFIX real
+norm1_pre_matrix(prcd_t evalB, prcd_t evaltransB, void *B, uint n);
+
 /* ------------------------------------------------------------
  * Conjugate gradient method (CG)
  * ------------------------------------------------------------ */
@@ -262,6 +418,110 @@ step_pcg(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata, pcavector b,
     pavector p, /* Search direction */
     pavector a);
 
+/* ------------------------------------------------------------
+ * Pipelined conjugate gradient method
+ * ------------------------------------------------------------ */
+
+/** @brief Initialize a pipelined preconditioned conjugate gradient
+ *  method to solve @f$A x = b@f$.
+ *
+ *  The pipelined method by Ghysels and Vanroose is mathematically
+ *  equivalent to @ref init_pcg and @ref step_pcg, but requires only
+ *  one global reduction per step. The three inner products of a step
+ *  are computed in a single pass, and they do not depend on the
+ *  following matrix-vector multiplication and preconditioner
+ *  application, so both can be overlapped in a distributed setting.
+ *  The price are additional vectors and slightly larger rounding
+ *  errors.
+ *
+ *  The matrices @f$A@f$ and @f$N@f$ have to be self-adjoint and
+ *  positive definite.
+ *
+ *  @param addeval Callback function name
+ *  @param matrix untyped pointer to matrix data
+ *  @param prcd Callback function name, may be <tt>NULL</tt>
+ *  @param pdata untyped pointer to preconditioner data
+ *  @param b Right-hand side.
+ *  @param x Approximate solution.
+ *  @param r Residual @f$r=b-Ax@f$.
+ *  @param u Preconditioned residual @f$u=Nr@f$.
+ *  @param w Auxiliary vector @f$w=Au@f$.
+ *  @param p Search direction.
+ *  @param s Auxiliary vector @f$s=Ap@f$.
+ *  @param q Auxiliary vector @f$q=Ns@f$.
+ *  @param z Auxiliary vector @f$z=Aq@f$.
+ *  @param m Auxiliary vector.
+ *  @param n Auxiliary vector.
+ *  @param gamma Inner product @f$\langle r, u \rangle@f$ of the
+ *    previous step.
+ *  @param alpha Step size of the previous step. */
+HEADER_PREFIX void
+init_pipecg(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, pavector r, pavector u, pavector w, pavector p,
+    pavector s, pavector q, pavector z, pavector m, pavector n, pfield gamma,
+    pfield alpha);
+
+/** @brief One step of a pipelined preconditioned conjugate gradient
+ *  method.
+ *
+ *  @param addeval Callback function name
+ *  @param matrix untyped pointer to matrix data
+ *  @param prcd Callback function name, may be <tt>NULL</tt>
+ *  @param pdata untyped pointer to preconditioner data
+ *  @param b Right-hand side.
+ *  @param x Approximate solution.
+ *  @param r Residual @f$r=b-Ax@f$.
+ *  @param u Preconditioned residual @f$u=Nr@f$.
+ *  @param w Auxiliary vector @f$w=Au@f$.
+ *  @param p Search direction.
+ *  @param s Auxiliary vector @f$s=Ap@f$.
+ *  @param q Auxiliary vector @f$q=Ns@f$.
+ *  @param z Auxiliary vector @f$z=Aq@f$.
+ *  @param m Auxiliary vector.
+ *  @param n Auxiliary vector.
+ *  @param gamma Inner product @f$\langle r, u \rangle@f$ of the
+ *    previous step, will be updated.
+ *  @param alpha Step size of the previous step, will be updated.
+ *  @returns Norm @f$\|r\|_2@f$ of the residual at the beginning of the
+ *    step, obtained from the same reduction as the inner products. */
+HEADER_PREFIX real
+step_pipecg(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, pavector r, pavector u, pavector w, pavector p,
+    pavector s, pavector q, pavector z, pavector m, pavector n, pfield gamma,
+    pfield alpha);
+
+/** @brief Replace the recursively updated vectors of the pipelined
+ *  conjugate gradient method by their definitions.
+ *
+ *  In exact arithmetic, the recurrences of @ref step_pipecg keep
+ *  @f$r=b-Ax@f$, @f$u=Nr@f$, @f$w=Au@f$, @f$s=Ap@f$, @f$q=Ns@f$ and
+ *  @f$z=Aq@f$. Since every one of them is updated independently,
+ *  rounding errors let @f$r@f$ drift away from the true residual,
+ *  and the attainable accuracy can be worse than for the standard
+ *  method. This function recomputes all of them from @f$x@f$ and
+ *  @f$p@f$, at the cost of three multiplications with @f$A@f$ and
+ *  two applications of @f$N@f$, and keeps the search direction, so
+ *  the iteration can continue.
+ *
+ *  @param addeval Callback function name
+ *  @param matrix untyped pointer to matrix data
+ *  @param prcd Callback function name, may be <tt>NULL</tt>
+ *  @param pdata untyped pointer to preconditioner data
+ *  @param b Right-hand side.
+ *  @param x Approximate solution.
+ *  @param r Residual @f$r=b-Ax@f$, will be recomputed.
+ *  @param u Preconditioned residual @f$u=Nr@f$, will be recomputed.
+ *  @param w Auxiliary vector @f$w=Au@f$, will be recomputed.
+ *  @param p Search direction.
+ *  @param s Auxiliary vector @f$s=Ap@f$, will be recomputed.
+ *  @param q Auxiliary vector @f$q=Ns@f$, will be recomputed.
+ *  @param z Auxiliary vector @f$z=Aq@f$, will be recomputed.
+ *  @returns Norm @f$\|b-Ax\|_2@f$ of the true residual. */
+HEADER_PREFIX real
+replace_pipecg(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata,
+    pcavector b, pcavector x, pavector r, pavector u, pavector w,
+    pcavector p, pavector s, pavector q, pavector z);
+
 /* ------------------------------------------------------------
  * Uzawa method
  * ------------------------------------------------------------ */
@@ -469,6 +729,70 @@ step_bicgstab(addeval_t addeval, void *matrix, pcavector b, /* Right-hand side *
     pavector p, /* Search direction */
     pavector a, pavector as);
 
+/* ------------------------------------------------------------
+ * Preconditioned stabilized biconjugated gradient method
+ * ------------------------------------------------------------ */
+
+/** @brief Initialize a preconditioned stabilized biconjugate gradient
+ *  method
+ *
+ *  The preconditioner is applied from the right, i.e., the method is
+ *  applied to @f$A N y = b@f$ with @f$x = N y@f$, so <tt>r</tt> is
+ *  the residual of the original system.
+ *
+ *  @param addeval Callback function name
+ *  @param matrix untyped pointer to matrix data
+ *  @param prcd Callback function for the preconditioner @f$N@f$,
+ *         applied from the right
+ *  @param pdata Data for the preconditioner
+ *  @param b Right-hand side.
+ *  @param x Approximate solution.
+ *  @param r Residual b-Ax
+ *  @param rt Adjoint residual
+ *  @param p Search direction
+ *  @param a auxiliary vector
+ *  @param as auxiliary vector
+ *  @param np auxiliary vector for the preconditioned search direction
+ *  @param ns auxiliary vector for the preconditioned intermediate
+ *         residual
+ */
+HEADER_PREFIX void
+init_pbicgstab(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata,
+    pcavector b, /* Right-hand side */
+    pavector x, /* Approximate solution */
+    pavector r, /* Residual b-Ax */
+    pavector rt, /* Adjoint residual */
+    pavector p, /* Search direction */
+    pavector a, pavector as, pavector np, pavector ns);
+
+/** @brief One step a preconditioned stabilized biconjugate gradient
+ *  method
+ *
+ *  @param addeval Callback function name
+ *  @param matrix untyped pointer to matrix data
+ *  @param prcd Callback function for the preconditioner @f$N@f$,
+ *         applied from the right
+ *  @param pdata Data for the preconditioner
+ *  @param b Right-hand side.
+ *  @param x Approximate solution.
+ *  @param r Residual b-Ax
+ *  @param rt Adjoint residual
+ *  @param p Search direction
+ *  @param a auxiliary vector
+ *  @param as auxiliary vector
+ *  @param np auxiliary vector for the preconditioned search direction
+ *  @param ns auxiliary vector for the preconditioned intermediate
+ *         residual
+ */
+HEADER_PREFIX void
+step_pbicgstab(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata,
+    pcavector b, /* Right-hand side */
+    pavector x, /* Approximate solution */
+    pavector r, /* Residual b-Ax */
+    pavector rt, /* Adjoint residual */
+    pavector p, /* Search direction */
+    pavector a, pavector as, pavector np, pavector ns);
+
 /* ------------------------------------------------------------
  * Generalized minimal residual method (GMRES)
  * ------------------------------------------------------------ */
@@ -684,6 +1008,131 @@ finish_pgmres(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata,
 HEADER_PREFIX real
 residualnorm_pgmres(pcavector rhat, uint k);
 
+/* ------------------------------------------------------------
+ * Flexible generalized minimal residual method (FGMRES)
+ * ------------------------------------------------------------ */
+
+/** @brief Initialize flexible GMRES.
+ *
+ *  The flexible GMRES method solves @f$A x = b@f$ with right
+ *  preconditioning by @f$N_k@f$ and allows the preconditioner to change
+ *  in every step, e.g., if it is an inner iterative solver or an
+ *  inexact H-matrix factorization. Since the Arnoldi basis
+ *  @f$Q_k@f$ cannot be mapped to the search space by one fixed matrix,
+ *  the preconditioned directions @f$z_k = N_k q_k@f$ are stored in
+ *  the columns of <tt>z</tt>.
+ *
+ *  The maximal dimension of the Krylov subspace is determined
+ *  by the number of columns of <tt>qr</tt>:
+ *  for a <tt>k</tt>-dimensional subspace, <tt>qr->cols==k+1</tt>
+ *  is required.
+ *
+ *  @param addeval Callback function representing the matrix @f$A@f$.
+ *  @param matrix Data for the <tt>addeval</tt> callback.
+ *  @param prcd Callback function representing the preconditioner
+ *         @f$N_k@f$, may change from step to step.
+ *  @param pdata Data for the <tt>prcd</tt> callback.
+ *  @param b Right-hand side vector @f$b@f$.
+ *  @param x Initial guess for the solution @f$x@f$, will eventually
+ *         be replaced by an improved approximation.
+ *  @param rhat Transformed residual. The absolute value of
+ *         <tt>rhat[*kk]</tt> is the Euclidean norm of the residual.
+ *  @param q Next vector of the Krylov basis, constructed by
+ *         Householder's elementary reflectors.
+ *  @param kk Pointer to current dimension of the Krylov space.
+ *  @param qr Representation of the Arnoldi basis @f$Q_{k+1}@f$ and the
+ *         transformed matrix @f$Q_{k+1}^* A Z_k@f$.
+ *  @param tau Scaling factors of elementary reflectors,
+ *         provided by @ref qrdecomp_amatrix.
+ *  @param z Preconditioned directions @f$Z_k@f$, requires
+ *         <tt>z->cols+1 >= qr->cols</tt>. */
+HEADER_PREFIX void
+init_fgmres(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, pavector rhat, pavector q, uint *kk, pamatrix qr,
+    pavector tau, pamatrix z);
+
+/** @brief One step of the flexible GMRES method.
+ *
+ *  If <tt>*kk+1 >= qr->cols</tt>, there is no room for the next
+ *  Arnoldi basis vector and the function returns immediately.
+ *  It can be restarted using @ref finish_fgmres.
+ *
+ *  Otherwise the preconditioner is applied to the current basis vector,
+ *  the result is stored in <tt>z</tt>, and the matrix
+ *  @f$Q_{k+1}^* A Z_k@f$ is updated.
+ *
+ *  @remark This function currently makes no use of <tt>b</tt>
+ *  and does not update <tt>x</tt>. The current residual
+ *  can be tracked via <tt>rhat[*kk]</tt>. Once it is sufficiently small,
+ *  the improved solution <tt>x</tt> can be obtained by using
+ *  @ref finish_fgmres.
+ *
+ *  @param addeval Callback function representing the matrix @f$A@f$.
+ *  @param matrix Data for the <tt>addeval</tt> callback.
+ *  @param prcd Callback function representing the preconditioner
+ *         @f$N_k@f$, may change from step to step.
+ *  @param pdata Data for the <tt>prcd</tt> callback.
+ *  @param b Right-hand side vector @f$b@f$.
+ *  @param x Initial guess for the solution @f$x@f$, will eventually
+ *         be replaced by an improved approximation.
+ *  @param rhat Transformed residual. The absolute value of
+ *         <tt>rhat[*kk]</tt> is the Euclidean norm of the residual.
+ *  @param q Next vector of the Krylov basis, constructed by
+ *         Householder's elementary reflectors.
+ *  @param kk Pointer to current dimension of the Krylov space.
+ *  @param qr Representation of the Arnoldi basis @f$Q_{k+1}@f$ and the
+ *         transformed matrix @f$Q_{k+1}^* A Z_k@f$.
+ *  @param tau Scaling factors of elementary reflectors,
+ *         provided by @ref qrdecomp_amatrix.
+ *  @param z Preconditioned directions @f$Z_k@f$, requires
+ *         <tt>z->cols+1 >= qr->cols</tt>. */
+HEADER_PREFIX void
+step_fgmres(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, pavector rhat, pavector q, uint *kk, pamatrix qr,
+    pavector tau, pamatrix z);
+
+/** @brief Completes or restarts the flexible GMRES method.
+ *
+ *  Solves the least-squares problem
+ *  @f$Q_{k+1}^* A Z_k \widehat{x} = Q_{k+1}^* r@f$ and performs the
+ *  update @f$x \gets x + Z_k \widehat{x}@f$.
+ *
+ *  The function calls @ref init_fgmres to reset the iteration and
+ *  prepare for a restart.
+ *
+ *  @param addeval Callback function representing the matrix @f$A@f$.
+ *  @param matrix Data for the <tt>addeval</tt> callback.
+ *  @param prcd Callback function representing the preconditioner
+ *         @f$N_k@f$, may change from step to step.
+ *  @param pdata Data for the <tt>prcd</tt> callback.
+ *  @param b Right-hand side vector @f$b@f$.
+ *  @param x Initial guess for the solution @f$x@f$, will eventually
+ *         be replaced by an improved approximation.
+ *  @param rhat Transformed residual. The absolute value of
+ *         <tt>rhat[*kk]</tt> is the Euclidean norm of the residual.
+ *  @param q Next vector of the Krylov basis, constructed by
+ *         Householder's elementary reflectors.
+ *  @param kk Pointer to current dimension of the Krylov space.
+ *  @param qr Representation of the Arnoldi basis @f$Q_{k+1}@f$ and the
+ *         transformed matrix @f$Q_{k+1}^* A Z_k@f$.
+ *  @param tau Scaling factors of elementary reflectors,
+ *         provided by @ref qrdecomp_amatrix.
+ *  @param z Preconditioned directions @f$Z_k@f$, requires
+ *         <tt>z->cols+1 >= qr->cols</tt>. */
+HEADER_PREFIX void
+finish_fgmres(addeval_t addeval, void *matrix, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, pavector rhat, pavector q, uint *kk, pamatrix qr,
+    pavector tau, pamatrix z);
+
+/** @brief Returns norm of current residual vector.
+ *
+ *  @param rhat Transformed residual. The absolute value of
+ *         <tt>rhat[k]</tt> is the Euclidean norm of the residual.
+ *  @param k Current dimension of the Krylov space.
+ *  @returns Norm of the residual. */
+HEADER_PREFIX real
+residualnorm_fgmres(pcavector rhat, uint k);
+
 /** @} */
 
 #endif
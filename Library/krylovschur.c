@@ -0,0 +1,858 @@
+/* ------------------------------------------------------------
+ * This is the file "krylovschur.c" of the H2Lib package.
+ * All rights reserved, Steffen Boerm 2016
+ * ------------------------------------------------------------ */
+
+#include "krylovschur.h"
+
+#include "eigensolvers.h"
+#include "harith.h"
+#include "krylovsolvers.h"
+
+#include <complex.h>
+#include <float.h>
+#include <math.h>
+
+/* Schur forms of the small Rayleigh quotients are always computed
+ * in double precision complex arithmetic */
+typedef double _Complex zfield;
+
+/* ------------------------------------------------------------
+ * Complex Schur decomposition of small matrices
+ * ------------------------------------------------------------ */
+
+/* Find c and s with [c s; -conj(s) c] [f; g] = [r; 0] */
+static void
+zlartg(zfield f, zfield g, double *c, zfield *s)
+{
+  double    af, ag, r;
+
+  af = cabs(f);
+  ag = cabs(g);
+
+  if (ag == 0.0) {
+    *c = 1.0;
+    *s = 0.0;
+  }
+  else if (af == 0.0) {
+    *c = 0.0;
+    *s = conj(g) / ag;
+  }
+  else {
+    r = hypot(af, ag);
+    *c = af / r;
+    *s = (f / af) * conj(g) / r;
+  }
+}
+
+/* Apply x <- c x + s y, y <- c y - conj(s) x */
+static void
+zrot(uint n, zfield *x, uint incx, zfield *y, uint incy, double c,
+     zfield s)
+{
+  zfield    xi, yi;
+  uint      i;
+
+  for (i = 0; i < n; i++) {
+    xi = x[i * incx];
+    yi = y[i * incy];
+    x[i * incx] = c * xi + s * yi;
+    y[i * incy] = c * yi - conj(s) * xi;
+  }
+}
+
+/* Apply the rotation to rows k and k+1, columns c0 to m-1, to
+ * columns k and k+1, rows 0 to r1-1, and to the columns of Q */
+static void
+rotate(uint m, zfield *T, uint ldt, zfield *Q, uint ldq, uint k, uint c0,
+       uint r1, double c, zfield s)
+{
+  zrot(m - c0, T + k + c0 * ldt, ldt, T + k + 1 + c0 * ldt, ldt, c, s);
+  zrot(r1, T + k * ldt, 1, T + (k + 1) * ldt, 1, c, conj(s));
+  zrot(m, Q + k * ldq, 1, Q + (k + 1) * ldq, 1, c, conj(s));
+}
+
+/* Compute T = Q^* T Q upper triangular, Q has to be initialized */
+static    bool
+schur_small(uint m, zfield *T, uint ldt, zfield *Q, uint ldq)
+{
+  zfield    s, mu, a, b, d, disc, mu1, mu2;
+  double    c, tst;
+  uint      col, row, lo, hi, k, iter;
+
+  /* Reduce to Hessenberg form by Givens rotations */
+  for (col = 0; col + 2 < m; col++)
+    for (row = m - 1; row > col + 1; row--)
+      if (T[row + col * ldt] != 0.0) {
+	zlartg(T[(row - 1) + col * ldt], T[row + col * ldt], &c, &s);
+	rotate(m, T, ldt, Q, ldq, row - 1, col, m, c, s);
+	T[row + col * ldt] = 0.0;
+      }
+
+  /* Shifted QR iteration */
+  hi = m - 1;
+  iter = 0;
+  while (hi > 0) {
+    for (lo = hi; lo > 0; lo--) {
+      tst = cabs(T[(lo - 1) + (lo - 1) * ldt]) + cabs(T[lo + lo * ldt]);
+      if (cabs(T[lo + (lo - 1) * ldt]) <= DBL_EPSILON * tst) {
+	T[lo + (lo - 1) * ldt] = 0.0;
+	break;
+      }
+    }
+
+    if (lo == hi) {
+      hi--;
+      iter = 0;
+      continue;
+    }
+
+    iter++;
+    if (iter > 60)
+      return false;
+
+    /* Wilkinson shift, exceptional shift every tenth step */
+    a = T[(hi - 1) + (hi - 1) * ldt];
+    b = T[(hi - 1) + hi * ldt];
+    d = T[hi + hi * ldt];
+    if (iter % 10 == 0)
+      mu = d + 0.75 * cabs(T[hi + (hi - 1) * ldt]);
+    else {
+      disc = csqrt(0.25 * (a - d) * (a - d) + b * T[hi + (hi - 1) * ldt]);
+      mu1 = 0.5 * (a + d) + disc;
+      mu2 = 0.5 * (a + d) - disc;
+      mu = (cabs(mu1 - d) < cabs(mu2 - d) ? mu1 : mu2);
+    }
+
+    /* Implicit single-shift step, chasing the bulge */
+    for (k = lo; k < hi; k++) {
+      if (k == lo) {
+	zlartg(T[lo + lo * ldt] - mu, T[(lo + 1) + lo * ldt], &c, &s);
+	rotate(m, T, ldt, Q, ldq, k, lo, UINT_MIN(k + 3, hi + 1), c, s);
+      }
+      else {
+	zlartg(T[k + (k - 1) * ldt], T[(k + 1) + (k - 1) * ldt], &c, &s);
+	rotate(m, T, ldt, Q, ldq, k, k - 1, UINT_MIN(k + 3, hi + 1), c, s);
+	T[(k + 1) + (k - 1) * ldt] = 0.0;
+      }
+    }
+  }
+
+  return true;
+}
+
+static double
+target_key(eigtarget which, zfield lambda)
+{
+  switch (which) {
+  case H2_EIG_LARGEST_MAGNITUDE:
+    return -cabs(lambda);
+  case H2_EIG_SMALLEST_MAGNITUDE:
+    return cabs(lambda);
+  case H2_EIG_LARGEST_REAL:
+    return -creal(lambda);
+  default:
+    return creal(lambda);
+  }
+}
+
+/* Move the wanted eigenvalues to the top of the Schur form. Since the
+ * keys of complex conjugate eigenvalues coincide, pairs stay adjacent. */
+static void
+reorder_schur(uint m, zfield *T, uint ldt, zfield *Q, uint ldq,
+	      eigtarget which)
+{
+  zfield    t11, t22, s;
+  double    c, key, bkey;
+  uint      pos, best, i;
+
+  for (pos = 0; pos + 1 < m; pos++) {
+    best = pos;
+    bkey = target_key(which, T[pos + pos * ldt]);
+    for (i = pos + 1; i < m; i++) {
+      key = target_key(which, T[i + i * ldt]);
+      if (key < bkey) {
+	best = i;
+	bkey = key;
+      }
+    }
+
+    /* Swap neighbouring diagonal elements, cf. LAPACK's ztrexc */
+    for (i = best; i > pos; i--) {
+      t11 = T[(i - 1) + (i - 1) * ldt];
+      t22 = T[i + i * ldt];
+      zlartg(T[(i - 1) + i * ldt], t22 - t11, &c, &s);
+      zrot(m - i - 1, T + (i - 1) + (i + 1) * ldt, ldt,
+	   T + i + (i + 1) * ldt, ldt, c, s);
+      zrot(i - 1, T + (i - 1) * ldt, 1, T + i * ldt, 1, c, conj(s));
+      zrot(m, Q + (i - 1) * ldq, 1, Q + i * ldq, 1, c, conj(s));
+      T[(i - 1) + (i - 1) * ldt] = t22;
+      T[i + i * ldt] = t11;
+    }
+  }
+}
+
+/* Orthonormal basis Y of the span of the first k columns of Q. If
+ * field is real, the span has to be closed under conjugation and a real
+ * basis is obtained from the real and imaginary parts. */
+static void
+basis_schur(uint m, const zfield *Q, uint ldq, uint k, pamatrix Y)
+{
+  uint      i, j;
+#ifdef USE_COMPLEX
+  for (j = 0; j < k; j++)
+    for (i = 0; i < m; i++)
+      Y->a[i + j * Y->ld] = Q[i + j * ldq];
+#else
+  pamatrix  M, U;
+  prealavector sigma;
+  uint     *perm;
+  uint      l, best;
+  real      sk;
+
+  M = new_amatrix(m, 2 * k);
+  for (j = 0; j < k; j++)
+    for (i = 0; i < m; i++) {
+      M->a[i + j * M->ld] = creal(Q[i + j * ldq]);
+      M->a[i + (j + k) * M->ld] = cimag(Q[i + j * ldq]);
+    }
+
+  l = UINT_MIN(m, 2 * k);
+  U = new_amatrix(m, l);
+  sigma = new_realavector(l);
+  svd_amatrix(M, sigma, U, NULL);
+
+  /* Singular values are not necessarily sorted */
+  perm = (uint *) allocmem(sizeof(uint) * l);
+  for (j = 0; j < l; j++)
+    perm[j] = j;
+  for (j = 0; j < k; j++) {
+    best = j;
+    sk = sigma->v[perm[j]];
+    for (i = j + 1; i < l; i++)
+      if (sigma->v[perm[i]] > sk) {
+	best = i;
+	sk = sigma->v[perm[i]];
+      }
+    i = perm[j];
+    perm[j] = perm[best];
+    perm[best] = i;
+
+    for (i = 0; i < m; i++)
+      Y->a[i + j * Y->ld] = U->a[i + perm[j] * U->ld];
+  }
+
+  freemem(perm);
+  del_realavector(sigma);
+  del_amatrix(U);
+  del_amatrix(M);
+#endif
+}
+
+bool
+schurbasis_amatrix(pcamatrix a, eigtarget which, pamatrix y)
+{
+  zfield   *T, *Q;
+  uint      m, i, j;
+  bool      ok;
+
+  m = a->rows;
+  assert(a->cols == m);
+  assert(y->rows == m);
+  assert(y->cols <= m);
+
+  T = (zfield *) allocmem(sizeof(zfield) * m * m);
+  Q = (zfield *) allocmem(sizeof(zfield) * m * m);
+  for (j = 0; j < m; j++)
+    for (i = 0; i < m; i++) {
+      T[i + j * m] = a->a[i + j * a->ld];
+      Q[i + j * m] = (i == j ? 1.0 : 0.0);
+    }
+
+  ok = schur_small(m, T, m, Q, m);
+  if (ok) {
+    reorder_schur(m, T, m, Q, m, which);
+    basis_schur(m, Q, m, y->cols, y);
+  }
+
+  freemem(Q);
+  freemem(T);
+
+  return ok;
+}
+
+/* ------------------------------------------------------------
+ * Block Krylov-Schur iteration
+ * ------------------------------------------------------------ */
+
+/* Orthonormalize column j of V against the columns 0 to j-1 by
+ * classical Gram-Schmidt with reorthogonalization. If h is not null,
+ * the coefficients and the norm are stored in h[0], ..., h[j]. */
+static void
+orthonormalize_column(pamatrix V, uint j, pfield h)
+{
+  avector   tmp1, tmp2;
+  amatrix   tmp3;
+  pavector  v, c;
+  pamatrix  Vj;
+  real      norm0, norm;
+  uint      i, pass;
+
+  v = init_column_avector(&tmp1, V, j);
+  Vj = init_sub_amatrix(&tmp3, V, V->rows, 0, j, 0);
+  c = init_avector(&tmp2, j);
+
+  if (h)
+    for (i = 0; i < j; i++)
+      h[i] = 0.0;
+
+  norm0 = norm2_avector(v);
+  for (pass = 0; pass < 2; pass++) {
+    clear_avector(c);
+    addevaltrans_amatrix_avector(1.0, Vj, v, c);
+    addeval_amatrix_avector(-1.0, Vj, c, v);
+    if (h)
+      for (i = 0; i < j; i++)
+	h[i] += c->v[i];
+  }
+  norm = norm2_avector(v);
+
+  /* Breakdown, continue with a random direction */
+  while (norm <= H2_MACH_EPS * norm0 || norm == 0.0) {
+    norm0 = 0.0;
+    random_avector(v);
+    for (pass = 0; pass < 2; pass++) {
+      clear_avector(c);
+      addevaltrans_amatrix_avector(1.0, Vj, v, c);
+      addeval_amatrix_avector(-1.0, Vj, c, v);
+    }
+    norm = norm2_avector(v);
+  }
+
+  if (h)
+    h[j] = (norm0 == 0.0 ? 0.0 : norm);
+  scale_avector(1.0 / norm, v);
+
+  uninit_avector(c);
+  uninit_amatrix(Vj);
+  uninit_avector(v);
+}
+
+/* Sort a real vector with respect to the target, store the
+ * permutation in perm */
+static void
+sort_real(eigtarget which, pcrealavector theta, uint *perm)
+{
+  uint      i, j, l;
+  double    key, bkey;
+
+  for (i = 0; i < theta->dim; i++)
+    perm[i] = i;
+
+  for (i = 0; i < theta->dim; i++) {
+    l = i;
+    bkey = target_key(which, theta->v[perm[i]]);
+    for (j = i + 1; j < theta->dim; j++) {
+      key = target_key(which, theta->v[perm[j]]);
+      if (key < bkey) {
+	l = j;
+	bkey = key;
+      }
+    }
+    j = perm[i];
+    perm[i] = perm[l];
+    perm[l] = j;
+  }
+}
+
+static    uint
+krylovschur(void *A, addevalblock_t addeval_A, uint n, uint p, uint m,
+	    bool herm, eigtarget which, real eps, uint maxiter, uint nev,
+	    zfield *lambda, pamatrix X)
+{
+  amatrix   tmp1, tmp2, tmp3, tmp4, tmp5;
+  pamatrix  V, G, Y, Vn, H, R, T1, S, Vs, Vd, Ys;
+  prealavector theta;
+  zfield   *T, *Q, sum;
+  double    tol;
+  uint     *perm;
+  real      anorm, res;
+  int       balance;
+  uint      i, j, k, l, iter, nconv;
+  bool      ok;
+
+  assert(p > 0);
+  assert(nev + 2 * p <= m);
+  assert(m + p <= n);
+
+  V = new_amatrix(n, m + p);
+  G = new_zero_amatrix(m + p, m);
+  Y = new_amatrix(m, m);
+  Vn = new_amatrix(n, m);
+  perm = (uint *) allocmem(sizeof(uint) * m);
+  T = (zfield *) allocmem(sizeof(zfield) * m * m);
+  Q = (zfield *) allocmem(sizeof(zfield) * m * m);
+
+  /* Random orthonormal starting block */
+  random_amatrix(V);
+  for (i = 0; i < p; i++)
+    orthonormalize_column(V, i, NULL);
+
+  j = 0;
+  iter = 0;
+  nconv = 0;
+  anorm = 0.0;
+  while (true) {
+    /* Expand the Krylov decomposition by blocks */
+    while (j + p <= m) {
+      Vs = init_sub_amatrix(&tmp1, V, n, 0, p, j);
+      Vd = init_sub_amatrix(&tmp2, V, n, 0, p, j + p);
+      clear_amatrix(Vd);
+      addeval_A(1.0, A, Vs, Vd);
+      uninit_amatrix(Vd);
+      uninit_amatrix(Vs);
+
+      for (i = 0; i < p; i++)
+	orthonormalize_column(V, j + p + i, G->a + (j + i) * G->ld);
+
+      j += p;
+    }
+
+    /* Rayleigh quotient and residual block */
+    H = init_sub_amatrix(&tmp1, G, j, 0, j, 0);
+    R = init_sub_amatrix(&tmp2, G, p, j, j, 0);
+    Ys = init_sub_amatrix(&tmp3, Y, j, 0, j, 0);
+    T1 = new_amatrix(p, j);
+
+    ok = true;
+    if (herm) {
+      S = new_amatrix(j, j);
+      for (l = 0; l < j; l++)
+	for (i = 0; i < j; i++)
+	  S->a[i + l * S->ld] = 0.5 * (H->a[i + l * H->ld]
+				       + CONJ(H->a[l + i * H->ld]));
+      theta = new_realavector(j);
+      Vs = new_amatrix(j, j);
+      eig_amatrix(S, theta, Vs);
+      sort_real(which, theta, perm);
+      for (l = 0; l < j; l++) {
+	T[l] = theta->v[perm[l]];
+	for (i = 0; i < j; i++)
+	  Ys->a[i + l * Ys->ld] = Vs->a[i + perm[l] * Vs->ld];
+      }
+      del_amatrix(Vs);
+      del_amatrix(S);
+      del_realavector(theta);
+
+      /* Residuals of all Ritz pairs */
+      clear_amatrix(T1);
+      addmul_amatrix(1.0, false, R, false, Ys, T1);
+      anorm = 0.0;
+      for (l = 0; l < j; l++)
+	anorm = REAL_MAX(anorm, cabs(T[l]));
+      nconv = 0;
+      for (l = 0; l < nev; l++) {
+	res = 0.0;
+	for (i = 0; i < p; i++)
+	  res += ABSSQR(T1->a[i + l * T1->ld]);
+	if (REAL_SQRT(res) <= eps * anorm)
+	  nconv++;
+      }
+      for (l = 0; l < nev; l++)
+	lambda[l] = T[l];
+    }
+    else {
+      for (l = 0; l < j; l++)
+	for (i = 0; i < j; i++) {
+	  T[i + l * j] = H->a[i + l * H->ld];
+	  Q[i + l * j] = (i == l ? 1.0 : 0.0);
+	}
+      ok = schur_small(j, T, j, Q, j);
+      if (ok)
+	reorder_schur(j, T, j, Q, j, which);
+
+      /* Residuals of the leading Schur vectors */
+      anorm = 0.0;
+      for (l = 0; l < j; l++)
+	anorm = REAL_MAX(anorm, cabs(T[l + l * j]));
+      nconv = 0;
+      for (l = 0; l < nev && nconv == l; l++) {
+	res = 0.0;
+	for (i = 0; i < p; i++) {
+	  sum = 0.0;
+	  for (k = 0; k < j; k++)
+	    sum += R->a[i + k * R->ld] * Q[k + l * j];
+	  res += creal(sum * conj(sum));
+	}
+	if (sqrt(res) <= eps * anorm)
+	  nconv++;
+      }
+      if (!ok)
+	nconv = 0;
+      for (l = 0; l < nev; l++)
+	lambda[l] = T[l + l * j];
+    }
+    del_amatrix(T1);
+
+    if (!ok || nconv >= nev || iter + 1 == maxiter)
+      break;
+
+    /* Keep the wanted part and some more */
+    k = nev + (j - nev - p) / 2;
+    if (!herm) {
+#ifndef USE_COMPLEX
+      /* Do not separate complex conjugate pairs */
+      tol = sqrt(DBL_EPSILON) * anorm;
+      balance = 0;
+      for (l = 0; l < k; l++)
+	if (cimag(T[l + l * j]) > tol)
+	  balance++;
+	else if (cimag(T[l + l * j]) < -tol)
+	  balance--;
+      if (balance != 0)
+	k = (k + 1 + p <= m ? k + 1 : k - 1);
+#else
+      (void) tol;
+      (void) balance;
+#endif
+      basis_schur(j, Q, j, k, Ys);
+    }
+
+    /* New basis V(:,0:k) = V(:,0:j) Y(:,0:k) */
+    Vs = init_sub_amatrix(&tmp4, V, n, 0, j, 0);
+    Vd = init_sub_amatrix(&tmp5, Vn, n, 0, k, 0);
+    Ys->cols = k;
+    clear_amatrix(Vd);
+    addmul_amatrix(1.0, false, Vs, false, Ys, Vd);
+    uninit_amatrix(Vs);
+    Vs = init_sub_amatrix(&tmp4, V, n, 0, k, 0);
+    copy_amatrix(false, Vd, Vs);
+    uninit_amatrix(Vs);
+    uninit_amatrix(Vd);
+
+    /* Move the next block to columns k to k+p-1 */
+    for (l = 0; l < p; l++)
+      for (i = 0; i < n; i++)
+	V->a[i + (k + l) * V->ld] = V->a[i + (j + l) * V->ld];
+
+    /* Rayleigh quotient Y^* H Y and residual block R Y */
+    T1 = new_amatrix(j, k);
+    clear_amatrix(T1);
+    addmul_amatrix(1.0, false, H, false, Ys, T1);
+    S = new_zero_amatrix(k + p, k);
+    Vs = init_sub_amatrix(&tmp4, S, k, 0, k, 0);
+    addmul_amatrix(1.0, true, Ys, false, T1, Vs);
+    uninit_amatrix(Vs);
+    Vs = init_sub_amatrix(&tmp4, S, p, k, k, 0);
+    addmul_amatrix(1.0, false, R, false, Ys, Vs);
+    uninit_amatrix(Vs);
+    del_amatrix(T1);
+
+    uninit_amatrix(Ys);
+    uninit_amatrix(R);
+    uninit_amatrix(H);
+
+    clear_amatrix(G);
+    Vs = init_sub_amatrix(&tmp4, G, k + p, 0, k, 0);
+    copy_amatrix(false, S, Vs);
+    uninit_amatrix(Vs);
+    del_amatrix(S);
+
+    j = k;
+    iter++;
+  }
+
+  /* Approximate eigenvectors or invariant subspace */
+  if (X) {
+    assert(X->rows == n);
+    assert(X->cols == nev);
+
+    if (!herm)
+      basis_schur(j, Q, j, nev, Ys);
+    Ys->cols = nev;
+    Vs = init_sub_amatrix(&tmp4, V, n, 0, j, 0);
+    clear_amatrix(X);
+    addmul_amatrix(1.0, false, Vs, false, Ys, X);
+    uninit_amatrix(Vs);
+  }
+
+  uninit_amatrix(Ys);
+  uninit_amatrix(R);
+  uninit_amatrix(H);
+
+  freemem(Q);
+  freemem(T);
+  freemem(perm);
+  del_amatrix(Vn);
+  del_amatrix(Y);
+  del_amatrix(G);
+  del_amatrix(V);
+
+  return nconv;
+}
+
+/* ------------------------------------------------------------
+ * Shift-invert operators
+ * ------------------------------------------------------------ */
+
+typedef struct {
+  prcd_t    solve;
+  void     *sdata;
+} shiftinvert;
+
+static void
+addevalblock_shiftinvert(field alpha, void *data, pcamatrix X, pamatrix Y)
+{
+  shiftinvert *si = (shiftinvert *) data;
+  avector   tmp1, tmp2, tmp3;
+  pavector  x, y, t;
+  uint      j;
+
+  t = init_avector(&tmp3, X->rows);
+  for (j = 0; j < X->cols; j++) {
+    x = init_column_avector(&tmp1, (pamatrix) X, j);
+    copy_avector(x, t);
+    uninit_avector(x);
+
+    si->solve(si->sdata, t);
+
+    y = init_column_avector(&tmp2, Y, j);
+    add_avector(alpha, t, y);
+    uninit_avector(y);
+  }
+  uninit_avector(t);
+}
+
+static void
+lrsolve_shiftinvert_hmatrix(void *LR, pavector x)
+{
+  lrsolve_hmatrix_avector(false, (pchmatrix) LR, x);
+}
+
+/* ------------------------------------------------------------
+ * Thick-restart Lanczos method
+ * ------------------------------------------------------------ */
+
+uint
+eig_lanczos(void *A, addevalblock_t addeval_A, uint n, uint blocksize,
+	    uint kmax, eigtarget which, real eps, uint maxiter,
+	    prealavector lambda, pamatrix X)
+{
+  zfield   *mu;
+  uint      i, nconv;
+
+  mu = (zfield *) allocmem(sizeof(zfield) * lambda->dim);
+
+  nconv = krylovschur(A, addeval_A, n, blocksize, kmax, true, which, eps,
+		      maxiter, lambda->dim, mu, X);
+
+  for (i = 0; i < lambda->dim; i++)
+    lambda->v[i] = creal(mu[i]);
+
+  freemem(mu);
+
+  return nconv;
+}
+
+uint
+eig_lanczos_amatrix(pcamatrix A, uint blocksize, uint kmax,
+		    eigtarget which, real eps, uint maxiter,
+		    prealavector lambda, pamatrix X)
+{
+  return eig_lanczos((void *) A, (addevalblock_t) addevalblock_amatrix,
+		     A->rows, blocksize, kmax, which, eps, maxiter, lambda, X);
+}
+
+uint
+eig_lanczos_sparsematrix(pcsparsematrix A, uint blocksize, uint kmax,
+			 eigtarget which, real eps, uint maxiter,
+			 prealavector lambda, pamatrix X)
+{
+  return eig_lanczos((void *) A,
+		     (addevalblock_t) addeval_sparsematrix_amatrix, A->rows,
+		     blocksize, kmax, which, eps, maxiter, lambda, X);
+}
+
+uint
+eig_lanczos_hmatrix(pchmatrix A, uint blocksize, uint kmax,
+		    eigtarget which, real eps, uint maxiter,
+		    prealavector lambda, pamatrix X)
+{
+  return eig_lanczos((void *) A, (addevalblock_t) addevalblock_hmatrix,
+		     A->rc->size, blocksize, kmax, which, eps, maxiter, lambda,
+		     X);
+}
+
+uint
+eig_lanczos_h2matrix(pch2matrix A, uint blocksize, uint kmax,
+		     eigtarget which, real eps, uint maxiter,
+		     prealavector lambda, pamatrix X)
+{
+  return eig_lanczos((void *) A, (addevalblock_t) addevalblock_h2matrix,
+		     A->rb->t->size, blocksize, kmax, which, eps, maxiter,
+		     lambda, X);
+}
+
+uint
+eig_lanczos_dh2matrix(pcdh2matrix A, uint blocksize, uint kmax,
+		      eigtarget which, real eps, uint maxiter,
+		      prealavector lambda, pamatrix X)
+{
+  return eig_lanczos((void *) A, (addevalblock_t) addevalblock_dh2matrix,
+		     A->rb->t->size, blocksize, kmax, which, eps, maxiter,
+		     lambda, X);
+}
+
+uint
+eig_shiftinvert_lanczos(prcd_t solve, void *sdata, uint n, real sigma,
+			uint kmax, real eps, uint maxiter,
+			prealavector lambda, pamatrix X)
+{
+  shiftinvert si;
+  uint      i, nconv;
+
+  si.solve = solve;
+  si.sdata = sdata;
+
+  nconv = eig_lanczos(&si, addevalblock_shiftinvert, n, 1, kmax,
+		      H2_EIG_LARGEST_MAGNITUDE, eps, maxiter, lambda, X);
+
+  for (i = 0; i < lambda->dim; i++)
+    lambda->v[i] = sigma + 1.0 / lambda->v[i];
+
+  return nconv;
+}
+
+uint
+eig_shiftinvert_lanczos_hmatrix(pchmatrix LR, real sigma, uint kmax,
+				real eps, uint maxiter, prealavector lambda,
+				pamatrix X)
+{
+  return eig_shiftinvert_lanczos(lrsolve_shiftinvert_hmatrix, (void *) LR,
+				 LR->rc->size, sigma, kmax, eps, maxiter,
+				 lambda, X);
+}
+
+/* ------------------------------------------------------------
+ * Krylov-Schur method
+ * ------------------------------------------------------------ */
+
+uint
+eig_krylovschur(void *A, addevalblock_t addeval_A, uint n, uint blocksize,
+		uint kmax, eigtarget which, real eps, uint maxiter,
+		prealavector lambda_re, prealavector lambda_im, pamatrix X)
+{
+  zfield   *mu;
+  uint      i, nconv;
+
+  assert(lambda_im->dim == lambda_re->dim);
+
+  mu = (zfield *) allocmem(sizeof(zfield) * lambda_re->dim);
+
+  nconv = krylovschur(A, addeval_A, n, blocksize, kmax, false, which, eps,
+		      maxiter, lambda_re->dim, mu, X);
+
+  for (i = 0; i < lambda_re->dim; i++) {
+    lambda_re->v[i] = creal(mu[i]);
+    lambda_im->v[i] = cimag(mu[i]);
+  }
+
+  freemem(mu);
+
+  return nconv;
+}
+
+uint
+eig_krylovschur_amatrix(pcamatrix A, uint blocksize, uint kmax,
+			eigtarget which, real eps, uint maxiter,
+			prealavector lambda_re, prealavector lambda_im,
+			pamatrix X)
+{
+  return eig_krylovschur((void *) A, (addevalblock_t) addevalblock_amatrix,
+			 A->rows, blocksize, kmax, which, eps, maxiter,
+			 lambda_re, lambda_im, X);
+}
+
+uint
+eig_krylovschur_sparsematrix(pcsparsematrix A, uint blocksize, uint kmax,
+			     eigtarget which, real eps, uint maxiter,
+			     prealavector lambda_re, prealavector lambda_im,
+			     pamatrix X)
+{
+  return eig_krylovschur((void *) A,
+			 (addevalblock_t) addeval_sparsematrix_amatrix,
+			 A->rows, blocksize, kmax, which, eps, maxiter,
+			 lambda_re, lambda_im, X);
+}
+
+uint
+eig_krylovschur_hmatrix(pchmatrix A, uint blocksize, uint kmax,
+			eigtarget which, real eps, uint maxiter,
+			prealavector lambda_re, prealavector lambda_im,
+			pamatrix X)
+{
+  return eig_krylovschur((void *) A, (addevalblock_t) addevalblock_hmatrix,
+			 A->rc->size, blocksize, kmax, which, eps, maxiter,
+			 lambda_re, lambda_im, X);
+}
+
+uint
+eig_krylovschur_h2matrix(pch2matrix A, uint blocksize, uint kmax,
+			 eigtarget which, real eps, uint maxiter,
+			 prealavector lambda_re, prealavector lambda_im,
+			 pamatrix X)
+{
+  return eig_krylovschur((void *) A,
+			 (addevalblock_t) addevalblock_h2matrix,
+			 A->rb->t->size, blocksize, kmax, which, eps, maxiter,
+			 lambda_re, lambda_im, X);
+}
+
+uint
+eig_krylovschur_dh2matrix(pcdh2matrix A, uint blocksize, uint kmax,
+			  eigtarget which, real eps, uint maxiter,
+			  prealavector lambda_re, prealavector lambda_im,
+			  pamatrix X)
+{
+  return eig_krylovschur((void *) A,
+			 (addevalblock_t) addevalblock_dh2matrix,
+			 A->rb->t->size, blocksize, kmax, which, eps, maxiter,
+			 lambda_re, lambda_im, X);
+}
+
+uint
+eig_shiftinvert_krylovschur(prcd_t solve, void *sdata, uint n, real sigma,
+			    uint kmax, real eps, uint maxiter,
+			    prealavector lambda_re, prealavector lambda_im,
+			    pamatrix X)
+{
+  shiftinvert si;
+  zfield    mu;
+  uint      i, nconv;
+
+  si.solve = solve;
+  si.sdata = sdata;
+
+  nconv = eig_krylovschur(&si, addevalblock_shiftinvert, n, 1, kmax,
+			  H2_EIG_LARGEST_MAGNITUDE, eps, maxiter, lambda_re,
+			  lambda_im, X);
+
+  for (i = 0; i < lambda_re->dim; i++) {
+    mu = sigma + 1.0 / (lambda_re->v[i] + I * lambda_im->v[i]);
+    lambda_re->v[i] = creal(mu);
+    lambda_im->v[i] = cimag(mu);
+  }
+
+  return nconv;
+}
+
+uint
+eig_shiftinvert_krylovschur_hmatrix(pchmatrix LR, real sigma, uint kmax,
+				    real eps, uint maxiter,
+				    prealavector lambda_re,
+				    prealavector lambda_im, pamatrix X)
+{
+  return eig_shiftinvert_krylovschur(lrsolve_shiftinvert_hmatrix,
+				     (void *) LR, LR->rc->size, sigma, kmax,
+				     eps, maxiter, lambda_re, lambda_im, X);
+}
@@ -0,0 +1,415 @@
+/* ------------------------------------------------------------
+ * This is the file "krylovschur.h" of the H2Lib package.
+ * All rights reserved, Steffen Boerm 2016
+ * ------------------------------------------------------------ */
+
+/** @file krylovschur.h
+ *  @author Steffen B&ouml;rm */
+
+#ifndef KRYLOVSCHUR_H
+#define KRYLOVSCHUR_H
+
+/** @defgroup krylovschur krylovschur
+ *  @brief Krylov-Schur eigensolvers for large matrices.
+ *
+ *  A few eigenvalues of a large matrix are approximated using only
+ *  matrix-vector products provided by an @ref addevalblock_t callback.
+ *  A block Krylov decomposition
+ *  @f$A V_k = V_k H_k + \widehat V B_k@f$ is expanded up to a maximal
+ *  dimension and then truncated to the wanted part of a Schur form of
+ *  the Rayleigh quotient @f$H_k@f$.
+ *
+ *  For self-adjoint matrices, @f$H_k@f$ is diagonalized and the
+ *  method becomes the thick-restart Lanczos method.
+ *  Using a factorization of @f$A-\sigma I@f$, e.g., an H-LU
+ *  factorization, the shift-invert variants find eigenvalues close
+ *  to a shift @f$\sigma@f$.
+ *  @{ */
+
+#include "amatrix.h"
+#include "realavector.h"
+#include "sparsematrix.h"
+#include "hmatrix.h"
+#include "h2matrix.h"
+#include "dh2matrix.h"
+#include "krylov.h"
+
+/** @brief Part of the spectrum that is approximated. */
+typedef enum {
+  /** @brief Eigenvalues of largest absolute value. */
+  H2_EIG_LARGEST_MAGNITUDE,
+  /** @brief Eigenvalues of smallest absolute value. */
+  H2_EIG_SMALLEST_MAGNITUDE,
+  /** @brief Eigenvalues of largest real part. */
+  H2_EIG_LARGEST_REAL,
+  /** @brief Eigenvalues of smallest real part. */
+  H2_EIG_SMALLEST_REAL
+} eigtarget;
+
+/* ------------------------------------------------------------
+ * Invariant subspaces of small matrices
+ * ------------------------------------------------------------ */
+
+/** @brief Find an orthonormal basis of the invariant subspace of a
+ *  small matrix belonging to the wanted eigenvalues.
+ *
+ *  A complex Schur form of <tt>a</tt> is computed and reordered so
+ *  that the wanted eigenvalues come first.
+ *  If <tt>field</tt> is real, the basis is taken from the real and
+ *  imaginary parts of the leading Schur vectors, so complex conjugate
+ *  pairs should not be split.
+ *
+ *  @param a Square matrix.
+ *  @param which Part of the spectrum to use.
+ *  @param y Matrix with <tt>a->rows</tt> rows, its columns are
+ *         overwritten by the orthonormal basis.
+ *  @returns <tt>true</tt> if the QR iteration converged. */
+HEADER_PREFIX bool
+schurbasis_amatrix(pcamatrix a, eigtarget which, pamatrix y);
+
+/* ------------------------------------------------------------
+ * Thick-restart Lanczos method
+ * ------------------------------------------------------------ */
+
+/** @brief Approximate a few eigenpairs of a self-adjoint matrix
+ *  by the thick-restart block Lanczos method.
+ *
+ *  The method stops if the residuals @f$\|A x_i - \lambda_i x_i\|_2@f$
+ *  of all wanted eigenpairs are bounded by @f$\epsilon@f$ times the
+ *  largest Ritz value in absolute value.
+ *
+ *  @param A Matrix, has to be self-adjoint.
+ *  @param addeval_A Block callback function for evaluation of
+ *         <tt>A</tt>.
+ *  @param n Dimension of <tt>A</tt>.
+ *  @param blocksize Number of vectors multiplied by <tt>A</tt> at once.
+ *  @param kmax Maximal dimension of the Krylov space, at least
+ *         <tt>lambda->dim+2*blocksize</tt> and at most
+ *         <tt>n-blocksize</tt>.
+ *  @param which Part of the spectrum to approximate.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts. <tt>maxiter=0</tt>
+ *         means that the number of restarts is not bounded.
+ *  @param lambda Approximate eigenvalues, the dimension determines
+ *         how many are computed. Sorted with the best match for
+ *         <tt>which</tt> first.
+ *  @param X If not <tt>NULL</tt>, the columns of this
+ *         <tt>n</tt> @f$\times@f$ <tt>lambda->dim</tt> matrix are filled
+ *         with orthonormal approximate eigenvectors.
+ *  @returns Number of converged eigenpairs. */
+HEADER_PREFIX uint
+eig_lanczos(void *A, addevalblock_t addeval_A, uint n, uint blocksize,
+    uint kmax, eigtarget which, real eps, uint maxiter, prealavector lambda,
+    pamatrix X);
+
+/** @brief Approximate a few eigenpairs of a self-adjoint matrix
+ *  by the thick-restart block Lanczos method.
+ *
+ *  @param A Matrix, has to be self-adjoint.
+ *  @param blocksize Number of vectors multiplied by <tt>A</tt> at once.
+ *  @param kmax Maximal dimension of the Krylov space.
+ *  @param which Part of the spectrum to approximate.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts.
+ *  @param lambda Approximate eigenvalues.
+ *  @param X If not <tt>NULL</tt>, approximate eigenvectors.
+ *  @returns Number of converged eigenpairs. */
+HEADER_PREFIX uint
+eig_lanczos_amatrix(pcamatrix A, uint blocksize, uint kmax,
+    eigtarget which, real eps, uint maxiter, prealavector lambda,
+    pamatrix X);
+
+/** @brief Approximate a few eigenpairs of a self-adjoint matrix
+ *  by the thick-restart block Lanczos method.
+ *
+ *  @param A Matrix, has to be self-adjoint.
+ *  @param blocksize Number of vectors multiplied by <tt>A</tt> at once.
+ *  @param kmax Maximal dimension of the Krylov space.
+ *  @param which Part of the spectrum to approximate.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts.
+ *  @param lambda Approximate eigenvalues.
+ *  @param X If not <tt>NULL</tt>, approximate eigenvectors.
+ *  @returns Number of converged eigenpairs. */
+HEADER_PREFIX uint
+eig_lanczos_sparsematrix(pcsparsematrix A, uint blocksize, uint kmax,
+    eigtarget which, real eps, uint maxiter, prealavector lambda,
+    pamatrix X);
+
+/** @brief Approximate a few eigenpairs of a self-adjoint matrix
+ *  by the thick-restart block Lanczos method.
+ *
+ *  @param A Matrix, has to be self-adjoint.
+ *  @param blocksize Number of vectors multiplied by <tt>A</tt> at once.
+ *  @param kmax Maximal dimension of the Krylov space.
+ *  @param which Part of the spectrum to approximate.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts.
+ *  @param lambda Approximate eigenvalues.
+ *  @param X If not <tt>NULL</tt>, approximate eigenvectors.
+ *  @returns Number of converged eigenpairs. */
+HEADER_PREFIX uint
+eig_lanczos_hmatrix(pchmatrix A, uint blocksize, uint kmax,
+    eigtarget which, real eps, uint maxiter, prealavector lambda,
+    pamatrix X);
+
+/** @brief Approximate a few eigenpairs of a self-adjoint matrix
+ *  by the thick-restart block Lanczos method.
+ *
+ *  @param A Matrix, has to be self-adjoint.
+ *  @param blocksize Number of vectors multiplied by <tt>A</tt> at once.
+ *  @param kmax Maximal dimension of the Krylov space.
+ *  @param which Part of the spectrum to approximate.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts.
+ *  @param lambda Approximate eigenvalues.
+ *  @param X If not <tt>NULL</tt>, approximate eigenvectors.
+ *  @returns Number of converged eigenpairs. */
+HEADER_PREFIX uint
+eig_lanczos_h2matrix(pch2matrix A, uint blocksize, uint kmax,
+    eigtarget which, real eps, uint maxiter, prealavector lambda,
+    pamatrix X);
+
+/** @brief Approximate a few eigenpairs of a self-adjoint matrix
+ *  by the thick-restart block Lanczos method.
+ *
+ *  @param A Matrix, has to be self-adjoint.
+ *  @param blocksize Number of vectors multiplied by <tt>A</tt> at once.
+ *  @param kmax Maximal dimension of the Krylov space.
+ *  @param which Part of the spectrum to approximate.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts.
+ *  @param lambda Approximate eigenvalues.
+ *  @param X If not <tt>NULL</tt>, approximate eigenvectors.
+ *  @returns Number of converged eigenpairs. */
+HEADER_PREFIX uint
+eig_lanczos_dh2matrix(pcdh2matrix A, uint blocksize, uint kmax,
+    eigtarget which, real eps, uint maxiter, prealavector lambda,
+    pamatrix X);
+
+/** @brief Approximate the eigenpairs of a self-adjoint matrix closest
+ *  to a shift @f$\sigma@f$ by the thick-restart Lanczos method
+ *  applied to @f$(A-\sigma I)^{-1}@f$.
+ *
+ *  The eigenvalues @f$\mu_i@f$ of @f$(A-\sigma I)^{-1}@f$ of largest
+ *  absolute value are computed and transformed back to
+ *  @f$\lambda_i = \sigma + 1/\mu_i@f$. The accuracy @f$\epsilon@f$
+ *  refers to the inverse.
+ *
+ *  @param solve Callback function solving a system with the matrix
+ *         @f$A-\sigma I@f$, e.g., by an H-LU factorization.
+ *  @param sdata Data for <tt>solve</tt>.
+ *  @param n Dimension of <tt>A</tt>.
+ *  @param sigma Shift @f$\sigma@f$.
+ *  @param kmax Maximal dimension of the Krylov space.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts.
+ *  @param lambda Approximate eigenvalues of @f$A@f$, closest to
+ *         @f$\sigma@f$ first.
+ *  @param X If not <tt>NULL</tt>, approximate eigenvectors.
+ *  @returns Number of converged eigenpairs. */
+HEADER_PREFIX uint
+eig_shiftinvert_lanczos(prcd_t solve, void *sdata, uint n, real sigma,
+    uint kmax, real eps, uint maxiter, prealavector lambda, pamatrix X);
+
+/** @brief Approximate the eigenpairs of a self-adjoint H-matrix
+ *  closest to a shift @f$\sigma@f$ by the thick-restart Lanczos method
+ *  applied to @f$(A-\sigma I)^{-1}@f$.
+ *
+ *  @param LR H-LU factorization of @f$A-\sigma I@f$, e.g., computed
+ *         by @ref lrdecomp_hmatrix.
+ *  @param sigma Shift @f$\sigma@f$.
+ *  @param kmax Maximal dimension of the Krylov space.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts.
+ *  @param lambda Approximate eigenvalues of @f$A@f$, closest to
+ *         @f$\sigma@f$ first.
+ *  @param X If not <tt>NULL</tt>, approximate eigenvectors.
+ *  @returns Number of converged eigenpairs. */
+HEADER_PREFIX uint
+eig_shiftinvert_lanczos_hmatrix(pchmatrix LR, real sigma, uint kmax,
+    real eps, uint maxiter, prealavector lambda, pamatrix X);
+
+/* ------------------------------------------------------------
+ * Krylov-Schur method
+ * ------------------------------------------------------------ */
+
+/** @brief Approximate a few eigenvalues of a general matrix by the
+ *  block Krylov-Schur method.
+ *
+ *  The small Schur forms are computed in complex arithmetic. If
+ *  <tt>field</tt> is real, the restarts use a real orthonormal basis
+ *  of the wanted invariant subspace, keeping complex conjugate pairs
+ *  together.
+ *  The method stops if the Schur vectors of all wanted eigenvalues
+ *  have residuals bounded by @f$\epsilon@f$ times the largest Ritz
+ *  value in absolute value.
+ *
+ *  @param A Matrix.
+ *  @param addeval_A Block callback function for evaluation of
+ *         <tt>A</tt>.
+ *  @param n Dimension of <tt>A</tt>.
+ *  @param blocksize Number of vectors multiplied by <tt>A</tt> at once.
+ *  @param kmax Maximal dimension of the Krylov space, at least
+ *         <tt>lambda_re->dim+2*blocksize</tt> and at most
+ *         <tt>n-blocksize</tt>.
+ *  @param which Part of the spectrum to approximate.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts. <tt>maxiter=0</tt>
+ *         means that the number of restarts is not bounded.
+ *  @param lambda_re Real parts of the approximate eigenvalues, the
+ *         dimension determines how many are computed. Sorted with the
+ *         best match for <tt>which</tt> first.
+ *  @param lambda_im Imaginary parts of the approximate eigenvalues.
+ *  @param X If not <tt>NULL</tt>, the columns of this
+ *         <tt>n</tt> @f$\times@f$ <tt>lambda_re->dim</tt> matrix are
+ *         filled with an orthonormal basis of the approximate invariant
+ *         subspace. If <tt>field</tt> is real and the last eigenvalue
+ *         is separated from its complex conjugate, this subspace is
+ *         only approximately invariant.
+ *  @returns Number of leading converged eigenvalues. */
+HEADER_PREFIX uint
+eig_krylovschur(void *A, addevalblock_t addeval_A, uint n, uint blocksize,
+    uint kmax, eigtarget which, real eps, uint maxiter,
+    prealavector lambda_re, prealavector lambda_im, pamatrix X);
+
+/** @brief Approximate a few eigenvalues of a general matrix by the
+ *  block Krylov-Schur method.
+ *
+ *  @param A Matrix.
+ *  @param blocksize Number of vectors multiplied by <tt>A</tt> at once.
+ *  @param kmax Maximal dimension of the Krylov space.
+ *  @param which Part of the spectrum to approximate.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts.
+ *  @param lambda_re Real parts of the approximate eigenvalues.
+ *  @param lambda_im Imaginary parts of the approximate eigenvalues.
+ *  @param X If not <tt>NULL</tt>, basis of the invariant subspace.
+ *  @returns Number of leading converged eigenvalues. */
+HEADER_PREFIX uint
+eig_krylovschur_amatrix(pcamatrix A, uint blocksize, uint kmax,
+    eigtarget which, real eps, uint maxiter, prealavector lambda_re,
+    prealavector lambda_im, pamatrix X);
+
+/** @brief Approximate a few eigenvalues of a general matrix by the
+ *  block Krylov-Schur method.
+ *
+ *  @param A Matrix.
+ *  @param blocksize Number of vectors multiplied by <tt>A</tt> at once.
+ *  @param kmax Maximal dimension of the Krylov space.
+ *  @param which Part of the spectrum to approximate.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts.
+ *  @param lambda_re Real parts of the approximate eigenvalues.
+ *  @param lambda_im Imaginary parts of the approximate eigenvalues.
+ *  @param X If not <tt>NULL</tt>, basis of the invariant subspace.
+ *  @returns Number of leading converged eigenvalues. */
+HEADER_PREFIX uint
+eig_krylovschur_sparsematrix(pcsparsematrix A, uint blocksize, uint kmax,
+    eigtarget which, real eps, uint maxiter, prealavector lambda_re,
+    prealavector lambda_im, pamatrix X);
+
+/** @brief Approximate a few eigenvalues of a general matrix by the
+ *  block Krylov-Schur method.
+ *
+ *  @param A Matrix.
+ *  @param blocksize Number of vectors multiplied by <tt>A</tt> at once.
+ *  @param kmax Maximal dimension of the Krylov space.
+ *  @param which Part of the spectrum to approximate.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts.
+ *  @param lambda_re Real parts of the approximate eigenvalues.
+ *  @param lambda_im Imaginary parts of the approximate eigenvalues.
+ *  @param X If not <tt>NULL</tt>, basis of the invariant subspace.
+ *  @returns Number of leading converged eigenvalues. */
+HEADER_PREFIX uint
+eig_krylovschur_hmatrix(pchmatrix A, uint blocksize, uint kmax,
+    eigtarget which, real eps, uint maxiter, prealavector lambda_re,
+    prealavector lambda_im, pamatrix X);
+
+/** @brief Approximate a few eigenvalues of a general matrix by the
+ *  block Krylov-Schur method.
+ *
+ *  @param A Matrix.
+ *  @param blocksize Number of vectors multiplied by <tt>A</tt> at once.
+ *  @param kmax Maximal dimension of the Krylov space.
+ *  @param which Part of the spectrum to approximate.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts.
+ *  @param lambda_re Real parts of the approximate eigenvalues.
+ *  @param lambda_im Imaginary parts of the approximate eigenvalues.
+ *  @param X If not <tt>NULL</tt>, basis of the invariant subspace.
+ *  @returns Number of leading converged eigenvalues. */
+HEADER_PREFIX uint
+eig_krylovschur_h2matrix(pch2matrix A, uint blocksize, uint kmax,
+    eigtarget which, real eps, uint maxiter, prealavector lambda_re,
+    prealavector lambda_im, pamatrix X);
+
+/** @brief Approximate a few eigenvalues of a general matrix by the
+ *  block Krylov-Schur method.
+ *
+ *  @param A Matrix.
+ *  @param blocksize Number of vectors multiplied by <tt>A</tt> at once.
+ *  @param kmax Maximal dimension of the Krylov space.
+ *  @param which Part of the spectrum to approximate.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts.
+ *  @param lambda_re Real parts of the approximate eigenvalues.
+ *  @param lambda_im Imaginary parts of the approximate eigenvalues.
+ *  @param X If not <tt>NULL</tt>, basis of the invariant subspace.
+ *  @returns Number of leading converged eigenvalues. */
+HEADER_PREFIX uint
+eig_krylovschur_dh2matrix(pcdh2matrix A, uint blocksize, uint kmax,
+    eigtarget which, real eps, uint maxiter, prealavector lambda_re,
+    prealavector lambda_im, pamatrix X);
+
+/** @brief Approximate the eigenvalues of a general matrix closest to
+ *  a shift @f$\sigma@f$ by the Krylov-Schur method applied to
+ *  @f$(A-\sigma I)^{-1}@f$.
+ *
+ *  The eigenvalues @f$\mu_i@f$ of @f$(A-\sigma I)^{-1}@f$ of largest
+ *  absolute value are computed and transformed back to
+ *  @f$\lambda_i = \sigma + 1/\mu_i@f$. The accuracy @f$\epsilon@f$
+ *  refers to the inverse.
+ *
+ *  @param solve Callback function solving a system with the matrix
+ *         @f$A-\sigma I@f$, e.g., by an H-LU factorization.
+ *  @param sdata Data for <tt>solve</tt>.
+ *  @param n Dimension of <tt>A</tt>.
+ *  @param sigma Shift @f$\sigma@f$.
+ *  @param kmax Maximal dimension of the Krylov space.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts.
+ *  @param lambda_re Real parts of the approximate eigenvalues of
+ *         @f$A@f$, closest to @f$\sigma@f$ first.
+ *  @param lambda_im Imaginary parts of the approximate eigenvalues.
+ *  @param X If not <tt>NULL</tt>, basis of the invariant subspace.
+ *  @returns Number of leading converged eigenvalues. */
+HEADER_PREFIX uint
+eig_shiftinvert_krylovschur(prcd_t solve, void *sdata, uint n, real sigma,
+    uint kmax, real eps, uint maxiter, prealavector lambda_re,
+    prealavector lambda_im, pamatrix X);
+
+/** @brief Approximate the eigenvalues of a general H-matrix closest to
+ *  a shift @f$\sigma@f$ by the Krylov-Schur method applied to
+ *  @f$(A-\sigma I)^{-1}@f$.
+ *
+ *  @param LR H-LU factorization of @f$A-\sigma I@f$, e.g., computed
+ *         by @ref lrdecomp_hmatrix.
+ *  @param sigma Shift @f$\sigma@f$.
+ *  @param kmax Maximal dimension of the Krylov space.
+ *  @param eps Relative accuracy @f$\epsilon@f$.
+ *  @param maxiter Maximal number of restarts.
+ *  @param lambda_re Real parts of the approximate eigenvalues of
+ *         @f$A@f$, closest to @f$\sigma@f$ first.
+ *  @param lambda_im Imaginary parts of the approximate eigenvalues.
+ *  @param X If not <tt>NULL</tt>, basis of the invariant subspace.
+ *  @returns Number of leading converged eigenvalues. */
+HEADER_PREFIX uint
+eig_shiftinvert_krylovschur_hmatrix(pchmatrix LR, real sigma, uint kmax,
+    real eps, uint maxiter, prealavector lambda_re, prealavector lambda_im,
+    pamatrix X);
+
+/** @} */
+
+#endif
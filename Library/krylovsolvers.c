@@ -9,26 +9,101 @@
 #include "krylovsolvers.h"
 #include "basic.h"
 #include "krylov.h"
+#include "harith.h"
+#include "matrixnorms.h"
+
+/* ------------------------------------------------------------
+ * Solver workspaces
+ * ------------------------------------------------------------ */
+
+/* The convenience solvers use a workspace only once, so they skip
+ * the first touch and leave the pages to the solver itself. */
+static pkrylovwork
+alloc_krylovwork(uint n, uint kmax, bool flexible, bool touch)
+{
+  pkrylovwork w;
+  pfield    mem;
+  size_t    sz, i;
+  uint      j, zcols;
+
+  w = (pkrylovwork) allocmem(sizeof(krylovwork));
+  w->n = n;
+  w->kmax = kmax;
+
+  /* Only flexible GMRES needs the preconditioned directions */
+  zcols = (flexible ? kmax : 0);
+
+  /* One block for all vectors, the QR factorization and the
+   * preconditioned directions */
+  sz = (size_t) n * (KRYLOVWORK_VECTORS + 1) + (size_t) n * (kmax + zcols)
+    + kmax;
+  w->mem = mem = allocfield(sz);
+
+  /* First touch in parallel, so that the pages are local to the
+   * threads working on them */
+  if (touch) {
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (i = 0; i < sz; i++)
+      mem[i] = 0.0;
+  }
+
+  for (j = 0; j < KRYLOVWORK_VECTORS; j++) {
+    init_pointer_avector(w->v + j, mem, n);
+    mem += n;
+  }
+  init_pointer_avector(&w->rhat, mem, n);
+  mem += n;
+  init_pointer_amatrix(&w->qr, mem, n, kmax);
+  mem += (size_t) n * kmax;
+  init_pointer_amatrix(&w->z, mem, n, zcols);
+  mem += (size_t) n * zcols;
+  init_pointer_avector(&w->tau, mem, kmax);
+
+  return w;
+}
+
+pkrylovwork
+new_krylovwork(uint n, uint kmax, bool flexible)
+{
+  return alloc_krylovwork(n, kmax, flexible, true);
+}
+
+void
+del_krylovwork(pkrylovwork w)
+{
+  uint      j;
+
+  uninit_avector(&w->tau);
+  uninit_amatrix(&w->z);
+  uninit_amatrix(&w->qr);
+  uninit_avector(&w->rhat);
+  for (j = 0; j < KRYLOVWORK_VECTORS; j++)
+    uninit_avector(w->v + j);
+
+  freemem(w->mem);
+  freemem(w);
+}
 
 /* ------------------------------------------------------------
  * Conjugated gradients method
  * ------------------------------------------------------------ */
 
 uint
-solve_cg_avector(void *A, addeval_t addeval_A, pcavector b, pavector x,
-		 real eps, uint maxiter)
+solve_cg_work_avector(pkrylovwork w, void *A, addeval_t addeval_A,
+		      pcavector b, pavector x, real eps, uint maxiter)
 {
   pavector  r, p, a;
   real      norm, error;
-  uint      n, iter;
+  uint      iter;
 
-  n = x->dim;
-
-  assert(b->dim == n);
+  assert(x->dim == w->n);
+  assert(b->dim == w->n);
 
-  r = new_avector(n);
-  p = new_avector(n);
-  a = new_avector(n);
+  r = w->v;
+  p = w->v + 1;
+  a = w->v + 2;
 
   norm = norm2_avector(b);
 
@@ -43,9 +118,19 @@ solve_cg_avector(void *A, addeval_t addeval_A, pcavector b, pavector x,
     iter++;
   }
 
-  del_avector(a);
-  del_avector(p);
-  del_avector(r);
+  return iter;
+}
+
+uint
+solve_cg_avector(void *A, addeval_t addeval_A, pcavector b, pavector x,
+		 real eps, uint maxiter)
+{
+  pkrylovwork w;
+  uint      iter;
+
+  w = alloc_krylovwork(x->dim, 0, false, false);
+  iter = solve_cg_work_avector(w, A, addeval_A, b, x, eps, maxiter);
+  del_krylovwork(w);
 
   return iter;
 }
@@ -96,21 +181,21 @@ solve_cg_dh2matrix_avector(pcdh2matrix A, pcavector b, pavector x,
  * ------------------------------------------------------------ */
 
 uint
-solve_pcg_avector(void *A, addeval_t addeval_A, prcd_t prcd, void *pdata,
-		  pcavector b, pavector x, real eps, uint maxiter)
+solve_pcg_work_avector(pkrylovwork w, void *A, addeval_t addeval_A,
+		       prcd_t prcd, void *pdata, pcavector b, pavector x,
+		       real eps, uint maxiter)
 {
   pavector  r, q, p, a;
   real      norm, error;
-  uint      n, iter;
+  uint      iter;
 
-  n = x->dim;
-
-  assert(b->dim == n);
+  assert(x->dim == w->n);
+  assert(b->dim == w->n);
 
-  r = new_avector(n);
-  q = new_avector(n);
-  p = new_avector(n);
-  a = new_avector(n);
+  r = w->v;
+  q = w->v + 1;
+  p = w->v + 2;
+  a = w->v + 3;
 
   norm = norm2_avector(b);
 
@@ -125,10 +210,20 @@ solve_pcg_avector(void *A, addeval_t addeval_A, prcd_t prcd, void *pdata,
     iter++;
   }
 
-  del_avector(a);
-  del_avector(p);
-  del_avector(q);
-  del_avector(r);
+  return iter;
+}
+
+uint
+solve_pcg_avector(void *A, addeval_t addeval_A, prcd_t prcd, void *pdata,
+		  pcavector b, pavector x, real eps, uint maxiter)
+{
+  pkrylovwork w;
+  uint      iter;
+
+  w = alloc_krylovwork(x->dim, 0, false, false);
+  iter = solve_pcg_work_avector(w, A, addeval_A, prcd, pdata, b, x, eps,
+				maxiter);
+  del_krylovwork(w);
 
   return iter;
 }
@@ -180,23 +275,22 @@ solve_pcg_dh2matrix_avector(pcdh2matrix A, prcd_t prcd, void *pdata,
  * ------------------------------------------------------------ */
 
 uint
-solve_gmres_avector(void *A, addeval_t addeval_A, pcavector b, pavector x,
-		    real eps, uint maxiter, uint kmax)
+solve_gmres_work_avector(pkrylovwork w, void *A, addeval_t addeval_A,
+			 pcavector b, pavector x, real eps, uint maxiter)
 {
-  pavector  rhat, r, q, tau;
+  pavector  rhat, q, tau;
   pamatrix  qr;
   real      norm, error;
-  uint      n, iter, k;
-
-  n = x->dim;
+  uint      iter, k, kmax;
 
-  assert(b->dim == n);
+  assert(x->dim == w->n);
+  assert(b->dim == w->n);
 
-  rhat = new_avector(n);
-  r = new_avector(n);
-  q = new_avector(n);
-  qr = new_amatrix(n, kmax);
-  tau = new_avector(kmax);
+  kmax = w->kmax;
+  rhat = &w->rhat;
+  q = w->v;
+  qr = &w->qr;
+  tau = &w->tau;
 
   norm = norm2_avector(b);
 
@@ -216,11 +310,19 @@ solve_gmres_avector(void *A, addeval_t addeval_A, pcavector b, pavector x,
   }
   finish_gmres(addeval_A, A, b, x, rhat, q, &k, qr, tau);
 
-  del_avector(tau);
-  del_amatrix(qr);
-  del_avector(q);
-  del_avector(r);
-  del_avector(rhat);
+  return iter;
+}
+
+uint
+solve_gmres_avector(void *A, addeval_t addeval_A, pcavector b, pavector x,
+		    real eps, uint maxiter, uint kmax)
+{
+  pkrylovwork w;
+  uint      iter;
+
+  w = alloc_krylovwork(x->dim, kmax, false, false);
+  iter = solve_gmres_work_avector(w, A, addeval_A, b, x, eps, maxiter);
+  del_krylovwork(w);
 
   return iter;
 }
@@ -272,24 +374,24 @@ solve_gmres_dh2matrix_avector(pcdh2matrix A, pcavector b, pavector x,
  * ------------------------------------------------------------ */
 
 uint
-solve_pgmres_avector(void *A, addeval_t addeval_A, prcd_t prcd,
-		     void *pdata, pcavector b, pavector x, real eps,
-		     uint maxiter, uint kmax)
+solve_pgmres_work_avector(pkrylovwork w, void *A, addeval_t addeval_A,
+			  prcd_t prcd, void *pdata, pcavector b, pavector x,
+			  real eps, uint maxiter)
 {
   pavector  rhat, r, q, tau;
   pamatrix  qr;
   real      norm, error;
-  uint      n, iter, k;
-
-  n = x->dim;
+  uint      iter, k, kmax;
 
-  assert(b->dim == n);
+  assert(x->dim == w->n);
+  assert(b->dim == w->n);
 
-  rhat = new_avector(n);
-  r = new_avector(n);
-  q = new_avector(n);
-  qr = new_amatrix(n, kmax);
-  tau = new_avector(kmax);
+  kmax = w->kmax;
+  rhat = &w->rhat;
+  r = w->v;
+  q = w->v + 1;
+  qr = &w->qr;
+  tau = &w->tau;
 
   copy_avector(b, r);
   prcd(pdata, r);
@@ -313,11 +415,21 @@ solve_pgmres_avector(void *A, addeval_t addeval_A, prcd_t prcd,
   if (k > 0)
     finish_pgmres(addeval_A, A, prcd, pdata, b, x, rhat, q, &k, qr, tau);
 
-  del_avector(tau);
-  del_amatrix(qr);
-  del_avector(q);
-  del_avector(r);
-  del_avector(rhat);
+  return iter;
+}
+
+uint
+solve_pgmres_avector(void *A, addeval_t addeval_A, prcd_t prcd,
+		     void *pdata, pcavector b, pavector x, real eps,
+		     uint maxiter, uint kmax)
+{
+  pkrylovwork w;
+  uint      iter;
+
+  w = alloc_krylovwork(x->dim, kmax, false, false);
+  iter = solve_pgmres_work_avector(w, A, addeval_A, prcd, pdata, b, x, eps,
+				   maxiter);
+  del_krylovwork(w);
 
   return iter;
 }
@@ -369,3 +481,1704 @@ solve_pgmres_dh2matrix_avector(pcdh2matrix A, prcd_t prcd, void *pdata,
 			      (addeval_t) addeval_dh2matrix_avector, prcd,
 			      pdata, b, x, eps, maxiter, kmax);
 }
+
+/* ------------------------------------------------------------
+ * Flexible generalized minimal residual method
+ * ------------------------------------------------------------ */
+
+uint
+solve_fgmres_work_avector(pkrylovwork w, void *A, addeval_t addeval_A,
+			  prcd_t prcd, void *pdata, pcavector b, pavector x,
+			  real eps, uint maxiter)
+{
+  pavector  rhat, q, tau;
+  pamatrix  qr, z;
+  real      norm, error;
+  uint      iter, k, kmax;
+
+  assert(x->dim == w->n);
+  assert(b->dim == w->n);
+  assert(w->z.cols == w->kmax);
+
+  kmax = w->kmax;
+  rhat = &w->rhat;
+  q = w->v;
+  qr = &w->qr;
+  tau = &w->tau;
+  z = &w->z;
+
+  norm = norm2_avector(b);
+
+  init_fgmres(addeval_A, A, prcd, pdata, b, x, rhat, q, &k, qr, tau, z);
+  error = residualnorm_fgmres(rhat, k);
+
+  iter = 0;
+  while (error > eps * norm && iter + 1 != maxiter) {
+    if (k + 1 >= kmax) {
+      finish_fgmres(addeval_A, A, prcd, pdata, b, x, rhat, q, &k, qr, tau,
+		    z);
+    }
+
+    step_fgmres(addeval_A, A, prcd, pdata, b, x, rhat, q, &k, qr, tau, z);
+    error = residualnorm_fgmres(rhat, k);
+
+    iter++;
+  }
+
+  if (k > 0)
+    finish_fgmres(addeval_A, A, prcd, pdata, b, x, rhat, q, &k, qr, tau, z);
+
+  return iter;
+}
+
+uint
+solve_fgmres_avector(void *A, addeval_t addeval_A, prcd_t prcd,
+		     void *pdata, pcavector b, pavector x, real eps,
+		     uint maxiter, uint kmax)
+{
+  pkrylovwork w;
+  uint      iter;
+
+  w = alloc_krylovwork(x->dim, kmax, true, false);
+  iter = solve_fgmres_work_avector(w, A, addeval_A, prcd, pdata, b, x, eps,
+				   maxiter);
+  del_krylovwork(w);
+
+  return iter;
+}
+
+uint
+solve_fgmres_amatrix_avector(pcamatrix A, prcd_t prcd, void *pdata,
+			     pcavector b, pavector x, real eps, uint maxiter,
+			     uint kmax)
+{
+  return solve_fgmres_avector((void *) A, (addeval_t) addeval_amatrix_avector,
+			      prcd, pdata, b, x, eps, maxiter, kmax);
+}
+
+uint
+solve_fgmres_sparsematrix_avector(pcsparsematrix A, prcd_t prcd, void *pdata,
+				  pcavector b, pavector x, real eps,
+				  uint maxiter, uint kmax)
+{
+  return solve_fgmres_avector((void *) A,
+			      (addeval_t) addeval_sparsematrix_avector, prcd,
+			      pdata, b, x, eps, maxiter, kmax);
+}
+
+uint
+solve_fgmres_hmatrix_avector(pchmatrix A, prcd_t prcd, void *pdata,
+			     pcavector b, pavector x, real eps, uint maxiter,
+			     uint kmax)
+{
+  return solve_fgmres_avector((void *) A, (addeval_t) addeval_hmatrix_avector,
+			      prcd, pdata, b, x, eps, maxiter, kmax);
+}
+
+uint
+solve_fgmres_h2matrix_avector(pch2matrix A, prcd_t prcd, void *pdata,
+			      pcavector b, pavector x, real eps, uint maxiter,
+			      uint kmax)
+{
+  return solve_fgmres_avector((void *) A,
+			      (addeval_t) addeval_h2matrix_avector, prcd,
+			      pdata, b, x, eps, maxiter, kmax);
+}
+
+uint
+solve_fgmres_dh2matrix_avector(pcdh2matrix A, prcd_t prcd, void *pdata,
+			       pcavector b, pavector x, real eps,
+			       uint maxiter, uint kmax)
+{
+  return solve_fgmres_avector((void *) A,
+			      (addeval_t) addeval_dh2matrix_avector, prcd,
+			      pdata, b, x, eps, maxiter, kmax);
+}
+
+/* ------------------------------------------------------------
+ * Biconjugate gradient method
+ * ------------------------------------------------------------ */
+
+uint
+solve_bicg_avector(void *A, addeval_t addeval_A, addeval_t addevaltrans_A,
+		   pcavector b, pavector x, real eps, uint maxiter)
+{
+  pavector  r, rt, p, pt, a, at;
+  real      norm, error;
+  uint      n, iter;
+
+  n = x->dim;
+
+  assert(b->dim == n);
+
+  r = new_avector(n);
+  rt = new_avector(n);
+  p = new_avector(n);
+  pt = new_avector(n);
+  a = new_avector(n);
+  at = new_avector(n);
+
+  norm = norm2_avector(b);
+
+  init_bicg(addeval_A, addevaltrans_A, A, b, x, r, rt, p, pt, a, at);
+  error = norm2_avector(r);
+
+  iter = 0;
+  while (error > eps * norm && iter + 1 != maxiter) {
+    step_bicg(addeval_A, addevaltrans_A, A, b, x, r, rt, p, pt, a, at);
+    error = norm2_avector(r);
+
+    iter++;
+  }
+
+  del_avector(at);
+  del_avector(a);
+  del_avector(pt);
+  del_avector(p);
+  del_avector(rt);
+  del_avector(r);
+
+  return iter;
+}
+
+uint
+solve_bicg_amatrix_avector(pcamatrix A, pcavector b, pavector x, real eps,
+			   uint maxiter)
+{
+  return solve_bicg_avector((void *) A, (addeval_t) addeval_amatrix_avector,
+			    (addeval_t) addevaltrans_amatrix_avector, b, x,
+			    eps, maxiter);
+}
+
+uint
+solve_bicg_sparsematrix_avector(pcsparsematrix A, pcavector b, pavector x,
+				real eps, uint maxiter)
+{
+  return solve_bicg_avector((void *) A,
+			    (addeval_t) addeval_sparsematrix_avector,
+			    (addeval_t) addevaltrans_sparsematrix_avector, b,
+			    x, eps, maxiter);
+}
+
+uint
+solve_bicg_hmatrix_avector(pchmatrix A, pcavector b, pavector x, real eps,
+			   uint maxiter)
+{
+  return solve_bicg_avector((void *) A, (addeval_t) addeval_hmatrix_avector,
+			    (addeval_t) addevaltrans_hmatrix_avector, b, x,
+			    eps, maxiter);
+}
+
+uint
+solve_bicg_h2matrix_avector(pch2matrix A, pcavector b, pavector x, real eps,
+			    uint maxiter)
+{
+  return solve_bicg_avector((void *) A, (addeval_t) addeval_h2matrix_avector,
+			    (addeval_t) addevaltrans_h2matrix_avector, b, x,
+			    eps, maxiter);
+}
+
+uint
+solve_bicg_dh2matrix_avector(pcdh2matrix A, pcavector b, pavector x, real eps,
+			     uint maxiter)
+{
+  return solve_bicg_avector((void *) A, (addeval_t) addeval_dh2matrix_avector,
+			    (addeval_t) addevaltrans_dh2matrix_avector, b, x,
+			    eps, maxiter);
+}
+
+/* ------------------------------------------------------------
+ * Stabilized biconjugate gradient method
+ * ------------------------------------------------------------ */
+
+uint
+solve_bicgstab_work_avector(pkrylovwork w, void *A, addeval_t addeval_A,
+			    pcavector b, pavector x, real eps, uint maxiter)
+{
+  pavector  r, rt, p, a, as;
+  real      norm, error;
+  uint      iter;
+
+  assert(x->dim == w->n);
+  assert(b->dim == w->n);
+
+  r = w->v;
+  rt = w->v + 1;
+  p = w->v + 2;
+  a = w->v + 3;
+  as = w->v + 4;
+
+  norm = norm2_avector(b);
+
+  init_bicgstab(addeval_A, A, b, x, r, rt, p, a, as);
+  error = norm2_avector(r);
+
+  iter = 0;
+  while (error > eps * norm && iter + 1 != maxiter) {
+    step_bicgstab(addeval_A, A, b, x, r, rt, p, a, as);
+    error = norm2_avector(r);
+
+    iter++;
+  }
+
+  return iter;
+}
+
+uint
+solve_bicgstab_avector(void *A, addeval_t addeval_A, pcavector b,
+		       pavector x, real eps, uint maxiter)
+{
+  pkrylovwork w;
+  uint      iter;
+
+  w = alloc_krylovwork(x->dim, 0, false, false);
+  iter = solve_bicgstab_work_avector(w, A, addeval_A, b, x, eps, maxiter);
+  del_krylovwork(w);
+
+  return iter;
+}
+
+uint
+solve_bicgstab_amatrix_avector(pcamatrix A, pcavector b, pavector x, real eps,
+			       uint maxiter)
+{
+  return solve_bicgstab_avector((void *) A,
+				(addeval_t) addeval_amatrix_avector, b, x,
+				eps, maxiter);
+}
+
+uint
+solve_bicgstab_sparsematrix_avector(pcsparsematrix A, pcavector b, pavector x,
+				    real eps, uint maxiter)
+{
+  return solve_bicgstab_avector((void *) A,
+				(addeval_t) addeval_sparsematrix_avector, b,
+				x, eps, maxiter);
+}
+
+uint
+solve_bicgstab_hmatrix_avector(pchmatrix A, pcavector b, pavector x, real eps,
+			       uint maxiter)
+{
+  return solve_bicgstab_avector((void *) A,
+				(addeval_t) addeval_hmatrix_avector, b, x,
+				eps, maxiter);
+}
+
+uint
+solve_bicgstab_h2matrix_avector(pch2matrix A, pcavector b, pavector x,
+				real eps, uint maxiter)
+{
+  return solve_bicgstab_avector((void *) A,
+				(addeval_t) addeval_h2matrix_avector, b, x,
+				eps, maxiter);
+}
+
+uint
+solve_bicgstab_dh2matrix_avector(pcdh2matrix A, pcavector b, pavector x,
+				 real eps, uint maxiter)
+{
+  return solve_bicgstab_avector((void *) A,
+				(addeval_t) addeval_dh2matrix_avector, b, x,
+				eps, maxiter);
+}
+
+/* ------------------------------------------------------------
+ * Preconditioned stabilized biconjugate gradient method
+ * ------------------------------------------------------------ */
+
+uint
+solve_pbicgstab_work_avector(pkrylovwork w, void *A, addeval_t addeval_A,
+			     prcd_t prcd, void *pdata, pcavector b,
+			     pavector x, real eps, uint maxiter)
+{
+  pavector  r, rt, p, a, as, np, ns;
+  real      norm, error;
+  uint      iter;
+
+  assert(x->dim == w->n);
+  assert(b->dim == w->n);
+
+  r = w->v;
+  rt = w->v + 1;
+  p = w->v + 2;
+  a = w->v + 3;
+  as = w->v + 4;
+  np = w->v + 5;
+  ns = w->v + 6;
+
+  norm = norm2_avector(b);
+
+  init_pbicgstab(addeval_A, A, prcd, pdata, b, x, r, rt, p, a, as, np, ns);
+  error = norm2_avector(r);
+
+  iter = 0;
+  while (error > eps * norm && iter + 1 != maxiter) {
+    step_pbicgstab(addeval_A, A, prcd, pdata, b, x, r, rt, p, a, as, np,
+		   ns);
+    error = norm2_avector(r);
+
+    iter++;
+  }
+
+  return iter;
+}
+
+uint
+solve_pbicgstab_avector(void *A, addeval_t addeval_A, prcd_t prcd,
+			void *pdata, pcavector b, pavector x, real eps,
+			uint maxiter)
+{
+  pkrylovwork w;
+  uint      iter;
+
+  w = alloc_krylovwork(x->dim, 0, false, false);
+  iter = solve_pbicgstab_work_avector(w, A, addeval_A, prcd, pdata, b, x,
+				      eps, maxiter);
+  del_krylovwork(w);
+
+  return iter;
+}
+
+uint
+solve_pbicgstab_amatrix_avector(pcamatrix A, prcd_t prcd, void *pdata,
+				pcavector b, pavector x, real eps,
+				uint maxiter)
+{
+  return solve_pbicgstab_avector((void *) A,
+				 (addeval_t) addeval_amatrix_avector, prcd,
+				 pdata, b, x, eps, maxiter);
+}
+
+uint
+solve_pbicgstab_sparsematrix_avector(pcsparsematrix A, prcd_t prcd,
+				     void *pdata, pcavector b, pavector x,
+				     real eps, uint maxiter)
+{
+  return solve_pbicgstab_avector((void *) A,
+				 (addeval_t) addeval_sparsematrix_avector,
+				 prcd, pdata, b, x, eps, maxiter);
+}
+
+uint
+solve_pbicgstab_hmatrix_avector(pchmatrix A, prcd_t prcd, void *pdata,
+				pcavector b, pavector x, real eps,
+				uint maxiter)
+{
+  return solve_pbicgstab_avector((void *) A,
+				 (addeval_t) addeval_hmatrix_avector, prcd,
+				 pdata, b, x, eps, maxiter);
+}
+
+uint
+solve_pbicgstab_h2matrix_avector(pch2matrix A, prcd_t prcd, void *pdata,
+				 pcavector b, pavector x, real eps,
+				 uint maxiter)
+{
+  return solve_pbicgstab_avector((void *) A,
+				 (addeval_t) addeval_h2matrix_avector, prcd,
+				 pdata, b, x, eps, maxiter);
+}
+
+uint
+solve_pbicgstab_dh2matrix_avector(pcdh2matrix A, prcd_t prcd, void *pdata,
+				  pcavector b, pavector x, real eps,
+				  uint maxiter)
+{
+  return solve_pbicgstab_avector((void *) A,
+				 (addeval_t) addeval_dh2matrix_avector, prcd,
+				 pdata, b, x, eps, maxiter);
+}
+
+/* ------------------------------------------------------------
+ * Induced dimension reduction method
+ * ------------------------------------------------------------ */
+
+/* cf. Martin van Gijzen and Peter Sonneveld, Algorithm 913: An elegant
+ * IDR(s) variant that efficiently exploits biorthogonality properties,
+ * with an optional right preconditioner and the residual replacement
+ * strategy "maintaining the convergence" for omega. */
+static    uint
+idrs(void *A, addeval_t addeval_A, prcd_t prcd, void *pdata, pcavector b,
+     pavector x, real eps, uint maxiter, uint s)
+{
+  amatrix   tmp1, tmp2;
+  avector   tmp4, tmp5, tmp6, tmp7;
+  pamatrix  P, G, U, M, Gk, Uk, QR;
+  pavector  r, v, t, f, c, tau, gk, uk, pi, ci, mk;
+  field     d[2];
+  field     alpha, beta, omega, tr;
+  real      norm, error, tnorm, rho;
+  uint      n, iter;
+  uint      i, k;
+
+  n = x->dim;
+
+  assert(b->dim == n);
+  assert(s > 0);
+
+  r = new_avector(n);
+  v = new_avector(n);
+  t = new_avector(n);
+  f = new_avector(s);
+  c = new_avector(s);
+  P = new_amatrix(n, s);
+  G = new_zero_amatrix(n, s);
+  U = new_zero_amatrix(n, s);
+  M = new_identity_amatrix(s, s);
+
+  /* Random orthonormal shadow space */
+  QR = new_amatrix(n, s);
+  random_amatrix(QR);
+  tau = new_avector(s);
+  qrdecomp_amatrix(QR, tau);
+  qrexpand_amatrix(QR, tau, P);
+  del_avector(tau);
+  del_amatrix(QR);
+
+  norm = norm2_avector(b);
+
+  copy_avector(b, r);
+  addeval_A(-1.0, A, x, r);
+  error = norm2_avector(r);
+
+  omega = 1.0;
+
+  iter = 0;
+  while (error > eps * norm && iter + 1 != maxiter) {
+    /* f = P^* r */
+    clear_avector(f);
+    addevaltrans_amatrix_avector(1.0, P, r, f);
+
+    for (k = 0; k < s && error > eps * norm && iter + 1 != maxiter; k++) {
+      /* Solve lower triangular system M(k:s,k:s) c = f(k:s) */
+      Gk = init_sub_amatrix(&tmp1, M, s - k, k, s - k, k);
+      c->dim = s - k;
+      for (i = 0; i < s - k; i++)
+	c->v[i] = f->v[k + i];
+      triangularsolve_amatrix_avector(true, false, false, Gk, c);
+      uninit_amatrix(Gk);
+
+      /* v = N (r - G(:,k:s) c) */
+      copy_avector(r, v);
+      Gk = init_sub_amatrix(&tmp1, G, n, 0, s - k, k);
+      addeval_amatrix_avector(-1.0, Gk, c, v);
+      uninit_amatrix(Gk);
+      if (prcd)
+	prcd(pdata, v);
+
+      /* u_k = U(:,k:s) c + omega v */
+      Uk = init_sub_amatrix(&tmp2, U, n, 0, s - k, k);
+      scale_avector(omega, v);
+      addeval_amatrix_avector(1.0, Uk, c, v);
+      uninit_amatrix(Uk);
+      uk = init_column_avector(&tmp4, U, k);
+      copy_avector(v, uk);
+
+      /* g_k = A u_k */
+      gk = init_column_avector(&tmp5, G, k);
+      clear_avector(gk);
+      addeval_A(1.0, A, uk, gk);
+
+      /* Make g_k orthogonal to p_0, ..., p_{k-1} */
+      for (i = 0; i < k; i++) {
+	pi = init_column_avector(&tmp6, P, i);
+	alpha = dotprod_avector(pi, gk) / M->a[i + i * M->ld];
+	uninit_avector(pi);
+
+	ci = init_column_avector(&tmp6, G, i);
+	add_avector(-alpha, ci, gk);
+	uninit_avector(ci);
+
+	ci = init_column_avector(&tmp6, U, i);
+	add_avector(-alpha, ci, uk);
+	uninit_avector(ci);
+      }
+
+      /* M(k:s,k) = P(:,k:s)^* g_k */
+      Gk = init_sub_amatrix(&tmp1, P, n, 0, s - k, k);
+      mk = init_column_avector(&tmp6, M, k);
+      ci = init_sub_avector(&tmp7, mk, s - k, k);
+      clear_avector(ci);
+      addevaltrans_amatrix_avector(1.0, Gk, gk, ci);
+      uninit_avector(ci);
+      uninit_avector(mk);
+      uninit_amatrix(Gk);
+
+      if (M->a[k + k * M->ld] == 0.0) {
+	uninit_avector(gk);
+	uninit_avector(uk);
+	break;
+      }
+
+      /* Make r orthogonal to p_0, ..., p_k */
+      beta = f->v[k] / M->a[k + k * M->ld];
+      error = addnorm2_avector(-beta, gk, r);
+      add_avector(beta, uk, x);
+
+      uninit_avector(gk);
+      uninit_avector(uk);
+
+      /* Update f = P^* r */
+      for (i = k + 1; i < s; i++)
+	f->v[i] -= beta * M->a[i + k * M->ld];
+
+      iter++;
+    }
+    c->dim = s;
+
+    if (error <= eps * norm || iter + 1 == maxiter)
+      break;
+
+    /* Dimension reduction step, v = N r, t = A v */
+    copy_avector(r, v);
+    if (prcd)
+      prcd(pdata, v);
+    clear_avector(t);
+    addeval_A(1.0, A, v, t);
+
+    dotprod2_avector(t, t, r, d);
+    tnorm = REAL_SQRT(REAL(d[0]));
+    if (tnorm == 0.0)
+      break;
+    tr = d[1];
+    omega = tr / (tnorm * tnorm);
+    rho = ABS(tr) / (tnorm * error);
+    if (rho < 0.7)
+      omega *= 0.7 / rho;
+
+    error = addnorm2_avector(-omega, t, r);
+    add_avector(omega, v, x);
+
+    iter++;
+  }
+
+  del_amatrix(M);
+  del_amatrix(U);
+  del_amatrix(G);
+  del_amatrix(P);
+  del_avector(c);
+  del_avector(f);
+  del_avector(t);
+  del_avector(v);
+  del_avector(r);
+
+  return iter;
+}
+
+uint
+solve_idrs_avector(void *A, addeval_t addeval_A, pcavector b, pavector x,
+		   real eps, uint maxiter, uint s)
+{
+  return idrs(A, addeval_A, NULL, NULL, b, x, eps, maxiter, s);
+}
+
+uint
+solve_idrs_amatrix_avector(pcamatrix A, pcavector b, pavector x, real eps,
+			   uint maxiter, uint s)
+{
+  return solve_idrs_avector((void *) A, (addeval_t) addeval_amatrix_avector,
+			    b, x, eps, maxiter, s);
+}
+
+uint
+solve_idrs_sparsematrix_avector(pcsparsematrix A, pcavector b, pavector x,
+				real eps, uint maxiter, uint s)
+{
+  return solve_idrs_avector((void *) A,
+			    (addeval_t) addeval_sparsematrix_avector, b, x,
+			    eps, maxiter, s);
+}
+
+uint
+solve_idrs_hmatrix_avector(pchmatrix A, pcavector b, pavector x, real eps,
+			   uint maxiter, uint s)
+{
+  return solve_idrs_avector((void *) A, (addeval_t) addeval_hmatrix_avector,
+			    b, x, eps, maxiter, s);
+}
+
+uint
+solve_idrs_h2matrix_avector(pch2matrix A, pcavector b, pavector x, real eps,
+			    uint maxiter, uint s)
+{
+  return solve_idrs_avector((void *) A, (addeval_t) addeval_h2matrix_avector,
+			    b, x, eps, maxiter, s);
+}
+
+uint
+solve_idrs_dh2matrix_avector(pcdh2matrix A, pcavector b, pavector x, real eps,
+			     uint maxiter, uint s)
+{
+  return solve_idrs_avector((void *) A, (addeval_t) addeval_dh2matrix_avector,
+			    b, x, eps, maxiter, s);
+}
+
+uint
+solve_pidrs_avector(void *A, addeval_t addeval_A, prcd_t prcd, void *pdata,
+		    pcavector b, pavector x, real eps, uint maxiter, uint s)
+{
+  return idrs(A, addeval_A, prcd, pdata, b, x, eps, maxiter, s);
+}
+
+uint
+solve_pidrs_amatrix_avector(pcamatrix A, prcd_t prcd, void *pdata,
+			    pcavector b, pavector x, real eps, uint maxiter,
+			    uint s)
+{
+  return solve_pidrs_avector((void *) A, (addeval_t) addeval_amatrix_avector,
+			     prcd, pdata, b, x, eps, maxiter, s);
+}
+
+uint
+solve_pidrs_sparsematrix_avector(pcsparsematrix A, prcd_t prcd, void *pdata,
+				 pcavector b, pavector x, real eps,
+				 uint maxiter, uint s)
+{
+  return solve_pidrs_avector((void *) A,
+			     (addeval_t) addeval_sparsematrix_avector, prcd,
+			     pdata, b, x, eps, maxiter, s);
+}
+
+uint
+solve_pidrs_hmatrix_avector(pchmatrix A, prcd_t prcd, void *pdata,
+			    pcavector b, pavector x, real eps, uint maxiter,
+			    uint s)
+{
+  return solve_pidrs_avector((void *) A, (addeval_t) addeval_hmatrix_avector,
+			     prcd, pdata, b, x, eps, maxiter, s);
+}
+
+uint
+solve_pidrs_h2matrix_avector(pch2matrix A, prcd_t prcd, void *pdata,
+			     pcavector b, pavector x, real eps, uint maxiter,
+			     uint s)
+{
+  return solve_pidrs_avector((void *) A, (addeval_t) addeval_h2matrix_avector,
+			     prcd, pdata, b, x, eps, maxiter, s);
+}
+
+uint
+solve_pidrs_dh2matrix_avector(pcdh2matrix A, prcd_t prcd, void *pdata,
+			      pcavector b, pavector x, real eps, uint maxiter,
+			      uint s)
+{
+  return solve_pidrs_avector((void *) A,
+			     (addeval_t) addeval_dh2matrix_avector, prcd,
+			     pdata, b, x, eps, maxiter, s);
+}
+
+/* ------------------------------------------------------------
+ * Pipelined conjugate gradients method
+ * ------------------------------------------------------------ */
+
+/* Number of steps between residual replacements */
+#define PIPECG_REPLACE 50
+
+uint
+solve_pipecg_avector(void *A, addeval_t addeval_A, prcd_t prcd, void *pdata,
+		     pcavector b, pavector x, real eps, uint maxiter)
+{
+  pavector  r, u, w, p, s, q, z, m, nv;
+  field     gamma, alpha;
+  real      norm, error;
+  uint      n, iter;
+
+  n = x->dim;
+
+  assert(b->dim == n);
+
+  r = new_avector(n);
+  u = new_avector(n);
+  w = new_avector(n);
+  p = new_avector(n);
+  s = new_avector(n);
+  q = new_avector(n);
+  z = new_avector(n);
+  m = new_avector(n);
+  nv = new_avector(n);
+
+  norm = norm2_avector(b);
+
+  init_pipecg(addeval_A, A, prcd, pdata, b, x, r, u, w, p, s, q, z, m, nv,
+	      &gamma, &alpha);
+  error = norm2_avector(r);
+
+  /* The residual norm is obtained from the fused reduction and lags
+   * one step behind. Since the recursive residual drifts away from
+   * b - A x, it is replaced periodically and before convergence is
+   * accepted. */
+  iter = 0;
+  while (error > eps * norm && iter + 1 != maxiter) {
+    error = step_pipecg(addeval_A, A, prcd, pdata, b, x, r, u, w, p, s, q, z,
+			m, nv, &gamma, &alpha);
+
+    iter++;
+
+    if (error <= eps * norm || iter % PIPECG_REPLACE == 0)
+      error = replace_pipecg(addeval_A, A, prcd, pdata, b, x, r, u, w, p, s,
+			     q, z);
+  }
+
+  del_avector(nv);
+  del_avector(m);
+  del_avector(z);
+  del_avector(q);
+  del_avector(s);
+  del_avector(p);
+  del_avector(w);
+  del_avector(u);
+  del_avector(r);
+
+  return iter;
+}
+
+uint
+solve_pipecg_amatrix_avector(pcamatrix A, prcd_t prcd, void *pdata,
+			     pcavector b, pavector x, real eps, uint maxiter)
+{
+  return solve_pipecg_avector((void *) A, (addeval_t) addeval_amatrix_avector,
+			      prcd, pdata, b, x, eps, maxiter);
+}
+
+uint
+solve_pipecg_sparsematrix_avector(pcsparsematrix A, prcd_t prcd, void *pdata,
+				  pcavector b, pavector x, real eps,
+				  uint maxiter)
+{
+  return solve_pipecg_avector((void *) A,
+			      (addeval_t) addeval_sparsematrix_avector, prcd,
+			      pdata, b, x, eps, maxiter);
+}
+
+uint
+solve_pipecg_hmatrix_avector(pchmatrix A, prcd_t prcd, void *pdata,
+			     pcavector b, pavector x, real eps, uint maxiter)
+{
+  return solve_pipecg_avector((void *) A, (addeval_t) addeval_hmatrix_avector,
+			      prcd, pdata, b, x, eps, maxiter);
+}
+
+uint
+solve_pipecg_h2matrix_avector(pch2matrix A, prcd_t prcd, void *pdata,
+			      pcavector b, pavector x, real eps, uint maxiter)
+{
+  return solve_pipecg_avector((void *) A,
+			      (addeval_t) addeval_h2matrix_avector, prcd,
+			      pdata, b, x, eps, maxiter);
+}
+
+uint
+solve_pipecg_dh2matrix_avector(pcdh2matrix A, prcd_t prcd, void *pdata,
+			       pcavector b, pavector x, real eps,
+			       uint maxiter)
+{
+  return solve_pipecg_avector((void *) A,
+			      (addeval_t) addeval_dh2matrix_avector, prcd,
+			      pdata, b, x, eps, maxiter);
+}
+
+/* ------------------------------------------------------------
+ * s-step generalized minimal residual method
+ * ------------------------------------------------------------ */
+
+/* y = N A x */
+static void
+apply_sgmres(void *A, addeval_t addeval_A, prcd_t prcd, void *pdata,
+	     pcavector x, pavector y)
+{
+  clear_avector(y);
+  addeval_A(1.0, A, x, y);
+  if (prcd)
+    prcd(pdata, y);
+}
+
+/* Orthonormalize the new basis vectors V = Q(:,k+1:k+s) against the
+ * previous ones Q(:,0:k+1) by two passes of block Gram-Schmidt and a
+ * Cholesky QR, V = Q(:,0:k+1) C + V R. The Gram matrix of the second
+ * pass is obtained by the same reduction as the projection coefficients.
+ * Falls back to a Householder QR if the Cholesky factorization fails. */
+static void
+orthonormalize_sgmres(pamatrix Q, uint k, uint s, pamatrix C, pamatrix R)
+{
+  amatrix   tmp1, tmp2, tmp3, tmp4, tmp5, tmp6;
+  pamatrix  Qo, Qa, V, Z, Zc, Zg, QR;
+  pavector  tau;
+  uint      n, i, j, info;
+
+  n = Q->rows;
+
+  Qo = init_sub_amatrix(&tmp1, Q, n, 0, k + 1, 0);
+  Qa = init_sub_amatrix(&tmp2, Q, n, 0, k + 1 + s, 0);
+  V = init_sub_amatrix(&tmp3, Q, n, 0, s, k + 1);
+
+  /* First pass, C = Q_o^* V, V = V - Q_o C */
+  clear_amatrix(C);
+  addmul_amatrix(1.0, true, Qo, false, V, C);
+  addmul_amatrix(-1.0, false, Qo, false, C, V);
+
+  /* Second pass, one reduction yields C2 = Q_o^* V and G = V^* V */
+  Z = new_zero_amatrix(k + 1 + s, s);
+  addmul_amatrix(1.0, true, Qa, false, V, Z);
+  Zc = init_sub_amatrix(&tmp4, Z, k + 1, 0, s, 0);
+  Zg = init_sub_amatrix(&tmp5, Z, s, k + 1, s, 0);
+  addmul_amatrix(-1.0, false, Qo, false, Zc, V);
+  add_amatrix(1.0, false, Zc, C);
+
+  /* G - C2^* C2 is the Gram matrix of the updated V */
+  addmul_amatrix(-1.0, true, Zc, false, Zc, Zg);
+  info = choldecomp_amatrix(Zg);
+
+  clear_amatrix(R);
+  if (info == 0) {
+    for (j = 0; j < s; j++)
+      for (i = 0; i <= j; i++)
+	R->a[i + j * R->ld] = CONJ(Zg->a[j + i * Zg->ld]);
+    triangularsolve_amatrix(false, false, true, R, true, V);
+  }
+  else {
+    QR = init_amatrix(&tmp6, n, s);
+    copy_amatrix(false, V, QR);
+    tau = new_avector(s);
+    qrdecomp_amatrix(QR, tau);
+    for (j = 0; j < s; j++)
+      for (i = 0; i <= j; i++)
+	R->a[i + j * R->ld] = QR->a[i + j * QR->ld];
+    qrexpand_amatrix(QR, tau, V);
+    del_avector(tau);
+    uninit_amatrix(QR);
+  }
+
+  uninit_amatrix(Zg);
+  uninit_amatrix(Zc);
+  del_amatrix(Z);
+  uninit_amatrix(V);
+  uninit_amatrix(Qa);
+  uninit_amatrix(Qo);
+}
+
+static uint
+sgmres(void *A, addeval_t addeval_A, prcd_t prcd, void *pdata, pcavector b,
+       pavector x, real eps, uint maxiter, uint kmax, uint sstep)
+{
+  avector   tmp1, tmp2;
+  amatrix   tmp3, tmp4, tmp5, tmp6;
+  pamatrix  Q, H, T, C, R, M, Bb, Ck, Hk, Mk, Ct;
+  pavector  r, v, w, rhat, tau;
+  real      norm, error, beta, sigma;
+  uint      n, k, iter, i, j;
+
+  n = x->dim;
+
+  assert(b->dim == n);
+
+  if (sstep > kmax)
+    sstep = kmax;
+  assert(sstep > 0);
+
+  Q = new_amatrix(n, kmax + 1);
+  H = new_amatrix(kmax + 1, kmax);
+  T = new_amatrix(kmax + 1, kmax);
+  C = new_amatrix(kmax + 1, sstep);
+  R = new_amatrix(sstep, sstep);
+  M = new_amatrix(kmax + 1, sstep);
+  Bb = new_amatrix(sstep, sstep);
+  r = new_avector(n);
+  rhat = new_avector(kmax + 1);
+  tau = new_avector(kmax);
+
+  /* Norm of the (preconditioned) right-hand side */
+  copy_avector(b, r);
+  if (prcd)
+    prcd(pdata, r);
+  norm = norm2_avector(r);
+
+  sigma = 0.0;
+  iter = 0;
+  for (;;) {
+    /* r = N (b - A x) */
+    copy_avector(b, r);
+    addeval_A(-1.0, A, x, r);
+    if (prcd)
+      prcd(pdata, r);
+    beta = norm2_avector(r);
+
+    if (beta <= eps * norm || (maxiter > 0 && iter >= maxiter))
+      break;
+
+    v = init_column_avector(&tmp1, Q, 0);
+    copy_avector(r, v);
+    scale_avector(1.0 / beta, v);
+
+    /* Fixed scaling of the monomial basis, avoids reductions between
+     * the products */
+    if (sigma == 0.0) {
+      apply_sgmres(A, addeval_A, prcd, pdata, v, r);
+      sigma = norm2_avector(r);
+      if (sigma == 0.0)
+	sigma = 1.0;
+    }
+    uninit_avector(v);
+
+    clear_amatrix(H);
+    k = 0;
+    error = beta;
+
+    while (error > eps * norm && k + sstep <= kmax
+	   && (maxiter == 0 || iter < maxiter)) {
+      /* Monomial basis N A q_k / sigma, (N A / sigma)^2 q_k, ... */
+      for (j = 0; j < sstep; j++) {
+	v = init_column_avector(&tmp1, Q, k + j);
+	w = init_column_avector(&tmp2, Q, k + j + 1);
+	apply_sgmres(A, addeval_A, prcd, pdata, v, w);
+	scale_avector(1.0 / sigma, w);
+	uninit_avector(w);
+	uninit_avector(v);
+      }
+
+      /* Orthonormalization of the entire block */
+      Ck = init_sub_amatrix(&tmp3, C, k + 1, 0, sstep, 0);
+      orthonormalize_sgmres(Q, k, sstep, Ck, R);
+
+      /* Change of basis, the Hessenberg columns k,...,k+s-1 are
+       * (sigma [C; R] - [H_old B_top; 0]) B_bot^{-1} */
+      Mk = init_sub_amatrix(&tmp4, M, k + sstep + 1, 0, sstep, 0);
+      clear_amatrix(Mk);
+      for (j = 0; j < sstep; j++) {
+	for (i = 0; i <= k; i++)
+	  Mk->a[i + j * Mk->ld] = sigma * Ck->a[i + j * Ck->ld];
+	for (i = 0; i <= j; i++)
+	  Mk->a[k + 1 + i + j * Mk->ld] = sigma * R->a[i + j * R->ld];
+      }
+
+      if (k > 0 && sstep > 1) {
+	/* B_top = [0, C(0:k,0:s-1)] */
+	Hk = init_sub_amatrix(&tmp5, H, k + 1, 0, k, 0);
+	Ct = init_sub_amatrix(&tmp6, C, k, 0, sstep - 1, 0);
+	uninit_amatrix(Mk);
+	Mk = init_sub_amatrix(&tmp4, M, k + 1, 0, sstep - 1, 1);
+	addmul_amatrix(-1.0, false, Hk, false, Ct, Mk);
+	uninit_amatrix(Mk);
+	uninit_amatrix(Ct);
+	uninit_amatrix(Hk);
+	Mk = init_sub_amatrix(&tmp4, M, k + sstep + 1, 0, sstep, 0);
+      }
+
+      /* B_bot = [e_0, (C(k,j-1); R(0:s-1,j-1))] */
+      clear_amatrix(Bb);
+      Bb->a[0] = 1.0;
+      for (j = 1; j < sstep; j++) {
+	Bb->a[j * Bb->ld] = Ck->a[k + (j - 1) * Ck->ld];
+	for (i = 1; i <= j; i++)
+	  Bb->a[i + j * Bb->ld] = R->a[(i - 1) + (j - 1) * R->ld];
+      }
+      triangularsolve_amatrix(false, false, true, Bb, true, Mk);
+
+      Hk = init_sub_amatrix(&tmp5, H, k + sstep + 1, 0, sstep, k);
+      copy_amatrix(false, Mk, Hk);
+      uninit_amatrix(Hk);
+      uninit_amatrix(Mk);
+      uninit_amatrix(Ck);
+
+      k += sstep;
+      iter += sstep;
+
+      /* Least-squares problem min |beta e_0 - H y| */
+      Hk = init_sub_amatrix(&tmp5, T, k + 1, 0, k, 0);
+      copy_sub_amatrix(false, H, Hk);
+      qrdecomp_amatrix(Hk, tau);
+      v = init_sub_avector(&tmp1, rhat, k + 1, 0);
+      clear_avector(v);
+      v->v[0] = beta;
+      qreval_amatrix_avector(true, Hk, tau, v);
+      error = ABS(v->v[k]);
+      uninit_avector(v);
+      uninit_amatrix(Hk);
+    }
+
+    if (k == 0)
+      break;
+
+    /* x = x + Q y */
+    Hk = init_sub_amatrix(&tmp5, T, k, 0, k, 0);
+    v = init_sub_avector(&tmp1, rhat, k, 0);
+    triangularsolve_amatrix_avector(false, false, false, Hk, v);
+    Mk = init_sub_amatrix(&tmp4, Q, n, 0, k, 0);
+    addeval_amatrix_avector(1.0, Mk, v, x);
+    uninit_amatrix(Mk);
+    uninit_avector(v);
+    uninit_amatrix(Hk);
+  }
+
+  del_avector(tau);
+  del_avector(rhat);
+  del_avector(r);
+  del_amatrix(Bb);
+  del_amatrix(M);
+  del_amatrix(R);
+  del_amatrix(C);
+  del_amatrix(T);
+  del_amatrix(H);
+  del_amatrix(Q);
+
+  return iter;
+}
+
+uint
+solve_sgmres_avector(void *A, addeval_t addeval_A, pcavector b, pavector x,
+		     real eps, uint maxiter, uint kmax, uint sstep)
+{
+  return sgmres(A, addeval_A, NULL, NULL, b, x, eps, maxiter, kmax, sstep);
+}
+
+uint
+solve_sgmres_amatrix_avector(pcamatrix A, pcavector b, pavector x, real eps,
+			     uint maxiter, uint kmax, uint sstep)
+{
+  return solve_sgmres_avector((void *) A, (addeval_t) addeval_amatrix_avector,
+			      b, x, eps, maxiter, kmax, sstep);
+}
+
+uint
+solve_sgmres_sparsematrix_avector(pcsparsematrix A, pcavector b, pavector x,
+				  real eps, uint maxiter, uint kmax,
+				  uint sstep)
+{
+  return solve_sgmres_avector((void *) A,
+			      (addeval_t) addeval_sparsematrix_avector, b, x,
+			      eps, maxiter, kmax, sstep);
+}
+
+uint
+solve_sgmres_hmatrix_avector(pchmatrix A, pcavector b, pavector x, real eps,
+			     uint maxiter, uint kmax, uint sstep)
+{
+  return solve_sgmres_avector((void *) A, (addeval_t) addeval_hmatrix_avector,
+			      b, x, eps, maxiter, kmax, sstep);
+}
+
+uint
+solve_sgmres_h2matrix_avector(pch2matrix A, pcavector b, pavector x, real eps,
+			      uint maxiter, uint kmax, uint sstep)
+{
+  return solve_sgmres_avector((void *) A,
+			      (addeval_t) addeval_h2matrix_avector, b, x, eps,
+			      maxiter, kmax, sstep);
+}
+
+uint
+solve_sgmres_dh2matrix_avector(pcdh2matrix A, pcavector b, pavector x,
+			       real eps, uint maxiter, uint kmax, uint sstep)
+{
+  return solve_sgmres_avector((void *) A,
+			      (addeval_t) addeval_dh2matrix_avector, b, x,
+			      eps, maxiter, kmax, sstep);
+}
+
+uint
+solve_psgmres_avector(void *A, addeval_t addeval_A, prcd_t prcd, void *pdata,
+		      pcavector b, pavector x, real eps, uint maxiter,
+		      uint kmax, uint sstep)
+{
+  return sgmres(A, addeval_A, prcd, pdata, b, x, eps, maxiter, kmax, sstep);
+}
+
+uint
+solve_psgmres_amatrix_avector(pcamatrix A, prcd_t prcd, void *pdata,
+			      pcavector b, pavector x, real eps, uint maxiter,
+			      uint kmax, uint sstep)
+{
+  return solve_psgmres_avector((void *) A,
+			       (addeval_t) addeval_amatrix_avector, prcd,
+			       pdata, b, x, eps, maxiter, kmax, sstep);
+}
+
+uint
+solve_psgmres_sparsematrix_avector(pcsparsematrix A, prcd_t prcd, void *pdata,
+				   pcavector b, pavector x, real eps,
+				   uint maxiter, uint kmax, uint sstep)
+{
+  return solve_psgmres_avector((void *) A,
+			       (addeval_t) addeval_sparsematrix_avector, prcd,
+			       pdata, b, x, eps, maxiter, kmax, sstep);
+}
+
+uint
+solve_psgmres_hmatrix_avector(pchmatrix A, prcd_t prcd, void *pdata,
+			      pcavector b, pavector x, real eps, uint maxiter,
+			      uint kmax, uint sstep)
+{
+  return solve_psgmres_avector((void *) A,
+			       (addeval_t) addeval_hmatrix_avector, prcd,
+			       pdata, b, x, eps, maxiter, kmax, sstep);
+}
+
+uint
+solve_psgmres_h2matrix_avector(pch2matrix A, prcd_t prcd, void *pdata,
+			       pcavector b, pavector x, real eps,
+			       uint maxiter, uint kmax, uint sstep)
+{
+  return solve_psgmres_avector((void *) A,
+			       (addeval_t) addeval_h2matrix_avector, prcd,
+			       pdata, b, x, eps, maxiter, kmax, sstep);
+}
+
+uint
+solve_psgmres_dh2matrix_avector(pcdh2matrix A, prcd_t prcd, void *pdata,
+				pcavector b, pavector x, real eps,
+				uint maxiter, uint kmax, uint sstep)
+{
+  return solve_psgmres_avector((void *) A,
+			       (addeval_t) addeval_dh2matrix_avector, prcd,
+			       pdata, b, x, eps, maxiter, kmax, sstep);
+}
+
+/* ------------------------------------------------------------
+ * Block matrix callbacks
+ * ------------------------------------------------------------ */
+
+void
+addevalblock_amatrix(field alpha, pcamatrix A, pcamatrix X, pamatrix Y)
+{
+  mvmblock_amatrix(alpha, false, A, X, Y);
+}
+
+void
+addevalblock_hmatrix(field alpha, pchmatrix A, pcamatrix X, pamatrix Y)
+{
+  mvmblock_hmatrix(alpha, false, A, X, Y);
+}
+
+void
+addevalblock_h2matrix(field alpha, pch2matrix A, pcamatrix X, pamatrix Y)
+{
+  mvmblock_h2matrix(alpha, false, A, X, Y);
+}
+
+void
+addevalblock_dh2matrix(field alpha, pcdh2matrix A, pcamatrix X, pamatrix Y)
+{
+  mvmblock_dh2matrix(alpha, false, A, X, Y);
+}
+
+/* ------------------------------------------------------------
+ * Auxiliary routines for block methods
+ * ------------------------------------------------------------ */
+
+/* Relative tolerance for dropping linearly dependent block directions */
+#define BLOCK_DROPTOL 1.0e-12
+
+/* Orthonormalize the columns of W by a pivoted QR decomposition,
+ * W = Q S. The first columns of W are overwritten by Q, directions
+ * below the drop tolerance are discarded. If S is not null, it
+ * receives the coefficients in its first rows.
+ * Returns the number of remaining directions. */
+static uint
+orthonormalize_block(pamatrix W, pamatrix S)
+{
+  amatrix   tmp1, tmp2;
+  pamatrix  QR, Q;
+  pavector  tau;
+  uint     *colpiv;
+  real      rmax;
+  uint      refl, k, i, j;
+
+  if (W->cols == 0)
+    return 0;
+
+  QR = init_amatrix(&tmp1, W->rows, W->cols);
+  copy_amatrix(false, W, QR);
+  tau = new_avector(W->cols);
+  colpiv = allocuint(W->cols);
+
+  refl = qrdecomp_pivot_amatrix(QR, tau, colpiv);
+
+  /* Determine the numerical rank */
+  rmax = ABS(QR->a[0]);
+  k = 0;
+  while (k < refl && ABS(QR->a[k + k * QR->ld]) > BLOCK_DROPTOL * rmax)
+    k++;
+
+  if (k > 0) {
+    Q = init_sub_amatrix(&tmp2, W, W->rows, 0, k, 0);
+    tau->dim = k;
+    qrexpand_amatrix(QR, tau, Q);
+    uninit_amatrix(Q);
+  }
+
+  /* Coefficients with respect to the original column order */
+  if (S) {
+    assert(S->rows >= k);
+    assert(S->cols == W->cols);
+
+    for (j = 0; j < W->cols; j++) {
+      for (i = 0; i < k && i <= j; i++)
+	S->a[i + colpiv[j] * S->ld] = QR->a[i + j * QR->ld];
+      for (; i < k; i++)
+	S->a[i + colpiv[j] * S->ld] = 0.0;
+    }
+  }
+
+  freemem(colpiv);
+  del_avector(tau);
+  uninit_amatrix(QR);
+
+  return k;
+}
+
+/* Exchange the columns j and l of R */
+static void
+swap_columns(pamatrix R, uint j, uint l)
+{
+  field     h;
+  uint      i;
+
+  if (j == l)
+    return;
+
+  for (i = 0; i < R->rows; i++) {
+    h = R->a[i + j * R->ld];
+    R->a[i + j * R->ld] = R->a[i + l * R->ld];
+    R->a[i + l * R->ld] = h;
+  }
+}
+
+/* Move converged columns of the active block R behind the active ones,
+ * together with the corresponding columns of Z if Z is not null.
+ * perm keeps track of the original column indices.
+ * Returns the number of remaining active columns. */
+static uint
+deflate_block(pamatrix R, pamatrix Z, uint *perm, pcreal bnorm, real eps,
+	      uint na)
+{
+  avector   tmp;
+  pavector  r;
+  uint      j, ip;
+
+  j = 0;
+  while (j < na) {
+    r = init_column_avector(&tmp, R, j);
+    if (norm2_avector(r) <= eps * bnorm[perm[j]]) {
+      uninit_avector(r);
+      na--;
+      swap_columns(R, j, na);
+      if (Z)
+	swap_columns(Z, j, na);
+      ip = perm[j];
+      perm[j] = perm[na];
+      perm[na] = ip;
+    }
+    else {
+      uninit_avector(r);
+      j++;
+    }
+  }
+
+  return na;
+}
+
+/* Xf(:,perm(j)) += alpha (V C)(:,j) for the active columns */
+static void
+addmul_active_columns(field alpha, pcamatrix V, pcamatrix C, const uint *perm,
+	     pamatrix Xf)
+{
+  avector   tmp1, tmp2;
+  pavector  c, x;
+  uint      j;
+
+  for (j = 0; j < C->cols; j++) {
+    c = init_column_avector(&tmp1, (pamatrix) C, j);
+    x = init_column_avector(&tmp2, Xf, perm[j]);
+    addeval_amatrix_avector(alpha, V, c, x);
+    uninit_avector(x);
+    uninit_avector(c);
+  }
+}
+
+/* ------------------------------------------------------------
+ * Block conjugated gradients method
+ * ------------------------------------------------------------ */
+
+uint
+solve_blockcg_amatrix(void *A, addevalblock_t addeval_A, pcamatrix B,
+		      pamatrix X, real eps, uint maxiter)
+{
+  amatrix   tmp1, tmp2, tmp3, tmp4, tmp5, tmp6, tmp7;
+  pamatrix  R, P, Q, G, alpha, beta, Ra, Pa, Qa, Ga, Aa, Ba;
+  avector   vtmp;
+  pavector  b;
+  preal     bnorm;
+  uint     *perm;
+  uint      n, s, na, k, iter, j;
+
+  n = X->rows;
+  s = X->cols;
+
+  assert(B->rows == n);
+  assert(B->cols == s);
+
+  R = new_amatrix(n, s);
+  P = new_amatrix(n, s);
+  Q = new_amatrix(n, s);
+  G = new_amatrix(s, s);
+  alpha = new_amatrix(s, s);
+  beta = new_amatrix(s, s);
+  bnorm = allocreal(s);
+  perm = allocuint(s);
+
+  for (j = 0; j < s; j++) {
+    b = init_column_avector(&vtmp, (pamatrix) B, j);
+    bnorm[j] = norm2_avector(b);
+    uninit_avector(b);
+    perm[j] = j;
+  }
+
+  /* R = B - A X */
+  copy_amatrix(false, B, R);
+  addeval_A(-1.0, A, X, R);
+
+  na = deflate_block(R, NULL, perm, bnorm, eps, s);
+
+  /* P = orth(R) */
+  Ra = init_sub_amatrix(&tmp1, R, n, 0, na, 0);
+  Pa = init_sub_amatrix(&tmp2, P, n, 0, na, 0);
+  copy_amatrix(false, Ra, Pa);
+  k = orthonormalize_block(Pa, NULL);
+  uninit_amatrix(Pa);
+  uninit_amatrix(Ra);
+
+  iter = 0;
+  while (na > 0 && k > 0 && (maxiter == 0 || iter < maxiter)) {
+    Ra = init_sub_amatrix(&tmp1, R, n, 0, na, 0);
+    Pa = init_sub_amatrix(&tmp2, P, n, 0, k, 0);
+    Qa = init_sub_amatrix(&tmp3, Q, n, 0, k, 0);
+    Ga = init_sub_amatrix(&tmp4, G, k, 0, k, 0);
+    Aa = init_sub_amatrix(&tmp5, alpha, k, 0, na, 0);
+    Ba = init_sub_amatrix(&tmp6, beta, k, 0, na, 0);
+
+    /* Q = A P, G = P^* A P */
+    clear_amatrix(Qa);
+    addeval_A(1.0, A, Pa, Qa);
+    clear_amatrix(Ga);
+    addmul_amatrix(1.0, true, Pa, false, Qa, Ga);
+    choldecomp_amatrix(Ga);
+
+    /* alpha = G^{-1} P^* R */
+    clear_amatrix(Aa);
+    addmul_amatrix(1.0, true, Pa, false, Ra, Aa);
+    cholsolve_amatrix(Ga, Aa);
+
+    /* beta = -G^{-1} Q^* (R - Q alpha) after the update of R */
+    addmul_active_columns(1.0, Pa, Aa, perm, X);
+    addmul_amatrix(-1.0, false, Qa, false, Aa, Ra);
+
+    clear_amatrix(Ba);
+    addmul_amatrix(-1.0, true, Qa, false, Ra, Ba);
+    cholsolve_amatrix(Ga, Ba);
+
+    /* P = R + P beta, computed in Q to avoid aliasing */
+    uninit_amatrix(Qa);
+    Qa = init_sub_amatrix(&tmp3, Q, n, 0, na, 0);
+    copy_amatrix(false, Ra, Qa);
+    addmul_amatrix(1.0, false, Pa, false, Ba, Qa);
+
+    /* Deflation of converged columns */
+    na = deflate_block(Ra, Qa, perm, bnorm, eps, na);
+
+    uninit_amatrix(Ba);
+    uninit_amatrix(Aa);
+    uninit_amatrix(Ga);
+    uninit_amatrix(Qa);
+    uninit_amatrix(Pa);
+    uninit_amatrix(Ra);
+
+    /* P = orth(R + P beta) for the remaining active columns */
+    Qa = init_sub_amatrix(&tmp3, Q, n, 0, na, 0);
+    Pa = init_sub_amatrix(&tmp7, P, n, 0, na, 0);
+    copy_amatrix(false, Qa, Pa);
+    k = orthonormalize_block(Pa, NULL);
+    uninit_amatrix(Pa);
+    uninit_amatrix(Qa);
+
+    iter++;
+  }
+
+  freemem(perm);
+  freemem(bnorm);
+  del_amatrix(beta);
+  del_amatrix(alpha);
+  del_amatrix(G);
+  del_amatrix(Q);
+  del_amatrix(P);
+  del_amatrix(R);
+
+  return iter;
+}
+
+uint
+solve_blockcg_amatrix_amatrix(pcamatrix A, pcamatrix B, pamatrix X, real eps,
+			      uint maxiter)
+{
+  return solve_blockcg_amatrix((void *) A,
+			       (addevalblock_t) addevalblock_amatrix, B, X,
+			       eps, maxiter);
+}
+
+uint
+solve_blockcg_sparsematrix_amatrix(pcsparsematrix A, pcamatrix B,
+				   pamatrix X, real eps, uint maxiter)
+{
+  return solve_blockcg_amatrix((void *) A,
+			       (addevalblock_t) addeval_sparsematrix_amatrix,
+			       B, X, eps, maxiter);
+}
+
+uint
+solve_blockcg_hmatrix_amatrix(pchmatrix A, pcamatrix B, pamatrix X, real eps,
+			      uint maxiter)
+{
+  return solve_blockcg_amatrix((void *) A,
+			       (addevalblock_t) addevalblock_hmatrix, B, X,
+			       eps, maxiter);
+}
+
+uint
+solve_blockcg_h2matrix_amatrix(pch2matrix A, pcamatrix B, pamatrix X,
+			       real eps, uint maxiter)
+{
+  return solve_blockcg_amatrix((void *) A,
+			       (addevalblock_t) addevalblock_h2matrix, B, X,
+			       eps, maxiter);
+}
+
+uint
+solve_blockcg_dh2matrix_amatrix(pcdh2matrix A, pcamatrix B, pamatrix X,
+				real eps, uint maxiter)
+{
+  return solve_blockcg_amatrix((void *) A,
+			       (addevalblock_t) addevalblock_dh2matrix, B, X,
+			       eps, maxiter);
+}
+
+/* ------------------------------------------------------------
+ * Block generalized minimal residual method
+ * ------------------------------------------------------------ */
+
+uint
+solve_blockgmres_amatrix(void *A, addevalblock_t addeval_A, pcamatrix B,
+			 pamatrix X, real eps, uint maxiter, uint kmax)
+{
+  amatrix   tmp1, tmp2, tmp3, tmp4, tmp5;
+  pamatrix  V, H, R, Xa, S, T, Y, C;
+  pamatrix  Ra, Xv, Vb, Vn, Hb, Ca, Ta, Ya;
+  avector   vtmp;
+  pavector  b, tau;
+  preal     bnorm;
+  uint     *perm;
+  real      norm;
+  bool      converged;
+  uint      n, s, mcap, na, k0, kn, nb, m, c, iter, i, j;
+
+  n = X->rows;
+  s = X->cols;
+
+  assert(B->rows == n);
+  assert(B->cols == s);
+
+  /* Space for at least one block step, even if kmax < s, so that
+   * every restart cycle counts at least one iteration */
+  mcap = UINT_MAX(kmax, s) + s;
+
+  V = new_amatrix(n, mcap);
+  H = new_amatrix(mcap, mcap);
+  T = new_amatrix(mcap, mcap);
+  Y = new_amatrix(mcap, s);
+  C = new_amatrix(mcap, s);
+  R = new_amatrix(n, s);
+  Xa = new_amatrix(n, s);
+  S = new_amatrix(s, s);
+  tau = new_avector(mcap);
+  bnorm = allocreal(s);
+  perm = allocuint(s);
+
+  for (j = 0; j < s; j++) {
+    b = init_column_avector(&vtmp, (pamatrix) B, j);
+    bnorm[j] = norm2_avector(b);
+    uninit_avector(b);
+    perm[j] = j;
+  }
+  na = s;
+
+  iter = 0;
+  for (;;) {
+    /* R = B - A X for the active columns */
+    for (j = 0; j < na; j++)
+      for (i = 0; i < n; i++) {
+	R->a[i + j * R->ld] = B->a[i + perm[j] * B->ld];
+	Xa->a[i + j * Xa->ld] = X->a[i + perm[j] * X->ld];
+      }
+    Ra = init_sub_amatrix(&tmp1, R, n, 0, na, 0);
+    Xv = init_sub_amatrix(&tmp2, Xa, n, 0, na, 0);
+    addeval_A(-1.0, A, Xv, Ra);
+    uninit_amatrix(Xv);
+
+    /* Converged columns are no longer needed */
+    na = deflate_block(Ra, NULL, perm, bnorm, eps, na);
+    uninit_amatrix(Ra);
+
+    if (na == 0 || (maxiter > 0 && iter >= maxiter))
+      break;
+
+    /* V_0 S = R */
+    Ra = init_sub_amatrix(&tmp1, R, n, 0, na, 0);
+    Vb = init_sub_amatrix(&tmp2, V, n, 0, na, 0);
+    copy_amatrix(false, Ra, Vb);
+    Ya = init_sub_amatrix(&tmp3, S, na, 0, na, 0);
+    k0 = orthonormalize_block(Vb, Ya);
+    uninit_amatrix(Ya);
+    uninit_amatrix(Vb);
+    uninit_amatrix(Ra);
+
+    if (k0 == 0)
+      break;
+
+    clear_amatrix(H);
+    m = k0;
+    c = 0;
+    converged = false;
+
+    while (!converged && m > c && m + (m - c) <= mcap
+	   && (maxiter == 0 || iter < maxiter)) {
+      nb = m - c;
+
+      /* W = A V_c, stored behind the current basis */
+      Vb = init_sub_amatrix(&tmp1, V, n, 0, nb, c);
+      Vn = init_sub_amatrix(&tmp2, V, n, 0, nb, m);
+      clear_amatrix(Vn);
+      addeval_A(1.0, A, Vb, Vn);
+      uninit_amatrix(Vb);
+
+      /* Block Gram-Schmidt, applied twice for stability */
+      Vb = init_sub_amatrix(&tmp1, V, n, 0, m, 0);
+      Hb = init_sub_amatrix(&tmp3, H, m, 0, nb, c);
+      Ca = init_sub_amatrix(&tmp4, C, m, 0, nb, 0);
+      for (i = 0; i < 2; i++) {
+	clear_amatrix(Ca);
+	addmul_amatrix(1.0, true, Vb, false, Vn, Ca);
+	addmul_amatrix(-1.0, false, Vb, false, Ca, Vn);
+	add_amatrix(1.0, false, Ca, Hb);
+      }
+      uninit_amatrix(Ca);
+      uninit_amatrix(Hb);
+      uninit_amatrix(Vb);
+
+      /* Orthonormalize the new block, dependent directions are dropped */
+      Hb = init_sub_amatrix(&tmp3, H, nb, m, nb, c);
+      kn = orthonormalize_block(Vn, Hb);
+      uninit_amatrix(Hb);
+      uninit_amatrix(Vn);
+
+      c = m;
+      m += kn;
+      iter++;
+
+      /* Least-squares problem min |E S - H Y| */
+      Ta = init_sub_amatrix(&tmp3, T, m, 0, c, 0);
+      copy_sub_amatrix(false, H, Ta);
+      Ya = init_sub_amatrix(&tmp4, Y, m, 0, na, 0);
+      clear_amatrix(Ya);
+      for (j = 0; j < na; j++)
+	for (i = 0; i < k0; i++)
+	  Ya->a[i + j * Ya->ld] = S->a[i + j * S->ld];
+      qrdecomp_amatrix(Ta, tau);
+      qreval_amatrix(true, Ta, tau, Ya);
+
+      /* Residual norms of all active columns */
+      converged = true;
+      for (j = 0; j < na && converged; j++) {
+	norm = 0.0;
+	for (i = c; i < m; i++)
+	  norm += ABSSQR(Ya->a[i + j * Ya->ld]);
+	if (REAL_SQRT(norm) > eps * bnorm[perm[j]])
+	  converged = false;
+      }
+
+      uninit_amatrix(Ya);
+      uninit_amatrix(Ta);
+    }
+
+    /* Every restart cycle takes at least one block step */
+    assert(c > 0);
+
+    /* X = X + V Y */
+    Ta = init_sub_amatrix(&tmp3, T, c, 0, c, 0);
+    Ya = init_sub_amatrix(&tmp4, Y, c, 0, na, 0);
+    triangularsolve_amatrix(false, false, false, Ta, false, Ya);
+    Vb = init_sub_amatrix(&tmp5, V, n, 0, c, 0);
+    addmul_active_columns(1.0, Vb, Ya, perm, X);
+    uninit_amatrix(Vb);
+    uninit_amatrix(Ya);
+    uninit_amatrix(Ta);
+  }
+
+  freemem(perm);
+  freemem(bnorm);
+  del_avector(tau);
+  del_amatrix(S);
+  del_amatrix(Xa);
+  del_amatrix(R);
+  del_amatrix(C);
+  del_amatrix(Y);
+  del_amatrix(T);
+  del_amatrix(H);
+  del_amatrix(V);
+
+  return iter;
+}
+
+uint
+solve_blockgmres_amatrix_amatrix(pcamatrix A, pcamatrix B, pamatrix X,
+				 real eps, uint maxiter, uint kmax)
+{
+  return solve_blockgmres_amatrix((void *) A,
+				  (addevalblock_t) addevalblock_amatrix, B, X,
+				  eps, maxiter, kmax);
+}
+
+uint
+solve_blockgmres_sparsematrix_amatrix(pcsparsematrix A, pcamatrix B,
+				      pamatrix X, real eps, uint maxiter,
+				      uint kmax)
+{
+  return solve_blockgmres_amatrix((void *) A,
+				  (addevalblock_t)
+				  addeval_sparsematrix_amatrix, B, X, eps,
+				  maxiter, kmax);
+}
+
+uint
+solve_blockgmres_hmatrix_amatrix(pchmatrix A, pcamatrix B, pamatrix X,
+				 real eps, uint maxiter, uint kmax)
+{
+  return solve_blockgmres_amatrix((void *) A,
+				  (addevalblock_t) addevalblock_hmatrix, B, X,
+				  eps, maxiter, kmax);
+}
+
+uint
+solve_blockgmres_h2matrix_amatrix(pch2matrix A, pcamatrix B, pamatrix X,
+				  real eps, uint maxiter, uint kmax)
+{
+  return solve_blockgmres_amatrix((void *) A,
+				  (addevalblock_t) addevalblock_h2matrix, B,
+				  X, eps, maxiter, kmax);
+}
+
+uint
+solve_blockgmres_dh2matrix_amatrix(pcdh2matrix A, pcamatrix B, pamatrix X,
+				   real eps, uint maxiter, uint kmax)
+{
+  return solve_blockgmres_amatrix((void *) A,
+				  (addevalblock_t) addevalblock_dh2matrix, B,
+				  X, eps, maxiter, kmax);
+}
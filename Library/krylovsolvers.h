@@ -21,6 +21,217 @@
  *  Krylov methods.
  *  @{ */
 
+/** @brief Number of auxiliary vectors in a @ref krylovwork object. */
+#define KRYLOVWORK_VECTORS 7
+
+/** @brief Workspace for Krylov solvers. */
+typedef struct _krylovwork krylovwork;
+
+/** @brief Pointer to @ref krylovwork object. */
+typedef krylovwork *pkrylovwork;
+
+/** @brief Workspace for Krylov solvers.
+ *
+ *  Holds all auxiliary vectors and matrices required by the
+ *  <tt>solve_*_work_avector</tt> functions in one contiguous block of
+ *  storage, so that a sequence of systems of the same dimension can be
+ *  solved without allocating memory in every call. */
+struct _krylovwork {
+  /** @brief Dimension of the systems. */
+  uint n;
+
+  /** @brief Maximal dimension of the Krylov subspace for GMRES
+   *  variants, may be zero for short-recurrence methods. */
+  uint kmax;
+
+  /** @brief Storage for all vectors and matrices. */
+  pfield mem;
+
+  /** @brief Auxiliary vectors of dimension <tt>n</tt>. */
+  avector v[KRYLOVWORK_VECTORS];
+
+  /** @brief Transformed residual of GMRES variants. */
+  avector rhat;
+
+  /** @brief Householder factorization of the Krylov basis. */
+  amatrix qr;
+
+  /** @brief Preconditioned basis vectors for flexible GMRES, has no
+   *  columns if the workspace is not flexible. */
+  amatrix z;
+
+  /** @brief Scaling factors of the Householder reflections. */
+  avector tau;
+};
+
+/** @brief Create a workspace for Krylov solvers.
+ *
+ *  The storage is cleared by all threads in parallel, so that on NUMA
+ *  systems it is distributed like the vectors it will be used with.
+ *
+ *  @param n Dimension of the systems.
+ *  @param kmax Maximal dimension of the Krylov subspace for GMRES
+ *         variants, zero if only short-recurrence methods are used.
+ *  @param flexible Set if the workspace is used by
+ *         @ref solve_fgmres_work_avector, which needs another
+ *         <tt>n</tt> times <tt>kmax</tt> matrix.
+ *  @returns New @ref krylovwork object. */
+HEADER_PREFIX pkrylovwork
+new_krylovwork(uint n, uint kmax, bool flexible);
+
+/** @brief Delete a workspace for Krylov solvers.
+ *
+ *  @param w Object to be deleted. */
+HEADER_PREFIX void
+del_krylovwork(pkrylovwork w);
+
+/** @brief Solve a self-adjoint positive definite system @f$Ax=b@f$
+ *  with the conjugate gradient method using a given workspace.
+ *
+ *  @param w Workspace of dimension <tt>x->dim</tt>.
+ *  @param A System matrix, has to be self-adjoint and positive definite.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_cg_work_avector(pkrylovwork w, void *A, addeval_t addeval_A,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a self-adjoint positive definite system @f$Ax=b@f$
+ *  with the preconditioned conjugate gradient method using a given
+ *  workspace.
+ *
+ *  @param w Workspace of dimension <tt>x->dim</tt>.
+ *  @param A System matrix, has to be self-adjoint and positive definite.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param prcd Callback function for preconditioner.
+ *  @param pdata Data for preconditioner callback.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pcg_work_avector(pkrylovwork w, void *A, addeval_t addeval_A,
+    prcd_t prcd, void *pdata, pcavector b, pavector x, real eps,
+    uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the
+ *  restarted generalized minimal residual method using a given
+ *  workspace.
+ *
+ *  @param w Workspace of dimension <tt>x->dim</tt>, its <tt>kmax</tt>
+ *         is the maximal dimension of the Krylov subspace.
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_gmres_work_avector(pkrylovwork w, void *A, addeval_t addeval_A,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the
+ *  left-preconditioned restarted generalized minimal residual method
+ *  using a given workspace.
+ *
+ *  @param w Workspace of dimension <tt>x->dim</tt>, its <tt>kmax</tt>
+ *         is the maximal dimension of the Krylov subspace.
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param prcd Callback function for preconditioner.
+ *  @param pdata Data for preconditioner callback.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|N(Ax-b)\|_2 \leq \epsilon \|Nb\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pgmres_work_avector(pkrylovwork w, void *A, addeval_t addeval_A,
+    prcd_t prcd, void *pdata, pcavector b, pavector x, real eps,
+    uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the flexible
+ *  restarted generalized minimal residual method using a given
+ *  workspace.
+ *
+ *  @param w Workspace of dimension <tt>x->dim</tt>, its <tt>kmax</tt>
+ *         is the maximal dimension of the Krylov subspace. Has to be
+ *         created with <tt>flexible</tt> set.
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param prcd Callback function for preconditioner, may change
+ *         from step to step.
+ *  @param pdata Data for preconditioner callback.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_fgmres_work_avector(pkrylovwork w, void *A, addeval_t addeval_A,
+    prcd_t prcd, void *pdata, pcavector b, pavector x, real eps,
+    uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the stabilized
+ *  biconjugate gradient method using a given workspace.
+ *
+ *  @param w Workspace of dimension <tt>x->dim</tt>.
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_bicgstab_work_avector(pkrylovwork w, void *A, addeval_t addeval_A,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the right-preconditioned
+ *  stabilized biconjugate gradient method using a given workspace.
+ *
+ *  @param w Workspace of dimension <tt>x->dim</tt>.
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param prcd Callback function for preconditioner.
+ *  @param pdata Data for preconditioner callback.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pbicgstab_work_avector(pkrylovwork w, void *A, addeval_t addeval_A,
+    prcd_t prcd, void *pdata, pcavector b, pavector x, real eps,
+    uint maxiter);
+
 /** @brief Solve a self-adjoint positive definite system @f$Ax=b@f$
  *  with the conjugate gradient method and a general matrix type <tt>A</tt>.
  *
@@ -425,6 +636,1272 @@ uint
 solve_pgmres_dh2matrix_avector(pcdh2matrix A, prcd_t prcd, void *pdata,
     pcavector b, pavector x, real eps, uint maxiter, uint kmax);
 
+/** @brief Solve a linear system @f$Ax=b@f$ with the flexible
+ *  generalized minimal residual method and a general matrix type
+ *  <tt>A</tt>.
+ *
+ *  The preconditioner is applied from the right and may change from
+ *  step to step, e.g., an inner iterative solver or a loosely truncated
+ *  H-LU factorization. The preconditioned directions are stored, so the
+ *  method needs twice the storage of @ref solve_pgmres_avector.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param prcd Callback function for preconditioner @f$N_k@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_fgmres_avector(void *A, addeval_t addeval_A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint kmax);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the flexible
+ *  generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N_k@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_fgmres_amatrix_avector(pcamatrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint kmax);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the flexible
+ *  generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N_k@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_fgmres_sparsematrix_avector(pcsparsematrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint kmax);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the flexible
+ *  generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N_k@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_fgmres_hmatrix_avector(pchmatrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint kmax);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the flexible
+ *  generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N_k@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_fgmres_h2matrix_avector(pch2matrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint kmax);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the flexible
+ *  generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N_k@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_fgmres_dh2matrix_avector(pcdh2matrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint kmax);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the biconjugate
+ *  gradient method and a general matrix type <tt>A</tt>.
+ *
+ *  Uses @ref init_bicg and @ref step_bicg. Requires one multiplication
+ *  with @f$A@f$ and one with @f$A^*@f$ per step, the storage does not
+ *  depend on the number of iterations.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param addevaltrans_A General callback function for evaluation of
+ *         the adjoint matrix <tt>A</tt>@f$^*@f$.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_bicg_avector(void *A, addeval_t addeval_A, addeval_t addevaltrans_A,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the biconjugate
+ *  gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_bicg_amatrix_avector(pcamatrix A, pcavector b, pavector x, real eps,
+    uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the biconjugate
+ *  gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_bicg_sparsematrix_avector(pcsparsematrix A, pcavector b, pavector x,
+    real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the biconjugate
+ *  gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_bicg_hmatrix_avector(pchmatrix A, pcavector b, pavector x, real eps,
+    uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the biconjugate
+ *  gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_bicg_h2matrix_avector(pch2matrix A, pcavector b, pavector x, real eps,
+    uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the biconjugate
+ *  gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_bicg_dh2matrix_avector(pcdh2matrix A, pcavector b, pavector x, real eps,
+    uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the stabilized
+ *  biconjugate gradient method and a general matrix type <tt>A</tt>.
+ *
+ *  Uses @ref init_bicgstab and @ref step_bicgstab. Requires two
+ *  multiplications with @f$A@f$ per step, the storage does not depend on
+ *  the number of iterations.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_bicgstab_avector(void *A, addeval_t addeval_A, pcavector b,
+    pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the stabilized
+ *  biconjugate gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_bicgstab_amatrix_avector(pcamatrix A, pcavector b, pavector x,
+    real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the stabilized
+ *  biconjugate gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_bicgstab_sparsematrix_avector(pcsparsematrix A, pcavector b, pavector x,
+    real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the stabilized
+ *  biconjugate gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_bicgstab_hmatrix_avector(pchmatrix A, pcavector b, pavector x,
+    real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the stabilized
+ *  biconjugate gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_bicgstab_h2matrix_avector(pch2matrix A, pcavector b, pavector x,
+    real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the stabilized
+ *  biconjugate gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_bicgstab_dh2matrix_avector(pcdh2matrix A, pcavector b, pavector x,
+    real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  stabilized biconjugate gradient method and a general matrix type
+ *  <tt>A</tt>.
+ *
+ *  Uses @ref init_pbicgstab and @ref step_pbicgstab. The preconditioner
+ *  is applied from the right, so the stopping criterion refers to the
+ *  residual of the original system.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param prcd Callback function for preconditioner @f$N@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pbicgstab_avector(void *A, addeval_t addeval_A, prcd_t prcd,
+    void *pdata, pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  stabilized biconjugate gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pbicgstab_amatrix_avector(pcamatrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  stabilized biconjugate gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pbicgstab_sparsematrix_avector(pcsparsematrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  stabilized biconjugate gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pbicgstab_hmatrix_avector(pchmatrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  stabilized biconjugate gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pbicgstab_h2matrix_avector(pch2matrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  stabilized biconjugate gradient method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pbicgstab_dh2matrix_avector(pcdh2matrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the induced
+ *  dimension reduction method IDR(s) and a general matrix type
+ *  <tt>A</tt>.
+ *
+ *  Uses a random orthonormal shadow space of dimension <tt>s</tt> and
+ *  requires @f$s+1@f$ multiplications with @f$A@f$ for @f$s+1@f$
+ *  iterations. The storage grows with <tt>s</tt>, but not with the
+ *  number of iterations. IDR(1) is mathematically equivalent to
+ *  BiCGStab, larger <tt>s</tt> usually reduce the number of
+ *  iterations.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param s Dimension of the shadow space.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_idrs_avector(void *A, addeval_t addeval_A, pcavector b, pavector x,
+    real eps, uint maxiter, uint s);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the induced
+ *  dimension reduction method IDR(s).
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param s Dimension of the shadow space.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_idrs_amatrix_avector(pcamatrix A, pcavector b, pavector x, real eps,
+    uint maxiter, uint s);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the induced
+ *  dimension reduction method IDR(s).
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param s Dimension of the shadow space.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_idrs_sparsematrix_avector(pcsparsematrix A, pcavector b, pavector x,
+    real eps, uint maxiter, uint s);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the induced
+ *  dimension reduction method IDR(s).
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param s Dimension of the shadow space.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_idrs_hmatrix_avector(pchmatrix A, pcavector b, pavector x, real eps,
+    uint maxiter, uint s);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the induced
+ *  dimension reduction method IDR(s).
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param s Dimension of the shadow space.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_idrs_h2matrix_avector(pch2matrix A, pcavector b, pavector x, real eps,
+    uint maxiter, uint s);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the induced
+ *  dimension reduction method IDR(s).
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param s Dimension of the shadow space.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_idrs_dh2matrix_avector(pcdh2matrix A, pcavector b, pavector x, real eps,
+    uint maxiter, uint s);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  induced dimension reduction method IDR(s) and a general matrix
+ *  type <tt>A</tt>.
+ *
+ *  The preconditioner is applied from the right, so the stopping
+ *  criterion refers to the residual of the original system.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param prcd Callback function for preconditioner @f$N@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param s Dimension of the shadow space.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pidrs_avector(void *A, addeval_t addeval_A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint s);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  induced dimension reduction method IDR(s).
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param s Dimension of the shadow space.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pidrs_amatrix_avector(pcamatrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint s);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  induced dimension reduction method IDR(s).
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param s Dimension of the shadow space.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pidrs_sparsematrix_avector(pcsparsematrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint s);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  induced dimension reduction method IDR(s).
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param s Dimension of the shadow space.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pidrs_hmatrix_avector(pchmatrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint s);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  induced dimension reduction method IDR(s).
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param s Dimension of the shadow space.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pidrs_h2matrix_avector(pch2matrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint s);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  induced dimension reduction method IDR(s).
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner @f$N@f$.
+ *  @param pdata Data for <tt>prcd</tt> callback function.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param s Dimension of the shadow space.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pidrs_dh2matrix_avector(pcdh2matrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint s);
+
+/** @brief Solve a self-adjoint positive definite system @f$Ax=b@f$
+ *  with the pipelined preconditioned conjugate gradient method and a
+ *  general matrix type <tt>A</tt>.
+ *
+ *  Uses @ref init_pipecg and @ref step_pipecg, i.e., only one global
+ *  reduction per step. The residual norm used in the stopping criterion
+ *  is taken from this reduction, so it lags one step behind.
+ *  Rounding errors open a gap between the recursively updated and the
+ *  true residual, so @ref replace_pipecg recomputes the residual every
+ *  50 steps and whenever the recursive residual signals convergence.
+ *  The method only stops once the true residual satisfies the
+ *  criterion or the maximal number of iterations is reached.
+ *
+ *  @param A System matrix, has to be self-adjoint and positive definite.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param prcd Callback function for preconditioner, may be
+ *         <tt>NULL</tt>.
+ *  @param pdata Data for preconditioner.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pipecg_avector(void *A, addeval_t addeval_A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a self-adjoint positive definite system @f$Ax=b@f$
+ *  with the pipelined preconditioned conjugate gradient method.
+ *
+ *  @param A System matrix, has to be self-adjoint and positive definite.
+ *  @param prcd Callback function for preconditioner, may be
+ *         <tt>NULL</tt>.
+ *  @param pdata Data for preconditioner.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pipecg_amatrix_avector(pcamatrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a self-adjoint positive definite system @f$Ax=b@f$
+ *  with the pipelined preconditioned conjugate gradient method.
+ *
+ *  @param A System matrix, has to be self-adjoint and positive definite.
+ *  @param prcd Callback function for preconditioner, may be
+ *         <tt>NULL</tt>.
+ *  @param pdata Data for preconditioner.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pipecg_sparsematrix_avector(pcsparsematrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a self-adjoint positive definite system @f$Ax=b@f$
+ *  with the pipelined preconditioned conjugate gradient method.
+ *
+ *  @param A System matrix, has to be self-adjoint and positive definite.
+ *  @param prcd Callback function for preconditioner, may be
+ *         <tt>NULL</tt>.
+ *  @param pdata Data for preconditioner.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pipecg_hmatrix_avector(pchmatrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a self-adjoint positive definite system @f$Ax=b@f$
+ *  with the pipelined preconditioned conjugate gradient method.
+ *
+ *  @param A System matrix, has to be self-adjoint and positive definite.
+ *  @param prcd Callback function for preconditioner, may be
+ *         <tt>NULL</tt>.
+ *  @param pdata Data for preconditioner.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pipecg_h2matrix_avector(pch2matrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a self-adjoint positive definite system @f$Ax=b@f$
+ *  with the pipelined preconditioned conjugate gradient method.
+ *
+ *  @param A System matrix, has to be self-adjoint and positive definite.
+ *  @param prcd Callback function for preconditioner, may be
+ *         <tt>NULL</tt>.
+ *  @param pdata Data for preconditioner.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_pipecg_dh2matrix_avector(pcdh2matrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the s-step
+ *  generalized minimal residual method and a general matrix type
+ *  <tt>A</tt>.
+ *
+ *  Blocks of <tt>sstep</tt> Krylov vectors are computed by a scaled
+ *  monomial basis without intermediate inner products and then
+ *  orthonormalized together by block Gram-Schmidt and a Cholesky QR.
+ *  This requires two global reductions per block instead of at least
+ *  one per step. The Hessenberg matrix is recovered from the change of
+ *  basis. Since the monomial basis becomes ill-conditioned quickly,
+ *  <tt>sstep</tt> should not exceed about 8.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @param sstep Number of steps per block.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_sgmres_avector(void *A, addeval_t addeval_A, pcavector b, pavector x,
+    real eps, uint maxiter, uint kmax, uint sstep);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the s-step
+ *  generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @param sstep Number of steps per block.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_sgmres_amatrix_avector(pcamatrix A, pcavector b, pavector x,
+    real eps, uint maxiter, uint kmax, uint sstep);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the s-step
+ *  generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @param sstep Number of steps per block.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_sgmres_sparsematrix_avector(pcsparsematrix A, pcavector b, pavector x,
+    real eps, uint maxiter, uint kmax, uint sstep);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the s-step
+ *  generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @param sstep Number of steps per block.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_sgmres_hmatrix_avector(pchmatrix A, pcavector b, pavector x,
+    real eps, uint maxiter, uint kmax, uint sstep);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the s-step
+ *  generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @param sstep Number of steps per block.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_sgmres_h2matrix_avector(pch2matrix A, pcavector b, pavector x,
+    real eps, uint maxiter, uint kmax, uint sstep);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the s-step
+ *  generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @param sstep Number of steps per block.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_sgmres_dh2matrix_avector(pcdh2matrix A, pcavector b, pavector x,
+    real eps, uint maxiter, uint kmax, uint sstep);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  s-step generalized minimal residual method and a general matrix type
+ *  <tt>A</tt>.
+ *
+ *  Like @ref solve_sgmres_avector, but applied to the left-preconditioned
+ *  system @f$NAx=Nb@f$.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param prcd Callback function for preconditioner.
+ *  @param pdata Data for preconditioner.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|N(Ax-b)\|_2 \leq \epsilon \|Nb\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @param sstep Number of steps per block.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_psgmres_avector(void *A, addeval_t addeval_A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint kmax, uint sstep);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  s-step generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner.
+ *  @param pdata Data for preconditioner.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|N(Ax-b)\|_2 \leq \epsilon \|Nb\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @param sstep Number of steps per block.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_psgmres_amatrix_avector(pcamatrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint kmax, uint sstep);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  s-step generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner.
+ *  @param pdata Data for preconditioner.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|N(Ax-b)\|_2 \leq \epsilon \|Nb\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @param sstep Number of steps per block.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_psgmres_sparsematrix_avector(pcsparsematrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint kmax, uint sstep);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  s-step generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner.
+ *  @param pdata Data for preconditioner.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|N(Ax-b)\|_2 \leq \epsilon \|Nb\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @param sstep Number of steps per block.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_psgmres_hmatrix_avector(pchmatrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint kmax, uint sstep);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  s-step generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner.
+ *  @param pdata Data for preconditioner.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|N(Ax-b)\|_2 \leq \epsilon \|Nb\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @param sstep Number of steps per block.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_psgmres_h2matrix_avector(pch2matrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint kmax, uint sstep);
+
+/** @brief Solve a linear system @f$Ax=b@f$ with the preconditioned
+ *  s-step generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param prcd Callback function for preconditioner.
+ *  @param pdata Data for preconditioner.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|N(Ax-b)\|_2 \leq \epsilon \|Nb\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @param sstep Number of steps per block.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_psgmres_dh2matrix_avector(pcdh2matrix A, prcd_t prcd, void *pdata,
+    pcavector b, pavector x, real eps, uint maxiter, uint kmax, uint sstep);
+
+/** @brief Block callback for dense matrices,
+ *  @f$Y \gets Y + \alpha A X@f$, can be cast to @ref addevalblock_t.
+ *
+ *  Same as @ref mvmblock_amatrix without transposition.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param A Matrix @f$A@f$.
+ *  @param X Source matrix @f$X@f$.
+ *  @param Y Target matrix @f$Y@f$. */
+HEADER_PREFIX void
+addevalblock_amatrix(field alpha, pcamatrix A, pcamatrix X, pamatrix Y);
+
+/** @brief Block callback for H-matrices,
+ *  @f$Y \gets Y + \alpha A X@f$, can be cast to @ref addevalblock_t.
+ *
+ *  Same as @ref mvmblock_hmatrix without transposition. In contrast
+ *  to @ref addmul_hmatrix_amatrix_amatrix, the rows of @f$X@f$ and
+ *  @f$Y@f$ are in the original order, like for
+ *  @ref addeval_hmatrix_avector, and the H-matrix is traversed only
+ *  once for all columns.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param A Matrix @f$A@f$.
+ *  @param X Source matrix @f$X@f$.
+ *  @param Y Target matrix @f$Y@f$. */
+HEADER_PREFIX void
+addevalblock_hmatrix(field alpha, pchmatrix A, pcamatrix X, pamatrix Y);
+
+/** @brief Block callback for H^2-matrices,
+ *  @f$Y \gets Y + \alpha A X@f$, can be cast to @ref addevalblock_t.
+ *
+ *  Same as @ref mvmblock_h2matrix without transposition, the rows of
+ *  @f$X@f$ and @f$Y@f$ are in the original order.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param A Matrix @f$A@f$.
+ *  @param X Source matrix @f$X@f$.
+ *  @param Y Target matrix @f$Y@f$. */
+HEADER_PREFIX void
+addevalblock_h2matrix(field alpha, pch2matrix A, pcamatrix X, pamatrix Y);
+
+/** @brief Block callback for directional H^2-matrices,
+ *  @f$Y \gets Y + \alpha A X@f$, can be cast to @ref addevalblock_t.
+ *
+ *  Same as @ref mvmblock_dh2matrix without transposition.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param A Matrix @f$A@f$.
+ *  @param X Source matrix @f$X@f$.
+ *  @param Y Target matrix @f$Y@f$. */
+HEADER_PREFIX void
+addevalblock_dh2matrix(field alpha, pcdh2matrix A, pcamatrix X, pamatrix Y);
+
+/** @brief Solve a self-adjoint positive definite system @f$AX=B@f$
+ *  with several right-hand sides by the block conjugate gradient method
+ *  and a general matrix type <tt>A</tt>.
+ *
+ *  All columns share the same block Krylov space, so every iteration
+ *  requires only one block evaluation of <tt>A</tt>. Linearly dependent
+ *  search directions are dropped, and converged columns are removed
+ *  from the active block.
+ *
+ *  @param A System matrix, has to be self-adjoint and positive definite.
+ *  @param addeval_A Block callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param B Right-hand side matrix.
+ *  @param X Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax_j-b_j\|_2 \leq \epsilon \|b_j\|_2@f$ holds
+ *         for all columns.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_blockcg_amatrix(void *A, addevalblock_t addeval_A, pcamatrix B,
+    pamatrix X, real eps, uint maxiter);
+
+/** @brief Solve a self-adjoint positive definite system @f$AX=B@f$
+ *  with several right-hand sides by the block conjugate gradient method.
+ *
+ *  @param A System matrix, has to be self-adjoint and positive definite.
+ *  @param B Right-hand side matrix.
+ *  @param X Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax_j-b_j\|_2 \leq \epsilon \|b_j\|_2@f$ holds
+ *         for all columns.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_blockcg_amatrix_amatrix(pcamatrix A, pcamatrix B, pamatrix X, real eps,
+    uint maxiter);
+
+/** @brief Solve a self-adjoint positive definite system @f$AX=B@f$
+ *  with several right-hand sides by the block conjugate gradient method.
+ *
+ *  @param A System matrix, has to be self-adjoint and positive definite.
+ *  @param B Right-hand side matrix.
+ *  @param X Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax_j-b_j\|_2 \leq \epsilon \|b_j\|_2@f$ holds
+ *         for all columns.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_blockcg_sparsematrix_amatrix(pcsparsematrix A, pcamatrix B, pamatrix X, real eps,
+    uint maxiter);
+
+/** @brief Solve a self-adjoint positive definite system @f$AX=B@f$
+ *  with several right-hand sides by the block conjugate gradient method.
+ *
+ *  @param A System matrix, has to be self-adjoint and positive definite.
+ *  @param B Right-hand side matrix.
+ *  @param X Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax_j-b_j\|_2 \leq \epsilon \|b_j\|_2@f$ holds
+ *         for all columns.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_blockcg_hmatrix_amatrix(pchmatrix A, pcamatrix B, pamatrix X, real eps,
+    uint maxiter);
+
+/** @brief Solve a self-adjoint positive definite system @f$AX=B@f$
+ *  with several right-hand sides by the block conjugate gradient method.
+ *
+ *  @param A System matrix, has to be self-adjoint and positive definite.
+ *  @param B Right-hand side matrix.
+ *  @param X Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax_j-b_j\|_2 \leq \epsilon \|b_j\|_2@f$ holds
+ *         for all columns.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_blockcg_h2matrix_amatrix(pch2matrix A, pcamatrix B, pamatrix X, real eps,
+    uint maxiter);
+
+/** @brief Solve a self-adjoint positive definite system @f$AX=B@f$
+ *  with several right-hand sides by the block conjugate gradient method.
+ *
+ *  @param A System matrix, has to be self-adjoint and positive definite.
+ *  @param B Right-hand side matrix.
+ *  @param X Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax_j-b_j\|_2 \leq \epsilon \|b_j\|_2@f$ holds
+ *         for all columns.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_blockcg_dh2matrix_amatrix(pcdh2matrix A, pcamatrix B, pamatrix X, real eps,
+    uint maxiter);
+
+/** @brief Solve a linear system @f$AX=B@f$ with several right-hand
+ *  sides by the restarted block generalized minimal residual method and a
+ *  general matrix type <tt>A</tt>.
+ *
+ *  All columns share the same block Krylov space, so every iteration
+ *  requires only one block evaluation of <tt>A</tt>. Linearly dependent
+ *  basis vectors are dropped, and converged columns are removed from the
+ *  active block at every restart.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param addeval_A Block callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param B Right-hand side matrix.
+ *  @param X Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax_j-b_j\|_2 \leq \epsilon \|b_j\|_2@f$ holds
+ *         for all columns.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of the block Krylov subspace
+ *         before a restart, values below the number of columns of
+ *         <tt>B</tt> are raised to it.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_blockgmres_amatrix(void *A, addevalblock_t addeval_A, pcamatrix B,
+    pamatrix X, real eps, uint maxiter, uint kmax);
+
+/** @brief Solve a linear system @f$AX=B@f$ with several right-hand
+ *  sides by the restarted block generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param B Right-hand side matrix.
+ *  @param X Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax_j-b_j\|_2 \leq \epsilon \|b_j\|_2@f$ holds
+ *         for all columns.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of the block Krylov subspace
+ *         before a restart.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_blockgmres_amatrix_amatrix(pcamatrix A, pcamatrix B, pamatrix X,
+    real eps, uint maxiter, uint kmax);
+
+/** @brief Solve a linear system @f$AX=B@f$ with several right-hand
+ *  sides by the restarted block generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param B Right-hand side matrix.
+ *  @param X Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax_j-b_j\|_2 \leq \epsilon \|b_j\|_2@f$ holds
+ *         for all columns.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of the block Krylov subspace
+ *         before a restart.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_blockgmres_sparsematrix_amatrix(pcsparsematrix A, pcamatrix B, pamatrix X,
+    real eps, uint maxiter, uint kmax);
+
+/** @brief Solve a linear system @f$AX=B@f$ with several right-hand
+ *  sides by the restarted block generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param B Right-hand side matrix.
+ *  @param X Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax_j-b_j\|_2 \leq \epsilon \|b_j\|_2@f$ holds
+ *         for all columns.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of the block Krylov subspace
+ *         before a restart.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_blockgmres_hmatrix_amatrix(pchmatrix A, pcamatrix B, pamatrix X,
+    real eps, uint maxiter, uint kmax);
+
+/** @brief Solve a linear system @f$AX=B@f$ with several right-hand
+ *  sides by the restarted block generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param B Right-hand side matrix.
+ *  @param X Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax_j-b_j\|_2 \leq \epsilon \|b_j\|_2@f$ holds
+ *         for all columns.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of the block Krylov subspace
+ *         before a restart.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_blockgmres_h2matrix_amatrix(pch2matrix A, pcamatrix B, pamatrix X,
+    real eps, uint maxiter, uint kmax);
+
+/** @brief Solve a linear system @f$AX=B@f$ with several right-hand
+ *  sides by the restarted block generalized minimal residual method.
+ *
+ *  @param A System matrix, should be invertible.
+ *  @param B Right-hand side matrix.
+ *  @param X Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax_j-b_j\|_2 \leq \epsilon \|b_j\|_2@f$ holds
+ *         for all columns.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of the block Krylov subspace
+ *         before a restart.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_blockgmres_dh2matrix_amatrix(pcdh2matrix A, pcamatrix B, pamatrix X,
+    real eps, uint maxiter, uint kmax);
+
 /** @} */
 
 #endif
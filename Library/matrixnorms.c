@@ -543,3 +543,315 @@ norm2diff_id_chol_dh2matrix_hmatrix(pcdh2matrix A, pchmatrix chol)
 				 (void *) chol, A->rb->t->size,
 				 A->cb->t->size);
 }
+
+/****************************************************
+ * Block matrix callbacks
+ ****************************************************/
+
+void
+mvmblock_amatrix(field alpha, bool trans, pcamatrix A, pcamatrix X,
+		 pamatrix Y)
+{
+  addmul_amatrix(alpha, trans, A, false, X, Y);
+}
+
+void
+mvmblock_sparsematrix(field alpha, bool trans, pcsparsematrix A, pcamatrix X,
+		      pamatrix Y)
+{
+  avector   xtmp, ytmp;
+  pavector  x, y;
+  uint      j;
+
+  if (!trans) {
+    addeval_sparsematrix_amatrix(alpha, A, X, Y);
+    return;
+  }
+
+  for (j = 0; j < X->cols; j++) {
+    x = init_column_avector(&xtmp, (pamatrix) X, j);
+    y = init_column_avector(&ytmp, Y, j);
+    mvm_sparsematrix_avector(alpha, true, A, x, y);
+    uninit_avector(y);
+    uninit_avector(x);
+  }
+}
+
+void
+mvmblock_hmatrix(field alpha, bool trans, pchmatrix A, pcamatrix X,
+		 pamatrix Y)
+{
+  pccluster xc, yc;
+  pamatrix  Xp, Yp;
+  amatrix   xtmp, ytmp;
+  uint      i, j;
+
+  xc = (trans ? A->rc : A->cc);
+  yc = (trans ? A->cc : A->rc);
+
+  /* Permutation of X and Y */
+  Xp = init_amatrix(&xtmp, X->rows, X->cols);
+  for (j = 0; j < X->cols; j++)
+    for (i = 0; i < X->rows; i++)
+      Xp->a[i + j * Xp->ld] = X->a[xc->idx[i] + j * X->ld];
+
+  Yp = init_amatrix(&ytmp, Y->rows, Y->cols);
+  for (j = 0; j < Y->cols; j++)
+    for (i = 0; i < Y->rows; i++)
+      Yp->a[i + j * Yp->ld] = Y->a[yc->idx[i] + j * Y->ld];
+
+  /* One traversal of the H-matrix for all columns */
+  addmul_hmatrix_amatrix_amatrix(alpha, trans, A, false, Xp, false, Yp);
+
+  /* Reverse permutation of Y */
+  for (j = 0; j < Y->cols; j++)
+    for (i = 0; i < Y->rows; i++)
+      Y->a[yc->idx[i] + j * Y->ld] = Yp->a[i + j * Yp->ld];
+
+  uninit_amatrix(Yp);
+  uninit_amatrix(Xp);
+}
+
+void
+mvmblock_h2matrix(field alpha, bool trans, pch2matrix A, pcamatrix X,
+		  pamatrix Y)
+{
+  pccluster xc, yc;
+  pamatrix  Xp, Yp;
+  amatrix   xtmp, ytmp;
+  uint      i, j;
+
+  xc = (trans ? A->rb->t : A->cb->t);
+  yc = (trans ? A->cb->t : A->rb->t);
+
+  /* Permutation of X and Y */
+  Xp = init_amatrix(&xtmp, X->rows, X->cols);
+  for (j = 0; j < X->cols; j++)
+    for (i = 0; i < X->rows; i++)
+      Xp->a[i + j * Xp->ld] = X->a[xc->idx[i] + j * X->ld];
+
+  Yp = init_amatrix(&ytmp, Y->rows, Y->cols);
+  for (j = 0; j < Y->cols; j++)
+    for (i = 0; i < Y->rows; i++)
+      Yp->a[i + j * Yp->ld] = Y->a[yc->idx[i] + j * Y->ld];
+
+  /* One traversal of the H2-matrix for all columns */
+  addmul_h2matrix_amatrix_amatrix(alpha, trans, A, false, Xp, Yp);
+
+  /* Reverse permutation of Y */
+  for (j = 0; j < Y->cols; j++)
+    for (i = 0; i < Y->rows; i++)
+      Y->a[yc->idx[i] + j * Y->ld] = Yp->a[i + j * Yp->ld];
+
+  uninit_amatrix(Yp);
+  uninit_amatrix(Xp);
+}
+
+void
+mvmblock_dh2matrix(field alpha, bool trans, pcdh2matrix A, pcamatrix X,
+		   pamatrix Y)
+{
+  avector   xtmp, ytmp;
+  pavector  x, y;
+  uint      j;
+
+  for (j = 0; j < X->cols; j++) {
+    x = init_column_avector(&xtmp, (pamatrix) X, j);
+    y = init_column_avector(&ytmp, Y, j);
+    mvm_dh2matrix_avector(alpha, trans, A, x, y);
+    uninit_avector(y);
+    uninit_avector(x);
+  }
+}
+
+/****************************************************
+ * Randomized norm2 estimators
+ ****************************************************/
+
+real
+norm2_randomized_amatrix(pcamatrix A, uint k, uint q, preal bound)
+{
+  return norm2_randomized_matrix((mvmblock_t) mvmblock_amatrix, (void *) A,
+				 A->rows, A->cols, k, q, bound);
+}
+
+real
+norm2_randomized_sparsematrix(pcsparsematrix A, uint k, uint q, preal bound)
+{
+  return norm2_randomized_matrix((mvmblock_t) mvmblock_sparsematrix,
+				 (void *) A, A->rows, A->cols, k, q, bound);
+}
+
+real
+norm2_randomized_hmatrix(pchmatrix A, uint k, uint q, preal bound)
+{
+  return norm2_randomized_matrix((mvmblock_t) mvmblock_hmatrix, (void *) A,
+				 A->rc->size, A->cc->size, k, q, bound);
+}
+
+real
+norm2_randomized_h2matrix(pch2matrix A, uint k, uint q, preal bound)
+{
+  return norm2_randomized_matrix((mvmblock_t) mvmblock_h2matrix, (void *) A,
+				 A->rb->t->size, A->cb->t->size, k, q, bound);
+}
+
+real
+norm2_randomized_dh2matrix(pcdh2matrix A, uint k, uint q, preal bound)
+{
+  return norm2_randomized_matrix((mvmblock_t) mvmblock_dh2matrix,
+				 (void *) A, A->rb->t->size, A->cb->t->size,
+				 k, q, bound);
+}
+
+real
+norm2diff_randomized_amatrix(pcamatrix a, pcamatrix b, uint k, uint q,
+			     preal bound)
+{
+  return norm2diff_randomized_matrix((mvmblock_t) mvmblock_amatrix,
+				     (void *) a,
+				     (mvmblock_t) mvmblock_amatrix,
+				     (void *) b, a->rows, a->cols, k, q,
+				     bound);
+}
+
+real
+norm2diff_randomized_sparsematrix(pcsparsematrix a, pcsparsematrix b, uint k,
+				  uint q, preal bound)
+{
+  return norm2diff_randomized_matrix((mvmblock_t) mvmblock_sparsematrix,
+				     (void *) a,
+				     (mvmblock_t) mvmblock_sparsematrix,
+				     (void *) b, a->rows, a->cols, k, q,
+				     bound);
+}
+
+real
+norm2diff_randomized_hmatrix(pchmatrix a, pchmatrix b, uint k, uint q,
+			     preal bound)
+{
+  return norm2diff_randomized_matrix((mvmblock_t) mvmblock_hmatrix,
+				     (void *) a,
+				     (mvmblock_t) mvmblock_hmatrix,
+				     (void *) b, a->rc->size, a->cc->size, k,
+				     q, bound);
+}
+
+real
+norm2diff_randomized_h2matrix(pch2matrix a, pch2matrix b, uint k, uint q,
+			      preal bound)
+{
+  return norm2diff_randomized_matrix((mvmblock_t) mvmblock_h2matrix,
+				     (void *) a,
+				     (mvmblock_t) mvmblock_h2matrix,
+				     (void *) b, a->rb->t->size,
+				     a->cb->t->size, k, q, bound);
+}
+
+real
+norm2diff_randomized_dh2matrix(pcdh2matrix a, pcdh2matrix b, uint k, uint q,
+			       preal bound)
+{
+  return norm2diff_randomized_matrix((mvmblock_t) mvmblock_dh2matrix,
+				     (void *) a,
+				     (mvmblock_t) mvmblock_dh2matrix,
+				     (void *) b, a->rb->t->size,
+				     a->cb->t->size, k, q, bound);
+}
+
+real
+norm2diff_id_lr_randomized_amatrix(pcamatrix A, pcamatrix LR, uint k, uint q,
+				   preal bound)
+{
+  return norm2diff_id_pre_randomized_matrix((mvmblock_t) mvmblock_amatrix,
+					    (void *) A,
+					    (prcd_t) lrsolve_n_amatrix_avector,
+					    (prcd_t) lrsolve_t_amatrix_avector,
+					    (void *) LR, A->rows, A->cols, k,
+					    q, bound);
+}
+
+real
+norm2diff_id_chol_randomized_amatrix(pcamatrix A, pcamatrix chol, uint k,
+				     uint q, preal bound)
+{
+  return norm2diff_id_pre_randomized_matrix((mvmblock_t) mvmblock_amatrix,
+					    (void *) A,
+					    (prcd_t) cholsolve_amatrix_avector,
+					    (prcd_t) cholsolve_amatrix_avector,
+					    (void *) chol, A->rows, A->cols,
+					    k, q, bound);
+}
+
+real
+norm2diff_id_lr_randomized_hmatrix(pchmatrix A, pchmatrix LR, uint k, uint q,
+				   preal bound)
+{
+  return norm2diff_id_pre_randomized_matrix((mvmblock_t) mvmblock_hmatrix,
+					    (void *) A,
+					    (prcd_t) lrsolve_n_hmatrix_avector,
+					    (prcd_t) lrsolve_t_hmatrix_avector,
+					    (void *) LR, A->rc->size,
+					    A->cc->size, k, q, bound);
+}
+
+real
+norm2diff_id_chol_randomized_hmatrix(pchmatrix A, pchmatrix chol, uint k,
+				     uint q, preal bound)
+{
+  return norm2diff_id_pre_randomized_matrix((mvmblock_t) mvmblock_hmatrix,
+					    (void *) A,
+					    (prcd_t) cholsolve_hmatrix_avector,
+					    (prcd_t) cholsolve_hmatrix_avector,
+					    (void *) chol, A->rc->size,
+					    A->cc->size, k, q, bound);
+}
+
+/****************************************************
+ * 1-norm condition estimators
+ ****************************************************/
+
+real
+norminv1_lr_amatrix(pcamatrix LR)
+{
+  return norm1_pre_matrix((prcd_t) lrsolve_n_amatrix_avector,
+			  (prcd_t) lrsolve_t_amatrix_avector, (void *) LR,
+			  LR->rows);
+}
+
+real
+norminv1_lr_hmatrix(pchmatrix LR)
+{
+  return norm1_pre_matrix((prcd_t) lrsolve_n_hmatrix_avector,
+			  (prcd_t) lrsolve_t_hmatrix_avector, (void *) LR,
+			  LR->rc->size);
+}
+
+real
+norminv1_chol_hmatrix(pchmatrix chol)
+{
+  return norm1_pre_matrix((prcd_t) cholsolve_hmatrix_avector,
+			  (prcd_t) cholsolve_hmatrix_avector, (void *) chol,
+			  chol->rc->size);
+}
+
+real
+condest1_lr_amatrix(pcamatrix A, pcamatrix LR)
+{
+  return norm1_matrix((mvm_t) mvm_amatrix_avector, (void *) A, A->rows,
+		      A->cols) * norminv1_lr_amatrix(LR);
+}
+
+real
+condest1_lr_hmatrix(pchmatrix A, pchmatrix LR)
+{
+  return norm1_matrix((mvm_t) mvm_hmatrix_avector, (void *) A, A->rc->size,
+		      A->cc->size) * norminv1_lr_hmatrix(LR);
+}
+
+real
+condest1_chol_hmatrix(pchmatrix A, pchmatrix chol)
+{
+  return norm1_matrix((mvm_t) mvm_hmatrix_avector, (void *) A, A->rc->size,
+		      A->cc->size) * norminv1_chol_hmatrix(chol);
+}
@@ -28,6 +28,9 @@
  *         @f$\lVert A-B \rVert_2@f$ with some factorized matrix @f$B@f$ or
  *         @f$\lVert I - B^{-1} A \rVert_2@f$ with some facotized matrix @f$B@f$
  *         can be computed.
+ *         Randomized block estimators with probabilistic upper bounds and
+ *         estimators for the 1-norm condition number of factorized
+ *         matrices are available as well.
  *
  *  @{ */
 
@@ -886,6 +889,401 @@ norm2diff_id_chol_dh2matrix_amatrix(pcdh2matrix A, pcamatrix chol);
 HEADER_PREFIX real
 norm2diff_id_chol_dh2matrix_hmatrix(pcdh2matrix A, pchmatrix chol);
 
+/****************************************************
+ * Block matrix callbacks
+ ****************************************************/
+
+/** @brief Block matrix callback for dense matrices,
+ *  @f$Y \gets Y + \alpha A X@f$ or @f$Y \gets Y + \alpha A^* X@f$,
+ *  can be cast to @ref mvmblock_t.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param trans Set if @f$A^*@f$ is to be used instead of @f$A@f$.
+ *  @param A Matrix @f$A@f$.
+ *  @param X Source matrix @f$X@f$.
+ *  @param Y Target matrix @f$Y@f$. */
+HEADER_PREFIX void
+mvmblock_amatrix(field alpha, bool trans, pcamatrix A, pcamatrix X,
+    pamatrix Y);
+
+/** @brief Block matrix callback for sparse matrices,
+ *  @f$Y \gets Y + \alpha A X@f$ or @f$Y \gets Y + \alpha A^* X@f$,
+ *  can be cast to @ref mvmblock_t.
+ *
+ *  The product with @f$A@f$ traverses the matrix once for all columns,
+ *  the product with @f$A^*@f$ is carried out column by column.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param trans Set if @f$A^*@f$ is to be used instead of @f$A@f$.
+ *  @param A Sparse matrix @f$A@f$.
+ *  @param X Source matrix @f$X@f$.
+ *  @param Y Target matrix @f$Y@f$. */
+HEADER_PREFIX void
+mvmblock_sparsematrix(field alpha, bool trans, pcsparsematrix A, pcamatrix X,
+    pamatrix Y);
+
+/** @brief Block matrix callback for hierarchical matrices,
+ *  @f$Y \gets Y + \alpha A X@f$ or @f$Y \gets Y + \alpha A^* X@f$,
+ *  can be cast to @ref mvmblock_t.
+ *
+ *  @f$X@f$ and @f$Y@f$ use the original ordering of the indices,
+ *  the H-matrix is traversed only once for all columns.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param trans Set if @f$A^*@f$ is to be used instead of @f$A@f$.
+ *  @param A Hierarchical matrix @f$A@f$.
+ *  @param X Source matrix @f$X@f$.
+ *  @param Y Target matrix @f$Y@f$. */
+HEADER_PREFIX void
+mvmblock_hmatrix(field alpha, bool trans, pchmatrix A, pcamatrix X,
+    pamatrix Y);
+
+/** @brief Block matrix callback for @f$\mathcal H^2@f$-matrices,
+ *  @f$Y \gets Y + \alpha A X@f$ or @f$Y \gets Y + \alpha A^* X@f$,
+ *  can be cast to @ref mvmblock_t.
+ *
+ *  @f$X@f$ and @f$Y@f$ use the original ordering of the indices,
+ *  the @f$\mathcal H^2@f$-matrix is traversed only once for all
+ *  columns.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param trans Set if @f$A^*@f$ is to be used instead of @f$A@f$.
+ *  @param A @f$\mathcal H^2@f$-matrix @f$A@f$.
+ *  @param X Source matrix @f$X@f$.
+ *  @param Y Target matrix @f$Y@f$. */
+HEADER_PREFIX void
+mvmblock_h2matrix(field alpha, bool trans, pch2matrix A, pcamatrix X,
+    pamatrix Y);
+
+/** @brief Block matrix callback for D@f$\mathcal H^2@f$-matrices,
+ *  @f$Y \gets Y + \alpha A X@f$ or @f$Y \gets Y + \alpha A^* X@f$,
+ *  can be cast to @ref mvmblock_t.
+ *
+ *  No block version of the matrix-vector multiplication is available,
+ *  so the columns are treated one by one.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param trans Set if @f$A^*@f$ is to be used instead of @f$A@f$.
+ *  @param A D@f$\mathcal H^2@f$-matrix @f$A@f$.
+ *  @param X Source matrix @f$X@f$.
+ *  @param Y Target matrix @f$Y@f$. */
+HEADER_PREFIX void
+mvmblock_dh2matrix(field alpha, bool trans, pcdh2matrix A, pcamatrix X,
+    pamatrix Y);
+
+/****************************************************
+ * Randomized norm2 estimators
+ ****************************************************/
+
+/** @brief Approximate the spectral norm @f$\|A\|_2@f$ of a dense matrix
+ *  by randomized block subspace iteration.
+ *
+ *  See @ref norm2_randomized_matrix for details.
+ *
+ *  @param A Dense matrix @f$A@f$.
+ *  @param k Number of random vectors.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by an upper bound for
+ *         @f$\|A\|_2@f$ that holds with probability at least
+ *         @f$1-10^{-k}@f$.
+ *  @returns Approximation of @f$\|A\|_2@f$. */
+HEADER_PREFIX real
+norm2_randomized_amatrix(pcamatrix A, uint k, uint q, preal bound);
+
+/** @brief Approximate the spectral norm @f$\|A\|_2@f$ of a sparse matrix
+ *  by randomized block subspace iteration.
+ *
+ *  See @ref norm2_randomized_matrix for details.
+ *
+ *  @param A Sparse matrix @f$A@f$.
+ *  @param k Number of random vectors.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by an upper bound for
+ *         @f$\|A\|_2@f$ that holds with probability at least
+ *         @f$1-10^{-k}@f$.
+ *  @returns Approximation of @f$\|A\|_2@f$. */
+HEADER_PREFIX real
+norm2_randomized_sparsematrix(pcsparsematrix A, uint k, uint q, preal bound);
+
+/** @brief Approximate the spectral norm @f$\|A\|_2@f$ of a hierarchical
+ *  matrix by randomized block subspace iteration.
+ *
+ *  See @ref norm2_randomized_matrix for details.
+ *
+ *  @param A Hierarchical matrix @f$A@f$.
+ *  @param k Number of random vectors.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by an upper bound for
+ *         @f$\|A\|_2@f$ that holds with probability at least
+ *         @f$1-10^{-k}@f$.
+ *  @returns Approximation of @f$\|A\|_2@f$. */
+HEADER_PREFIX real
+norm2_randomized_hmatrix(pchmatrix A, uint k, uint q, preal bound);
+
+/** @brief Approximate the spectral norm @f$\|A\|_2@f$ of an
+ *  @f$\mathcal H^2@f$-matrix by randomized block subspace iteration.
+ *
+ *  See @ref norm2_randomized_matrix for details.
+ *
+ *  @param A @f$\mathcal H^2@f$-matrix @f$A@f$.
+ *  @param k Number of random vectors.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by an upper bound for
+ *         @f$\|A\|_2@f$ that holds with probability at least
+ *         @f$1-10^{-k}@f$.
+ *  @returns Approximation of @f$\|A\|_2@f$. */
+HEADER_PREFIX real
+norm2_randomized_h2matrix(pch2matrix A, uint k, uint q, preal bound);
+
+/** @brief Approximate the spectral norm @f$\|A\|_2@f$ of a
+ *  D@f$\mathcal H^2@f$-matrix by randomized block subspace iteration.
+ *
+ *  See @ref norm2_randomized_matrix for details.
+ *
+ *  @param A D@f$\mathcal H^2@f$-matrix @f$A@f$.
+ *  @param k Number of random vectors.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by an upper bound for
+ *         @f$\|A\|_2@f$ that holds with probability at least
+ *         @f$1-10^{-k}@f$.
+ *  @returns Approximation of @f$\|A\|_2@f$. */
+HEADER_PREFIX real
+norm2_randomized_dh2matrix(pcdh2matrix A, uint k, uint q, preal bound);
+
+/** @brief Approximate the spectral norm @f$\|A-B\|_2@f$ of the difference
+ *  of two dense matrices by randomized block subspace iteration.
+ *
+ *  See @ref norm2_randomized_matrix for details.
+ *
+ *  @param a Dense matrix @f$A@f$.
+ *  @param b Dense matrix @f$B@f$.
+ *  @param k Number of random vectors.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by an upper bound for
+ *         @f$\|A-B\|_2@f$ that holds with probability at least
+ *         @f$1-10^{-k}@f$.
+ *  @returns Approximation of @f$\|A-B\|_2@f$. */
+HEADER_PREFIX real
+norm2diff_randomized_amatrix(pcamatrix a, pcamatrix b, uint k, uint q,
+    preal bound);
+
+/** @brief Approximate the spectral norm @f$\|A-B\|_2@f$ of the difference
+ *  of two sparse matrices by randomized block subspace iteration.
+ *
+ *  See @ref norm2_randomized_matrix for details.
+ *
+ *  @param a Sparse matrix @f$A@f$.
+ *  @param b Sparse matrix @f$B@f$.
+ *  @param k Number of random vectors.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by an upper bound for
+ *         @f$\|A-B\|_2@f$ that holds with probability at least
+ *         @f$1-10^{-k}@f$.
+ *  @returns Approximation of @f$\|A-B\|_2@f$. */
+HEADER_PREFIX real
+norm2diff_randomized_sparsematrix(pcsparsematrix a, pcsparsematrix b, uint k,
+    uint q, preal bound);
+
+/** @brief Approximate the spectral norm @f$\|A-B\|_2@f$ of the difference
+ *  of two hierarchical matrices by randomized block subspace iteration.
+ *
+ *  See @ref norm2_randomized_matrix for details.
+ *
+ *  @param a Hierarchical matrix @f$A@f$.
+ *  @param b Hierarchical matrix @f$B@f$.
+ *  @param k Number of random vectors.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by an upper bound for
+ *         @f$\|A-B\|_2@f$ that holds with probability at least
+ *         @f$1-10^{-k}@f$.
+ *  @returns Approximation of @f$\|A-B\|_2@f$. */
+HEADER_PREFIX real
+norm2diff_randomized_hmatrix(pchmatrix a, pchmatrix b, uint k, uint q,
+    preal bound);
+
+/** @brief Approximate the spectral norm @f$\|A-B\|_2@f$ of the difference
+ *  of two @f$\mathcal H^2@f$-matrices by randomized block subspace
+ *  iteration.
+ *
+ *  See @ref norm2_randomized_matrix for details.
+ *
+ *  @param a @f$\mathcal H^2@f$-matrix @f$A@f$.
+ *  @param b @f$\mathcal H^2@f$-matrix @f$B@f$.
+ *  @param k Number of random vectors.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by an upper bound for
+ *         @f$\|A-B\|_2@f$ that holds with probability at least
+ *         @f$1-10^{-k}@f$.
+ *  @returns Approximation of @f$\|A-B\|_2@f$. */
+HEADER_PREFIX real
+norm2diff_randomized_h2matrix(pch2matrix a, pch2matrix b, uint k, uint q,
+    preal bound);
+
+/** @brief Approximate the spectral norm @f$\|A-B\|_2@f$ of the difference
+ *  of two D@f$\mathcal H^2@f$-matrices by randomized block subspace
+ *  iteration.
+ *
+ *  See @ref norm2_randomized_matrix for details.
+ *
+ *  @param a D@f$\mathcal H^2@f$-matrix @f$A@f$.
+ *  @param b D@f$\mathcal H^2@f$-matrix @f$B@f$.
+ *  @param k Number of random vectors.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by an upper bound for
+ *         @f$\|A-B\|_2@f$ that holds with probability at least
+ *         @f$1-10^{-k}@f$.
+ *  @returns Approximation of @f$\|A-B\|_2@f$. */
+HEADER_PREFIX real
+norm2diff_randomized_dh2matrix(pcdh2matrix a, pcdh2matrix b, uint k, uint q,
+    preal bound);
+
+/** @brief Approximate the spectral norm @f$\|I - B^{-1}A\|_2@f$ for a
+ *  dense LR factorization of @f$B@f$ by randomized block subspace iteration.
+ *
+ *  See @ref norm2diff_id_pre_randomized_matrix for details.
+ *
+ *  @param A Dense matrix @f$A@f$.
+ *  @param LR Dense LR factorization of the matrix @f$B@f$.
+ *  @param k Number of random vectors.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by an upper bound for
+ *         @f$\|I - B^{-1}A\|_2@f$ that holds with probability at least
+ *         @f$1-10^{-k}@f$.
+ *  @returns Approximation of @f$\|I - B^{-1}A\|_2@f$. */
+HEADER_PREFIX real
+norm2diff_id_lr_randomized_amatrix(pcamatrix A, pcamatrix LR, uint k, uint q,
+    preal bound);
+
+/** @brief Approximate the spectral norm @f$\|I - B^{-1}A\|_2@f$ for a
+ *  dense Cholesky factorization of @f$B@f$ by randomized block subspace
+ *  iteration.
+ *
+ *  See @ref norm2diff_id_pre_randomized_matrix for details.
+ *
+ *  @param A Dense matrix @f$A@f$.
+ *  @param chol Dense Cholesky factorization of the matrix @f$B@f$.
+ *  @param k Number of random vectors.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by an upper bound for
+ *         @f$\|I - B^{-1}A\|_2@f$ that holds with probability at least
+ *         @f$1-10^{-k}@f$.
+ *  @returns Approximation of @f$\|I - B^{-1}A\|_2@f$. */
+HEADER_PREFIX real
+norm2diff_id_chol_randomized_amatrix(pcamatrix A, pcamatrix chol, uint k,
+    uint q, preal bound);
+
+/** @brief Approximate the spectral norm @f$\|I - B^{-1}A\|_2@f$ for a
+ *  hierarchical LR factorization of @f$B@f$ by randomized block subspace
+ *  iteration.
+ *
+ *  See @ref norm2diff_id_pre_randomized_matrix for details.
+ *
+ *  @param A Hierarchical matrix @f$A@f$.
+ *  @param LR Hierarchical LR factorization of the matrix @f$B@f$.
+ *  @param k Number of random vectors.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by an upper bound for
+ *         @f$\|I - B^{-1}A\|_2@f$ that holds with probability at least
+ *         @f$1-10^{-k}@f$.
+ *  @returns Approximation of @f$\|I - B^{-1}A\|_2@f$. */
+HEADER_PREFIX real
+norm2diff_id_lr_randomized_hmatrix(pchmatrix A, pchmatrix LR, uint k, uint q,
+    preal bound);
+
+/** @brief Approximate the spectral norm @f$\|I - B^{-1}A\|_2@f$ for a
+ *  hierarchical Cholesky factorization of @f$B@f$ by randomized block
+ *  subspace iteration.
+ *
+ *  See @ref norm2diff_id_pre_randomized_matrix for details.
+ *
+ *  @param A Hierarchical matrix @f$A@f$.
+ *  @param chol Hierarchical Cholesky factorization of the matrix @f$B@f$.
+ *  @param k Number of random vectors.
+ *  @param q Number of subspace iteration steps.
+ *  @param bound If not null, will be overwritten by an upper bound for
+ *         @f$\|I - B^{-1}A\|_2@f$ that holds with probability at least
+ *         @f$1-10^{-k}@f$.
+ *  @returns Approximation of @f$\|I - B^{-1}A\|_2@f$. */
+HEADER_PREFIX real
+norm2diff_id_chol_randomized_hmatrix(pchmatrix A, pchmatrix chol, uint k,
+    uint q, preal bound);
+
+/****************************************************
+ * 1-norm condition estimators
+ ****************************************************/
+
+/** @brief Estimate the 1-norm @f$\|A^{-1}\|_1@f$ of the inverse of a
+ *  matrix given by a dense LR factorization.
+ *
+ *  Uses @ref norm1_pre_matrix, i.e., a few forward and backward
+ *  substitutions with the factors.
+ *
+ *  @param LR Dense LR factorization of @f$A@f$.
+ *  @returns Estimate of @f$\|A^{-1}\|_1@f$. */
+HEADER_PREFIX real
+norminv1_lr_amatrix(pcamatrix LR);
+
+/** @brief Estimate the 1-norm @f$\|A^{-1}\|_1@f$ of the inverse of a
+ *  matrix given by a hierarchical LR factorization.
+ *
+ *  Uses @ref norm1_pre_matrix, i.e., a few forward and backward
+ *  substitutions with @ref lrsolve_n_hmatrix_avector and
+ *  @ref lrsolve_t_hmatrix_avector.
+ *
+ *  @param LR Hierarchical LR factorization of @f$A@f$.
+ *  @returns Estimate of @f$\|A^{-1}\|_1@f$. */
+HEADER_PREFIX real
+norminv1_lr_hmatrix(pchmatrix LR);
+
+/** @brief Estimate the 1-norm @f$\|A^{-1}\|_1@f$ of the inverse of a
+ *  matrix given by a hierarchical Cholesky factorization.
+ *
+ *  @param chol Hierarchical Cholesky factorization of @f$A@f$.
+ *  @returns Estimate of @f$\|A^{-1}\|_1@f$. */
+HEADER_PREFIX real
+norminv1_chol_hmatrix(pchmatrix chol);
+
+/** @brief Estimate the condition number
+ *  @f$\kappa_1(A) = \|A\|_1 \|A^{-1}\|_1@f$ of a dense matrix.
+ *
+ *  Both norms are estimated by @ref norm1_matrix and
+ *  @ref norm1_pre_matrix, so the result is usually a lower bound
+ *  within a small factor of the true condition number.
+ *
+ *  @param A Dense matrix @f$A@f$.
+ *  @param LR Dense LR factorization of @f$A@f$.
+ *  @returns Estimate of @f$\kappa_1(A)@f$. */
+HEADER_PREFIX real
+condest1_lr_amatrix(pcamatrix A, pcamatrix LR);
+
+/** @brief Estimate the condition number
+ *  @f$\kappa_1(A) = \|A\|_1 \|A^{-1}\|_1@f$ of a hierarchical matrix
+ *  using its LR factorization.
+ *
+ *  Both norms are estimated by @ref norm1_matrix and
+ *  @ref norm1_pre_matrix, so the result is usually a lower bound
+ *  within a small factor of the true condition number.
+ *  The cost is a few matrix-vector multiplications and forward and
+ *  backward substitutions.
+ *
+ *  @param A Hierarchical matrix @f$A@f$.
+ *  @param LR Hierarchical LR factorization of @f$A@f$.
+ *  @returns Estimate of @f$\kappa_1(A)@f$. */
+HEADER_PREFIX real
+condest1_lr_hmatrix(pchmatrix A, pchmatrix LR);
+
+/** @brief Estimate the condition number
+ *  @f$\kappa_1(A) = \|A\|_1 \|A^{-1}\|_1@f$ of a hierarchical matrix
+ *  using its Cholesky factorization.
+ *
+ *  See @ref condest1_lr_hmatrix for details.
+ *
+ *  @param A Hierarchical matrix @f$A@f$.
+ *  @param chol Hierarchical Cholesky factorization of @f$A@f$.
+ *  @returns Estimate of @f$\kappa_1(A)@f$. */
+HEADER_PREFIX real
+condest1_chol_hmatrix(pchmatrix A, pchmatrix chol);
+
 /**
  *  @}
  *  */
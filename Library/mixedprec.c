@@ -0,0 +1,742 @@
+/* ------------------------------------------------------------
+ * This is the file "mixedprec.c" of the H2Lib package.
+ * All rights reserved, Steffen Boerm 2016
+ * ------------------------------------------------------------ */
+
+/** @file mixedprec.c
+ *  @author Steffen B&ouml;rm */
+
+#include "mixedprec.h"
+#include "basic.h"
+#include "harith.h"
+
+/* ------------------------------------------------------------
+ * Constructors, destructors and conversion
+ * ------------------------------------------------------------ */
+
+plpamatrix
+init_lpamatrix(plpamatrix a, uint rows, uint cols)
+{
+  a->a = (rows > 0 && cols > 0 ?
+	  (plpfield) allocmem(sizeof(lpfield) * (size_t) rows * cols) :
+	  NULL);
+  a->ld = rows;
+  a->rows = rows;
+  a->cols = cols;
+
+  return a;
+}
+
+void
+uninit_lpamatrix(plpamatrix a)
+{
+  if (a->a)
+    freemem(a->a);
+}
+
+plpamatrix
+new_amatrix_lpamatrix(pcamatrix a)
+{
+  plpamatrix b;
+
+  b = (plpamatrix) allocmem(sizeof(lpamatrix));
+  init_lpamatrix(b, a->rows, a->cols);
+  convert_amatrix_lpamatrix(a, b);
+
+  return b;
+}
+
+void
+del_lpamatrix(plpamatrix a)
+{
+  uninit_lpamatrix(a);
+  freemem(a);
+}
+
+void
+convert_amatrix_lpamatrix(pcamatrix a, plpamatrix b)
+{
+  uint      i, j;
+
+  assert(a->rows == b->rows);
+  assert(a->cols == b->cols);
+
+  for (j = 0; j < a->cols; j++)
+    for (i = 0; i < a->rows; i++)
+      b->a[i + j * b->ld] = (lpfield) a->a[i + j * a->ld];
+}
+
+void
+convert_lpamatrix_amatrix(pclpamatrix a, pamatrix b)
+{
+  uint      i, j;
+
+  assert(a->rows == b->rows);
+  assert(a->cols == b->cols);
+
+  for (j = 0; j < a->cols; j++)
+    for (i = 0; i < a->rows; i++)
+      b->a[i + j * b->ld] = (field) a->a[i + j * a->ld];
+}
+
+plprkmatrix
+new_rkmatrix_lprkmatrix(pcrkmatrix r)
+{
+  plprkmatrix lr;
+
+  lr = (plprkmatrix) allocmem(sizeof(lprkmatrix));
+  init_lpamatrix(&lr->A, r->A.rows, r->k);
+  init_lpamatrix(&lr->B, r->B.rows, r->k);
+  lr->k = r->k;
+
+  convert_amatrix_lpamatrix(&r->A, &lr->A);
+  convert_amatrix_lpamatrix(&r->B, &lr->B);
+
+  return lr;
+}
+
+void
+del_lprkmatrix(plprkmatrix r)
+{
+  uninit_lpamatrix(&r->B);
+  uninit_lpamatrix(&r->A);
+  freemem(r);
+}
+
+plphmatrix
+new_hmatrix_lphmatrix(pchmatrix a)
+{
+  plphmatrix lh;
+  uint      rsons, csons;
+  uint      i, j;
+
+  lh = (plphmatrix) allocmem(sizeof(lphmatrix));
+  lh->rc = a->rc;
+  lh->cc = a->cc;
+  lh->r = NULL;
+  lh->f = NULL;
+  lh->son = NULL;
+  lh->rsons = 0;
+  lh->csons = 0;
+  lh->desc = 1;
+
+  if (a->son) {
+    rsons = a->rsons;
+    csons = a->csons;
+
+    lh->son = (plphmatrix *) allocmem(sizeof(plphmatrix) * rsons * csons);
+    lh->rsons = rsons;
+    lh->csons = csons;
+    for (j = 0; j < csons; j++)
+      for (i = 0; i < rsons; i++) {
+	lh->son[i + j * rsons] = new_hmatrix_lphmatrix(a->son[i + j * rsons]);
+	lh->desc += lh->son[i + j * rsons]->desc;
+      }
+  }
+  else if (a->r)
+    lh->r = new_rkmatrix_lprkmatrix(a->r);
+  else {
+    assert(a->f != NULL);
+    lh->f = new_amatrix_lpamatrix(a->f);
+  }
+
+  return lh;
+}
+
+phmatrix
+new_lphmatrix_hmatrix(pclphmatrix a)
+{
+  phmatrix  hm;
+  uint      rsons, csons;
+  uint      i, j;
+
+  if (a->son) {
+    rsons = a->rsons;
+    csons = a->csons;
+
+    hm = new_super_hmatrix(a->rc, a->cc, rsons, csons);
+    for (j = 0; j < csons; j++)
+      for (i = 0; i < rsons; i++)
+	ref_hmatrix(hm->son + i + j * rsons,
+		    new_lphmatrix_hmatrix(a->son[i + j * rsons]));
+  }
+  else if (a->r) {
+    hm = new_rk_hmatrix(a->rc, a->cc, a->r->k);
+    convert_lpamatrix_amatrix(&a->r->A, &hm->r->A);
+    convert_lpamatrix_amatrix(&a->r->B, &hm->r->B);
+  }
+  else {
+    assert(a->f != NULL);
+    hm = new_full_hmatrix(a->rc, a->cc);
+    convert_lpamatrix_amatrix(a->f, hm->f);
+  }
+
+  update_hmatrix(hm);
+
+  return hm;
+}
+
+void
+del_lphmatrix(plphmatrix a)
+{
+  uint      i;
+
+  if (a->son) {
+    for (i = 0; i < a->rsons * a->csons; i++)
+      del_lphmatrix(a->son[i]);
+    freemem(a->son);
+  }
+
+  if (a->r)
+    del_lprkmatrix(a->r);
+
+  if (a->f)
+    del_lpamatrix(a->f);
+
+  freemem(a);
+}
+
+plphmatrix
+new_lrdecomp_lphmatrix(pchmatrix a, pctruncmode tm, real eps)
+{
+  phmatrix  LR;
+  plphmatrix lh;
+
+  LR = clone_hmatrix(a);
+  lrdecomp_hmatrix(LR, tm, eps);
+  lh = new_hmatrix_lphmatrix(LR);
+  del_hmatrix(LR);
+
+  return lh;
+}
+
+/* ------------------------------------------------------------
+ * Statistics
+ * ------------------------------------------------------------ */
+
+size_t
+getsize_lpamatrix(pclpamatrix a)
+{
+  return sizeof(lpamatrix) + sizeof(lpfield) * (size_t) a->rows * a->cols;
+}
+
+size_t
+getsize_lprkmatrix(pclprkmatrix r)
+{
+  size_t    sz;
+
+  sz = sizeof(lprkmatrix);
+  sz += sizeof(lpfield) * (size_t) r->A.rows * r->k;
+  sz += sizeof(lpfield) * (size_t) r->B.rows * r->k;
+
+  return sz;
+}
+
+size_t
+getsize_lphmatrix(pclphmatrix a)
+{
+  size_t    sz;
+  uint      i;
+
+  sz = sizeof(lphmatrix);
+
+  if (a->r)
+    sz += getsize_lprkmatrix(a->r);
+
+  if (a->f)
+    sz += getsize_lpamatrix(a->f);
+
+  if (a->son) {
+    sz += sizeof(plphmatrix) * a->rsons * a->csons;
+    for (i = 0; i < a->rsons * a->csons; i++)
+      sz += getsize_lphmatrix(a->son[i]);
+  }
+
+  return sz;
+}
+
+/* ------------------------------------------------------------
+ * Matrix-vector multiplication
+ * ------------------------------------------------------------ */
+
+void
+addeval_lpamatrix_avector(field alpha, pclpamatrix a, pcavector x,
+			  pavector y)
+{
+  pclpfield aa = a->a;
+  pfield    yv = y->v;
+  field     t;
+  uint      i, j;
+
+  assert(x->dim >= a->cols);
+  assert(y->dim >= a->rows);
+
+  for (j = 0; j < a->cols; j++) {
+    t = alpha * x->v[j];
+    for (i = 0; i < a->rows; i++)
+      yv[i] += aa[i + j * a->ld] * t;
+  }
+}
+
+void
+addevaltrans_lpamatrix_avector(field alpha, pclpamatrix a, pcavector x,
+			       pavector y)
+{
+  pclpfield aa = a->a;
+  pcfield   xv = x->v;
+  field     sum;
+  uint      i, j;
+
+  assert(x->dim >= a->rows);
+  assert(y->dim >= a->cols);
+
+  for (j = 0; j < a->cols; j++) {
+    sum = 0.0;
+    for (i = 0; i < a->rows; i++)
+      sum += CONJ((field) aa[i + j * a->ld]) * xv[i];
+    y->v[j] += alpha * sum;
+  }
+}
+
+static void
+addeval_lprkmatrix_avector(field alpha, bool trans, pclprkmatrix r,
+			   pcavector x, pavector y)
+{
+  pavector  t;
+
+  t = new_avector(r->k);
+  clear_avector(t);
+
+  if (trans) {
+    addevaltrans_lpamatrix_avector(1.0, &r->A, x, t);
+    addeval_lpamatrix_avector(alpha, &r->B, t, y);
+  }
+  else {
+    addevaltrans_lpamatrix_avector(1.0, &r->B, x, t);
+    addeval_lpamatrix_avector(alpha, &r->A, t, y);
+  }
+
+  del_avector(t);
+}
+
+/* Multiplication with vectors in cluster order, y += alpha A x or
+ * y += alpha A^* x */
+static void
+fastaddeval_lphmatrix_avector(field alpha, bool trans, pclphmatrix a,
+			      pavector x, pavector y)
+{
+  avector   xtmp, ytmp;
+  pavector  x1, y1;
+  pclphmatrix b;
+  uint      rsons, csons;
+  uint      xoff, yoff, i, j;
+
+  if (a->r)
+    addeval_lprkmatrix_avector(alpha, trans, a->r, x, y);
+  else if (a->f) {
+    if (trans)
+      addevaltrans_lpamatrix_avector(alpha, a->f, x, y);
+    else
+      addeval_lpamatrix_avector(alpha, a->f, x, y);
+  }
+  else {
+    rsons = a->rsons;
+    csons = a->csons;
+
+    xoff = 0;
+    for (j = 0; j < csons; j++) {
+      yoff = 0;
+      for (i = 0; i < rsons; i++) {
+	b = a->son[i + j * rsons];
+
+	if (trans) {
+	  x1 = init_sub_avector(&xtmp, x, b->rc->size, yoff);
+	  y1 = init_sub_avector(&ytmp, y, b->cc->size, xoff);
+	}
+	else {
+	  x1 = init_sub_avector(&xtmp, x, b->cc->size, xoff);
+	  y1 = init_sub_avector(&ytmp, y, b->rc->size, yoff);
+	}
+
+	fastaddeval_lphmatrix_avector(alpha, trans, b, x1, y1);
+
+	uninit_avector(y1);
+	uninit_avector(x1);
+
+	yoff += b->rc->size;
+      }
+      assert(yoff == a->rc->size);
+
+      xoff += a->son[j * rsons]->cc->size;
+    }
+    assert(xoff == a->cc->size);
+  }
+}
+
+void
+addeval_lphmatrix_avector(field alpha, pclphmatrix a, pcavector x,
+			  pavector y)
+{
+  avector   xtmp, ytmp;
+  pavector  xp, yp;
+  uint      i;
+
+  assert(x->dim == a->cc->size);
+  assert(y->dim == a->rc->size);
+
+  xp = init_avector(&xtmp, x->dim);
+  for (i = 0; i < xp->dim; i++)
+    xp->v[i] = x->v[a->cc->idx[i]];
+
+  yp = init_avector(&ytmp, y->dim);
+  for (i = 0; i < yp->dim; i++)
+    yp->v[i] = y->v[a->rc->idx[i]];
+
+  fastaddeval_lphmatrix_avector(alpha, false, a, xp, yp);
+
+  for (i = 0; i < yp->dim; i++)
+    y->v[a->rc->idx[i]] = yp->v[i];
+
+  uninit_avector(yp);
+  uninit_avector(xp);
+}
+
+/* ------------------------------------------------------------
+ * Solving linear systems
+ * ------------------------------------------------------------ */
+
+/* Forward or backward substitution with a dense triangular matrix */
+static void
+triangularsolve_lpamatrix_avector(bool alower, bool aunit, bool atrans,
+				  pclpamatrix a, pavector x)
+{
+  pclpfield aa = a->a;
+  pfield    xv = x->v;
+  uint      ld = a->ld;
+  uint      n = UINT_MIN(a->rows, a->cols);
+  field     sum;
+  uint      i, j;
+
+  assert(x->dim == n);
+
+  if (alower && !atrans) {
+    for (j = 0; j < n; j++) {
+      if (!aunit)
+	xv[j] /= (field) aa[j + j * ld];
+      for (i = j + 1; i < n; i++)
+	xv[i] -= aa[i + j * ld] * xv[j];
+    }
+  }
+  else if (alower) {
+    for (j = n; j-- > 0;) {
+      sum = xv[j];
+      for (i = j + 1; i < n; i++)
+	sum -= CONJ((field) aa[i + j * ld]) * xv[i];
+      xv[j] = (aunit ? sum : sum / CONJ((field) aa[j + j * ld]));
+    }
+  }
+  else if (!atrans) {
+    for (j = n; j-- > 0;) {
+      if (!aunit)
+	xv[j] /= (field) aa[j + j * ld];
+      for (i = 0; i < j; i++)
+	xv[i] -= aa[i + j * ld] * xv[j];
+    }
+  }
+  else {
+    for (j = 0; j < n; j++) {
+      sum = xv[j];
+      for (i = 0; i < j; i++)
+	sum -= CONJ((field) aa[i + j * ld]) * xv[i];
+      xv[j] = (aunit ? sum : sum / CONJ((field) aa[j + j * ld]));
+    }
+  }
+}
+
+static void
+lowersolve_lphmatrix_avector(bool aunit, bool atrans, pclphmatrix a,
+			     pavector xp)
+{
+  avector   tmp1, tmp2;
+  pavector  xp1, xp2;
+  uint      sons;
+  uint      roff, roff2;
+  uint      i, j;
+
+  assert(a->rc == a->cc);
+  assert(a->cc->size == xp->dim);
+
+  if (a->f)
+    triangularsolve_lpamatrix_avector(true, aunit, atrans, a->f, xp);
+  else if (!atrans) {
+    assert(a->son != 0);
+    assert(a->rsons == a->csons);
+
+    sons = a->rsons;
+
+    roff = 0;
+    for (i = 0; i < sons; i++) {
+      xp1 = init_sub_avector(&tmp1, xp, a->son[i]->rc->size, roff);
+
+      lowersolve_lphmatrix_avector(aunit, false, a->son[i + i * sons], xp1);
+
+      roff2 = roff + a->son[i]->rc->size;
+      for (j = i + 1; j < sons; j++) {
+	xp2 = init_sub_avector(&tmp2, xp, a->son[j]->rc->size, roff2);
+
+	fastaddeval_lphmatrix_avector(-1.0, false, a->son[j + i * sons], xp1,
+				      xp2);
+
+	uninit_avector(xp2);
+
+	roff2 += a->son[j]->rc->size;
+      }
+      assert(roff2 == a->rc->size);
+
+      uninit_avector(xp1);
+
+      roff += a->son[i]->rc->size;
+    }
+    assert(roff == a->rc->size);
+  }
+  else {
+    assert(a->son != 0);
+    assert(a->rsons == a->csons);
+
+    sons = a->rsons;
+
+    roff = a->rc->size;
+    for (i = sons; i-- > 0;) {
+      roff -= a->son[i]->rc->size;
+
+      xp1 = init_sub_avector(&tmp1, xp, a->son[i]->rc->size, roff);
+
+      roff2 = roff + a->son[i]->rc->size;
+      for (j = i + 1; j < sons; j++) {
+	xp2 = init_sub_avector(&tmp2, xp, a->son[j]->rc->size, roff2);
+
+	fastaddeval_lphmatrix_avector(-1.0, true, a->son[j + i * sons], xp2,
+				      xp1);
+
+	uninit_avector(xp2);
+
+	roff2 += a->son[j]->rc->size;
+      }
+      assert(roff2 == a->rc->size);
+
+      lowersolve_lphmatrix_avector(aunit, true, a->son[i + i * sons], xp1);
+
+      uninit_avector(xp1);
+    }
+    assert(roff == 0);
+  }
+}
+
+static void
+uppersolve_lphmatrix_avector(bool aunit, bool atrans, pclphmatrix a,
+			     pavector xp)
+{
+  avector   tmp1, tmp2;
+  pavector  xp1, xp2;
+  uint      sons;
+  uint      roff, roff2;
+  uint      i, j;
+
+  assert(a->rc == a->cc);
+  assert(a->cc->size == xp->dim);
+
+  if (a->f)
+    triangularsolve_lpamatrix_avector(false, aunit, atrans, a->f, xp);
+  else if (!atrans) {
+    assert(a->son != 0);
+    assert(a->rsons == a->csons);
+
+    sons = a->rsons;
+
+    roff = a->rc->size;
+    for (i = sons; i-- > 0;) {
+      roff -= a->son[i]->rc->size;
+
+      xp1 = init_sub_avector(&tmp1, xp, a->son[i]->rc->size, roff);
+
+      uppersolve_lphmatrix_avector(aunit, false, a->son[i + i * sons], xp1);
+
+      roff2 = roff;
+      for (j = i; j-- > 0;) {
+	roff2 -= a->son[j]->rc->size;
+
+	xp2 = init_sub_avector(&tmp2, xp, a->son[j]->rc->size, roff2);
+
+	fastaddeval_lphmatrix_avector(-1.0, false, a->son[j + i * sons], xp1,
+				      xp2);
+
+	uninit_avector(xp2);
+      }
+      assert(roff2 == 0);
+
+      uninit_avector(xp1);
+    }
+    assert(roff == 0);
+  }
+  else {
+    assert(a->son != 0);
+    assert(a->rsons == a->csons);
+
+    sons = a->rsons;
+
+    roff = 0;
+    for (i = 0; i < sons; i++) {
+      xp1 = init_sub_avector(&tmp1, xp, a->son[i]->rc->size, roff);
+
+      roff2 = roff;
+      for (j = i; j-- > 0;) {
+	roff2 -= a->son[j]->rc->size;
+
+	xp2 = init_sub_avector(&tmp2, xp, a->son[j]->rc->size, roff2);
+
+	fastaddeval_lphmatrix_avector(-1.0, true, a->son[j + i * sons], xp2,
+				      xp1);
+
+	uninit_avector(xp2);
+      }
+      assert(roff2 == 0);
+
+      uppersolve_lphmatrix_avector(aunit, true, a->son[i + i * sons], xp1);
+
+      uninit_avector(xp1);
+
+      roff += a->son[i]->rc->size;
+    }
+    assert(roff == a->rc->size);
+  }
+}
+
+void
+lrsolve_n_lphmatrix_avector(pclphmatrix a, pavector x)
+{
+  avector   tmp;
+  pavector  xp;
+  const uint *idx;
+  uint      i, n;
+
+  assert(x->dim == a->rc->size);
+
+  n = a->rc->size;
+  idx = a->rc->idx;
+
+  xp = init_avector(&tmp, n);
+  for (i = 0; i < n; i++)
+    xp->v[i] = x->v[idx[i]];
+
+  lowersolve_lphmatrix_avector(true, false, a, xp);
+  uppersolve_lphmatrix_avector(false, false, a, xp);
+
+  for (i = 0; i < n; i++)
+    x->v[idx[i]] = xp->v[i];
+  uninit_avector(xp);
+}
+
+void
+lrsolve_t_lphmatrix_avector(pclphmatrix a, pavector x)
+{
+  avector   tmp;
+  pavector  xp;
+  const uint *idx;
+  uint      i, n;
+
+  assert(x->dim == a->rc->size);
+
+  n = a->rc->size;
+  idx = a->rc->idx;
+
+  xp = init_avector(&tmp, n);
+  for (i = 0; i < n; i++)
+    xp->v[i] = x->v[idx[i]];
+
+  uppersolve_lphmatrix_avector(false, true, a, xp);
+  lowersolve_lphmatrix_avector(true, true, a, xp);
+
+  for (i = 0; i < n; i++)
+    x->v[idx[i]] = xp->v[i];
+  uninit_avector(xp);
+}
+
+void
+lrsolve_lphmatrix_avector(bool atrans, pclphmatrix a, pavector x)
+{
+  if (atrans)
+    lrsolve_t_lphmatrix_avector(a, x);
+  else
+    lrsolve_n_lphmatrix_avector(a, x);
+}
+
+/* ------------------------------------------------------------
+ * Mixed-precision solvers
+ * ------------------------------------------------------------ */
+
+uint
+solve_irefine_avector(void *A, addeval_t addeval_A, pclphmatrix LR,
+		      pcavector b, pavector x, real eps, uint maxiter)
+{
+  pavector  r;
+  real      norm, error;
+  uint      n, iter;
+
+  n = x->dim;
+
+  assert(b->dim == n);
+
+  r = new_avector(n);
+
+  norm = norm2_avector(b);
+
+  copy_avector(b, r);
+  addeval_A(-1.0, A, x, r);
+  error = norm2_avector(r);
+
+  iter = 0;
+  while (error > eps * norm && iter + 1 != maxiter) {
+    /* Correction with the low-precision factorization */
+    lrsolve_n_lphmatrix_avector(LR, r);
+    add_avector(1.0, r, x);
+
+    /* Residual in working precision */
+    copy_avector(b, r);
+    addeval_A(-1.0, A, x, r);
+    error = norm2_avector(r);
+
+    iter++;
+  }
+
+  del_avector(r);
+
+  return iter;
+}
+
+uint
+solve_irefine_hmatrix_avector(pchmatrix A, pclphmatrix LR, pcavector b,
+			      pavector x, real eps, uint maxiter)
+{
+  return solve_irefine_avector((void *) A,
+			       (addeval_t) addeval_hmatrix_avector, LR, b, x,
+			       eps, maxiter);
+}
+
+uint
+solve_mpgmres_avector(void *A, addeval_t addeval_A, pclphmatrix LR,
+		      pcavector b, pavector x, real eps, uint maxiter,
+		      uint kmax)
+{
+  return solve_fgmres_avector(A, addeval_A,
+			      (prcd_t) lrsolve_n_lphmatrix_avector,
+			      (void *) LR, b, x, eps, maxiter, kmax);
+}
+
+uint
+solve_mpgmres_hmatrix_avector(pchmatrix A, pclphmatrix LR, pcavector b,
+			      pavector x, real eps, uint maxiter, uint kmax)
+{
+  return solve_mpgmres_avector((void *) A,
+			       (addeval_t) addeval_hmatrix_avector, LR, b, x,
+			       eps, maxiter, kmax);
+}
@@ -0,0 +1,406 @@
+/* ------------------------------------------------------------
+ * This is the file "mixedprec.h" of the H2Lib package.
+ * All rights reserved, Steffen Boerm 2016
+ * ------------------------------------------------------------ */
+
+/** @file mixedprec.h
+ *  @author Steffen B&ouml;rm */
+
+#ifndef MIXEDPREC_H
+#define MIXEDPREC_H
+
+/** @defgroup mixedprec mixedprec
+ *  @brief Low-precision storage of matrices and mixed-precision solvers.
+ *
+ *  The precision of @ref field is fixed at compile time. The classes
+ *  @ref lpamatrix, @ref lprkmatrix and @ref lphmatrix store copies of
+ *  @ref amatrix, @ref rkmatrix and @ref hmatrix objects in single
+ *  precision, while all operations accumulate in the working precision.
+ *
+ *  A typical application is an H-LU factorization computed with a coarse
+ *  accuracy and stored in single precision. Since the forward and
+ *  backward substitutions are limited by the memory bandwidth, this
+ *  halves both storage and solve time, and iterative refinement or
+ *  flexible GMRES restore the full accuracy of the working precision.
+ *  @{ */
+
+/** @brief Low-precision field type. */
+#ifdef USE_COMPLEX
+typedef float _Complex lpfield;
+#else
+typedef float lpfield;
+#endif
+
+/** @brief Pointer to @ref lpfield array. */
+typedef lpfield *plpfield;
+
+/** @brief Pointer to constant @ref lpfield array. */
+typedef const lpfield *pclpfield;
+
+/** @brief Dense matrix in low precision. */
+typedef struct _lpamatrix lpamatrix;
+
+/** @brief Pointer to @ref lpamatrix object. */
+typedef lpamatrix *plpamatrix;
+
+/** @brief Pointer to constant @ref lpamatrix object. */
+typedef const lpamatrix *pclpamatrix;
+
+/** @brief Low-rank matrix in low precision. */
+typedef struct _lprkmatrix lprkmatrix;
+
+/** @brief Pointer to @ref lprkmatrix object. */
+typedef lprkmatrix *plprkmatrix;
+
+/** @brief Pointer to constant @ref lprkmatrix object. */
+typedef const lprkmatrix *pclprkmatrix;
+
+/** @brief Hierarchical matrix in low precision. */
+typedef struct _lphmatrix lphmatrix;
+
+/** @brief Pointer to @ref lphmatrix object. */
+typedef lphmatrix *plphmatrix;
+
+/** @brief Pointer to constant @ref lphmatrix object. */
+typedef const lphmatrix *pclphmatrix;
+
+#include "hmatrix.h"
+#include "krylovsolvers.h"
+#include "truncation.h"
+
+/** @brief Dense matrix in low precision, stored in column-major order. */
+struct _lpamatrix {
+  /** @brief Coefficients, entry @f$(i,j)@f$ is stored in
+   *  <tt>a[i+j*ld]</tt>. */
+  plpfield a;
+
+  /** @brief Leading dimension. */
+  uint ld;
+
+  /** @brief Number of rows. */
+  uint rows;
+
+  /** @brief Number of columns. */
+  uint cols;
+};
+
+/** @brief Low-rank matrix @f$A B^*@f$ in low precision. */
+struct _lprkmatrix {
+  /** @brief Row factor @f$A@f$. */
+  lpamatrix A;
+
+  /** @brief Column factor @f$B@f$. */
+  lpamatrix B;
+
+  /** @brief Rank, i.e., number of columns of @f$A@f$ and @f$B@f$. */
+  uint k;
+};
+
+/** @brief Hierarchical matrix in low precision.
+ *
+ *  Has the same block structure as the @ref hmatrix it was created
+ *  from. */
+struct _lphmatrix {
+  /** @brief Row cluster. */
+  pccluster rc;
+
+  /** @brief Column cluster. */
+  pccluster cc;
+
+  /** @brief Low-rank matrix, if this is an admissible leaf. */
+  plprkmatrix r;
+
+  /** @brief Dense matrix, if this is an inadmissible leaf. */
+  plpamatrix f;
+
+  /** @brief Submatrices, if this matrix is subdivided. */
+  plphmatrix *son;
+
+  /** @brief Number of row sons. */
+  uint rsons;
+
+  /** @brief Number of column sons. */
+  uint csons;
+
+  /** @brief Number of descendants in the block tree. */
+  uint desc;
+};
+
+/* ------------------------------------------------------------
+ * Constructors, destructors and conversion
+ * ------------------------------------------------------------ */
+
+/** @brief Initialize a low-precision dense matrix.
+ *
+ *  @param a Object to be initialized.
+ *  @param rows Number of rows.
+ *  @param cols Number of columns.
+ *  @returns Initialized @ref lpamatrix object. */
+HEADER_PREFIX plpamatrix
+init_lpamatrix(plpamatrix a, uint rows, uint cols);
+
+/** @brief Uninitialize a low-precision dense matrix.
+ *
+ *  @param a Object to be uninitialized. */
+HEADER_PREFIX void
+uninit_lpamatrix(plpamatrix a);
+
+/** @brief Create a low-precision copy of a dense matrix.
+ *
+ *  @param a Source matrix.
+ *  @returns New @ref lpamatrix object with the rounded entries of
+ *    <tt>a</tt>. */
+HEADER_PREFIX plpamatrix
+new_amatrix_lpamatrix(pcamatrix a);
+
+/** @brief Delete a low-precision dense matrix.
+ *
+ *  @param a Object to be deleted. */
+HEADER_PREFIX void
+del_lpamatrix(plpamatrix a);
+
+/** @brief Round a dense matrix to low precision, @f$b \gets a@f$.
+ *
+ *  @param a Source matrix.
+ *  @param b Target matrix of the same size. */
+HEADER_PREFIX void
+convert_amatrix_lpamatrix(pcamatrix a, plpamatrix b);
+
+/** @brief Copy a low-precision dense matrix into working precision,
+ *  @f$b \gets a@f$.
+ *
+ *  @param a Source matrix.
+ *  @param b Target matrix of the same size. */
+HEADER_PREFIX void
+convert_lpamatrix_amatrix(pclpamatrix a, pamatrix b);
+
+/** @brief Create a low-precision copy of a low-rank matrix.
+ *
+ *  @param r Source matrix.
+ *  @returns New @ref lprkmatrix object. */
+HEADER_PREFIX plprkmatrix
+new_rkmatrix_lprkmatrix(pcrkmatrix r);
+
+/** @brief Delete a low-precision low-rank matrix.
+ *
+ *  @param r Object to be deleted. */
+HEADER_PREFIX void
+del_lprkmatrix(plprkmatrix r);
+
+/** @brief Create a low-precision copy of an @f$\mathcal{H}@f$-matrix.
+ *
+ *  @param a Source matrix, e.g., an H-LU factorization computed by
+ *    @ref lrdecomp_hmatrix.
+ *  @returns New @ref lphmatrix object with the same block structure. */
+HEADER_PREFIX plphmatrix
+new_hmatrix_lphmatrix(pchmatrix a);
+
+/** @brief Create an @f$\mathcal{H}@f$-matrix in working precision
+ *  from a low-precision copy.
+ *
+ *  @param a Source matrix.
+ *  @returns New @ref hmatrix object with the same block structure. */
+HEADER_PREFIX phmatrix
+new_lphmatrix_hmatrix(pclphmatrix a);
+
+/** @brief Delete a low-precision @f$\mathcal{H}@f$-matrix.
+ *
+ *  @param a Object to be deleted. */
+HEADER_PREFIX void
+del_lphmatrix(plphmatrix a);
+
+/** @brief Compute an H-LU factorization and store it in low precision.
+ *
+ *  The factorization is computed by @ref lrdecomp_hmatrix in working
+ *  precision on a copy of <tt>a</tt>, since the arithmetic operations
+ *  are only available for @ref field. The copy is released after it
+ *  has been rounded.
+ *
+ *  @param a Matrix to be factorized, is not changed.
+ *  @param tm Truncation mode, may be <tt>NULL</tt>.
+ *  @param eps Truncation accuracy, coarse values are sufficient for
+ *    a preconditioner.
+ *  @returns Low-precision representation of the factors, can be used
+ *    with @ref lrsolve_lphmatrix_avector. */
+HEADER_PREFIX plphmatrix
+new_lrdecomp_lphmatrix(pchmatrix a, pctruncmode tm, real eps);
+
+/* ------------------------------------------------------------
+ * Statistics
+ * ------------------------------------------------------------ */
+
+/** @brief Get size of a low-precision dense matrix.
+ *
+ *  @param a Matrix.
+ *  @returns Size of allocated storage in bytes. */
+HEADER_PREFIX size_t
+getsize_lpamatrix(pclpamatrix a);
+
+/** @brief Get size of a low-precision low-rank matrix.
+ *
+ *  @param r Matrix.
+ *  @returns Size of allocated storage in bytes. */
+HEADER_PREFIX size_t
+getsize_lprkmatrix(pclprkmatrix r);
+
+/** @brief Get size of a low-precision @f$\mathcal{H}@f$-matrix.
+ *
+ *  @param a Matrix.
+ *  @returns Size of allocated storage in bytes. */
+HEADER_PREFIX size_t
+getsize_lphmatrix(pclphmatrix a);
+
+/* ------------------------------------------------------------
+ * Matrix-vector multiplication
+ * ------------------------------------------------------------ */
+
+/** @brief Matrix-vector multiplication @f$y \gets y + \alpha A x@f$,
+ *  accumulated in working precision.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param a Matrix @f$A@f$.
+ *  @param x Source vector @f$x@f$.
+ *  @param y Target vector @f$y@f$. */
+HEADER_PREFIX void
+addeval_lpamatrix_avector(field alpha, pclpamatrix a, pcavector x,
+    pavector y);
+
+/** @brief Adjoint matrix-vector multiplication
+ *  @f$y \gets y + \alpha A^* x@f$, accumulated in working precision.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param a Matrix @f$A@f$.
+ *  @param x Source vector @f$x@f$.
+ *  @param y Target vector @f$y@f$. */
+HEADER_PREFIX void
+addevaltrans_lpamatrix_avector(field alpha, pclpamatrix a, pcavector x,
+    pavector y);
+
+/** @brief Matrix-vector multiplication @f$y \gets y + \alpha A x@f$
+ *  for a low-precision @f$\mathcal{H}@f$-matrix.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param a Matrix @f$A@f$.
+ *  @param x Source vector @f$x@f$.
+ *  @param y Target vector @f$y@f$. */
+HEADER_PREFIX void
+addeval_lphmatrix_avector(field alpha, pclphmatrix a, pcavector x,
+    pavector y);
+
+/* ------------------------------------------------------------
+ * Solving linear systems
+ * ------------------------------------------------------------ */
+
+/** @brief Solve @f$L R x = b@f$ with a low-precision H-LU
+ *  factorization.
+ *
+ *  Compatible with @ref prcd_t and can be used as a preconditioner.
+ *
+ *  @param a Factorization created by @ref new_lrdecomp_lphmatrix or
+ *    by @ref new_hmatrix_lphmatrix from the result of
+ *    @ref lrdecomp_hmatrix.
+ *  @param x Right-hand side, overwritten by the solution. */
+HEADER_PREFIX void
+lrsolve_n_lphmatrix_avector(pclphmatrix a, pavector x);
+
+/** @brief Solve @f$(L R)^* x = b@f$ with a low-precision H-LU
+ *  factorization.
+ *
+ *  @param a Factorization.
+ *  @param x Right-hand side, overwritten by the solution. */
+HEADER_PREFIX void
+lrsolve_t_lphmatrix_avector(pclphmatrix a, pavector x);
+
+/** @brief Solve @f$L R x = b@f$ or @f$(L R)^* x = b@f$ with a
+ *  low-precision H-LU factorization.
+ *
+ *  @param atrans Set if the adjoint system is to be solved.
+ *  @param a Factorization.
+ *  @param x Right-hand side, overwritten by the solution. */
+HEADER_PREFIX void
+lrsolve_lphmatrix_avector(bool atrans, pclphmatrix a, pavector x);
+
+/** @brief Solve a linear system @f$Ax=b@f$ by iterative refinement
+ *  with a low-precision factorization and a general matrix type
+ *  <tt>A</tt>.
+ *
+ *  The residual @f$r = b - Ax@f$ is computed in working precision and
+ *  the correction @f$x \gets x + (LR)^{-1} r@f$ uses the low-precision
+ *  factorization. Converges if the factorization is a sufficiently
+ *  good approximation of @f$A@f$.
+ *
+ *  @param A System matrix.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param LR Low-precision factorization approximating <tt>A</tt>.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_irefine_avector(void *A, addeval_t addeval_A, pclphmatrix LR,
+    pcavector b, pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ by iterative refinement
+ *  with a low-precision factorization.
+ *
+ *  @param A System matrix.
+ *  @param LR Low-precision factorization approximating <tt>A</tt>.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_irefine_hmatrix_avector(pchmatrix A, pclphmatrix LR, pcavector b,
+    pavector x, real eps, uint maxiter);
+
+/** @brief Solve a linear system @f$Ax=b@f$ by GMRES in working precision,
+ *  preconditioned with a low-precision factorization, for a general
+ *  matrix type <tt>A</tt>.
+ *
+ *  Uses @ref solve_fgmres_avector, so the stopping criterion refers to
+ *  the unpreconditioned residual. More robust than
+ *  @ref solve_irefine_avector if the factorization is very coarse.
+ *
+ *  @param A System matrix.
+ *  @param addeval_A General callback function for evaluation of a matrix
+ *         <tt>A</tt>.
+ *  @param LR Low-precision factorization approximating <tt>A</tt>.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_mpgmres_avector(void *A, addeval_t addeval_A, pclphmatrix LR,
+    pcavector b, pavector x, real eps, uint maxiter, uint kmax);
+
+/** @brief Solve a linear system @f$Ax=b@f$ by GMRES in working precision,
+ *  preconditioned with a low-precision factorization.
+ *
+ *  @param A System matrix.
+ *  @param LR Low-precision factorization approximating <tt>A</tt>.
+ *  @param b Right-hand side vector.
+ *  @param x Initial guess, will be overwritten by approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @param kmax Maximal dimension of Krylov subspace.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_mpgmres_hmatrix_avector(pchmatrix A, pclphmatrix LR, pcavector b,
+    pavector x, real eps, uint maxiter, uint kmax);
+
+/** @} */
+
+#endif
@@ -0,0 +1,269 @@
+/* ------------------------------------------------------------
+ * This is the file "multigrid.c" of the H2Lib package.
+ * All rights reserved, Steffen Boerm 2016
+ * ------------------------------------------------------------ */
+
+#include "multigrid.h"
+
+#include "factorizations.h"
+#include "basic.h"
+
+#include <assert.h>
+
+/* Number of rows in the blocks of the parallel Gauss-Seidel iteration */
+#define GS_BLOCKSIZE 2048
+
+/* ------------------------------------------------------------
+ * Constructors and destructors
+ * ------------------------------------------------------------ */
+
+pmultigrid
+new_multigrid(uint levels, psparsematrix A, pcsparsematrix *P)
+{
+  pmultigrid mg;
+  psparsematrix Al;
+  pfield    dv;
+  uint      l, i, j, info;
+
+  assert(levels > 0);
+  assert(A->rows == A->cols);
+
+  mg = (pmultigrid) allocmem(sizeof(multigrid));
+  mg->levels = levels;
+  mg->A = (psparsematrix *) allocmem(sizeof(psparsematrix) * levels);
+  mg->P = (pcsparsematrix *) allocmem(sizeof(pcsparsematrix) * levels);
+  mg->dinv = (pavector *) allocmem(sizeof(pavector) * levels);
+  mg->b = (pavector *) allocmem(sizeof(pavector) * levels);
+  mg->x = (pavector *) allocmem(sizeof(pavector) * levels);
+  mg->r = (pavector *) allocmem(sizeof(pavector) * levels);
+
+  /* Galerkin products for the coarse levels */
+  mg->A[levels - 1] = A;
+  mg->P[levels - 1] = NULL;
+  for (l = levels - 1; l-- > 0;) {
+    assert(P[l]->rows == mg->A[l + 1]->cols);
+    mg->P[l] = P[l];
+    mg->A[l] = new_galerkin_sparsematrix(mg->A[l + 1], P[l]);
+  }
+
+  for (l = 0; l < levels; l++) {
+    Al = mg->A[l];
+
+    mg->b[l] = new_avector(Al->rows);
+    mg->x[l] = new_avector(Al->rows);
+    mg->r[l] = new_avector(Al->rows);
+
+    /* Inverted diagonal for the smoothers */
+    mg->dinv[l] = new_avector(Al->rows);
+    dv = mg->dinv[l]->v;
+    for (i = 0; i < Al->rows; i++) {
+      for (j = Al->row[i]; j < Al->row[i + 1] && Al->col[j] != i; j++);
+      assert(j < Al->row[i + 1]);
+      dv[i] = 1.0 / Al->coeff[j];
+    }
+  }
+
+  /* Dense factorization of the coarsest matrix */
+  Al = mg->A[0];
+  mg->C = new_zero_amatrix(Al->rows, Al->cols);
+  add_sparsematrix_amatrix(1.0, false, Al, mg->C);
+  if (Al->rows > 0) {
+    info = lrdecomp_amatrix(mg->C);
+    assert(info == 0);
+    (void) info;
+  }
+
+  mg->csolve = NULL;
+  mg->cdata = NULL;
+
+  mg->smoother = H2_MG_JACOBI;
+  mg->omega = 2.0 / 3.0;
+  mg->nu1 = 2;
+  mg->nu2 = 2;
+  mg->gamma = 1;
+
+  return mg;
+}
+
+void
+del_multigrid(pmultigrid mg)
+{
+  uint      l;
+
+  del_amatrix(mg->C);
+
+  for (l = 0; l < mg->levels; l++) {
+    del_avector(mg->dinv[l]);
+    del_avector(mg->r[l]);
+    del_avector(mg->x[l]);
+    del_avector(mg->b[l]);
+    if (l + 1 < mg->levels)
+      del_sparsematrix(mg->A[l]);
+  }
+
+  freemem(mg->r);
+  freemem(mg->x);
+  freemem(mg->b);
+  freemem(mg->dinv);
+  freemem(mg->P);
+  freemem(mg->A);
+  freemem(mg);
+}
+
+void
+setcoarse_multigrid(pmultigrid mg, prcd_t solve, void *data)
+{
+  mg->csolve = solve;
+  mg->cdata = data;
+}
+
+/* ------------------------------------------------------------
+ * Multigrid iteration
+ * ------------------------------------------------------------ */
+
+static void
+smooth_jacobi(pcmultigrid mg, uint l)
+{
+  pcsparsematrix A = mg->A[l];
+  pfield    xv = mg->x[l]->v;
+  pcfield   rv = mg->r[l]->v;
+  pcfield   dv = mg->dinv[l]->v;
+  real      omega = mg->omega;
+  uint      i;
+
+  copy_avector(mg->b[l], mg->r[l]);
+  addeval_sparsematrix_avector(-1.0, A, mg->x[l], mg->r[l]);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (i = 0; i < A->rows; i++)
+    xv[i] += omega * dv[i] * rv[i];
+}
+
+static void
+smooth_gauss_seidel(pcmultigrid mg, uint l, bool forward)
+{
+  pcsparsematrix A = mg->A[l];
+  pfield    xv = mg->x[l]->v;
+  pcfield   bv = mg->b[l]->v;
+  pcfield   dv = mg->dinv[l]->v;
+  pcfield   xold;
+  uint      blocks;
+  uint      k;
+
+  /* Couplings between blocks use the previous iterate */
+  copy_avector(mg->x[l], mg->r[l]);
+  xold = mg->r[l]->v;
+
+  blocks = (A->rows + GS_BLOCKSIZE - 1) / GS_BLOCKSIZE;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+  for (k = 0; k < blocks; k++) {
+    uint      start = k * GS_BLOCKSIZE;
+    uint      end = UINT_MIN(start + GS_BLOCKSIZE, A->rows);
+    uint      i, n, j, c;
+    field     sum;
+
+    for (n = 0; n < end - start; n++) {
+      i = (forward ? start + n : end - 1 - n);
+
+      sum = bv[i];
+      for (j = A->row[i]; j < A->row[i + 1]; j++) {
+	c = A->col[j];
+	if (c != i)
+	  sum -= A->coeff[j] * (start <= c && c < end ? xv[c] : xold[c]);
+      }
+      xv[i] = dv[i] * sum;
+    }
+  }
+}
+
+static void
+smooth(pcmultigrid mg, uint l, bool forward)
+{
+  if (mg->smoother == H2_MG_GAUSS_SEIDEL)
+    smooth_gauss_seidel(mg, l, forward);
+  else
+    smooth_jacobi(mg, l);
+}
+
+static void
+cycle(pcmultigrid mg, uint l)
+{
+  uint      i;
+
+  if (l == 0) {
+    copy_avector(mg->b[0], mg->x[0]);
+    if (mg->csolve)
+      mg->csolve(mg->cdata, mg->x[0]);
+    else if (mg->C->rows > 0)
+      lrsolve_amatrix_avector(false, mg->C, mg->x[0]);
+    return;
+  }
+
+  /* Pre-smoothing */
+  for (i = 0; i < mg->nu1; i++)
+    smooth(mg, l, true);
+
+  /* Restrict the residual */
+  copy_avector(mg->b[l], mg->r[l]);
+  addeval_sparsematrix_avector(-1.0, mg->A[l], mg->x[l], mg->r[l]);
+  clear_avector(mg->b[l - 1]);
+  addevaltrans_sparsematrix_avector(1.0, mg->P[l - 1], mg->r[l],
+				    mg->b[l - 1]);
+
+  /* Coarse-grid correction */
+  clear_avector(mg->x[l - 1]);
+  for (i = 0; i < mg->gamma; i++)
+    cycle(mg, l - 1);
+  addeval_sparsematrix_avector(1.0, mg->P[l - 1], mg->x[l - 1], mg->x[l]);
+
+  /* Post-smoothing */
+  for (i = 0; i < mg->nu2; i++)
+    smooth(mg, l, false);
+}
+
+void
+prcd_multigrid(pcmultigrid mg, pavector r)
+{
+  uint      l = mg->levels - 1;
+
+  assert(r->dim == mg->A[l]->rows);
+
+  copy_avector(r, mg->b[l]);
+  clear_avector(mg->x[l]);
+  cycle(mg, l);
+  copy_avector(mg->x[l], r);
+}
+
+uint
+solve_multigrid_avector(pcmultigrid mg, pcavector b, pavector x, real eps,
+			uint maxiter)
+{
+  pcsparsematrix A = mg->A[mg->levels - 1];
+  pavector  d;
+  real      norm, error;
+  uint      iter;
+
+  d = new_avector(A->rows);
+
+  norm = norm2_avector(b);
+
+  for (iter = 0; maxiter == 0 || iter < maxiter; iter++) {
+    copy_avector(b, d);
+    addeval_sparsematrix_avector(-1.0, A, x, d);
+    error = norm2_avector(d);
+    if (error <= eps * norm)
+      break;
+
+    prcd_multigrid(mg, d);
+    add_avector(1.0, d, x);
+  }
+
+  del_avector(d);
+
+  return iter;
+}
@@ -0,0 +1,185 @@
+/* ------------------------------------------------------------
+ * This is the file "multigrid.h" of the H2Lib package.
+ * All rights reserved, Steffen Boerm 2016
+ * ------------------------------------------------------------ */
+
+/** @file multigrid.h
+ *  @author Steffen B&ouml;rm */
+
+#ifndef MULTIGRID_H
+#define MULTIGRID_H
+
+/** @defgroup multigrid multigrid
+ *  @brief Geometric multigrid methods for sparse matrices.
+ *
+ *  A @ref multigrid object describes a hierarchy of nested spaces by
+ *  prolongation matrices, e.g., constructed by
+ *  @ref build_tet3dp1_prolongation_sparsematrix or
+ *  @ref build_tri2dp1_prolongation_sparsematrix for meshes obtained by
+ *  @ref refine_tet3d or @ref refine_tri2d.
+ *  The coarse-grid matrices are computed by Galerkin products, and
+ *  one multigrid cycle can be used as a preconditioner for the
+ *  conjugate gradient method.
+ *  @{ */
+
+/** @brief Multigrid hierarchy. */
+typedef struct _multigrid multigrid;
+
+/** @brief Pointer to @ref multigrid object. */
+typedef multigrid *pmultigrid;
+
+/** @brief Pointer to constant @ref multigrid object. */
+typedef const multigrid *pcmultigrid;
+
+#include "sparsematrix.h"
+#include "amatrix.h"
+#include "krylov.h"
+
+/** @brief Smoothing iterations for multigrid methods. */
+typedef enum {
+  /** @brief Damped Jacobi iteration. */
+  H2_MG_JACOBI,
+  /** @brief Gauss-Seidel iteration, forward for pre-smoothing and
+   *  backward for post-smoothing. Blocks of rows are processed in
+   *  parallel, couplings between blocks are treated like in the
+   *  Jacobi iteration. */
+  H2_MG_GAUSS_SEIDEL
+} mgsmoother;
+
+/** @brief Multigrid hierarchy.
+ *
+ *  Level <tt>0</tt> is the coarsest level, level <tt>levels-1</tt>
+ *  the finest one.
+ *  The parameters <tt>smoother</tt>, <tt>omega</tt>, <tt>nu1</tt>,
+ *  <tt>nu2</tt> and <tt>gamma</tt> can be changed at any time. */
+struct _multigrid {
+  /** @brief Number of levels. */
+  uint levels;
+
+  /** @brief System matrices, <tt>A[levels-1]</tt> is provided by the
+   *  user, all others are Galerkin products. */
+  psparsematrix *A;
+
+  /** @brief Prolongations, <tt>P[l]</tt> maps level <tt>l</tt>
+   *  to level <tt>l+1</tt>. */
+  pcsparsematrix *P;
+
+  /** @brief Inverted diagonal entries of the system matrices. */
+  pavector *dinv;
+
+  /** @brief Right-hand sides on all levels. */
+  pavector *b;
+
+  /** @brief Approximate solutions on all levels. */
+  pavector *x;
+
+  /** @brief Residuals on all levels. */
+  pavector *r;
+
+  /** @brief Factorized coarsest matrix, used if <tt>csolve</tt>
+   *  is not set. */
+  pamatrix C;
+
+  /** @brief Optional coarse-grid solver, e.g., an H-LU factorization,
+   *  see @ref setcoarse_multigrid. */
+  prcd_t csolve;
+
+  /** @brief Data for <tt>csolve</tt>. */
+  void *cdata;
+
+  /** @brief Smoothing iteration. */
+  mgsmoother smoother;
+
+  /** @brief Damping parameter of the Jacobi iteration. */
+  real omega;
+
+  /** @brief Number of pre-smoothing steps. */
+  uint nu1;
+
+  /** @brief Number of post-smoothing steps. */
+  uint nu2;
+
+  /** @brief Number of recursive calls, <tt>1</tt> for the V-cycle and
+   *  <tt>2</tt> for the W-cycle. */
+  uint gamma;
+};
+
+/* ------------------------------------------------------------
+ * Constructors and destructors
+ * ------------------------------------------------------------ */
+
+/** @brief Create a multigrid hierarchy.
+ *
+ *  The coarse-grid matrices are computed by
+ *  @f$A_l = P_l^* A_{l+1} P_l@f$ using
+ *  @ref new_galerkin_sparsematrix, and the coarsest matrix is
+ *  factorized.
+ *  By default, two damped Jacobi steps with @f$\omega=2/3@f$ are used
+ *  for pre- and post-smoothing in a V-cycle.
+ *
+ *  @param levels Number of levels.
+ *  @param A System matrix on the finest level. Has to be kept alive
+ *    as long as the hierarchy is used.
+ *  @param P Array of <tt>levels-1</tt> prolongations, <tt>P[l]</tt>
+ *    maps level <tt>l</tt> to level <tt>l+1</tt>. The matrices have to
+ *    be kept alive as long as the hierarchy is used.
+ *  @returns New @ref multigrid object. */
+HEADER_PREFIX pmultigrid
+new_multigrid(uint levels, psparsematrix A, pcsparsematrix *P);
+
+/** @brief Delete a multigrid hierarchy.
+ *
+ *  The matrices provided to @ref new_multigrid are not deleted.
+ *
+ *  @param mg Object to be deleted. */
+HEADER_PREFIX void
+del_multigrid(pmultigrid mg);
+
+/** @brief Replace the dense coarse-grid solver.
+ *
+ *  Useful if the coarsest level is too large for a dense factorization,
+ *  e.g., <tt>solve</tt> can apply an H-LU factorization.
+ *
+ *  @param mg Multigrid hierarchy.
+ *  @param solve Callback solving the coarse system, the right-hand
+ *    side is overwritten by the solution. <tt>NULL</tt> restores the
+ *    dense solver.
+ *  @param data Data for <tt>solve</tt>. */
+HEADER_PREFIX void
+setcoarse_multigrid(pmultigrid mg, prcd_t solve, void *data);
+
+/* ------------------------------------------------------------
+ * Multigrid iteration
+ * ------------------------------------------------------------ */
+
+/** @brief Perform one multigrid cycle as a preconditioner.
+ *
+ *  Starting with zero, one cycle is applied to the system
+ *  @f$A e = r@f$ on the finest level, and <tt>r</tt> is overwritten
+ *  by the result.
+ *  The function can be cast to @ref prcd_t and used, e.g., with
+ *  @ref solve_pcg_sparsematrix_avector. If <tt>nu1</tt> and
+ *  <tt>nu2</tt> coincide, the preconditioner is self-adjoint.
+ *
+ *  @param mg Multigrid hierarchy.
+ *  @param r Residual, overwritten by the correction. */
+HEADER_PREFIX void
+prcd_multigrid(pcmultigrid mg, pavector r);
+
+/** @brief Solve a system by the multigrid iteration.
+ *
+ *  @param mg Multigrid hierarchy.
+ *  @param b Right-hand side.
+ *  @param x Initial guess, overwritten by the approximate solution.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *         @f$\|Ax-b\|_2 \leq \epsilon \|b\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *         means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_multigrid_avector(pcmultigrid mg, pcavector b, pavector x, real eps,
+			uint maxiter);
+
+/** @} */
+
+#endif
@@ -0,0 +1,248 @@
+/* ------------------------------------------------------------
+ * This is the file "reorder.c" of the H2Lib package.
+ * All rights reserved, Steffen Boerm 2016
+ * ------------------------------------------------------------ */
+
+#include "reorder.h"
+
+#include "basic.h"
+
+#include <assert.h>
+#include <stdint.h>
+
+/* ------------------------------------------------------------
+ * Reverse Cuthill-McKee
+ * ------------------------------------------------------------ */
+
+/* Breadth-first search starting at r, neighbours are visited by
+ * increasing degree. Returns the number of visited vertices, the
+ * last level starts at *last, the number of levels is *depth. */
+static    uint
+bfs(uint r, const uint *start, const uint *adj, uint *mark, uint m,
+    uint *queue, uint *last, uint *depth)
+{
+  uint      head, tail, level, i, j, k, v, w;
+
+  queue[0] = r;
+  mark[r] = m;
+  head = 0;
+  tail = 1;
+  *last = 0;
+  *depth = 0;
+
+  while (head < tail) {
+    level = tail;
+    *last = head;
+    (*depth)++;
+
+    for (; head < level; head++) {
+      v = queue[head];
+      k = tail;
+      for (j = start[v]; j < start[v + 1]; j++) {
+	w = adj[j];
+	if (mark[w] != m) {
+	  mark[w] = m;
+	  queue[tail++] = w;
+	}
+      }
+
+      /* Sort the new vertices by degree */
+      for (i = k + 1; i < tail; i++) {
+	w = queue[i];
+	for (j = i; j > k && start[queue[j - 1] + 1] - start[queue[j - 1]] >
+	     start[w + 1] - start[w]; j--)
+	  queue[j] = queue[j - 1];
+	queue[j] = w;
+      }
+    }
+  }
+
+  return tail;
+}
+
+void
+rcm_reorder(uint n, uint edges, const uint *e, uint *perm)
+{
+  uint     *start, *adj, *mark, *queue;
+  uint      i, j, r, cnt, last, depth, d, next, m;
+
+  /* Adjacency lists */
+  start = allocuint(n + 1);
+  for (i = 0; i <= n; i++)
+    start[i] = 0;
+  for (i = 0; i < edges; i++) {
+    assert(e[2 * i] < n && e[2 * i + 1] < n);
+    start[e[2 * i] + 1]++;
+    start[e[2 * i + 1] + 1]++;
+  }
+  for (i = 0; i < n; i++)
+    start[i + 1] += start[i];
+
+  adj = allocuint(start[n]);
+  for (i = 0; i < edges; i++) {
+    adj[start[e[2 * i]]++] = e[2 * i + 1];
+    adj[start[e[2 * i + 1]]++] = e[2 * i];
+  }
+  for (i = n; i > 0; i--)
+    start[i] = start[i - 1];
+  start[0] = 0;
+
+  mark = allocuint(n);
+  for (i = 0; i < n; i++)
+    mark[i] = 0;
+  queue = allocuint(n);
+
+  /* Marks 1 and 2 are used to find pseudo-peripheral vertices,
+   * 3 marks vertices that have been numbered */
+  next = n;
+  for (i = 0; i < n; i++)
+    if (mark[i] != 3) {
+      /* Start with a vertex of minimal degree in this component */
+      r = i;
+      cnt = bfs(r, start, adj, mark, 1, queue, &last, &depth);
+      for (j = 0; j < cnt; j++)
+	if (start[queue[j] + 1] - start[queue[j]] < start[r + 1] - start[r])
+	  r = queue[j];
+
+      /* Move to a vertex of minimal degree in the last level as long
+       * as the number of levels grows, alternating marks 2 and 1 */
+      m = 2;
+      bfs(r, start, adj, mark, m, queue, &last, &depth);
+      for (;;) {
+	j = queue[last];
+	for (; last < cnt; last++)
+	  if (start[queue[last] + 1] - start[queue[last]] <
+	      start[j + 1] - start[j])
+	    j = queue[last];
+
+	m = 3 - m;
+	bfs(j, start, adj, mark, m, queue, &last, &d);
+	if (d <= depth)
+	  break;
+	r = j;
+	depth = d;
+      }
+
+      /* Number the component in reverse order */
+      cnt = bfs(r, start, adj, mark, 3, queue, &last, &depth);
+      for (j = 0; j < cnt; j++)
+	perm[queue[j]] = --next;
+    }
+  assert(next == 0);
+
+  freemem(queue);
+  freemem(mark);
+  freemem(adj);
+  freemem(start);
+}
+
+/* ------------------------------------------------------------
+ * Morton ordering
+ * ------------------------------------------------------------ */
+
+typedef struct {
+  uint64_t *code;
+  uint     *idx;
+} mortondata;
+
+static    bool
+leq_morton(uint i, uint j, void *data)
+{
+  mortondata *md = (mortondata *) data;
+
+  return md->code[i] <= md->code[j];
+}
+
+static void
+swap_morton(uint i, uint j, void *data)
+{
+  mortondata *md = (mortondata *) data;
+  uint64_t  c;
+  uint      k;
+
+  c = md->code[i];
+  md->code[i] = md->code[j];
+  md->code[j] = c;
+
+  k = md->idx[i];
+  md->idx[i] = md->idx[j];
+  md->idx[j] = k;
+}
+
+void
+morton_reorder(uint n, uint dim, const real *x, uint *perm)
+{
+  mortondata md;
+  real      xmin[3], xmax[3], scale[3];
+  uint64_t  c, q;
+  uint      bits, i, j, b;
+
+  assert(dim > 0 && dim <= 3);
+
+  if (n == 0)
+    return;
+
+  bits = 63 / dim;
+  if (bits > 31)
+    bits = 31;
+
+  /* Bounding box */
+  for (j = 0; j < dim; j++) {
+    xmin[j] = xmax[j] = x[j];
+    for (i = 1; i < n; i++) {
+      xmin[j] = REAL_MIN(xmin[j], x[i * dim + j]);
+      xmax[j] = REAL_MAX(xmax[j], x[i * dim + j]);
+    }
+    scale[j] = (xmax[j] > xmin[j] ?
+		((real) ((1u << bits) - 1)) / (xmax[j] - xmin[j]) : 0.0);
+  }
+
+  /* Interleave the bits of the scaled coordinates */
+  md.code = (uint64_t *) allocmem(sizeof(uint64_t) * n);
+  md.idx = allocuint(n);
+  for (i = 0; i < n; i++) {
+    c = 0;
+    for (j = 0; j < dim; j++) {
+      q = (uint64_t) ((x[i * dim + j] - xmin[j]) * scale[j]);
+      for (b = 0; b < bits; b++)
+	c |= ((q >> b) & 1) << (b * dim + j);
+    }
+    md.code[i] = c;
+    md.idx[i] = i;
+  }
+
+  heapsort(n, leq_morton, swap_morton, &md);
+
+  for (i = 0; i < n; i++)
+    perm[md.idx[i]] = i;
+
+  freemem(md.idx);
+  freemem(md.code);
+}
+
+/* ------------------------------------------------------------
+ * Ordering by keys
+ * ------------------------------------------------------------ */
+
+void
+key_reorder(uint n, uint keys, const uint *key, uint *perm)
+{
+  uint     *start;
+  uint      i;
+
+  /* Counting sort */
+  start = allocuint(keys + 1);
+  for (i = 0; i <= keys; i++)
+    start[i] = 0;
+  for (i = 0; i < n; i++) {
+    assert(key[i] < keys);
+    start[key[i] + 1]++;
+  }
+  for (i = 0; i < keys; i++)
+    start[i + 1] += start[i];
+
+  for (i = 0; i < n; i++)
+    perm[i] = start[key[i]]++;
+
+  freemem(start);
+}
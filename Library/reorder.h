@@ -0,0 +1,80 @@
+/* ------------------------------------------------------------
+ * This is the file "reorder.h" of the H2Lib package.
+ * All rights reserved, Steffen Boerm 2016
+ * ------------------------------------------------------------ */
+
+/** @file reorder.h
+ *  @author Steffen B&ouml;rm */
+
+#ifndef REORDER_H
+#define REORDER_H
+
+/** @defgroup reorder reorder
+ *  @brief Orderings improving the locality of meshes and graphs.
+ *
+ *  The functions in this module compute permutations that can be
+ *  used, e.g., by @ref reorder_tet3d, @ref reorder_tri2d or
+ *  @ref reorder_surface3d to renumber the entities of a mesh.
+ *  All permutations are represented by an array <tt>perm</tt> such
+ *  that <tt>perm[i]</tt> is the new index of the entity with the old
+ *  index <tt>i</tt>.
+ *
+ *  @{ */
+
+#include "settings.h"
+
+/** @brief Strategies for reordering meshes. */
+typedef enum {
+  /** @brief Reverse Cuthill-McKee ordering of the vertex graph,
+   *  reduces the bandwidth of finite element matrices. */
+  H2_REORDER_RCM,
+  /** @brief Morton (Z-curve) ordering of the vertex coordinates,
+   *  keeps neighbouring vertices close in memory. */
+  H2_REORDER_MORTON
+} reordermode;
+
+/** @brief Reverse Cuthill-McKee ordering of a graph.
+ *
+ *  Every connected component is started at a pseudo-peripheral vertex
+ *  and traversed breadth-first, visiting neighbours by increasing
+ *  degree. The resulting order is reversed.
+ *
+ *  @param n Number of vertices.
+ *  @param edges Number of edges.
+ *  @param e Array of <tt>2*edges</tt> entries, edge <tt>i</tt> connects
+ *    the vertices <tt>e[2*i]</tt> and <tt>e[2*i+1]</tt>.
+ *  @param perm Array of <tt>n</tt> entries, will be overwritten by
+ *    the new indices of the vertices. */
+HEADER_PREFIX void
+rcm_reorder(uint n, uint edges, const uint *e, uint *perm);
+
+/** @brief Morton ordering of a point set.
+ *
+ *  The bounding box of the points is subdivided regularly, and the
+ *  points are sorted by interleaving the bits of their coordinates.
+ *
+ *  @param n Number of points.
+ *  @param dim Spatial dimension, at most <tt>3</tt>.
+ *  @param x Array of <tt>n*dim</tt> coordinates, point <tt>i</tt>
+ *    is given by <tt>x[i*dim]</tt> to <tt>x[i*dim+dim-1]</tt>.
+ *  @param perm Array of <tt>n</tt> entries, will be overwritten by
+ *    the new indices of the points. */
+HEADER_PREFIX void
+morton_reorder(uint n, uint dim, const real *x, uint *perm);
+
+/** @brief Stable ordering by integer keys.
+ *
+ *  Used to order edges, faces or elements of a mesh consistently with
+ *  its vertices, e.g., by the smallest new index of their vertices.
+ *
+ *  @param n Number of entities.
+ *  @param keys Upper bound for the keys.
+ *  @param key Array of <tt>n</tt> keys, all smaller than <tt>keys</tt>.
+ *  @param perm Array of <tt>n</tt> entries, will be overwritten by
+ *    the new indices of the entities. */
+HEADER_PREFIX void
+key_reorder(uint n, uint keys, const uint *key, uint *perm);
+
+/** @} */
+
+#endif
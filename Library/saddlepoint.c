@@ -0,0 +1,350 @@
+/* ------------------------------------------------------------
+ * This is the file "saddlepoint.c" of the H2Lib package.
+ * All rights reserved, Steffen Boerm 2016
+ * ------------------------------------------------------------ */
+
+#include "saddlepoint.h"
+
+#include "ddcluster.h"
+#include "harith.h"
+#include "krylov.h"
+#include "krylovsolvers.h"
+#include "basic.h"
+
+#include <assert.h>
+
+/* ------------------------------------------------------------
+ * Constructors and destructors
+ * ------------------------------------------------------------ */
+
+psaddlepoint
+new_saddlepoint(pcsparsematrix A, pcsparsematrix B, pclustergeometry cg,
+		uint clf, real eta, pctruncmode tm, real eps)
+{
+  psaddlepoint sp;
+  psparsematrix Bt;
+  pfield    dv;
+  uint     *flag;
+  uint      n2, i, j;
+
+  assert(A->rows == A->cols);
+  assert(B->cols == A->rows);
+
+  n2 = B->rows;
+
+  sp = (psaddlepoint) allocmem(sizeof(saddlepoint));
+  sp->A = A;
+  sp->B = B;
+
+  /* Inverted diagonal of A */
+  sp->dinv = new_avector(A->rows);
+  dv = sp->dinv->v;
+  for (i = 0; i < A->rows; i++) {
+    for (j = A->row[i]; j < A->row[i + 1] && A->col[j] != i; j++);
+    assert(j < A->row[i + 1]);
+    dv[i] = 1.0 / A->coeff[j];
+  }
+
+  /* S = B D^{-1} B^*, rows of B^* are scaled by D^{-1} */
+  Bt = new_adjoint_sparsematrix(B);
+  for (i = 0; i < Bt->rows; i++)
+    for (j = Bt->row[i]; j < Bt->row[i + 1]; j++)
+      Bt->coeff[j] *= dv[i];
+  sp->S = new_product_sparsematrix(B, Bt);
+  del_sparsematrix(Bt);
+
+  /* Domain decomposition cluster and block trees */
+  sp->idx = allocuint(n2);
+  flag = allocuint(n2);
+  for (i = 0; i < n2; i++) {
+    sp->idx[i] = i;
+    flag[i] = 0;
+  }
+  sp->root = build_adaptive_dd_cluster((pclustergeometry) cg, n2, sp->idx,
+				       clf, sp->S, cg->dim, flag);
+  freemem(flag);
+  sp->broot = build_nonstrict_block(sp->root, sp->root, &eta,
+				    admissible_dd_cluster);
+
+  /* H-Cholesky factorization, keeps the preconditioner self-adjoint */
+  sp->L = build_from_block_hmatrix(sp->broot, 0);
+  copy_sparsematrix_hmatrix(sp->S, sp->L);
+  choldecomp_hmatrix(sp->L, tm, eps);
+
+  sp->inner_eps = 1.0e-12;
+  sp->inner_maxiter = 0;
+
+  return sp;
+}
+
+void
+del_saddlepoint(psaddlepoint sp)
+{
+  del_hmatrix(sp->L);
+  del_block(sp->broot);
+  del_cluster(sp->root);
+  freemem(sp->idx);
+  del_sparsematrix(sp->S);
+  del_avector(sp->dinv);
+  freemem(sp);
+}
+
+/* ------------------------------------------------------------
+ * Preconditioners
+ * ------------------------------------------------------------ */
+
+void
+prcd_schur_saddlepoint(pcsaddlepoint sp, pavector r2)
+{
+  cholsolve_hmatrix_avector(sp->L, r2);
+}
+
+static void
+prcd_diag(void *pdata, pavector r)
+{
+  pcavector dinv = (pcavector) pdata;
+  uint      i;
+
+  assert(r->dim == dinv->dim);
+
+  for (i = 0; i < r->dim; i++)
+    r->v[i] *= dinv->v[i];
+}
+
+void
+solve_A_saddlepoint(pcsaddlepoint sp, pavector x1)
+{
+  pavector  b1;
+
+  b1 = new_avector(x1->dim);
+  copy_avector(x1, b1);
+  clear_avector(x1);
+
+  (void) solve_pcg_sparsematrix_avector(sp->A, prcd_diag, sp->dinv, b1, x1,
+					sp->inner_eps, sp->inner_maxiter);
+
+  del_avector(b1);
+}
+
+/* ------------------------------------------------------------
+ * Solvers
+ * ------------------------------------------------------------ */
+
+uint
+solve_uzawa_saddlepoint(pcsaddlepoint sp, pcavector b1, pcavector b2,
+			pavector x1, pavector x2, real eps, uint maxiter)
+{
+  pavector  r2, q2, p2, a1, s2;
+  real      norm, norm0;
+  uint      i;
+
+  assert(b1->dim == sp->A->rows);
+  assert(b2->dim == sp->B->rows);
+
+  r2 = new_avector(b2->dim);
+  q2 = new_avector(b2->dim);
+  p2 = new_avector(b2->dim);
+  a1 = new_avector(b1->dim);
+  s2 = new_avector(b2->dim);
+
+  init_puzawa((prcd_t) solve_A_saddlepoint, (void *) sp,
+	      (mvm_t) mvm_sparsematrix_avector, (void *) sp->B,
+	      (prcd_t) prcd_schur_saddlepoint, (void *) sp, b1, b2, x1, x2,
+	      r2, q2, p2, a1, s2);
+  norm0 = norm2_avector(r2);
+  norm = norm0;
+
+  for (i = 0; norm > eps * norm0 && (maxiter == 0 || i < maxiter); i++) {
+    step_puzawa((prcd_t) solve_A_saddlepoint, (void *) sp,
+		(mvm_t) mvm_sparsematrix_avector, (void *) sp->B,
+		(prcd_t) prcd_schur_saddlepoint, (void *) sp, b1, b2, x1, x2,
+		r2, q2, p2, a1, s2);
+    norm = norm2_avector(r2);
+  }
+
+  del_avector(s2);
+  del_avector(a1);
+  del_avector(p2);
+  del_avector(q2);
+  del_avector(r2);
+
+  return i;
+}
+
+/* y = K x with the saddle point matrix K */
+static void
+eval_block(pcsaddlepoint sp, pavector x, pavector y)
+{
+  avector   tmp1, tmp2, tmp3, tmp4;
+  pavector  x1, x2, y1, y2;
+  uint      n1 = sp->A->rows;
+  uint      n2 = sp->B->rows;
+
+  x1 = init_sub_avector(&tmp1, x, n1, 0);
+  x2 = init_sub_avector(&tmp2, x, n2, n1);
+  y1 = init_sub_avector(&tmp3, y, n1, 0);
+  y2 = init_sub_avector(&tmp4, y, n2, n1);
+
+  clear_avector(y);
+  addeval_sparsematrix_avector(1.0, sp->A, x1, y1);
+  addevaltrans_sparsematrix_avector(1.0, sp->B, x2, y1);
+  addeval_sparsematrix_avector(1.0, sp->B, x1, y2);
+
+  uninit_avector(y2);
+  uninit_avector(y1);
+  uninit_avector(x2);
+  uninit_avector(x1);
+}
+
+/* Block-diagonal preconditioner diag(D^{-1}, S^{-1}) */
+static void
+prcd_block(pcsaddlepoint sp, pavector r)
+{
+  avector   tmp1, tmp2;
+  pavector  r1, r2;
+  uint      n1 = sp->A->rows;
+  uint      n2 = sp->B->rows;
+
+  r1 = init_sub_avector(&tmp1, r, n1, 0);
+  r2 = init_sub_avector(&tmp2, r, n2, n1);
+
+  prcd_diag(sp->dinv, r1);
+  prcd_schur_saddlepoint(sp, r2);
+
+  uninit_avector(r2);
+  uninit_avector(r1);
+}
+
+uint
+solve_minres_saddlepoint(pcsaddlepoint sp, pcavector b1, pcavector b2,
+			 pavector x1, pavector x2, real eps, uint maxiter)
+{
+  pavector  x, v_old, v, v_new, z, z_new, w_old, w, w_new, h, t;
+  avector   tmp1, tmp2;
+  pavector  xs;
+  real      gamma_old, gamma, gamma_new, delta;
+  real      c_old, c, c_new, s_old, s, s_new;
+  real      alpha0, alpha1, alpha2, alpha3, eta, eta0;
+  uint      n1 = sp->A->rows;
+  uint      n2 = sp->B->rows;
+  uint      n = n1 + n2;
+  uint      i;
+
+  assert(b1->dim == n1 && x1->dim == n1);
+  assert(b2->dim == n2 && x2->dim == n2);
+
+  x = new_avector(n);
+  v_old = new_zero_avector(n);
+  v = new_avector(n);
+  v_new = new_avector(n);
+  z = new_avector(n);
+  z_new = new_avector(n);
+  w_old = new_zero_avector(n);
+  w = new_zero_avector(n);
+  w_new = new_avector(n);
+  h = new_avector(n);
+
+  xs = init_sub_avector(&tmp1, x, n1, 0);
+  copy_avector(x1, xs);
+  uninit_avector(xs);
+  xs = init_sub_avector(&tmp1, x, n2, n1);
+  copy_avector(x2, xs);
+  uninit_avector(xs);
+
+  /* v = b - K x */
+  eval_block(sp, x, v);
+  scale_avector(-1.0, v);
+  xs = init_sub_avector(&tmp1, v, n1, 0);
+  add_avector(1.0, b1, xs);
+  uninit_avector(xs);
+  xs = init_sub_avector(&tmp1, v, n2, n1);
+  add_avector(1.0, b2, xs);
+  uninit_avector(xs);
+
+  /* z = P^{-1} v */
+  copy_avector(v, z);
+  prcd_block(sp, z);
+  gamma = REAL_SQRT(REAL(dotprod_avector(z, v)));
+  gamma_old = 1.0;
+
+  eta = eta0 = gamma;
+  c_old = c = 1.0;
+  s_old = s = 0.0;
+
+  for (i = 0; REAL_ABS(eta) > eps * eta0 && (maxiter == 0 || i < maxiter);
+       i++) {
+    scale_avector(1.0 / gamma, z);
+
+    /* Lanczos step for the preconditioned matrix */
+    eval_block(sp, z, h);
+    delta = REAL(dotprod_avector(h, z));
+
+    copy_avector(h, v_new);
+    add_avector(-delta / gamma, v, v_new);
+    add_avector(-gamma / gamma_old, v_old, v_new);
+
+    copy_avector(v_new, z_new);
+    prcd_block(sp, z_new);
+    gamma_new = REAL_SQRT(REAL(dotprod_avector(z_new, v_new)));
+
+    /* Givens rotations */
+    alpha0 = c * delta - c_old * s * gamma;
+    alpha1 = REAL_SQRT(alpha0 * alpha0 + gamma_new * gamma_new);
+    alpha2 = s * delta + c_old * c * gamma;
+    alpha3 = s_old * gamma;
+
+    c_new = alpha0 / alpha1;
+    s_new = gamma_new / alpha1;
+
+    /* Update of the search direction and the solution */
+    copy_avector(z, w_new);
+    add_avector(-alpha3, w_old, w_new);
+    add_avector(-alpha2, w, w_new);
+    scale_avector(1.0 / alpha1, w_new);
+
+    add_avector(c_new * eta, w_new, x);
+    eta = -s_new * eta;
+
+    /* Shift vectors and coefficients */
+    t = v_old;
+    v_old = v;
+    v = v_new;
+    v_new = t;
+
+    t = z;
+    z = z_new;
+    z_new = t;
+
+    t = w_old;
+    w_old = w;
+    w = w_new;
+    w_new = t;
+
+    gamma_old = gamma;
+    gamma = gamma_new;
+    c_old = c;
+    c = c_new;
+    s_old = s;
+    s = s_new;
+  }
+
+  xs = init_sub_avector(&tmp1, x, n1, 0);
+  copy_avector(xs, x1);
+  uninit_avector(xs);
+  xs = init_sub_avector(&tmp2, x, n2, n1);
+  copy_avector(xs, x2);
+  uninit_avector(xs);
+
+  del_avector(h);
+  del_avector(w_new);
+  del_avector(w);
+  del_avector(w_old);
+  del_avector(z_new);
+  del_avector(z);
+  del_avector(v_new);
+  del_avector(v);
+  del_avector(v_old);
+  del_avector(x);
+
+  return i;
+}
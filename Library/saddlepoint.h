@@ -0,0 +1,188 @@
+/* ------------------------------------------------------------
+ * This is the file "saddlepoint.h" of the H2Lib package.
+ * All rights reserved, Steffen Boerm 2016
+ * ------------------------------------------------------------ */
+
+/** @file saddlepoint.h
+ *  @author Steffen B&ouml;rm */
+
+#ifndef SADDLEPOINT_H
+#define SADDLEPOINT_H
+
+/** @defgroup saddlepoint saddlepoint
+ *  @brief Solvers for sparse saddle point systems.
+ *
+ *  The @ref saddlepoint class solves systems of the form
+ *  @f[ \begin{pmatrix} A & B^*\\ B & \end{pmatrix}
+ *      \begin{pmatrix} x_1\\ x_2 \end{pmatrix}
+ *    = \begin{pmatrix} b_1\\ b_2 \end{pmatrix}, @f]
+ *  e.g., the Darcy systems assembled by
+ *  @ref assemble_tet3drt0_darcy_A_sparsematrix and
+ *  @ref assemble_tet3drt0_darcy_B_sparsematrix.
+ *
+ *  The Schur complement @f$B A^{-1} B^*@f$ is approximated by the
+ *  sparse matrix @f$S = B D^{-1} B^*@f$ with the diagonal @f$D@f$ of
+ *  @f$A@f$. @f$S@f$ is converted into a hierarchical matrix using a
+ *  domain decomposition cluster tree and factorized by the
+ *  H-Cholesky decomposition. Its inverse is used as a preconditioner
+ *  either in the preconditioned Uzawa iteration or, together with
+ *  @f$D^{-1}@f$, as a block-diagonal preconditioner for MINRES.
+ *  @{ */
+
+/** @brief Saddle point solver. */
+typedef struct _saddlepoint saddlepoint;
+
+/** @brief Pointer to @ref saddlepoint object. */
+typedef saddlepoint *psaddlepoint;
+
+/** @brief Pointer to constant @ref saddlepoint object. */
+typedef const saddlepoint *pcsaddlepoint;
+
+#include "sparsematrix.h"
+#include "clustergeometry.h"
+#include "block.h"
+#include "hmatrix.h"
+#include "truncation.h"
+
+/** @brief Saddle point solver. */
+struct _saddlepoint {
+  /** @brief Upper left block, self-adjoint and positive definite. */
+  pcsparsematrix A;
+
+  /** @brief Lower left block. */
+  pcsparsematrix B;
+
+  /** @brief Inverted diagonal of @f$A@f$. */
+  pavector dinv;
+
+  /** @brief Approximation @f$B D^{-1} B^*@f$ of the Schur complement. */
+  psparsematrix S;
+
+  /** @brief Index array for the cluster tree of @f$S@f$. */
+  uint *idx;
+
+  /** @brief Domain decomposition cluster tree for @f$S@f$. */
+  pcluster root;
+
+  /** @brief Block tree for @f$S@f$. */
+  pblock broot;
+
+  /** @brief H-Cholesky factor of @f$S@f$. */
+  phmatrix L;
+
+  /** @brief Relative accuracy of the inner solver for @f$A@f$ used
+   *  by the Uzawa iteration. */
+  real inner_eps;
+
+  /** @brief Maximal number of inner iterations, <tt>0</tt> means
+   *  no bound. */
+  uint inner_maxiter;
+};
+
+/* ------------------------------------------------------------
+ * Constructors and destructors
+ * ------------------------------------------------------------ */
+
+/** @brief Create a saddle point solver.
+ *
+ *  Computes @f$S = B D^{-1} B^*@f$, clusters its indices by
+ *  @ref build_adaptive_dd_cluster, converts it into an
+ *  @ref hmatrix and computes its H-Cholesky factorization.
+ *
+ *  @param A Upper left block, has to be kept alive as long as the
+ *    solver is used.
+ *  @param B Lower left block, has to be kept alive as long as the
+ *    solver is used.
+ *  @param cg Geometry of the indices of @f$x_2@f$, e.g., constructed
+ *    by @ref build_tet3drt0_B_clustergeometry.
+ *  @param clf Maximal leaf size.
+ *  @param eta Admissibility parameter.
+ *  @param tm Truncation mode.
+ *  @param eps Truncation accuracy of the H-Cholesky factorization.
+ *  @returns New @ref saddlepoint object. */
+HEADER_PREFIX psaddlepoint
+new_saddlepoint(pcsparsematrix A, pcsparsematrix B, pclustergeometry cg,
+		uint clf, real eta, pctruncmode tm, real eps);
+
+/** @brief Delete a saddle point solver.
+ *
+ *  @param sp Object to be deleted. */
+HEADER_PREFIX void
+del_saddlepoint(psaddlepoint sp);
+
+/* ------------------------------------------------------------
+ * Preconditioners
+ * ------------------------------------------------------------ */
+
+/** @brief Apply the inverse of the Schur complement approximation,
+ *  @f$r_2 \gets S^{-1} r_2@f$.
+ *
+ *  Can be cast to @ref prcd_t.
+ *
+ *  @param sp Saddle point solver.
+ *  @param r2 Vector, will be overwritten. */
+HEADER_PREFIX void
+prcd_schur_saddlepoint(pcsaddlepoint sp, pavector r2);
+
+/** @brief Solve @f$A x_1 = b_1@f$ by the conjugate gradient method
+ *  with diagonal preconditioning.
+ *
+ *  The accuracy is controlled by <tt>inner_eps</tt> and
+ *  <tt>inner_maxiter</tt>. Can be cast to @ref prcd_t.
+ *
+ *  @param sp Saddle point solver.
+ *  @param x1 Right-hand side, will be overwritten by the solution. */
+HEADER_PREFIX void
+solve_A_saddlepoint(pcsaddlepoint sp, pavector x1);
+
+/* ------------------------------------------------------------
+ * Solvers
+ * ------------------------------------------------------------ */
+
+/** @brief Solve the saddle point system by the preconditioned Uzawa
+ *  iteration, i.e., the conjugate gradient method for the Schur
+ *  complement preconditioned by @ref prcd_schur_saddlepoint.
+ *
+ *  @param sp Saddle point solver.
+ *  @param b1 First right-hand side @f$b_1@f$.
+ *  @param b2 Second right-hand side @f$b_2@f$.
+ *  @param x1 First component of the solution @f$x_1@f$, will be
+ *    overwritten.
+ *  @param x2 Second component of the solution @f$x_2@f$, initial
+ *    guess, will be overwritten.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *    the residual @f$r_2 = B x_1 - b_2@f$ of the Schur complement
+ *    system satisfies @f$\|r_2\|_2 \leq \epsilon \|r_2^{(0)}\|_2@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *    means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_uzawa_saddlepoint(pcsaddlepoint sp, pcavector b1, pcavector b2,
+			pavector x1, pavector x2, real eps, uint maxiter);
+
+/** @brief Solve the saddle point system by the preconditioned
+ *  MINRES method.
+ *
+ *  The block-diagonal preconditioner consists of @f$D^{-1}@f$ and
+ *  @ref prcd_schur_saddlepoint, so no inner iteration is required.
+ *
+ *  @param sp Saddle point solver.
+ *  @param b1 First right-hand side @f$b_1@f$.
+ *  @param b2 Second right-hand side @f$b_2@f$.
+ *  @param x1 First component of the solution @f$x_1@f$, initial
+ *    guess, will be overwritten.
+ *  @param x2 Second component of the solution @f$x_2@f$, initial
+ *    guess, will be overwritten.
+ *  @param eps Relative accuracy @f$\epsilon@f$, the method stops if
+ *    the preconditioned residual norm has been reduced by
+ *    @f$\epsilon@f$.
+ *  @param maxiter Maximal number of iterations. <tt>maxiter=0</tt>
+ *    means that the number of iterations is not bounded.
+ *  @returns Number of iterations. */
+HEADER_PREFIX uint
+solve_minres_saddlepoint(pcsaddlepoint sp, pcavector b1, pcavector b2,
+			 pavector x1, pavector x2, real eps, uint maxiter);
+
+/** @} */
+
+#endif
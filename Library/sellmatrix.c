@@ -0,0 +1,344 @@
+/* ------------------------------------------------------------
+ * This is the file "sellmatrix.c" of the H2Lib package.
+ * All rights reserved, Steffen Boerm 2015
+ * ------------------------------------------------------------ */
+
+#include "sellmatrix.h"
+
+#include <assert.h>
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+/* ------------------------------------------------------------
+ * Constructors and destructors
+ * ------------------------------------------------------------ */
+
+typedef struct {
+  const uint *row;
+  uint     *perm;
+} sortrows;
+
+static    bool
+geq_rowlength(uint i, uint j, void *data)
+{
+  sortrows *sr = (sortrows *) data;
+  const uint *row = sr->row;
+  uint      pi = sr->perm[i];
+  uint      pj = sr->perm[j];
+
+  return (row[pi + 1] - row[pi] >= row[pj + 1] - row[pj]);
+}
+
+static void
+swap_rowlength(uint i, uint j, void *data)
+{
+  sortrows *sr = (sortrows *) data;
+  uint      h;
+
+  h = sr->perm[i];
+  sr->perm[i] = sr->perm[j];
+  sr->perm[j] = h;
+}
+
+psellmatrix
+new_sparsematrix_sellmatrix(pcsparsematrix a, uint chunk, uint sigma)
+{
+  psellmatrix s;
+  sortrows  sr;
+  const uint *row = a->row;
+  uint      rows = a->rows;
+  uint      chunks, prows, entries;
+  uint      i, k, w, r, off;
+
+  assert(chunk > 0);
+
+  /* Round sigma up to a multiple of the chunk size */
+  if (sigma < chunk)
+    sigma = chunk;
+  sigma = (sigma + chunk - 1) / chunk * chunk;
+
+  chunks = (rows + chunk - 1) / chunk;
+  prows = chunks * chunk;
+
+  s = (psellmatrix) allocmem(sizeof(sellmatrix));
+  s->rows = rows;
+  s->cols = a->cols;
+  s->chunk = chunk;
+  s->sigma = sigma;
+  s->chunks = chunks;
+  s->perm = allocuint(prows);
+  s->start = allocuint(chunks + 1);
+  s->width = allocuint(chunks);
+
+  /* Sort rows by decreasing length within windows of sigma rows */
+  for (i = 0; i < rows; i++)
+    s->perm[i] = i;
+  sr.row = row;
+  for (i = 0; i < rows; i += sigma) {
+    sr.perm = s->perm + i;
+    heapsort((rows - i < sigma ? rows - i : sigma), geq_rowlength,
+	     swap_rowlength, &sr);
+  }
+  for (i = rows; i < prows; i++)
+    s->perm[i] = rows;
+
+  /* Determine the widths of the chunks */
+  entries = 0;
+  for (k = 0; k < chunks; k++) {
+    w = 0;
+    for (i = k * chunk; i < (k + 1) * chunk; i++) {
+      r = s->perm[i];
+      if (r < rows && row[r + 1] - row[r] > w)
+	w = row[r + 1] - row[r];
+    }
+    s->start[k] = entries;
+    s->width[k] = w;
+    entries += w * chunk;
+  }
+  s->start[chunks] = entries;
+
+  s->col = allocuint(entries);
+  s->coeff = allocfield(entries);
+
+  /* Accumulators for the transposed product */
+#ifdef USE_OPENMP
+  s->threads = omp_get_max_threads();
+#else
+  s->threads = 1;
+#endif
+  s->acc = (s->threads > 1 && s->cols > 0 ?
+	    allocfield((size_t) s->cols * s->threads) : NULL);
+
+  /* Fill column indices, padding refers to the first column.
+   * Padding only appears in chunks containing a non-empty row, so the
+   * first column exists whenever it is referenced. */
+  assert(entries == 0 || a->cols > 0);
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,w,r,off)
+#endif
+  for (k = 0; k < chunks; k++)
+    for (i = 0; i < chunk; i++) {
+      r = s->perm[k * chunk + i];
+      off = s->start[k] + i;
+      for (w = 0; w < s->width[k]; w++) {
+	s->col[off + w * chunk] = (r < rows && w < row[r + 1] - row[r] ?
+				   a->col[row[r] + w] : 0);
+      }
+    }
+
+  update_sparsematrix_sellmatrix(a, s);
+
+  return s;
+}
+
+void
+del_sellmatrix(psellmatrix s)
+{
+  if (s->acc)
+    freemem(s->acc);
+  freemem(s->coeff);
+  freemem(s->col);
+  freemem(s->width);
+  freemem(s->start);
+  freemem(s->perm);
+  freemem(s);
+}
+
+void
+update_sparsematrix_sellmatrix(pcsparsematrix a, psellmatrix s)
+{
+  const uint *row = a->row;
+  uint      rows = s->rows;
+  uint      chunk = s->chunk;
+  uint      i, k, w, r, off;
+
+  assert(a->rows == s->rows);
+  assert(a->cols == s->cols);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,w,r,off)
+#endif
+  for (k = 0; k < s->chunks; k++)
+    for (i = 0; i < chunk; i++) {
+      r = s->perm[k * chunk + i];
+      off = s->start[k] + i;
+      for (w = 0; w < s->width[k]; w++) {
+	s->coeff[off + w * chunk] = (r < rows && w < row[r + 1] - row[r] ?
+				     a->coeff[row[r] + w] : 0.0);
+      }
+    }
+}
+
+/* ------------------------------------------------------------
+ * Statistics
+ * ------------------------------------------------------------ */
+
+size_t
+getsize_sellmatrix(pcsellmatrix s)
+{
+  size_t    sz;
+
+  sz = (size_t) sizeof(sellmatrix);
+  sz += (size_t) sizeof(uint) * s->chunks * s->chunk;
+  sz += (size_t) sizeof(uint) * (2 * s->chunks + 1);
+  sz += (size_t) sizeof(uint) * s->start[s->chunks];
+  sz += (size_t) sizeof(field) * s->start[s->chunks];
+  if (s->acc)
+    sz += (size_t) sizeof(field) * s->cols * s->threads;
+
+  return sz;
+}
+
+/* ------------------------------------------------------------
+ * Basic linear algebra
+ * ------------------------------------------------------------ */
+
+void
+addeval_sellmatrix_avector(field alpha, pcsellmatrix s, pcavector x,
+			   pavector y)
+{
+  uint      chunk = s->chunk;
+  uint      rows = s->rows;
+  pcfield   xv = x->v;
+  pfield    yv = y->v;
+  pfield    sum;
+  const uint *col;
+  pcfield   coeff;
+  uint      i, k, w, r;
+
+  assert(x->dim == s->cols);
+  assert(y->dim == s->rows);
+
+#ifdef USE_OPENMP
+#pragma omp parallel private(sum,col,coeff,i,w,r)
+#endif
+  {
+    sum = allocfield(chunk);
+
+#ifdef USE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (k = 0; k < s->chunks; k++) {
+      col = s->col + s->start[k];
+      coeff = s->coeff + s->start[k];
+
+      for (i = 0; i < chunk; i++)
+	sum[i] = 0.0;
+
+      /* All rows of the chunk are processed simultaneously */
+      for (w = 0; w < s->width[k]; w++) {
+#ifdef USE_OPENMP
+#pragma omp simd
+#endif
+	for (i = 0; i < chunk; i++)
+	  sum[i] += coeff[w * chunk + i] * xv[col[w * chunk + i]];
+      }
+
+      for (i = 0; i < chunk; i++) {
+	r = s->perm[k * chunk + i];
+	if (r < rows)
+	  yv[r] += alpha * sum[i];
+      }
+    }
+
+    freemem(sum);
+  }
+}
+
+void
+addevaltrans_sellmatrix_avector(field alpha, pcsellmatrix s, pcavector x,
+				pavector y)
+{
+  uint      chunk = s->chunk;
+  uint      rows = s->rows;
+  uint      cols = s->cols;
+  pcfield   xv = x->v;
+  pfield    yv = y->v;
+  pfield    acc;
+  const uint *col;
+  pcfield   coeff;
+  field     val;
+  uint      nthreads;
+  uint      i, j, k, w, r;
+
+  assert(x->dim == s->rows);
+  assert(y->dim == s->cols);
+
+#ifdef USE_OPENMP
+  nthreads = (omp_in_parallel() ? 1 : omp_get_max_threads());
+#else
+  nthreads = 1;
+#endif
+  if (s->acc == NULL)
+    nthreads = 1;
+  else if (nthreads > s->threads)
+    nthreads = s->threads;
+
+  /* Every thread accumulates its contributions in a private vector
+   * provided by the matrix */
+  acc = (nthreads > 1 ? s->acc : yv);
+
+#ifdef USE_OPENMP
+#pragma omp parallel private(col,coeff,val,i,j,w,r) num_threads(nthreads)
+#endif
+  {
+    pfield    ya;
+    uint      tid, nt;
+
+#ifdef USE_OPENMP
+    tid = omp_get_thread_num();
+    nt = omp_get_num_threads();
+#else
+    tid = 0;
+    nt = 1;
+#endif
+
+    ya = yv;
+    if (nthreads > 1) {
+      ya = acc + (size_t) cols * tid;
+      for (j = 0; j < cols; j++)
+	ya[j] = 0.0;
+    }
+
+#ifdef USE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (k = 0; k < s->chunks; k++) {
+      col = s->col + s->start[k];
+      coeff = s->coeff + s->start[k];
+
+      for (i = 0; i < chunk; i++) {
+	r = s->perm[k * chunk + i];
+	if (r < rows) {
+	  val = (nthreads > 1 ? xv[r] : alpha * xv[r]);
+	  for (w = 0; w < s->width[k]; w++)
+	    ya[col[w * chunk + i]] += CONJ(coeff[w * chunk + i]) * val;
+	}
+      }
+    }
+
+    if (nthreads > 1) {
+#ifdef USE_OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (j = 0; j < cols; j++) {
+	val = 0.0;
+	for (i = 0; i < nt; i++)
+	  val += acc[(size_t) cols * i + j];
+	yv[j] += alpha * val;
+      }
+    }
+  }
+}
+
+void
+mvm_sellmatrix_avector(field alpha, bool trans, pcsellmatrix s,
+		       pcavector x, pavector y)
+{
+  if (trans)
+    addevaltrans_sellmatrix_avector(alpha, s, x, y);
+  else
+    addeval_sellmatrix_avector(alpha, s, x, y);
+}
@@ -0,0 +1,171 @@
+/* ------------------------------------------------------------
+ * This is the file "sellmatrix.h" of the H2Lib package.
+ * All rights reserved, Steffen Boerm 2015
+ * ------------------------------------------------------------ */
+
+/** @file sellmatrix.h
+ *  @author Steffen B&ouml;rm */
+
+#ifndef SELLMATRIX_H
+#define SELLMATRIX_H
+
+/** @defgroup sellmatrix sellmatrix
+ *  @brief Representation of a sparse matrix in sliced ELLPACK format.
+ *
+ *  The @ref sellmatrix class stores a copy of a @ref sparsematrix
+ *  in the SELL-C-@f$\sigma@f$ format: rows are sorted by their
+ *  lengths within windows of @f$\sigma@f$ rows, grouped into chunks
+ *  of @f$C@f$ rows, and the entries of each chunk are stored
+ *  column-major and padded to the length of its longest row.
+ *  This allows matrix-vector multiplications to process @f$C@f$ rows
+ *  simultaneously in SIMD units.
+ *
+ *  @{ */
+
+/** @brief Representation of a sparse matrix in sliced ELLPACK format. */
+typedef struct _sellmatrix sellmatrix;
+
+/** @brief Pointer to @ref sellmatrix object. */
+typedef sellmatrix *psellmatrix;
+
+/** @brief Pointer to constant @ref sellmatrix object. */
+typedef const sellmatrix *pcsellmatrix;
+
+#include "sparsematrix.h"
+
+/** @brief Representation of a sparse matrix in sliced ELLPACK format.
+ *
+ *  The rows are permuted and split into chunks of <tt>chunk</tt>
+ *  rows. Chunk <tt>k</tt> contains the rows
+ *  <tt>perm[k*chunk]</tt> to <tt>perm[k*chunk+chunk-1]</tt> of the
+ *  original matrix and is stored as a <tt>chunk</tt>
+ *  @f$\times@f$ <tt>width[k]</tt> matrix in column-major order
+ *  starting at <tt>start[k]</tt> in <tt>col</tt> and <tt>coeff</tt>.
+ *  Padding entries have the coefficient zero. */
+struct _sellmatrix {
+  /** @brief Number of rows. */
+  uint rows;
+  /** @brief Number of columns. */
+  uint cols;
+
+  /** @brief Number of rows per chunk, @f$C@f$. */
+  uint chunk;
+  /** @brief Number of rows sorted by length, @f$\sigma@f$. */
+  uint sigma;
+  /** @brief Number of chunks. */
+  uint chunks;
+
+  /** @brief Original row indices of the permuted rows,
+   *  padded with <tt>rows</tt> for the last chunk. */
+  uint *perm;
+  /** @brief Starting indices of the chunks in @c col and @c coeff. */
+  uint *start;
+  /** @brief Number of entries in the longest row of each chunk. */
+  uint *width;
+
+  /** @brief Column indices, including padding. */
+  uint *col;
+  /** @brief Coefficients, including padding. */
+  pfield coeff;
+
+  /** @brief Number of threads <tt>acc</tt> provides room for. */
+  uint threads;
+  /** @brief Private accumulators for the threads of
+   *  @ref addevaltrans_sellmatrix_avector, <tt>cols</tt> entries per
+   *  thread, or <tt>NULL</tt> if only one thread is used. */
+  pfield acc;
+};
+
+/* ------------------------------------------------------------ *
+ * Constructors and destructors                                 *
+ * ------------------------------------------------------------ */
+
+/** @brief Create a @ref sellmatrix copy of a @ref sparsematrix.
+ *
+ *  @remark Should always be matched by a call to @ref del_sellmatrix.
+ *
+ *  @param a Source matrix.
+ *  @param chunk Number of rows per chunk @f$C@f$, should be a
+ *    multiple of the SIMD width.
+ *  @param sigma Number of rows sorted by length @f$\sigma@f$, rounded
+ *    up to a multiple of <tt>chunk</tt>. Larger values reduce the
+ *    padding, but also the locality of the access to the result vector.
+ *  @returns New @ref sellmatrix object with the same entries as
+ *    <tt>a</tt>. */
+HEADER_PREFIX psellmatrix
+new_sparsematrix_sellmatrix(pcsparsematrix a, uint chunk, uint sigma);
+
+/** @brief Delete a @ref sellmatrix object.
+ *
+ *  @param s Object to be deleted. */
+HEADER_PREFIX void
+del_sellmatrix(psellmatrix s);
+
+/** @brief Copy the coefficients of a @ref sparsematrix into a
+ *  @ref sellmatrix.
+ *
+ *  Useful if the coefficients of <tt>a</tt> have been assembled again,
+ *  e.g., in a time-stepping scheme.
+ *
+ *  @param a Source matrix, has to have the same sparsity pattern
+ *    as the matrix used to construct <tt>s</tt>.
+ *  @param s Target matrix. */
+HEADER_PREFIX void
+update_sparsematrix_sellmatrix(pcsparsematrix a, psellmatrix s);
+
+/* ------------------------------------------------------------ *
+ * Statistics                                                   *
+ * ------------------------------------------------------------ */
+
+/** @brief Get size of a given @ref sellmatrix object.
+ *
+ *  @param s Target matrix.
+ *  @returns Size of allocated storage in bytes. */
+HEADER_PREFIX size_t
+getsize_sellmatrix(pcsellmatrix s);
+
+/* ------------------------------------------------------------ *
+ * Basic linear algebra                                         *
+ * ------------------------------------------------------------ */
+
+/** @brief Matrix-vector multiplication
+ *  @f$y \gets y + \alpha S x@f$.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param s Matrix @f$S@f$.
+ *  @param x Source vector @f$x@f$.
+ *  @param y Target vector @f$y@f$. */
+HEADER_PREFIX void
+addeval_sellmatrix_avector(field alpha, pcsellmatrix s, pcavector x,
+			   pavector y);
+
+/** @brief Adjoint matrix-vector multiplication
+ *  @f$y \gets y + \alpha S^* x@f$.
+ *
+ *  Outside of parallel regions, the threads accumulate their
+ *  contributions in the buffer <tt>s->acc</tt>, so the function must
+ *  not be called for the same matrix by concurrent threads.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param s Matrix @f$S@f$.
+ *  @param x Source vector @f$x@f$.
+ *  @param y Target vector @f$y@f$. */
+HEADER_PREFIX void
+addevaltrans_sellmatrix_avector(field alpha, pcsellmatrix s, pcavector x,
+				pavector y);
+
+/** @brief Matrix-vector multiplication
+ *  @f$y \gets y + \alpha S x@f$ or @f$y \gets y + \alpha S^* x@f$.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param trans Set if @f$S^*@f$ is to be used instead of @f$S@f$.
+ *  @param s Matrix @f$S@f$.
+ *  @param x Source vector @f$x@f$.
+ *  @param y Target vector @f$y@f$. */
+HEADER_PREFIX void
+mvm_sellmatrix_avector(field alpha, bool trans, pcsellmatrix s,
+		       pcavector x, pavector y);
+
+/** @} */
+
+#endif
@@ -9,10 +9,30 @@
 #include <assert.h>
 #include <stdio.h>
 
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
 /* ------------------------------------------------------------
  * Constructors and destructors
  * ------------------------------------------------------------ */
 
+/* Last generation handed out, zero is reserved for "no matrix" */
+static size_t lastgen = 0;
+
+static size_t
+newgen(void)
+{
+  size_t    gen;
+
+#ifdef USE_OPENMP
+#pragma omp atomic capture
+#endif
+  gen = ++lastgen;
+
+  return gen;
+}
+
 psparsematrix
 new_raw_sparsematrix(uint rows, uint cols, uint nz)
 {
@@ -28,6 +48,7 @@ new_raw_sparsematrix(uint rows, uint cols, uint nz)
   sp->rows = rows;
   sp->cols = cols;
   sp->nz = nz;
+  sp->gen = newgen();
 
   for (i = 0; i < rows + 1; ++i) {
     sp->row[i] = 0;
@@ -53,6 +74,7 @@ new_identity_sparsematrix(uint rows, uint cols)
   sp->rows = rows;
   sp->cols = cols;
   sp->nz = n;
+  sp->gen = newgen();
 
   for (i = 0; i < n; ++i) {
     sp->row[i] = i;
@@ -66,6 +88,28 @@ new_identity_sparsematrix(uint rows, uint cols)
   return sp;
 }
 
+/* Sort the column indices of one row in ascending order, then move the
+ * diagonal entry to the front, keeping the others sorted. */
+static void
+sort_row(uint i, uint *col, uint n)
+{
+  uint      j, k, c;
+
+  for (j = 1; j < n; j++) {
+    c = col[j];
+    for (k = j; k > 0 && col[k - 1] > c; k--)
+      col[k] = col[k - 1];
+    col[k] = c;
+  }
+
+  for (j = 0; j < n && col[j] != i; j++);
+  if (j < n) {
+    for (k = j; k > 0; k--)
+      col[k] = col[k - 1];
+    col[0] = i;
+  }
+}
+
 psparsematrix
 new_zero_sparsematrix(psparsepattern sp)
 {
@@ -109,12 +153,338 @@ new_zero_sparsematrix(psparsepattern sp)
   assert(j == nz);
   row[i] = j;
 
-  /* Ensure that diagonal entries come first */
-  sort_sparsematrix(A);
+  /* Ensure that diagonal entries come first, followed by the remaining
+     entries in ascending order */
+  for (i = 0; i < rows; i++)
+    sort_row(i, col + row[i], row[i + 1] - row[i]);
 
   return A;
 }
 
+psparsematrix
+new_elements_sparsematrix(uint rows, uint cols, uint elements,
+			  uint rdofs, const uint *rdof,
+			  uint cdofs, const uint *cdof)
+{
+  psparsematrix A;
+  uint     *estart, *epos, *elist, *marker;
+  uint      nthreads;
+  uint      e, i, k, r, nz;
+
+  /* Count the elements containing each row */
+  estart = allocuint(rows + 1);
+  for (i = 0; i <= rows; i++)
+    estart[i] = 0;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for private(k,r)
+#endif
+  for (e = 0; e < elements; e++)
+    for (k = 0; k < rdofs; k++) {
+      r = rdof[(size_t) e * rdofs + k];
+      if (r < rows) {
+#ifdef USE_OPENMP
+#pragma omp atomic
+#endif
+	estart[r + 1]++;
+      }
+    }
+
+  for (i = 0; i < rows; i++)
+    estart[i + 1] += estart[i];
+
+  /* Transpose the element table into lists of elements for each row */
+  elist = allocuint(estart[rows]);
+  epos = allocuint(rows);
+  for (i = 0; i < rows; i++)
+    epos[i] = estart[i];
+
+#ifdef USE_OPENMP
+#pragma omp parallel for private(k,r)
+#endif
+  for (e = 0; e < elements; e++)
+    for (k = 0; k < rdofs; k++) {
+      r = rdof[(size_t) e * rdofs + k];
+      if (r < rows) {
+	uint      p;
+
+#ifdef USE_OPENMP
+#pragma omp atomic capture
+#endif
+	p = epos[r]++;
+
+	elist[p] = e;
+      }
+    }
+
+  freemem(epos);
+
+#ifdef USE_OPENMP
+  nthreads = omp_get_max_threads();
+#else
+  nthreads = 1;
+#endif
+
+  /* Every thread marks the columns it has already seen in the current
+     row, so duplicates are removed without any sorting or allocation */
+  marker = allocuint((size_t) cols * nthreads);
+
+  A = new_raw_sparsematrix(rows, cols, 0);
+
+  /* First pass: count the non-zero entries in each row */
+#ifdef USE_OPENMP
+#pragma omp parallel
+#endif
+  {
+    uint     *mark;
+    uint      c, n, p, j;
+    uint      ii;
+
+#ifdef USE_OPENMP
+    mark = marker + (size_t) cols * omp_get_thread_num();
+#else
+    mark = marker;
+#endif
+    for (j = 0; j < cols; j++)
+      mark[j] = rows;
+
+#ifdef USE_OPENMP
+#pragma omp for schedule(dynamic,256)
+#endif
+    for (ii = 0; ii < rows; ii++) {
+      n = 0;
+      for (p = estart[ii]; p < estart[ii + 1]; p++)
+	for (j = 0; j < cdofs; j++) {
+	  c = cdof[(size_t) elist[p] * cdofs + j];
+	  if (c < cols && mark[c] != ii) {
+	    mark[c] = ii;
+	    n++;
+	  }
+	}
+      A->row[ii + 1] = n;
+    }
+  }
+
+  for (i = 0; i < rows; i++)
+    A->row[i + 1] += A->row[i];
+  nz = A->row[rows];
+
+  freemem(A->col);
+  freemem(A->coeff);
+  A->col = allocuint(nz);
+  A->coeff = allocfield(nz);
+  A->nz = nz;
+
+  /* Second pass: fill the column indices */
+#ifdef USE_OPENMP
+#pragma omp parallel
+#endif
+  {
+    uint     *mark;
+    uint      c, n, p, j;
+    uint      ii;
+
+#ifdef USE_OPENMP
+    mark = marker + (size_t) cols * omp_get_thread_num();
+#else
+    mark = marker;
+#endif
+    for (j = 0; j < cols; j++)
+      mark[j] = rows;
+
+#ifdef USE_OPENMP
+#pragma omp for schedule(dynamic,256)
+#endif
+    for (ii = 0; ii < rows; ii++) {
+      n = A->row[ii];
+      for (p = estart[ii]; p < estart[ii + 1]; p++)
+	for (j = 0; j < cdofs; j++) {
+	  c = cdof[(size_t) elist[p] * cdofs + j];
+	  if (c < cols && mark[c] != ii) {
+	    mark[c] = ii;
+	    A->col[n] = c;
+	    A->coeff[n] = 0.0;
+	    n++;
+	  }
+	}
+      assert(n == A->row[ii + 1]);
+
+      sort_row(ii, A->col + A->row[ii], n - A->row[ii]);
+    }
+  }
+
+  freemem(marker);
+  freemem(elist);
+  freemem(estart);
+
+  return A;
+}
+
+psparsematrix
+new_adjoint_sparsematrix(pcsparsematrix a)
+{
+  psparsematrix b;
+  uint     *pos;
+  uint      i, j, k;
+
+  b = new_raw_sparsematrix(a->cols, a->rows, a->nz);
+
+  for (j = 0; j <= a->cols; j++)
+    b->row[j] = 0;
+  for (k = 0; k < a->nz; k++)
+    b->row[a->col[k] + 1]++;
+  for (j = 0; j < a->cols; j++)
+    b->row[j + 1] += b->row[j];
+
+  pos = allocuint(a->cols);
+  for (j = 0; j < a->cols; j++)
+    pos[j] = b->row[j];
+
+  /* Rows of a are processed in ascending order, so the rows of b are
+     sorted */
+  for (i = 0; i < a->rows; i++)
+    for (k = a->row[i]; k < a->row[i + 1]; k++) {
+      j = a->col[k];
+      b->col[pos[j]] = i;
+      b->coeff[pos[j]] = CONJ(a->coeff[k]);
+      pos[j]++;
+    }
+
+  freemem(pos);
+
+  return b;
+}
+
+/* Product computed row by row */
+psparsematrix
+new_product_sparsematrix(pcsparsematrix a, pcsparsematrix b)
+{
+  psparsematrix c;
+  uint     *work;
+  uint      nthreads;
+  uint      i, rows, cols, nz;
+
+  assert(a->cols == b->rows);
+
+  rows = a->rows;
+  cols = b->cols;
+
+#ifdef USE_OPENMP
+  nthreads = omp_get_max_threads();
+#else
+  nthreads = 1;
+#endif
+
+  /* Every thread needs a marker and a position array */
+  work = allocuint((size_t) 2 * cols * nthreads);
+
+  c = new_raw_sparsematrix(rows, cols, 0);
+
+#ifdef USE_OPENMP
+#pragma omp parallel
+#endif
+  {
+    uint     *mark, *pos;
+    uint      ii, j, k, l, n;
+
+#ifdef USE_OPENMP
+    mark = work + (size_t) 2 * cols * omp_get_thread_num();
+#else
+    mark = work;
+#endif
+    pos = mark + cols;
+    for (j = 0; j < cols; j++)
+      mark[j] = rows;
+
+    /* First pass: count the entries of each row */
+#ifdef USE_OPENMP
+#pragma omp for schedule(dynamic,256)
+#endif
+    for (ii = 0; ii < rows; ii++) {
+      n = 0;
+      for (k = a->row[ii]; k < a->row[ii + 1]; k++)
+	for (l = b->row[a->col[k]]; l < b->row[a->col[k] + 1]; l++) {
+	  j = b->col[l];
+	  if (mark[j] != ii) {
+	    mark[j] = ii;
+	    n++;
+	  }
+	}
+      c->row[ii + 1] = n;
+    }
+
+#ifdef USE_OPENMP
+#pragma omp single
+#endif
+    {
+      c->row[0] = 0;
+      for (i = 0; i < rows; i++)
+	c->row[i + 1] += c->row[i];
+      nz = c->row[rows];
+
+      freemem(c->col);
+      freemem(c->coeff);
+      c->col = allocuint(nz);
+      c->coeff = allocfield(nz);
+      c->nz = nz;
+    }
+
+    for (j = 0; j < cols; j++)
+      mark[j] = rows;
+
+    /* Second pass: collect and sort the column indices, then add the
+       products of the coefficients */
+#ifdef USE_OPENMP
+#pragma omp for schedule(dynamic,256)
+#endif
+    for (ii = 0; ii < rows; ii++) {
+      n = c->row[ii];
+      for (k = a->row[ii]; k < a->row[ii + 1]; k++)
+	for (l = b->row[a->col[k]]; l < b->row[a->col[k] + 1]; l++) {
+	  j = b->col[l];
+	  if (mark[j] != ii) {
+	    mark[j] = ii;
+	    c->col[n] = j;
+	    n++;
+	  }
+	}
+      assert(n == c->row[ii + 1]);
+
+      sort_row(ii, c->col + c->row[ii], n - c->row[ii]);
+
+      for (l = c->row[ii]; l < n; l++) {
+	pos[c->col[l]] = l;
+	c->coeff[l] = 0.0;
+      }
+
+      for (k = a->row[ii]; k < a->row[ii + 1]; k++)
+	for (l = b->row[a->col[k]]; l < b->row[a->col[k] + 1]; l++)
+	  c->coeff[pos[b->col[l]]] += a->coeff[k] * b->coeff[l];
+    }
+  }
+
+  freemem(work);
+
+  return c;
+}
+
+psparsematrix
+new_galerkin_sparsematrix(pcsparsematrix a, pcsparsematrix p)
+{
+  psparsematrix ap, pt, c;
+
+  assert(a->cols == p->rows);
+
+  ap = new_product_sparsematrix(a, p);
+  pt = new_adjoint_sparsematrix(p);
+  c = new_product_sparsematrix(pt, ap);
+
+  del_sparsematrix(pt);
+  del_sparsematrix(ap);
+
+  return c;
+}
+
 void
 del_sparsematrix(psparsematrix a)
 {
@@ -133,6 +503,37 @@ del_sparsematrix(psparsematrix a)
  * Access methods
  * ------------------------------------------------------------ */
 
+/* Find the position of an entry in the pattern. Rows usually store the
+ * diagonal first and the remaining columns in ascending order, so we try
+ * the first entry and a binary search before falling back to a linear
+ * scan for rows that have been filled in a different order. */
+static    uint
+findentry_sparsematrix(pcsparsematrix a, uint row, uint col)
+{
+  uint      i, l, r, m;
+
+  l = a->row[row];
+  r = a->row[row + 1];
+
+  if (l < r && a->col[l] == col)
+    return l;
+
+  i = l + 1;
+  while (i < r) {
+    m = (i + r) / 2;
+    if (a->col[m] < col)
+      i = m + 1;
+    else
+      r = m;
+  }
+  if (i < a->row[row + 1] && a->col[i] == col)
+    return i;
+
+  for (i = l; i < a->row[row + 1] && a->col[i] != col; i++);
+
+  return i;
+}
+
 field
 addentry_sparsematrix(psparsematrix a, uint row, uint col, field x)
 {
@@ -142,7 +543,7 @@ addentry_sparsematrix(psparsematrix a, uint row, uint col, field x)
   assert(row < a->rows);
   assert(col < a->cols);
 
-  for (i = a->row[row]; i < a->row[row + 1] && a->col[i] != col; i++);
+  i = findentry_sparsematrix(a, row, col);
 
   assert(i < a->row[row + 1]);
   assert(a->col[i] == col);
@@ -159,13 +560,47 @@ setentry_sparsematrix(psparsematrix a, uint row, uint col, field x)
   assert(row < a->rows);
   assert(col < a->cols);
 
-  for (i = a->row[row]; i < a->row[row + 1] && a->col[i] != col; i++);
+  i = findentry_sparsematrix(a, row, col);
   assert(i < a->row[row + 1]);
   assert(a->col[i] == col);
 
   a->coeff[i] = x;
 }
 
+uint     *
+new_elements_slots_sparsematrix(pcsparsematrix a, uint elements,
+				uint rdofs, const uint *rdof,
+				uint cdofs, const uint *cdof)
+{
+  uint     *slot;
+  uint      e, i, j, r, c;
+  size_t    k;
+
+  slot = allocuint((size_t) elements * rdofs * cdofs);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,j,r,c,k)
+#endif
+  for (e = 0; e < elements; e++) {
+    k = (size_t) e * rdofs * cdofs;
+    for (i = 0; i < rdofs; i++) {
+      r = rdof[(size_t) e * rdofs + i];
+      for (j = 0; j < cdofs; j++) {
+	c = cdof[(size_t) e * cdofs + j];
+	if (r < a->rows && c < a->cols) {
+	  slot[k] = findentry_sparsematrix(a, r, c);
+	  assert(slot[k] < a->row[r + 1]);
+	}
+	else
+	  slot[k] = a->nz;
+	k++;
+      }
+    }
+  }
+
+  return slot;
+}
+
 /* ------------------------------------------------------------
  * Statistics
  * ------------------------------------------------------------ */
@@ -215,8 +650,11 @@ sort_sparsematrix(psparsematrix a)
     k = row[i];
     for (j = row[i]; j < row[i + 1] && i != col[j]; j++);
     if (j < row[i + 1])
-      swap(k, j, col, coeff);
+      for (; j > k; j--)
+	swap(j - 1, j, col, coeff);
   }
+
+  a->gen = newgen();
 }
 
 void
@@ -320,6 +758,10 @@ print_eps_sparsematrix(pcsparsematrix a, const char *filename, uint offset)
  * Basic linear algebra
  * ------------------------------------------------------------ */
 
+/* Products with matrices with fewer non-zero entries are not worth
+ * starting a parallel region */
+#define PARALLEL_NZ 4096
+
 void
 addeval_sparsematrix_avector(field alpha, pcsparsematrix a, pcavector x,
 			     pavector y)
@@ -330,7 +772,7 @@ addeval_sparsematrix_avector(field alpha, pcsparsematrix a, pcavector x,
   uint      rows;
   pcfield   xv;
   pfield    yv;
-  register field sum;
+  field     sum;
   uint      i, j;
 
   assert(a != NULL);
@@ -346,6 +788,10 @@ addeval_sparsematrix_avector(field alpha, pcsparsematrix a, pcavector x,
   xv = x->v;
   yv = y->v;
 
+  /* Rows are distributed among the threads */
+#ifdef USE_OPENMP
+#pragma omp parallel for if(a->nz >= PARALLEL_NZ) private(j,sum) schedule(static)
+#endif
   for (i = 0; i < rows; i++) {
     sum = 0.0;
     for (j = row[i]; j < row[i + 1]; j++) {
@@ -362,10 +808,12 @@ addevaltrans_sparsematrix_avector(field alpha, pcsparsematrix a,
   uint     *row;
   uint     *col;
   field    *coeff;
-  uint      rows;
+  uint      rows, cols;
   pcfield   xv;
   pfield    yv;
-  register field val;
+  pfield    acc;
+  field     val;
+  uint      nthreads;
   uint      i, j;
 
   assert(a != NULL);
@@ -378,15 +826,70 @@ addevaltrans_sparsematrix_avector(field alpha, pcsparsematrix a,
   col = a->col;
   coeff = a->coeff;
   rows = a->rows;
+  cols = a->cols;
   xv = x->v;
   yv = y->v;
 
-  for (i = 0; i < rows; i++) {
-    val = alpha * xv[i];
-    for (j = row[i]; j < row[i + 1]; j++) {
-      yv[col[j]] += coeff[j] * val;
+#ifdef USE_OPENMP
+  nthreads = (omp_in_parallel() || a->nz < PARALLEL_NZ ? 1 :
+	      omp_get_max_threads());
+#else
+  nthreads = 1;
+#endif
+
+  if (nthreads == 1) {
+    for (i = 0; i < rows; i++) {
+      val = alpha * xv[i];
+      for (j = row[i]; j < row[i + 1]; j++) {
+	yv[col[j]] += CONJ(coeff[j]) * val;
+      }
+    }
+    return;
+  }
+
+  /* Every thread accumulates the contributions of its rows in a private
+     vector, the vectors are summed up afterwards */
+  acc = allocfield((size_t) cols * nthreads);
+
+#ifdef USE_OPENMP
+#pragma omp parallel private(val,i,j) num_threads(nthreads)
+#endif
+  {
+    pfield    ya;
+    uint      nt;
+
+#ifdef USE_OPENMP
+    ya = acc + (size_t) cols * omp_get_thread_num();
+    nt = omp_get_num_threads();
+#else
+    ya = acc;
+    nt = 1;
+#endif
+
+    for (j = 0; j < cols; j++)
+      ya[j] = 0.0;
+
+#ifdef USE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (i = 0; i < rows; i++) {
+      val = xv[i];
+      for (j = row[i]; j < row[i + 1]; j++)
+	ya[col[j]] += CONJ(coeff[j]) * val;
+    }
+
+#ifdef USE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (j = 0; j < cols; j++) {
+      val = 0.0;
+      for (i = 0; i < nt; i++)
+	val += acc[(size_t) cols * i + j];
+      yv[j] += alpha * val;
     }
   }
+
+  freemem(acc);
 }
 
 void
@@ -401,6 +904,38 @@ mvm_sparsematrix_avector(field alpha, bool trans, pcsparsematrix a,
   }
 }
 
+void
+addeval_sparsematrix_amatrix(field alpha, pcsparsematrix a, pcamatrix x,
+			     pamatrix y)
+{
+  const uint *row = a->row;
+  const uint *col = a->col;
+  pcfield   coeff = a->coeff;
+  pcfield   xa = x->a;
+  pfield    ya = y->a;
+  longindex ldx = x->ld;
+  longindex ldy = y->ld;
+  uint      cols = x->cols;
+  field     c;
+  uint      i, j, k;
+
+  assert(a->cols == x->rows);
+  assert(a->rows == y->rows);
+  assert(x->cols == y->cols);
+
+  /* Rows are distributed among the threads */
+#ifdef USE_OPENMP
+#pragma omp parallel for if(a->nz * (size_t) cols >= PARALLEL_NZ) private(j,k,c) schedule(static)
+#endif
+  for (i = 0; i < a->rows; i++) {
+    for (j = row[i]; j < row[i + 1]; j++) {
+      c = alpha * coeff[j];
+      for (k = 0; k < cols; k++)
+	ya[i + k * ldy] += c * xa[col[j] + k * ldx];
+    }
+  }
+}
+
 real
 norm2_sparsematrix(pcsparsematrix S)
 {
@@ -54,6 +54,11 @@ struct _sparsematrix {
   uint *col;
   /** @brief Coefficients of non-zero entries. */
   pfield coeff;
+
+  /** @brief Generation of the sparsity pattern, unique among all
+   *  matrices and renewed by @ref sort_sparsematrix, used to validate
+   *  cached positions like those of @ref setslots_tet3dp1. */
+  size_t gen;
 };
 
 /* ------------------------------------------------------------ *
@@ -93,6 +98,75 @@ new_identity_sparsematrix(uint rows, uint cols);
 HEADER_PREFIX psparsematrix
 new_zero_sparsematrix(psparsepattern sp);
 
+/** @brief Create a sparsematrix for the coupling of finite elements.
+ *
+ *  Every element @f$e@f$ couples the row indices
+ *  <tt>rdof[e*rdofs]</tt>, ..., <tt>rdof[e*rdofs+rdofs-1]</tt> with the
+ *  column indices <tt>cdof[e*cdofs]</tt>, ...,
+ *  <tt>cdof[e*cdofs+cdofs-1]</tt>. Indices not smaller than <tt>rows</tt>
+ *  or <tt>cols</tt>, respectively, are ignored, e.g., for fixed
+ *  degrees of freedom.
+ *
+ *  The element table is transposed to find the elements containing each
+ *  row, then the columns of every row are collected and duplicates are
+ *  removed by marking the columns already seen. Both steps run in
+ *  parallel, and in contrast to @ref new_zero_sparsematrix no storage
+ *  is allocated per non-zero entry.
+ *
+ *  The diagonal entry of each row comes first, the remaining column
+ *  indices are sorted in ascending order.
+ *
+ *  @remark Should always be matched by a call to @ref del_sparsematrix.
+ *
+ *  @param rows Number of rows.
+ *  @param cols Number of columns.
+ *  @param elements Number of elements.
+ *  @param rdofs Number of row indices per element.
+ *  @param rdof Row indices of all elements.
+ *  @param cdofs Number of column indices per element.
+ *  @param cdof Column indices of all elements.
+ *  @returns Fully initialized @ref sparsematrix object with zero
+ *     coefficients. */
+HEADER_PREFIX psparsematrix
+new_elements_sparsematrix(uint rows, uint cols, uint elements,
+    uint rdofs, const uint *rdof, uint cdofs, const uint *cdof);
+
+/** @brief Create the adjoint @f$A^*@f$ of a sparse matrix.
+ *
+ *  The columns in each row of the result are sorted in ascending order.
+ *
+ *  @param a Matrix @f$A@f$.
+ *  @returns New @ref sparsematrix object containing @f$A^*@f$. */
+HEADER_PREFIX psparsematrix
+new_adjoint_sparsematrix(pcsparsematrix a);
+
+/** @brief Create the product @f$A B@f$ of sparse matrices.
+ *
+ *  The sparsity pattern and the coefficients are computed in parallel
+ *  by Gustavson's algorithm.
+ *  The rows store the diagonal entry, if present, first and the
+ *  remaining columns in ascending order.
+ *
+ *  @param a Matrix @f$A@f$.
+ *  @param b Matrix @f$B@f$.
+ *  @returns New @ref sparsematrix object containing @f$A B@f$. */
+HEADER_PREFIX psparsematrix
+new_product_sparsematrix(pcsparsematrix a, pcsparsematrix b);
+
+/** @brief Create the Galerkin product @f$P^* A P@f$ of sparse matrices.
+ *
+ *  Used to construct coarse-grid matrices for multigrid methods:
+ *  if the columns of @f$P@f$ describe coarse basis functions in terms
+ *  of fine ones, @f$P^* A P@f$ is the coarse-grid matrix.
+ *  The rows of the result store the diagonal first and the remaining
+ *  columns in ascending order.
+ *
+ *  @param a Matrix @f$A@f$.
+ *  @param p Prolongation @f$P@f$.
+ *  @returns New @ref sparsematrix object containing @f$P^* A P@f$. */
+HEADER_PREFIX psparsematrix
+new_galerkin_sparsematrix(pcsparsematrix a, pcsparsematrix p);
+
 /** @brief Delete a @ref sparsematrix object.
  *
  *  Releases the storage corresponding to the object.
@@ -109,6 +183,10 @@ del_sparsematrix(psparsematrix a);
  *
  *  Only entries appearing in the sparsity pattern of the matrix
  *  are allowed.
+ *  If the row stores the diagonal first and the remaining columns
+ *  in ascending order, as is the case for matrices created by
+ *  @ref new_zero_sparsematrix or @ref new_elements_sparsematrix,
+ *  the entry is found by binary search.
  *
  *  @param a Target matrix @f$A@f$.
  *  @param row Row index @f$i@f$.
@@ -130,6 +208,32 @@ addentry_sparsematrix(psparsematrix a, uint row, uint col, field x);
 HEADER_PREFIX void
 setentry_sparsematrix(psparsematrix a, uint row, uint col, field x);
 
+/** @brief Find the positions of element matrices in the pattern.
+ *
+ *  For every element <tt>e</tt> and all local indices <tt>i</tt> and
+ *  <tt>j</tt>, the position of the entry with row
+ *  <tt>rdof[e*rdofs+i]</tt> and column <tt>cdof[e*cdofs+j]</tt> in
+ *  <tt>a->col</tt> and <tt>a->coeff</tt> is stored in
+ *  <tt>slot[(e*rdofs+i)*cdofs+j]</tt>.
+ *  Entries with a row index not below <tt>a->rows</tt> or a column
+ *  index not below <tt>a->cols</tt> are marked by <tt>a->nz</tt>.
+ *
+ *  Once the positions are known, element matrices can be added by
+ *  <tt>a->coeff[slot[k]] += x</tt> without searching the rows, which
+ *  pays off if a matrix is assembled repeatedly on a fixed mesh.
+ *
+ *  @param a Matrix containing all required entries in its pattern.
+ *  @param elements Number of elements.
+ *  @param rdofs Number of row indices per element.
+ *  @param rdof Row indices of all elements.
+ *  @param cdofs Number of column indices per element.
+ *  @param cdof Column indices of all elements.
+ *  @returns Array of <tt>elements*rdofs*cdofs</tt> positions,
+ *    to be released by @ref freemem. */
+HEADER_PREFIX uint *
+new_elements_slots_sparsematrix(pcsparsematrix a, uint elements,
+    uint rdofs, const uint *rdof, uint cdofs, const uint *cdof);
+
 /* ------------------------------------------------------------
  * Statistics
  * ------------------------------------------------------------ */
@@ -152,10 +256,12 @@ getsize_sparsematrix(pcsparsematrix a);
  *     come first.
  *
  *  Reorder the entries of each row in @c col and @c coeff to
- *  place the diagonal entry first.
+ *  place the diagonal entry first, keeping the order of the
+ *  remaining entries.
  *  Since many iterative solvers require us to handle this entry
  *  differently from all others, this optimization can improve
  *  the performance.
+ *  Since entries are moved, the generation @c a->gen is renewed.
  *
  *  @param a Target matrix. */
 HEADER_PREFIX void
@@ -232,6 +338,20 @@ HEADER_PREFIX void
 mvm_sparsematrix_avector(field alpha, bool trans, pcsparsematrix a, pcavector x,
     pavector y);
 
+/** @brief Multiply a matrix @f$A@f$ by a matrix @f$X@f$,
+ *  @f$Y \gets Y + \alpha A X@f$.
+ *
+ *  The sparse matrix is traversed only once, each entry is applied
+ *  to all columns of @f$X@f$.
+ *
+ *  @param alpha Scaling factor @f$\alpha@f$.
+ *  @param a Matrix @f$A@f$.
+ *  @param x Source matrix @f$X@f$.
+ *  @param y Target matrix @f$Y@f$. */
+HEADER_PREFIX void
+addeval_sparsematrix_amatrix(field alpha, pcsparsematrix a, pcamatrix x,
+    pamatrix y);
+
 /** @brief Approximate the spectral norm @f$\|S\|_2@f$ of a matrix @f$S@f$.
  *
  *  The spectral norm is approximated by applying a few steps of the power
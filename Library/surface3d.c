@@ -19,6 +19,7 @@
 #endif
 
 #include "basic.h"
+#include "reorder.h"
 
 /* ------------------------------------------------------------
  Constructor and destructor
@@ -62,6 +63,9 @@ prepare_surface3d(psurface3d gr)
   hmin = 1e30;
   hmax = 0.0;
 
+#ifdef USE_OPENMP
+#pragma omp parallel for private(dx,dy,dz,norm,height,a,b,c) reduction(min:hmin) reduction(max:hmax)
+#endif
   for (i = 0; i < triangles; i++) {
     dx[0] = x[t[i][1]][0] - x[t[i][0]][0];
     dx[1] = x[t[i][1]][1] - x[t[i][0]][1];
@@ -437,6 +441,97 @@ translate_surface3d(psurface3d gr, real * t)
   prepare_surface3d(gr);
 }
 
+void
+permute_surface3d(psurface3d gr, const uint *xp, const uint *ep,
+		  const uint *tp)
+{
+  real(*x)[3];
+  uint(*e)[2];
+  uint(*t)[3];
+  uint(*s)[3];
+  real(*n)[3];
+  real     *g;
+  uint      i, j, k;
+
+  x = (real(*)[3]) allocmem((size_t) sizeof(real[3]) * gr->vertices);
+  for (i = 0; i < gr->vertices; i++) {
+    k = (xp ? xp[i] : i);
+    x[k][0] = gr->x[i][0];
+    x[k][1] = gr->x[i][1];
+    x[k][2] = gr->x[i][2];
+  }
+
+  e = (uint(*)[2]) allocmem((size_t) sizeof(uint[2]) * gr->edges);
+  for (i = 0; i < gr->edges; i++) {
+    k = (ep ? ep[i] : i);
+    for (j = 0; j < 2; j++)
+      e[k][j] = (xp ? xp[gr->e[i][j]] : gr->e[i][j]);
+  }
+
+  t = (uint(*)[3]) allocmem((size_t) sizeof(uint[3]) * gr->triangles);
+  s = (uint(*)[3]) allocmem((size_t) sizeof(uint[3]) * gr->triangles);
+  n = (real(*)[3]) allocmem((size_t) sizeof(real[3]) * gr->triangles);
+  g = (real *) allocmem((size_t) sizeof(real) * gr->triangles);
+  for (i = 0; i < gr->triangles; i++) {
+    k = (tp ? tp[i] : i);
+    for (j = 0; j < 3; j++) {
+      t[k][j] = (xp ? xp[gr->t[i][j]] : gr->t[i][j]);
+      s[k][j] = (ep ? ep[gr->s[i][j]] : gr->s[i][j]);
+      n[k][j] = gr->n[i][j];
+    }
+    g[k] = gr->g[i];
+  }
+
+  freemem(gr->g);
+  freemem(gr->n);
+  freemem(gr->s);
+  freemem(gr->t);
+  freemem(gr->e);
+  freemem(gr->x);
+
+  gr->x = x;
+  gr->e = e;
+  gr->t = t;
+  gr->s = s;
+  gr->n = n;
+  gr->g = g;
+}
+
+void
+reorder_surface3d(psurface3d gr, reordermode mode, uint *vperm)
+{
+  uint     *xp, *ep, *tp, *key;
+  uint      i;
+
+  xp = (vperm ? vperm : allocuint(gr->vertices));
+  if (mode == H2_REORDER_MORTON)
+    morton_reorder(gr->vertices, 3, (const real *) gr->x, xp);
+  else
+    rcm_reorder(gr->vertices, gr->edges, (const uint *) gr->e, xp);
+
+  /* Edges and triangles are sorted by their smallest new vertex
+   * index */
+  key = allocuint(UINT_MAX(gr->edges, gr->triangles));
+
+  ep = allocuint(gr->edges);
+  for (i = 0; i < gr->edges; i++)
+    key[i] = UINT_MIN(xp[gr->e[i][0]], xp[gr->e[i][1]]);
+  key_reorder(gr->edges, gr->vertices, key, ep);
+
+  tp = allocuint(gr->triangles);
+  for (i = 0; i < gr->triangles; i++)
+    key[i] = UINT_MIN3(xp[gr->t[i][0]], xp[gr->t[i][1]], xp[gr->t[i][2]]);
+  key_reorder(gr->triangles, gr->vertices, key, tp);
+
+  permute_surface3d(gr, xp, ep, tp);
+
+  freemem(tp);
+  freemem(ep);
+  freemem(key);
+  if (vperm == NULL)
+    freemem(xp);
+}
+
 psurface3d
 merge_surface3d(pcsurface3d gr1, pcsurface3d gr2)
 {
@@ -1495,7 +1590,6 @@ refine_red_surface3d(psurface3d in)
   psurface3d gr;
   uint      newtriangles, newedges, newvertices;
   uint      i, j, s, t, e, v;
-  real      x[3];
 
   newtriangles = 4 * triangles;
   newedges = 2 * edges + 3 * triangles;
@@ -1503,16 +1597,26 @@ refine_red_surface3d(psurface3d in)
 
   gr = new_surface3d(newvertices, newedges, newtriangles);
 
+  /* The indices of all new entities are determined by their parents,
+   * so every loop can be parallelized, the last loop for each kind of
+   * entity reports its final index to check the total count */
+#ifdef USE_OPENMP
+#pragma omp parallel for private(j)
+#endif
   for (v = 0; v < vertices; ++v) {
     for (j = 0; j < 3; ++j) {
       gr->x[v][j] = in->x[v][j];
     }
   }
 
+  v = vertices;
+#ifdef USE_OPENMP
+#pragma omp parallel for private(j) lastprivate(v)
+#endif
   for (e = 0; e < edges; ++e) {
+    v = vertices + e;
     for (j = 0; j < 3; ++j) {
-      x[j] = 0.5 * (in->x[in->e[e][0]][j] + in->x[in->e[e][1]][j]);
-      gr->x[v][j] = x[j];
+      gr->x[v][j] = 0.5 * (in->x[in->e[e][0]][j] + in->x[in->e[e][1]][j]);
     }
     gr->e[2 * e][0] = in->e[e][0];
     gr->e[2 * e][1] = v;
@@ -1520,12 +1624,17 @@ refine_red_surface3d(psurface3d in)
     gr->e[2 * e + 1][1] = in->e[e][1];
     v++;
   }
-  e *= 2;
+  assert(v == newvertices);
 
+  e = 2 * edges;
   s = 0;
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,j) lastprivate(s,e)
+#endif
   for (t = 0; t < triangles; ++t) {
+    e = 2 * edges + 3 * t;
+    s = 4 * t;
     for (j = 0; j < 3; ++j) {
-
       gr->e[e][0] = gr->e[2 * in->s[t][(j + 1) % 3] + 1][0];
       gr->e[e][1] = gr->e[2 * in->s[t][j] + 1][0];
       e++;
@@ -1578,14 +1687,9 @@ refine_red_surface3d(psurface3d in)
       gr->t[s][i] = gr->e[e - 3 + ((i + 1) % 3)][0];
     }
     s++;
-
   }
-  t *= 4;
-
-  assert(t == newtriangles);
   assert(s == newtriangles);
   assert(e == newedges);
-  assert(v == newvertices);
 
   prepare_surface3d(gr);
 
@@ -38,6 +38,7 @@ typedef surface3d *psurface3d;
 typedef const surface3d *pcsurface3d;
 
 #include "settings.h"
+#include "reorder.h"
 
 /**
  * @brief Representation of a triangle surface mesh.
@@ -186,6 +187,36 @@ scale_surface3d(psurface3d gr, real *a, real *b);
 HEADER_PREFIX void
 translate_surface3d(psurface3d gr, real *t);
 
+/**
+ * @brief Renumber the vertices, edges and triangles of a geometry.
+ *
+ * All connectivity arrays, normal vectors and Gram determinants are
+ * permuted consistently. Discretizations and matrices constructed for
+ * the geometry before become invalid.
+ *
+ * @param gr Geometry, will be renumbered.
+ * @param xp New indices of the vertices, <tt>NULL</tt> keeps them.
+ * @param ep New indices of the edges, <tt>NULL</tt> keeps them.
+ * @param tp New indices of the triangles, <tt>NULL</tt> keeps them.
+ */
+HEADER_PREFIX void
+permute_surface3d(psurface3d gr, const uint *xp, const uint *ep,
+		  const uint *tp);
+
+/**
+ * @brief Renumber a geometry to improve the locality of its entities.
+ *
+ * The vertices are ordered by @ref rcm_reorder or @ref morton_reorder,
+ * edges and triangles are sorted by their smallest vertex.
+ *
+ * @param gr Geometry, will be renumbered.
+ * @param mode Ordering strategy for the vertices.
+ * @param vperm Array of <tt>gr->vertices</tt> entries, will be
+ *   overwritten by the new indices of the vertices, or <tt>NULL</tt>.
+ */
+HEADER_PREFIX void
+reorder_surface3d(psurface3d gr, reordermode mode, uint *vperm);
+
 /**
  * @brief Merge to meshes into a single mesh.
  *
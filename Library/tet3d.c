@@ -6,6 +6,7 @@
 #include "tet3d.h"
 
 #include "basic.h"
+#include "reorder.h"
 
 #include <assert.h>
 #include <math.h>
@@ -529,6 +530,196 @@ getvertices_face_tet3d(pctet3d t3, uint nf, uint v[]) {
   }
 }
 
+uint
+colour_tet3d(pctet3d gr, uint **cstart, uint **celem)
+{
+  uint      elements = gr->tetrahedra;
+  uint      vertices = gr->vertices;
+  uint     *vstart, *velem, *colour, *forbidden, *cs, *ce;
+  uint      colours;
+  uint      i, j, k, c, t, v[4];
+
+  /* Lists of elements sharing a vertex */
+  vstart = allocuint(vertices + 1);
+  for (i = 0; i <= vertices; i++)
+    vstart[i] = 0;
+  for (t = 0; t < elements; t++) {
+    getvertices_tet3d(gr, t, v);
+    for (i = 0; i < 4; i++)
+      vstart[v[i] + 1]++;
+  }
+  for (i = 0; i < vertices; i++)
+    vstart[i + 1] += vstart[i];
+
+  velem = allocuint(vstart[vertices]);
+  for (t = 0; t < elements; t++) {
+    getvertices_tet3d(gr, t, v);
+    for (i = 0; i < 4; i++)
+      velem[vstart[v[i]]++] = t;
+  }
+  for (i = vertices; i > 0; i--)
+    vstart[i] = vstart[i - 1];
+  vstart[0] = 0;
+
+  /* Greedy colouring: every element receives the smallest colour not
+     used by an element sharing one of its vertices */
+  colour = allocuint(elements);
+  forbidden = allocuint(elements + 1);
+  for (c = 0; c <= elements; c++)
+    forbidden[c] = elements;
+  colours = 0;
+  for (t = 0; t < elements; t++) {
+    getvertices_tet3d(gr, t, v);
+    for (i = 0; i < 4; i++)
+      for (j = vstart[v[i]]; j < vstart[v[i] + 1] && velem[j] < t; j++)
+	forbidden[colour[velem[j]]] = t;
+
+    for (c = 0; c < colours && forbidden[c] == t; c++);
+    colour[t] = c;
+    if (c == colours)
+      colours++;
+  }
+
+  /* Sort elements by colour */
+  cs = allocuint(colours + 1);
+  for (c = 0; c <= colours; c++)
+    cs[c] = 0;
+  for (t = 0; t < elements; t++)
+    cs[colour[t] + 1]++;
+  for (c = 0; c < colours; c++)
+    cs[c + 1] += cs[c];
+
+  ce = allocuint(elements);
+  for (t = 0; t < elements; t++) {
+    k = colour[t];
+    ce[cs[k]++] = t;
+  }
+  for (c = colours; c > 0; c--)
+    cs[c] = cs[c - 1];
+  cs[0] = 0;
+
+  freemem(forbidden);
+  freemem(colour);
+  freemem(velem);
+  freemem(vstart);
+
+  *cstart = cs;
+  *celem = ce;
+
+  return colours;
+}
+
+void
+permute_tet3d(ptet3d gr, const uint *xp, const uint *ep, const uint *fp,
+	      const uint *tp)
+{
+  real(*x)[3];
+  uint(*e)[2];
+  uint(*f)[3];
+  uint(*t)[4];
+  uint     *xb, *eb, *fb;
+  uint      i, j, n;
+
+  x = (real(*)[3]) allocmem(sizeof(real[3]) * gr->vertices);
+  xb = (uint *) allocmem(sizeof(uint) * gr->vertices);
+  for (i = 0; i < gr->vertices; i++) {
+    n = (xp ? xp[i] : i);
+    x[n][0] = gr->x[i][0];
+    x[n][1] = gr->x[i][1];
+    x[n][2] = gr->x[i][2];
+    xb[n] = gr->xb[i];
+  }
+
+  e = (uint(*)[2]) allocmem(sizeof(uint[2]) * gr->edges);
+  eb = (uint *) allocmem(sizeof(uint) * gr->edges);
+  for (i = 0; i < gr->edges; i++) {
+    n = (ep ? ep[i] : i);
+    for (j = 0; j < 2; j++)
+      e[n][j] = (xp ? xp[gr->e[i][j]] : gr->e[i][j]);
+    eb[n] = gr->eb[i];
+  }
+
+  f = (uint(*)[3]) allocmem(sizeof(uint[3]) * gr->faces);
+  fb = (uint *) allocmem(sizeof(uint) * gr->faces);
+  for (i = 0; i < gr->faces; i++) {
+    n = (fp ? fp[i] : i);
+    for (j = 0; j < 3; j++)
+      f[n][j] = (ep ? ep[gr->f[i][j]] : gr->f[i][j]);
+    fb[n] = gr->fb[i];
+  }
+
+  t = (uint(*)[4]) allocmem(sizeof(uint[4]) * gr->tetrahedra);
+  for (i = 0; i < gr->tetrahedra; i++) {
+    n = (tp ? tp[i] : i);
+    for (j = 0; j < 4; j++)
+      t[n][j] = (fp ? fp[gr->t[i][j]] : gr->t[i][j]);
+  }
+
+  freemem(gr->fb);
+  freemem(gr->eb);
+  freemem(gr->xb);
+  freemem(gr->t);
+  freemem(gr->f);
+  freemem(gr->e);
+  freemem(gr->x);
+
+  gr->x = x;
+  gr->e = e;
+  gr->f = f;
+  gr->t = t;
+  gr->xb = xb;
+  gr->eb = eb;
+  gr->fb = fb;
+}
+
+void
+reorder_tet3d(ptet3d gr, reordermode mode, uint *vperm)
+{
+  uint     *xp, *ep, *fp, *tp, *key;
+  uint      i, j;
+
+  xp = (vperm ? vperm : allocuint(gr->vertices));
+  if (mode == H2_REORDER_MORTON)
+    morton_reorder(gr->vertices, 3, (const real *) gr->x, xp);
+  else
+    rcm_reorder(gr->vertices, gr->edges, (const uint *) gr->e, xp);
+
+  /* Edges are sorted by their smallest new vertex index, faces by
+   * their smallest new edge index, tetrahedra by their smallest new
+   * face index */
+  key = allocuint(UINT_MAX3(gr->edges, gr->faces, gr->tetrahedra));
+
+  ep = allocuint(gr->edges);
+  for (i = 0; i < gr->edges; i++)
+    key[i] = UINT_MIN(xp[gr->e[i][0]], xp[gr->e[i][1]]);
+  key_reorder(gr->edges, gr->vertices, key, ep);
+
+  fp = allocuint(gr->faces);
+  for (i = 0; i < gr->faces; i++) {
+    key[i] = ep[gr->f[i][0]];
+    for (j = 1; j < 3; j++)
+      key[i] = UINT_MIN(key[i], ep[gr->f[i][j]]);
+  }
+  key_reorder(gr->faces, gr->edges, key, fp);
+
+  tp = allocuint(gr->tetrahedra);
+  for (i = 0; i < gr->tetrahedra; i++) {
+    key[i] = fp[gr->t[i][0]];
+    for (j = 1; j < 4; j++)
+      key[i] = UINT_MIN(key[i], fp[gr->t[i][j]]);
+  }
+  key_reorder(gr->tetrahedra, gr->faces, key, tp);
+
+  permute_tet3d(gr, xp, ep, fp, tp);
+
+  freemem(tp);
+  freemem(fp);
+  freemem(ep);
+  freemem(key);
+  if (vperm == NULL)
+    freemem(xp);
+}
+
 uint
 fixnormals_tet3d(ptet3d gr)
 {
@@ -877,9 +1068,17 @@ refine_tet3d(pctet3d t3, ptet3dref * t3r)
     tf = (*t3r)->tf = (uint *) allocmem(sizeof(uint) * r->tetrahedra);
   }
 
+  /* The indices of all new entities are determined by their parents,
+   * so every loop can be parallelized, the last loop for each kind of
+   * entity reports its final index to check the total count */
+
   /* Create vertices by copying old vertices */
-  i = 0;
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i)
+#endif
   for (j = 0; j < vertices; j++) {
+    i = j;
+
     r->x[i][0] = x[j][0];
     r->x[i][1] = x[j][1];
     r->x[i][2] = x[j][2];
@@ -888,12 +1087,17 @@ refine_tet3d(pctet3d t3, ptet3dref * t3r)
       xf[i] = j;
       xt[i] = 0;
     }
-    i++;
   }
 
   /* Create vertices within edges */
-  edge_vertices = i;
+  edge_vertices = vertices;
+  i = edge_vertices;
+#ifdef USE_OPENMP
+#pragma omp parallel for lastprivate(i)
+#endif
   for (j = 0; j < edges; j++) {
+    i = edge_vertices + j;
+
     r->x[i][0] = 0.5 * (x[e[j][0]][0] + x[e[j][1]][0]);
     r->x[i][1] = 0.5 * (x[e[j][0]][1] + x[e[j][1]][1]);
     r->x[i][2] = 0.5 * (x[e[j][0]][2] + x[e[j][1]][2]);
@@ -907,8 +1111,12 @@ refine_tet3d(pctet3d t3, ptet3dref * t3r)
   assert(i == r->vertices);
 
   /* Create edges by splitting old edges */
-  i = 0;
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i)
+#endif
   for (j = 0; j < edges; j++) {
+    i = 2 * j;
+
     r->e[i][0] = e[j][0];
     r->e[i][1] = edge_vertices + j;
     r->eb[i] = eb[j];
@@ -925,12 +1133,16 @@ refine_tet3d(pctet3d t3, ptet3dref * t3r)
       ef[i] = j;
       et[i] = 1;
     }
-    i++;
   }
 
   /* Create edges within faces */
-  face_edges = i;
+  face_edges = 2 * edges;
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i)
+#endif
   for (j = 0; j < faces; j++) {
+    i = face_edges + 3 * j;
+
     r->e[i][0] = edge_vertices + f[j][1];
     r->e[i][1] = edge_vertices + f[j][2];
     r->eb[i] = fb[j];
@@ -956,12 +1168,17 @@ refine_tet3d(pctet3d t3, ptet3dref * t3r)
       ef[i] = j;
       et[i] = 2;
     }
-    i++;
   }
 
   /* Create edges within tetrahedra */
-  tetrahedron_edges = i;
+  tetrahedron_edges = 2 * edges + 3 * faces;
+  i = tetrahedron_edges;
+#ifdef USE_OPENMP
+#pragma omp parallel for lastprivate(i)
+#endif
   for (j = 0; j < tetrahedra; j++) {
+    i = tetrahedron_edges + j;
+
     r->e[i][0] = edge_vertices + common_edge_global(f, t[j][3], t[j][1]);
     r->e[i][1] = edge_vertices + common_edge_global(f, t[j][2], t[j][0]);
     r->eb[i] = 0;
@@ -974,8 +1191,12 @@ refine_tet3d(pctet3d t3, ptet3dref * t3r)
   assert(i == r->edges);
 
   /* Create faces by splitting old faces */
-  i = 0;
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i)
+#endif
   for (j = 0; j < faces; j++) {
+    i = 4 * j;
+
     intersecting_edges(re, 2 * f[j][1], 2 * f[j][2], r->f[i] + 1,
 		       r->f[i] + 2);
     r->f[i][0] = face_edges + 3 * j;
@@ -1012,12 +1233,16 @@ refine_tet3d(pctet3d t3, ptet3dref * t3r)
       ff[i] = j;
       ft[i] = 2;
     }
-    i++;
   }
 
   /* Create faces closest to vertices within tetrahedra */
-  vertex_faces = i;
+  vertex_faces = 4 * faces;
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i)
+#endif
   for (j = 0; j < tetrahedra; j++) {
+    i = vertex_faces + 4 * j;
+
     r->f[i][0] = face_edges + 3 * t[j][1] + common_edge(f, t[j][1], t[j][0]);
     r->f[i][1] = face_edges + 3 * t[j][2] + common_edge(f, t[j][2], t[j][0]);
     r->f[i][2] = face_edges + 3 * t[j][3] + common_edge(f, t[j][3], t[j][0]);
@@ -1056,12 +1281,17 @@ refine_tet3d(pctet3d t3, ptet3dref * t3r)
       ff[i] = j;
       ft[i] = 3;
     }
-    i++;
   }
 
   /* Create faces touching the central diagonal within tetrahedra */
-  center_faces = i;
+  center_faces = 4 * faces + 4 * tetrahedra;
+  i = center_faces;
+#ifdef USE_OPENMP
+#pragma omp parallel for lastprivate(i)
+#endif
   for (j = 0; j < tetrahedra; j++) {
+    i = center_faces + 4 * j;
+
     r->f[i][0] = tetrahedron_edges + j;
     r->f[i][1] = face_edges + 3 * t[j][0] + common_edge(f, t[j][0], t[j][1]);
     r->f[i][2] = face_edges + 3 * t[j][3] + common_edge(f, t[j][3], t[j][2]);
@@ -1105,8 +1335,12 @@ refine_tet3d(pctet3d t3, ptet3dref * t3r)
   assert(i == r->faces);
 
   /* Create vertex tetrahedra */
-  i = 0;
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i)
+#endif
   for (j = 0; j < tetrahedra; j++) {
+    i = 4 * j;
+
     r->t[i][0] = vertex_faces + 4 * j;
     r->t[i][1] = 4 * t[j][1] + common_edge(f, t[j][1], t[j][0]);
     r->t[i][2] = 4 * t[j][2] + common_edge(f, t[j][2], t[j][0]);
@@ -1137,11 +1371,16 @@ refine_tet3d(pctet3d t3, ptet3dref * t3r)
     r->t[i][3] = vertex_faces + 4 * j + 3;
     if (t3r)
       tf[i] = j;
-    i++;
   }
 
   /* Create interior tetrahedra */
+  i = 4 * tetrahedra;
+#ifdef USE_OPENMP
+#pragma omp parallel for lastprivate(i)
+#endif
   for (j = 0; j < tetrahedra; j++) {
+    i = 4 * tetrahedra + 4 * j;
+
     r->t[i][0] = center_faces + 4 * j + 2;
     r->t[i][1] = 4 * t[j][2] + 3;
     r->t[i][2] = center_faces + 4 * j + 3;
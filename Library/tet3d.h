@@ -39,6 +39,7 @@ typedef struct _tet3dbuilder tet3dbuilder;
 typedef tet3dbuilder *ptet3dbuilder;
 
 #include "settings.h"
+#include "reorder.h"
 
 /* ------------------------------------------------------------
    Tetrahedral mesh,
@@ -226,6 +227,54 @@ getedges_tet3d(pctet3d gr, uint tn, uint e[]);
 HEADER_PREFIX void
 getvertices_face_tet3d(pctet3d t3, uint nf, uint v[]);
 
+/** @brief Colour the tetrahedra of a mesh.
+ *
+ *  Tetrahedra are coloured such that no two tetrahedra of the same
+ *  colour share a vertex, and therefore also no edge, face or degree of
+ *  freedom of a finite element space.
+ *  Element matrices of all tetrahedra of one colour can be added to a
+ *  shared sparse matrix in parallel without synchronization.
+ *
+ *  @param gr Mesh.
+ *  @param cstart Will be overwritten by an array of <tt>colours+1</tt>
+ *    entries, tetrahedra of colour <tt>c</tt> are found in
+ *    <tt>celem[cstart[c]]</tt> to <tt>celem[cstart[c+1]-1]</tt>.
+ *  @param celem Will be overwritten by an array containing the
+ *    tetrahedra sorted by colour.
+ *  @returns Number of colours <tt>colours</tt>. */
+HEADER_PREFIX uint
+colour_tet3d(pctet3d gr, uint **cstart, uint **celem);
+
+/** @brief Renumber the vertices, edges, faces and tetrahedra of a mesh.
+ *
+ *  All connectivity arrays and boundary flags are permuted
+ *  consistently. Refinement relations, discretizations and matrices
+ *  constructed for the mesh before become invalid.
+ *
+ *  @param gr Mesh, will be renumbered.
+ *  @param xp New indices of the vertices, <tt>NULL</tt> keeps them.
+ *  @param ep New indices of the edges, <tt>NULL</tt> keeps them.
+ *  @param fp New indices of the faces, <tt>NULL</tt> keeps them.
+ *  @param tp New indices of the tetrahedra, <tt>NULL</tt> keeps them. */
+HEADER_PREFIX void
+permute_tet3d(ptet3d gr, const uint *xp, const uint *ep, const uint *fp,
+	      const uint *tp);
+
+/** @brief Renumber a mesh to improve the locality of its entities.
+ *
+ *  The vertices are ordered by @ref rcm_reorder or
+ *  @ref morton_reorder, edges, faces and tetrahedra are sorted by
+ *  their smallest vertex, edge or face, respectively.
+ *  Should be called before refining the mesh and setting up
+ *  discretizations, so that all derived structures inherit the order.
+ *
+ *  @param gr Mesh, will be renumbered.
+ *  @param mode Ordering strategy for the vertices.
+ *  @param vperm Array of <tt>gr->vertices</tt> entries, will be
+ *    overwritten by the new indices of the vertices, or <tt>NULL</tt>. */
+HEADER_PREFIX void
+reorder_tet3d(ptet3d gr, reordermode mode, uint *vperm);
+
 /* ------------------------------------------------------------
    Check structure for inconsistencies
    ------------------------------------------------------------ */
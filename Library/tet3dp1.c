@@ -9,7 +9,6 @@
 #include <stdio.h>
 
 #include "basic.h"
-#include "sparsepattern.h"
 
 ptet3dp1
 new_tet3dp1(pctet3d gr)
@@ -40,48 +39,68 @@ new_tet3dp1(pctet3d gr)
   dc->ndof = ndof;
   dc->nfix = nfix;
 
+  dc->slotgen = 0;
+  dc->slot = NULL;
+  dc->fslotgen = 0;
+  dc->fslot = NULL;
+
+  dc->colours = colour_tet3d(gr, &dc->cstart, &dc->celem);
+
   return dc;
 }
 
 void
 del_tet3dp1(ptet3dp1 dc)
 {
+  setslots_tet3dp1(dc, NULL, NULL);
+
+  freemem(dc->celem);
+  freemem(dc->cstart);
+
   freemem(dc->idx2dof);
   freemem(dc->is_dof);
   freemem(dc);
 }
 
-psparsematrix
-build_tet3dp1_sparsematrix(pctet3dp1 dc)
+/* Collect the degrees of freedom of all tetrahedra in dof, fixed vertices
+ * are marked by ndof. If fix is not null, the indices of fixed vertices
+ * are collected there and degrees of freedom are marked by nfix. */
+static void
+element_dofs(pctet3dp1 dc, uint *dof, uint *fix)
 {
   pctet3d   gr = dc->gr;
   const bool *is_dof = dc->is_dof;
   const uint *idx2dof = dc->idx2dof;
   uint      ndof = dc->ndof;
-  psparsepattern sp;
-  psparsematrix A;
-  uint      i, j, ii, jj, t, v[4];
-
-  sp = new_sparsepattern(ndof, ndof);
+  uint      nfix = dc->nfix;
+  uint      i, t, v[4];
 
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,v)
+#endif
   for (t = 0; t < gr->tetrahedra; t++) {
     getvertices_tet3d(gr, t, v);
-    for (i = 0; i < 4; i++)
-      if (is_dof[v[i]]) {
-	ii = idx2dof[v[i]];
+    for (i = 0; i < 4; i++) {
+      dof[4 * t + i] = (is_dof[v[i]] ? idx2dof[v[i]] : ndof);
+      if (fix)
+	fix[4 * t + i] = (is_dof[v[i]] ? nfix : idx2dof[v[i]]);
+    }
+  }
+}
 
-	for (j = 0; j < 4; j++)
-	  if (is_dof[v[j]]) {
-	    jj = idx2dof[v[j]];
+psparsematrix
+build_tet3dp1_sparsematrix(pctet3dp1 dc)
+{
+  uint      elements = dc->gr->tetrahedra;
+  psparsematrix A;
+  uint     *dof;
 
-	    addnz_sparsepattern(sp, ii, jj);
-	  }
-      }
-  }
+  dof = allocuint((size_t) 4 * elements);
+  element_dofs(dc, dof, NULL);
 
-  A = new_zero_sparsematrix(sp);
+  A = new_elements_sparsematrix(dc->ndof, dc->ndof, elements, 4, dof, 4, dof);
 
-  del_sparsepattern(sp);
+  freemem(dof);
 
   return A;
 }
@@ -89,39 +108,73 @@ build_tet3dp1_sparsematrix(pctet3dp1 dc)
 psparsematrix
 build_tet3dp1_interaction_sparsematrix(pctet3dp1 dc)
 {
-  pctet3d   gr = dc->gr;
-  const bool *is_dof = dc->is_dof;
-  const uint *idx2dof = dc->idx2dof;
-  uint      ndof = dc->ndof;
-  uint      nfix = dc->nfix;
-  psparsepattern sp;
+  uint      elements = dc->gr->tetrahedra;
   psparsematrix Af;
-  uint      i, j, ii, jj, t, v[4];
+  uint     *rdof, *cdof;
 
-  sp = new_sparsepattern(ndof, nfix);
+  /* Rows correspond to free, columns to fixed vertices */
+  rdof = allocuint((size_t) 4 * elements);
+  cdof = allocuint((size_t) 4 * elements);
+  element_dofs(dc, rdof, cdof);
 
-  for (t = 0; t < gr->tetrahedra; t++) {
-    getvertices_tet3d(gr, t, v);
-    for (i = 0; i < 4; i++)
-      if (is_dof[v[i]]) {
-	ii = idx2dof[v[i]];
-	assert(ii < ndof);
+  Af = new_elements_sparsematrix(dc->ndof, dc->nfix, elements, 4, rdof, 4,
+				 cdof);
 
-	for (j = 0; j < 4; j++)
-	  if (!is_dof[v[j]]) {
-	    jj = idx2dof[v[j]];
-	    assert(jj < nfix);
+  freemem(cdof);
+  freemem(rdof);
 
-	    addnz_sparsepattern(sp, ii, jj);
-	  }
-      }
+  return Af;
+}
+
+void
+setslots_tet3dp1(ptet3dp1 dc, pcsparsematrix A, pcsparsematrix Af)
+{
+  uint      elements = dc->gr->tetrahedra;
+  uint     *rdof, *cdof;
+
+  if (dc->slot)
+    freemem(dc->slot);
+  if (dc->fslot)
+    freemem(dc->fslot);
+  dc->slotgen = 0;
+  dc->slot = NULL;
+  dc->fslotgen = 0;
+  dc->fslot = NULL;
+
+  if (A == NULL && Af == NULL)
+    return;
+
+  rdof = allocuint((size_t) 4 * elements);
+  cdof = allocuint((size_t) 4 * elements);
+  element_dofs(dc, rdof, cdof);
+
+  if (A) {
+    assert(A->rows == dc->ndof && A->cols == dc->ndof);
+    dc->slot = new_elements_slots_sparsematrix(A, elements, 4, rdof, 4, rdof);
+    dc->slotgen = A->gen;
   }
 
-  Af = new_zero_sparsematrix(sp);
+  if (Af) {
+    assert(Af->rows == dc->ndof && Af->cols == dc->nfix);
+    dc->fslot = new_elements_slots_sparsematrix(Af, elements, 4, rdof, 4,
+						cdof);
+    dc->fslotgen = Af->gen;
+  }
 
-  del_sparsepattern(sp);
+  freemem(cdof);
+  freemem(rdof);
+}
 
-  return Af;
+/* Add a scaled element matrix using precomputed positions */
+static void
+addslots(psparsematrix A, const uint *slot, const real At[4][4], real scale)
+{
+  uint      i, j;
+
+  for (i = 0; i < 4; i++)
+    for (j = 0; j < 4; j++)
+      if (slot[4 * i + j] < A->nz)
+	A->coeff[slot[4 * i + j]] += scale * At[i][j];
 }
 
 psparsematrix
@@ -136,47 +189,52 @@ build_tet3dp1_prolongation_sparsematrix(pctet3dp1 dfine, pctet3dp1 dcoarse,
   const uint *coarse_idx2dof = dcoarse->idx2dof;
   uint      nfine = dfine->ndof;
   uint      ncoarse = dcoarse->ndof;
-  psparsepattern sp;
   psparsematrix P;
+  uint     *rdof, *cdof;
   uint      i, j, k, ii, jj;
 
-  sp = new_sparsepattern(nfine, ncoarse);
+  /* Every fine vertex is an element coupling its degree of freedom with
+     at most two coarse ones, fixed vertices are marked by nfine or
+     ncoarse, respectively */
+  rdof = allocuint(gr->vertices);
+  cdof = allocuint((size_t) 2 * gr->vertices);
 
-  for (i = 0; i < gr->vertices; i++)
+  for (i = 0; i < gr->vertices; i++) {
+    rdof[i] = nfine;
+    cdof[2 * i] = ncoarse;
+    cdof[2 * i + 1] = ncoarse;
     if (fine_dof[i]) {
-      ii = fine_idx2dof[i];
+      rdof[i] = fine_idx2dof[i];
       switch (rf->xt[i]) {
       case 0:
 	j = rf->xf[i];
-	if (coarse_dof[j]) {
-	  jj = coarse_idx2dof[j];
-	  addnz_sparsepattern(sp, ii, jj);
-	}
+	if (coarse_dof[j])
+	  cdof[2 * i] = coarse_idx2dof[j];
 	break;
       case 1:
 	k = rf->xf[i];
 	j = e[k][0];
-	if (coarse_dof[j]) {
-	  jj = coarse_idx2dof[j];
-	  addnz_sparsepattern(sp, ii, jj);
-	}
+	if (coarse_dof[j])
+	  cdof[2 * i] = coarse_idx2dof[j];
 	j = e[k][1];
-	if (coarse_dof[j]) {
-	  jj = coarse_idx2dof[j];
-	  addnz_sparsepattern(sp, ii, jj);
-	}
+	if (coarse_dof[j])
+	  cdof[2 * i + 1] = coarse_idx2dof[j];
 	break;
       default:
 	(void) fprintf(stderr,
 		       "Unknown father type %u of vertex %u\n", rf->xf[i], i);
-	del_sparsepattern(sp);
+	freemem(cdof);
+	freemem(rdof);
 	return 0;
       }
     }
+  }
 
-  P = new_zero_sparsematrix(sp);
+  P = new_elements_sparsematrix(nfine, ncoarse, gr->vertices, 1, rdof, 2,
+				cdof);
 
-  del_sparsepattern(sp);
+  freemem(cdof);
+  freemem(rdof);
 
   for (i = 0; i < gr->vertices; i++)
     if (fine_dof[i]) {
@@ -219,7 +277,6 @@ assemble_tet3dp1_laplace_sparsematrix(pctet3dp1 dc, psparsematrix A,
 {
   pctet3d   gr = dc->gr;
   const     real(*x)[3] = (const real(*)[3]) gr->x;
-  uint      tetrahedra = gr->tetrahedra;
   const bool *is_dof = dc->is_dof;
   const uint *idx2dof = dc->idx2dof;
   uint      ndof = dc->ndof;
@@ -229,78 +286,88 @@ assemble_tet3dp1_laplace_sparsematrix(pctet3dp1 dc, psparsematrix A,
   real      At[4][4];
   real      det;
   uint      v[4];
-  uint      t, i, j, ii, jj;
-
-  for (t = 0; t < tetrahedra; t++) {
-    /* Get vertices */
-    getvertices_tet3d(gr, t, v);
-
-    /* Get vertex coordinates */
-    for (i = 0; i < 4; i++) {
-      xt[i][0] = x[v[i]][0];
-      xt[i][1] = x[v[i]][1];
-      xt[i][2] = x[v[i]][2];
-    }
-
-    /* Compute gradients and Jacobi determinant */
-    for (i = 0; i < 4; i++) {
-      g[i][0] = ((xt[(i + 2) % 4][1] - xt[(i + 1) % 4][1])
-		 * (xt[(i + 3) % 4][2] - xt[(i + 1) % 4][2])
-		 - (xt[(i + 2) % 4][2] - xt[(i + 1) % 4][2])
-		 * (xt[(i + 3) % 4][1] - xt[(i + 1) % 4][1]));
-      g[i][1] = ((xt[(i + 2) % 4][2] - xt[(i + 1) % 4][2])
-		 * (xt[(i + 3) % 4][0] - xt[(i + 1) % 4][0])
-		 - (xt[(i + 2) % 4][0] - xt[(i + 1) % 4][0])
-		 * (xt[(i + 3) % 4][2] - xt[(i + 1) % 4][2]));
-      g[i][2] = ((xt[(i + 2) % 4][0] - xt[(i + 1) % 4][0])
-		 * (xt[(i + 3) % 4][1] - xt[(i + 1) % 4][1])
-		 - (xt[(i + 2) % 4][1] - xt[(i + 1) % 4][1])
-		 * (xt[(i + 3) % 4][0] - xt[(i + 1) % 4][0]));
-
-      det = ((xt[i][0] - xt[(i + 1) % 4][0]) * g[i][0]
-	     + (xt[i][1] - xt[(i + 1) % 4][1]) * g[i][1]
-	     + (xt[i][2] - xt[(i + 1) % 4][2]) * g[i][2]);
-
-      g[i][0] /= det;
-      g[i][1] /= det;
-      g[i][2] /= det;
-    }
-
-    /* Compute element matrix */
-    for (i = 0; i < 4; i++)
-      for (j = 0; j < 4; j++)
-	At[i][j] = (g[i][0] * g[j][0]
-		    + g[i][1] * g[j][1]
-		    + g[i][2] * g[j][2]) * fabs(det) / 6.0;
+  uint      c, n, t, i, j, ii, jj;
+
+  for (c = 0; c < dc->colours; c++) {
+#ifdef USE_OPENMP
+#pragma omp parallel for private(xt,g,At,det,v,i,j,ii,jj,t)
+#endif
+    for (n = dc->cstart[c]; n < dc->cstart[c + 1]; n++) {
+      t = dc->celem[n];
+      /* Get vertices */
+      getvertices_tet3d(gr, t, v);
+
+      /* Get vertex coordinates */
+      for (i = 0; i < 4; i++) {
+	xt[i][0] = x[v[i]][0];
+	xt[i][1] = x[v[i]][1];
+	xt[i][2] = x[v[i]][2];
+      }
 
-    /* Add to system matrix */
-    if (A)
-      for (i = 0; i < 4; i++)
-	if (is_dof[v[i]]) {
-	  ii = idx2dof[v[i]];
-
-	  for (j = 0; j < 4; j++)
-	    if (is_dof[v[j]]) {
-	      jj = idx2dof[v[j]];
-	      addentry_sparsematrix(A, ii, jj, At[i][j]);
-	    }
-	}
+      /* Compute gradients and Jacobi determinant */
+      for (i = 0; i < 4; i++) {
+	g[i][0] = ((xt[(i + 2) % 4][1] - xt[(i + 1) % 4][1])
+		   * (xt[(i + 3) % 4][2] - xt[(i + 1) % 4][2])
+		   - (xt[(i + 2) % 4][2] - xt[(i + 1) % 4][2])
+		   * (xt[(i + 3) % 4][1] - xt[(i + 1) % 4][1]));
+	g[i][1] = ((xt[(i + 2) % 4][2] - xt[(i + 1) % 4][2])
+		   * (xt[(i + 3) % 4][0] - xt[(i + 1) % 4][0])
+		   - (xt[(i + 2) % 4][0] - xt[(i + 1) % 4][0])
+		   * (xt[(i + 3) % 4][2] - xt[(i + 1) % 4][2]));
+	g[i][2] = ((xt[(i + 2) % 4][0] - xt[(i + 1) % 4][0])
+		   * (xt[(i + 3) % 4][1] - xt[(i + 1) % 4][1])
+		   - (xt[(i + 2) % 4][1] - xt[(i + 1) % 4][1])
+		   * (xt[(i + 3) % 4][0] - xt[(i + 1) % 4][0]));
+
+	det = ((xt[i][0] - xt[(i + 1) % 4][0]) * g[i][0]
+	       + (xt[i][1] - xt[(i + 1) % 4][1]) * g[i][1]
+	       + (xt[i][2] - xt[(i + 1) % 4][2]) * g[i][2]);
+
+	g[i][0] /= det;
+	g[i][1] /= det;
+	g[i][2] /= det;
+      }
 
-    /* Add to interaction matrix */
-    if (Af)
+      /* Compute element matrix */
       for (i = 0; i < 4; i++)
-	if (is_dof[v[i]]) {
-	  ii = idx2dof[v[i]];
-	  assert(ii < ndof);
-
-	  for (j = 0; j < 4; j++)
-	    if (!is_dof[v[j]]) {
-	      jj = idx2dof[v[j]];
-	      assert(jj < nfix);
+	for (j = 0; j < 4; j++)
+	  At[i][j] = (g[i][0] * g[j][0]
+		      + g[i][1] * g[j][1]
+		      + g[i][2] * g[j][2]) * fabs(det) / 6.0;
+
+      /* Add to system matrix */
+      if (A && A->gen == dc->slotgen)
+	addslots(A, dc->slot + (size_t) 16 * t, At, 1.0);
+      else if (A)
+	for (i = 0; i < 4; i++)
+	  if (is_dof[v[i]]) {
+	    ii = idx2dof[v[i]];
+
+	    for (j = 0; j < 4; j++)
+	      if (is_dof[v[j]]) {
+		jj = idx2dof[v[j]];
+		addentry_sparsematrix(A, ii, jj, At[i][j]);
+	      }
+	  }
 
-	      addentry_sparsematrix(Af, ii, jj, At[i][j]);
-	    }
-	}
+      /* Add to interaction matrix */
+      if (Af && Af->gen == dc->fslotgen)
+	addslots(Af, dc->fslot + (size_t) 16 * t, At, 1.0);
+      else if (Af)
+	for (i = 0; i < 4; i++)
+	  if (is_dof[v[i]]) {
+	    ii = idx2dof[v[i]];
+	    assert(ii < ndof);
+
+	    for (j = 0; j < 4; j++)
+	      if (!is_dof[v[j]]) {
+		jj = idx2dof[v[j]];
+		assert(jj < nfix);
+
+		addentry_sparsematrix(Af, ii, jj, At[i][j]);
+	      }
+	  }
+    }
   }
 }
 
@@ -315,7 +382,6 @@ assemble_tet3dp1_mass_sparsematrix(pctet3dp1 dc, psparsematrix M,
   };
   pctet3d   gr = dc->gr;
   const     real(*x)[3] = (const real(*)[3]) gr->x;
-  uint      tetrahedra = gr->tetrahedra;
   const bool *is_dof = dc->is_dof;
   const uint *idx2dof = dc->idx2dof;
   uint      ndof = dc->ndof;
@@ -324,58 +390,68 @@ assemble_tet3dp1_mass_sparsematrix(pctet3dp1 dc, psparsematrix M,
   real      g0[3];
   real      adet;
   uint      v[4];
-  uint      t, i, j, ii, jj;
+  uint      c, n, t, i, j, ii, jj;
+
+  for (c = 0; c < dc->colours; c++) {
+#ifdef USE_OPENMP
+#pragma omp parallel for private(xt,g0,adet,v,i,j,ii,jj,t)
+#endif
+    for (n = dc->cstart[c]; n < dc->cstart[c + 1]; n++) {
+      t = dc->celem[n];
+      /* Get vertices */
+      getvertices_tet3d(gr, t, v);
+
+      /* Get vertex coordinates */
+      for (i = 0; i < 4; i++) {
+	xt[i][0] = x[v[i]][0];
+	xt[i][1] = x[v[i]][1];
+	xt[i][2] = x[v[i]][2];
+      }
 
-  for (t = 0; t < tetrahedra; t++) {
-    /* Get vertices */
-    getvertices_tet3d(gr, t, v);
+      g0[0] = ((xt[2][1] - xt[1][1]) * (xt[3][2] - xt[1][2])
+	       - (xt[2][2] - xt[1][2]) * (xt[3][1] - xt[1][1]));
+      g0[1] = ((xt[2][2] - xt[1][2]) * (xt[3][0] - xt[1][0])
+	       - (xt[2][0] - xt[1][0]) * (xt[3][2] - xt[1][2]));
+      g0[2] = ((xt[2][0] - xt[1][0]) * (xt[3][1] - xt[1][1])
+	       - (xt[2][1] - xt[1][1]) * (xt[3][0] - xt[1][0]));
+
+      adet = fabs((xt[0][0] - xt[1][0]) * g0[0]
+		  + (xt[0][1] - xt[1][1]) * g0[1]
+		  + (xt[0][2] - xt[1][2]) * g0[2]);
+
+      /* Add to system matrix */
+      if (M && M->gen == dc->slotgen)
+	addslots(M, dc->slot + (size_t) 16 * t, Mt, adet);
+      else if (M)
+	for (i = 0; i < 4; i++)
+	  if (is_dof[v[i]]) {
+	    ii = idx2dof[v[i]];
+
+	    for (j = 0; j < 4; j++)
+	      if (is_dof[v[j]]) {
+		jj = idx2dof[v[j]];
+		addentry_sparsematrix(M, ii, jj, adet * Mt[i][j]);
+	      }
+	  }
 
-    /* Get vertex coordinates */
-    for (i = 0; i < 4; i++) {
-      xt[i][0] = x[v[i]][0];
-      xt[i][1] = x[v[i]][1];
-      xt[i][2] = x[v[i]][2];
+      /* Add to interaction matrix */
+      if (Mf && Mf->gen == dc->fslotgen)
+	addslots(Mf, dc->fslot + (size_t) 16 * t, Mt, adet);
+      else if (Mf)
+	for (i = 0; i < 4; i++)
+	  if (is_dof[v[i]]) {
+	    ii = idx2dof[v[i]];
+	    assert(ii < ndof);
+
+	    for (j = 0; j < 4; j++)
+	      if (!is_dof[v[j]]) {
+		jj = idx2dof[v[j]];
+		assert(jj < nfix);
+
+		addentry_sparsematrix(Mf, ii, jj, adet * Mt[i][j]);
+	      }
+	  }
     }
-
-    g0[0] = ((xt[2][1] - xt[1][1]) * (xt[3][2] - xt[1][2])
-	     - (xt[2][2] - xt[1][2]) * (xt[3][1] - xt[1][1]));
-    g0[1] = ((xt[2][2] - xt[1][2]) * (xt[3][0] - xt[1][0])
-	     - (xt[2][0] - xt[1][0]) * (xt[3][2] - xt[1][2]));
-    g0[2] = ((xt[2][0] - xt[1][0]) * (xt[3][1] - xt[1][1])
-	     - (xt[2][1] - xt[1][1]) * (xt[3][0] - xt[1][0]));
-
-    adet = fabs((xt[0][0] - xt[1][0]) * g0[0]
-		+ (xt[0][1] - xt[1][1]) * g0[1]
-		+ (xt[0][2] - xt[1][2]) * g0[2]);
-
-    /* Add to system matrix */
-    if (M)
-      for (i = 0; i < 4; i++)
-	if (is_dof[v[i]]) {
-	  ii = idx2dof[v[i]];
-
-	  for (j = 0; j < 4; j++)
-	    if (is_dof[v[j]]) {
-	      jj = idx2dof[v[j]];
-	      addentry_sparsematrix(M, ii, jj, adet * Mt[i][j]);
-	    }
-	}
-
-    /* Add to interaction matrix */
-    if (Mf)
-      for (i = 0; i < 4; i++)
-	if (is_dof[v[i]]) {
-	  ii = idx2dof[v[i]];
-	  assert(ii < ndof);
-
-	  for (j = 0; j < 4; j++)
-	    if (!is_dof[v[j]]) {
-	      jj = idx2dof[v[j]];
-	      assert(jj < nfix);
-
-	      addentry_sparsematrix(Mf, ii, jj, adet * Mt[i][j]);
-	    }
-	}
   }
 }
 
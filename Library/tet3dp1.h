@@ -59,6 +59,32 @@ struct _tet3dp1 {
   /** @brief Consecutive indices for all degrees of freedom and all
    *  fixed vertices. */
   uint *idx2dof;
+
+  /** @brief Generation @ref sparsematrix.gen of the matrix for the
+   *  degrees of freedom <tt>slot</tt> refers to, zero if none,
+   *  see @ref setslots_tet3dp1. */
+  size_t slotgen;
+
+  /** @brief Positions of the element matrices in the matrix with
+   *  generation <tt>slotgen</tt>, 16 per tetrahedron, or <tt>NULL</tt>. */
+  uint *slot;
+
+  /** @brief Generation of the interaction matrix <tt>fslot</tt>
+   *  refers to, zero if none. */
+  size_t fslotgen;
+
+  /** @brief Positions of the element matrices in the matrix with
+   *  generation <tt>fslotgen</tt>, 16 per tetrahedron, or <tt>NULL</tt>. */
+  uint *fslot;
+  /** @brief Number of colours of the tetrahedra, see @ref colour_tet3d. */
+  uint colours;
+
+  /** @brief Start of each colour in <tt>celem</tt>. */
+  uint *cstart;
+
+  /** @brief Tetrahedra sorted by colour, used to assemble
+   *  matrices in parallel. */
+  uint *celem;
 };
 
 /** @brief Create a @ref tet3dp1 object using a @ref tet3d mesh.
@@ -128,6 +154,29 @@ HEADER_PREFIX psparsematrix
 build_tet3dp1_prolongation_sparsematrix(pctet3dp1 dfine, pctet3dp1 dcoarse,
 			   pctet3dref rf);
 
+/** @brief Prepare repeated assembly into fixed matrices.
+ *
+ *  Finds the positions of all element matrix entries in the patterns
+ *  of <tt>A</tt> and <tt>Af</tt> and stores them in <tt>dc</tt>.
+ *  If one of these matrices is passed to
+ *  @ref assemble_tet3dp1_laplace_sparsematrix or
+ *  @ref assemble_tet3dp1_mass_sparsematrix later on, the element
+ *  matrices are added without searching the rows, which speeds up
+ *  nonlinear or time-stepping schemes that reassemble on a fixed mesh.
+ *  Matrices are recognized by their generation @ref sparsematrix.gen,
+ *  so a new matrix at the address of a deleted one or a matrix
+ *  reordered by @ref sort_sparsematrix falls back to searching.
+ *
+ *  Calling the function with two null pointers releases the positions.
+ *
+ *  @param dc @ref tet3dp1 object describing the space.
+ *  @param A Matrix created by @ref build_tet3dp1_sparsematrix or
+ *    <tt>NULL</tt>.
+ *  @param Af Matrix created by
+ *    @ref build_tet3dp1_interaction_sparsematrix or <tt>NULL</tt>. */
+HEADER_PREFIX void
+setslots_tet3dp1(ptet3dp1 dc, pcsparsematrix A, pcsparsematrix Af);
+
 /** @brief Assemble stiffness matrix.
  *
  *  Element matrices for all tetrahedra are computed and added
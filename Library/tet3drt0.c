@@ -38,6 +38,8 @@ ptet3drt0 new_tet3drt0(pctet3d t3) {
   dc->ndof = ndof;
   dc->nfix = nfix;
 
+  dc->colours = colour_tet3d(t3, &dc->cstart, &dc->celem);
+
   return dc;
 }
 
@@ -67,6 +69,8 @@ void update_tet3drt0(ptet3drt0 rt0) {
 }
 
 void del_tet3drt0(ptet3drt0 dc) {
+  freemem(dc->celem);
+  freemem(dc->cstart);
   freemem(dc->is_dof);
   freemem(dc->idx2dof);
   freemem(dc);
@@ -756,10 +760,9 @@ void assemble_tet3drt0_darcy_A_sparsematrix(pctet3drt0 dc, psparsematrix A,
   const uint (*t)[4] = (const uint (*)[4]) dc->t3->t;
   const uint *is_dof = dc->is_dof;
   const uint *idx2dof = dc->idx2dof;
-  uint tetrahedra = dc->t3->tetrahedra;
   uint ndof = dc->ndof;
   uint nfix = dc->nfix;
-  uint i, j, ii, jj, d, k, l;
+  uint c, n, i, j, ii, jj, d, k, l;
 
   real At[4][4];
   uint v[4];
@@ -772,172 +775,168 @@ void assemble_tet3drt0_darcy_A_sparsematrix(pctet3drt0 dc, psparsematrix A,
   //int eti_end, eti_start;
 
   //tetrahedra =1;
-  for (d = 0; d < tetrahedra; d++) {
-    // printf("tetrahedra %d\n", d);
-    /*Get faces of tetrahedra d*/
-    ft[0] = t[d][0];
-    ft[1] = t[d][1];
-    ft[2] = t[d][2];
-    ft[3] = t[d][3];
-    // printf("faces %d %d %d %d\n", ft[0], ft[1], ft[2], ft[3]);
-    /*Get vertices of tetrahedra d*/
-    getvertices_tet3d(dc->t3, d, v);
-    //     printf("vertices\n");
-    // printf("%d %f %f %f\n", xt[0], x[xt[0]][0], x[xt[0]][1], x[xt[0]][2]);
-    // printf("%d %f %f %f\n", xt[1], x[xt[1]][0], x[xt[1]][1], x[xt[1]][2]);
-    // printf("%d %f %f %f\n", xt[2], x[xt[2]][0], x[xt[2]][1], x[xt[2]][2]);
-    // printf("%d %f %f %f\n", xt[3], x[xt[3]][0], x[xt[3]][1], x[xt[3]][2]);
-
-    /*volume of tetrahedra d*/
-    T = (1.0 / 6.0) * fabs(
-            (x[v[1]][0] - x[v[0]][0]) * ((x[v[2]][1] - x[v[0]][1])
-                * (x[v[3]][2] - x[v[0]][2])
-                                         - (x[v[2]][2] - x[v[0]][2]) * (x[v[3]][1]
-                                             - x[v[0]][1]))
-
-            - (x[v[1]][1] - x[v[0]][1]) * ((x[v[2]][0] - x[v[0]][0])
-                * (x[v[3]][2] - x[v[0]][2])
-                                           - (x[v[2]][2] - x[v[0]][2]) * (x[v[3]][0]
-                                               - x[v[0]][0]))
-
-            + (x[v[1]][2] - x[v[0]][2]) * ((x[v[2]][0] - x[v[0]][0])
-                * (x[v[3]][1] - x[v[0]][1])
-                                           - (x[v[2]][1] - x[v[0]][1]) * (x[v[3]][0]
-                                               - x[v[0]][0])));
-    //printf("T = %f \n",T);
-    /*algebraic sign*/
-    //sigma[0]=1; sigma[1]= 1;sigma[2]=1; /*VZ noch richtig bestimmen!!!!!!!!!!!!*/
-    // for(i=0;i<3;i++){
-    //  eti_start = e[et[i]][0]; eti_end = e[et[i]][1];
-    // a = x[eti_start][0] - x[eti_end][0];
-    // b = x[eti_start][1] - x[eti_end][1];
-    /*length of edge i*/
-    // E[i] = sqrt(a*a+b*b);
-    //}
-    /*Initialise At with zero*/
-    for (i = 0; i < 4; i++)
-      for (j = 0; j < 4; j++)
-        At[i][j] = 0.0;
-
-    /* Compute element matrix */
-    for (i = 0; i < 4; i++)
-      for (j = 0; j < 4; j++) {
-        /*non diagonal entry*/
-        if (i != j) {
-          if ((i == 0 && j == 1) || (i == 1 && j == 0)) {
-            k = 2;
-            l = 3;
-          } else if ((i == 0 && j == 2) || (i == 2 && j == 0)) {
-            k = 1;
-            l = 3;
-          } else if ((i == 0 && j == 3) || (i == 3 && j == 0)) {
-            k = 1;
-            l = 2;
-          } else if ((i == 1 && j == 2) || (i == 2 && j == 1)) {
-            k = 0;
-            l = 3;
-          } else if ((i == 1 && j == 3) || (i == 3 && j == 1)) {
-            k = 0;
-            l = 2;
-          } else {
-            k = 0;
-            l = 1;
-          }
-          // printf("i=%d, j=%d, k=%d, l=%d \n",i,j,k,l);
-
-          x_ij[0] = x[v[i]][0] - x[v[j]][0];
-          x_ij[1] = x[v[i]][1] - x[v[j]][1];
-          x_ij[2] = x[v[i]][2] - x[v[j]][2];
-          x_jk[0] = x[v[j]][0] - x[v[k]][0];
-          x_jk[1] = x[v[j]][1] - x[v[k]][1];
-          x_jk[2] = x[v[j]][2] - x[v[k]][2];
-          //x_kl[0] = x[v[k]][0] - x[v[l]][0]; x_kl[1] = x[v[k]][1] - x[v[l]][1]; x_kl[2] = x[v[k]][2] - x[v[l]][2];
-          x_li[0] = x[v[l]][0] - x[v[i]][0];
-          x_li[1] = x[v[l]][1] - x[v[i]][1];
-          x_li[2] = x[v[l]][2] - x[v[i]][2];
-          x_ik[0] = x[v[i]][0] - x[v[k]][0];
-          x_ik[1] = x[v[i]][1] - x[v[k]][1];
-          x_ik[2] = x[v[i]][2] - x[v[k]][2];
-          x_jl[0] = x[v[j]][0] - x[v[l]][0];
-          x_jl[1] = x[v[j]][1] - x[v[l]][1];
-          x_jl[2] = x[v[j]][2] - x[v[l]][2];
-
-          At[i][j] = -2 * scalar(x_ij, x_ij) - 2 * scalar(x_ij, x_ik)
-              + 2 * scalar(x_jk, x_ij) + 3 * scalar(x_jk, x_ik)
-                     - 2 * scalar(x_jk, x_li)
-                     + 2 * scalar(x_jl, x_ij) + 2 * scalar(x_jl, x_ik)
-                     - 3 * scalar(x_jl, x_li)
-                     + 2 * scalar(x_ij, x_li);
-          signum_i = compute_type_of_face_tet3d(dc->t3, d, i);
-          signum_j = compute_type_of_face_tet3d(dc->t3, d, j);
-          At[i][j] = (signum_i * signum_j * At[i][j] * K->v[d]) / (324 * T); 
-          //printf("At[%u][%u] = %f signum[%u] = %f signum[%u] = %f\n",i, j,  At[i][j], i, signum_i, j, signum_j);
-        }
-
-        else { /*diagonal entry*/
-          assert(i == j);
-          i = ((j + 1) % 4);
-          k = ((j + 2) % 4);
-          l = ((j + 3) % 4);
-
-          x_ij[0] = x[v[i]][0] - x[v[j]][0];
-          x_ij[1] = x[v[i]][1] - x[v[j]][1];
-          x_ij[2] = x[v[i]][2] - x[v[j]][2];
-          x_jk[0] = x[v[j]][0] - x[v[k]][0];
-          x_jk[1] = x[v[j]][1] - x[v[k]][1];
-          x_jk[2] = x[v[j]][2] - x[v[k]][2];
-          //x_kl[0] = x[v[k]][0] - x[v[l]][0]; x_kl[1] = x[v[k]][1] - x[v[l]][1]; x_kl[2] = x[v[k]][2] - x[v[l]][2];
-          x_li[0] = x[v[l]][0] - x[v[i]][0];
-          x_li[1] = x[v[l]][1] - x[v[i]][1];
-          x_li[2] = x[v[l]][2] - x[v[i]][2];
-          x_ik[0] = x[v[i]][0] - x[v[k]][0];
-          x_ik[1] = x[v[i]][1] - x[v[k]][1];
-          x_ik[2] = x[v[i]][2] - x[v[k]][2];
-          x_jl[0] = x[v[j]][0] - x[v[l]][0];
-          x_jl[1] = x[v[j]][1] - x[v[l]][1];
-          x_jl[2] = x[v[j]][2] - x[v[l]][2];
-
-          At[j][j] = 3 * scalar(x_ij, x_ij) + 3 * scalar(x_jk, x_jk)
-                     + 3 * scalar(x_jl, x_jl)
-                     - 4 * scalar(x_ij, x_jk)
-                     + 4 * scalar(x_jl, x_jk)
-                     - 4 * scalar(x_jl, x_ij);
-          At[j][j] = (At[j][j] * K->v[d]) / (324 * T); 
-
-          i = j;
-        }
-
-      }
-    /* Add to system matrix */
-    for (i = 0; i < 4; i++) {
-      if (is_dof[ft[i]] == 0 || is_dof[ft[i]] == 1) {
-        ii = idx2dof[ft[i]];
-        for (j = 0; j < 4; j++) {
-          if (is_dof[ft[j]] == 0 || is_dof[ft[j]] == 1) {
-            jj = idx2dof[ft[j]];
-            addentry_sparsematrix(A, ii, jj, At[i][j]);
-          }
-        }
+  for (c = 0; c < dc->colours; c++) {
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,j,ii,jj,d,k,l,At,v,ft,T,signum_i,signum_j,x_ij,x_jk,x_li,x_ik,x_jl)
+#endif
+    for (n = dc->cstart[c]; n < dc->cstart[c + 1]; n++) {
+      d = dc->celem[n];
+      /*Get faces of tetrahedra d*/
+      ft[0] = t[d][0];
+      ft[1] = t[d][1];
+      ft[2] = t[d][2];
+      ft[3] = t[d][3];
+      /*Get vertices of tetrahedra d*/
+      getvertices_tet3d(dc->t3, d, v);
+
+      /*volume of tetrahedra d*/
+      T = (1.0 / 6.0) * fabs(
+	      (x[v[1]][0] - x[v[0]][0]) * ((x[v[2]][1] - x[v[0]][1])
+		  * (x[v[3]][2] - x[v[0]][2])
+					   - (x[v[2]][2] - x[v[0]][2]) * (x[v[3]][1]
+					       - x[v[0]][1]))
+
+	      - (x[v[1]][1] - x[v[0]][1]) * ((x[v[2]][0] - x[v[0]][0])
+		  * (x[v[3]][2] - x[v[0]][2])
+					     - (x[v[2]][2] - x[v[0]][2]) * (x[v[3]][0]
+						 - x[v[0]][0]))
+
+	      + (x[v[1]][2] - x[v[0]][2]) * ((x[v[2]][0] - x[v[0]][0])
+		  * (x[v[3]][1] - x[v[0]][1])
+					     - (x[v[2]][1] - x[v[0]][1]) * (x[v[3]][0]
+						 - x[v[0]][0])));
+      /*algebraic sign*/
+      //sigma[0]=1; sigma[1]= 1;sigma[2]=1; /*VZ noch richtig bestimmen!!!!!!!!!!!!*/
+      // for(i=0;i<3;i++){
+      //  eti_start = e[et[i]][0]; eti_end = e[et[i]][1];
+      // a = x[eti_start][0] - x[eti_end][0];
+      // b = x[eti_start][1] - x[eti_end][1];
+      /*length of edge i*/
+      // E[i] = sqrt(a*a+b*b);
+      //}
+      /*Initialise At with zero*/
+      for (i = 0; i < 4; i++)
+	for (j = 0; j < 4; j++)
+	  At[i][j] = 0.0;
+
+      /* Compute element matrix */
+      for (i = 0; i < 4; i++)
+	for (j = 0; j < 4; j++) {
+	  /*non diagonal entry*/
+	  if (i != j) {
+	    if ((i == 0 && j == 1) || (i == 1 && j == 0)) {
+	      k = 2;
+	      l = 3;
+	    } else if ((i == 0 && j == 2) || (i == 2 && j == 0)) {
+	      k = 1;
+	      l = 3;
+	    } else if ((i == 0 && j == 3) || (i == 3 && j == 0)) {
+	      k = 1;
+	      l = 2;
+	    } else if ((i == 1 && j == 2) || (i == 2 && j == 1)) {
+	      k = 0;
+	      l = 3;
+	    } else if ((i == 1 && j == 3) || (i == 3 && j == 1)) {
+	      k = 0;
+	      l = 2;
+	    } else {
+	      k = 0;
+	      l = 1;
+	    }
+
+	    x_ij[0] = x[v[i]][0] - x[v[j]][0];
+	    x_ij[1] = x[v[i]][1] - x[v[j]][1];
+	    x_ij[2] = x[v[i]][2] - x[v[j]][2];
+	    x_jk[0] = x[v[j]][0] - x[v[k]][0];
+	    x_jk[1] = x[v[j]][1] - x[v[k]][1];
+	    x_jk[2] = x[v[j]][2] - x[v[k]][2];
+	    //x_kl[0] = x[v[k]][0] - x[v[l]][0]; x_kl[1] = x[v[k]][1] - x[v[l]][1]; x_kl[2] = x[v[k]][2] - x[v[l]][2];
+	    x_li[0] = x[v[l]][0] - x[v[i]][0];
+	    x_li[1] = x[v[l]][1] - x[v[i]][1];
+	    x_li[2] = x[v[l]][2] - x[v[i]][2];
+	    x_ik[0] = x[v[i]][0] - x[v[k]][0];
+	    x_ik[1] = x[v[i]][1] - x[v[k]][1];
+	    x_ik[2] = x[v[i]][2] - x[v[k]][2];
+	    x_jl[0] = x[v[j]][0] - x[v[l]][0];
+	    x_jl[1] = x[v[j]][1] - x[v[l]][1];
+	    x_jl[2] = x[v[j]][2] - x[v[l]][2];
+
+	    At[i][j] = -2 * scalar(x_ij, x_ij) - 2 * scalar(x_ij, x_ik)
+		+ 2 * scalar(x_jk, x_ij) + 3 * scalar(x_jk, x_ik)
+		       - 2 * scalar(x_jk, x_li)
+		       + 2 * scalar(x_jl, x_ij) + 2 * scalar(x_jl, x_ik)
+		       - 3 * scalar(x_jl, x_li)
+		       + 2 * scalar(x_ij, x_li);
+	    signum_i = compute_type_of_face_tet3d(dc->t3, d, i);
+	    signum_j = compute_type_of_face_tet3d(dc->t3, d, j);
+	    At[i][j] = (signum_i * signum_j * At[i][j] * K->v[d]) / (324 * T); 
+	  }
+
+	  else { /*diagonal entry*/
+	    assert(i == j);
+	    i = ((j + 1) % 4);
+	    k = ((j + 2) % 4);
+	    l = ((j + 3) % 4);
+
+	    x_ij[0] = x[v[i]][0] - x[v[j]][0];
+	    x_ij[1] = x[v[i]][1] - x[v[j]][1];
+	    x_ij[2] = x[v[i]][2] - x[v[j]][2];
+	    x_jk[0] = x[v[j]][0] - x[v[k]][0];
+	    x_jk[1] = x[v[j]][1] - x[v[k]][1];
+	    x_jk[2] = x[v[j]][2] - x[v[k]][2];
+	    //x_kl[0] = x[v[k]][0] - x[v[l]][0]; x_kl[1] = x[v[k]][1] - x[v[l]][1]; x_kl[2] = x[v[k]][2] - x[v[l]][2];
+	    x_li[0] = x[v[l]][0] - x[v[i]][0];
+	    x_li[1] = x[v[l]][1] - x[v[i]][1];
+	    x_li[2] = x[v[l]][2] - x[v[i]][2];
+	    x_ik[0] = x[v[i]][0] - x[v[k]][0];
+	    x_ik[1] = x[v[i]][1] - x[v[k]][1];
+	    x_ik[2] = x[v[i]][2] - x[v[k]][2];
+	    x_jl[0] = x[v[j]][0] - x[v[l]][0];
+	    x_jl[1] = x[v[j]][1] - x[v[l]][1];
+	    x_jl[2] = x[v[j]][2] - x[v[l]][2];
+
+	    At[j][j] = 3 * scalar(x_ij, x_ij) + 3 * scalar(x_jk, x_jk)
+		       + 3 * scalar(x_jl, x_jl)
+		       - 4 * scalar(x_ij, x_jk)
+		       + 4 * scalar(x_jl, x_jk)
+		       - 4 * scalar(x_jl, x_ij);
+	    At[j][j] = (At[j][j] * K->v[d]) / (324 * T); 
+
+	    i = j;
+	  }
+
+	}
+      /* Add to system matrix */
+      for (i = 0; i < 4; i++) {
+	if (is_dof[ft[i]] == 0 || is_dof[ft[i]] == 1) {
+	  ii = idx2dof[ft[i]];
+	  for (j = 0; j < 4; j++) {
+	    if (is_dof[ft[j]] == 0 || is_dof[ft[j]] == 1) {
+	      jj = idx2dof[ft[j]];
+	      addentry_sparsematrix(A, ii, jj, At[i][j]);
+	    }
+	  }
+	}
       }
-    }
 
-    /* Add to interaction matrix */
-    if (Af) {
-      for (i = 0; i < 4; i++) {
-        if (is_dof[ft[i]] == 0 || is_dof[ft[i]] == 1) { /*inner or Dirichlet*/
-          ii = idx2dof[ft[i]];
-          assert(ii < ndof);
-          for (j = 0; j < 4; j++) {
-            if (is_dof[ft[j]] == 2) { /*Neumann*/
-              jj = idx2dof[ft[j]];
-              assert(jj < nfix);
-              addentry_sparsematrix(Af, ii, jj, At[i][j]);
-            }
-          }
-        }
+      /* Add to interaction matrix */
+      if (Af) {
+	for (i = 0; i < 4; i++) {
+	  if (is_dof[ft[i]] == 0 || is_dof[ft[i]] == 1) { /*inner or Dirichlet*/
+	    ii = idx2dof[ft[i]];
+	    assert(ii < ndof);
+	    for (j = 0; j < 4; j++) {
+	      if (is_dof[ft[j]] == 2) { /*Neumann*/
+		jj = idx2dof[ft[j]];
+		assert(jj < nfix);
+		addentry_sparsematrix(Af, ii, jj, At[i][j]);
+	      }
+	    }
+	  }
+	}
       }
-    }
 
+    }
   }
 }
 
@@ -955,6 +954,10 @@ void assemble_tet3drt0_darcy_B_sparsematrix(pctet3drt0 dc, psparsematrix A,
   //real a,b, sigma_i;
   real signum;
 
+  /* Every tetrahedron only contributes to its own row */
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,ii,signum,At,ft)
+#endif
   for (d = 0; d < tetrahedra; d++) {
     /*Get faces of tetrahedra d*/
     ft[0] = t[d][0];
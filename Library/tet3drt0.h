@@ -73,6 +73,16 @@ struct _tet3drt0
   
   /** @brief Consecutive indices for all degrees of freedom and all fixed faces.*/
   uint *idx2dof; 
+
+  /** @brief Number of colours of the tetrahedra, see @ref colour_tet3d. */
+  uint colours;
+
+  /** @brief Start of each colour in <tt>celem</tt>. */
+  uint *cstart;
+
+  /** @brief Tetrahedra sorted by colour, used to assemble
+   *  matrices in parallel. */
+  uint *celem;
 };
 
 /** @brief Create a @ref tet3drt0 object using a @ref tet3d mesh.
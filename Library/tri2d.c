@@ -1,6 +1,7 @@
 #include "tri2d.h"
 
 #include "basic.h"
+#include "reorder.h"
 
 #include <assert.h>
 #include <math.h>
@@ -658,6 +659,170 @@ getvertices_tri2d(pctri2d t2, uint tn, uint v[])
   v[1] = common_vertex_global(e, t[tn][2], t[tn][0]);	/*common vertex in edge 2 and 0 in triangle tn */
 }
 
+uint
+colour_tri2d(pctri2d t2, uint **cstart, uint **celem)
+{
+  uint      elements = t2->triangles;
+  uint      vertices = t2->vertices;
+  uint     *vstart, *velem, *colour, *forbidden, *cs, *ce;
+  uint      colours;
+  uint      i, j, k, c, t, v[3];
+
+  /* Lists of elements sharing a vertex */
+  vstart = allocuint(vertices + 1);
+  for (i = 0; i <= vertices; i++)
+    vstart[i] = 0;
+  for (t = 0; t < elements; t++) {
+    getvertices_tri2d(t2, t, v);
+    for (i = 0; i < 3; i++)
+      vstart[v[i] + 1]++;
+  }
+  for (i = 0; i < vertices; i++)
+    vstart[i + 1] += vstart[i];
+
+  velem = allocuint(vstart[vertices]);
+  for (t = 0; t < elements; t++) {
+    getvertices_tri2d(t2, t, v);
+    for (i = 0; i < 3; i++)
+      velem[vstart[v[i]]++] = t;
+  }
+  for (i = vertices; i > 0; i--)
+    vstart[i] = vstart[i - 1];
+  vstart[0] = 0;
+
+  /* Greedy colouring: every element receives the smallest colour not
+     used by an element sharing one of its vertices */
+  colour = allocuint(elements);
+  forbidden = allocuint(elements + 1);
+  for (c = 0; c <= elements; c++)
+    forbidden[c] = elements;
+  colours = 0;
+  for (t = 0; t < elements; t++) {
+    getvertices_tri2d(t2, t, v);
+    for (i = 0; i < 3; i++)
+      for (j = vstart[v[i]]; j < vstart[v[i] + 1] && velem[j] < t; j++)
+	forbidden[colour[velem[j]]] = t;
+
+    for (c = 0; c < colours && forbidden[c] == t; c++);
+    colour[t] = c;
+    if (c == colours)
+      colours++;
+  }
+
+  /* Sort elements by colour */
+  cs = allocuint(colours + 1);
+  for (c = 0; c <= colours; c++)
+    cs[c] = 0;
+  for (t = 0; t < elements; t++)
+    cs[colour[t] + 1]++;
+  for (c = 0; c < colours; c++)
+    cs[c + 1] += cs[c];
+
+  ce = allocuint(elements);
+  for (t = 0; t < elements; t++) {
+    k = colour[t];
+    ce[cs[k]++] = t;
+  }
+  for (c = colours; c > 0; c--)
+    cs[c] = cs[c - 1];
+  cs[0] = 0;
+
+  freemem(forbidden);
+  freemem(colour);
+  freemem(velem);
+  freemem(vstart);
+
+  *cstart = cs;
+  *celem = ce;
+
+  return colours;
+}
+
+void
+permute_tri2d(ptri2d t2, const uint *xp, const uint *ep, const uint *tp)
+{
+  real(*x)[2];
+  uint(*e)[2];
+  uint(*t)[3];
+  uint     *xb, *eb;
+  uint      i, j, n;
+
+  x = (real(*)[2]) allocmem(sizeof(real[2]) * t2->vertices);
+  xb = (uint *) allocmem(sizeof(uint) * t2->vertices);
+  for (i = 0; i < t2->vertices; i++) {
+    n = (xp ? xp[i] : i);
+    x[n][0] = t2->x[i][0];
+    x[n][1] = t2->x[i][1];
+    xb[n] = t2->xb[i];
+  }
+
+  e = (uint(*)[2]) allocmem(sizeof(uint[2]) * t2->edges);
+  eb = (uint *) allocmem(sizeof(uint) * t2->edges);
+  for (i = 0; i < t2->edges; i++) {
+    n = (ep ? ep[i] : i);
+    for (j = 0; j < 2; j++)
+      e[n][j] = (xp ? xp[t2->e[i][j]] : t2->e[i][j]);
+    eb[n] = t2->eb[i];
+  }
+
+  t = (uint(*)[3]) allocmem(sizeof(uint[3]) * t2->triangles);
+  for (i = 0; i < t2->triangles; i++) {
+    n = (tp ? tp[i] : i);
+    for (j = 0; j < 3; j++)
+      t[n][j] = (ep ? ep[t2->t[i][j]] : t2->t[i][j]);
+  }
+
+  freemem(t2->eb);
+  freemem(t2->xb);
+  freemem(t2->t);
+  freemem(t2->e);
+  freemem(t2->x);
+
+  t2->x = x;
+  t2->e = e;
+  t2->t = t;
+  t2->xb = xb;
+  t2->eb = eb;
+}
+
+void
+reorder_tri2d(ptri2d t2, reordermode mode, uint *vperm)
+{
+  uint     *xp, *ep, *tp, *key;
+  uint      i, j;
+
+  xp = (vperm ? vperm : allocuint(t2->vertices));
+  if (mode == H2_REORDER_MORTON)
+    morton_reorder(t2->vertices, 2, (const real *) t2->x, xp);
+  else
+    rcm_reorder(t2->vertices, t2->edges, (const uint *) t2->e, xp);
+
+  /* Edges are sorted by their smallest new vertex index, triangles
+   * by their smallest new edge index */
+  key = allocuint(UINT_MAX(t2->edges, t2->triangles));
+
+  ep = allocuint(t2->edges);
+  for (i = 0; i < t2->edges; i++)
+    key[i] = UINT_MIN(xp[t2->e[i][0]], xp[t2->e[i][1]]);
+  key_reorder(t2->edges, t2->vertices, key, ep);
+
+  tp = allocuint(t2->triangles);
+  for (i = 0; i < t2->triangles; i++) {
+    key[i] = ep[t2->t[i][0]];
+    for (j = 1; j < 3; j++)
+      key[i] = UINT_MIN(key[i], ep[t2->t[i][j]]);
+  }
+  key_reorder(t2->triangles, t2->edges, key, tp);
+
+  permute_tri2d(t2, xp, ep, tp);
+
+  freemem(tp);
+  freemem(ep);
+  freemem(key);
+  if (vperm == NULL)
+    freemem(xp);
+}
+
 void
 write_tri2d(pctri2d t2, const char *name)
 {
@@ -39,6 +39,7 @@ typedef struct _tri2dbuilder tri2dbuilder;
 typedef tri2dbuilder *ptri2dbuilder;
 
 #include "settings.h"
+#include "reorder.h"
 
 /* ------------------------------------------------------------
    Triangular mesh,
@@ -168,6 +169,52 @@ read_tri2d(const char *name);
 HEADER_PREFIX void
 getvertices_tri2d(pctri2d t2, uint tn, uint v[]);
 
+/** @brief Colour the triangles of a mesh.
+ *
+ *  Triangles are coloured such that no two triangles of the same
+ *  colour share a vertex, and therefore also no edge or degree of
+ *  freedom of a finite element space.
+ *  Element matrices of all triangles of one colour can be added to a
+ *  shared sparse matrix in parallel without synchronization.
+ *
+ *  @param t2 Mesh.
+ *  @param cstart Will be overwritten by an array of <tt>colours+1</tt>
+ *    entries, triangles of colour <tt>c</tt> are found in
+ *    <tt>celem[cstart[c]]</tt> to <tt>celem[cstart[c+1]-1]</tt>.
+ *  @param celem Will be overwritten by an array containing the
+ *    triangles sorted by colour.
+ *  @returns Number of colours <tt>colours</tt>. */
+HEADER_PREFIX uint
+colour_tri2d(pctri2d t2, uint **cstart, uint **celem);
+
+/** @brief Renumber the vertices, edges and triangles of a mesh.
+ *
+ *  All connectivity arrays and boundary flags are permuted
+ *  consistently. Refinement relations, discretizations and matrices
+ *  constructed for the mesh before become invalid.
+ *
+ *  @param t2 Mesh, will be renumbered.
+ *  @param xp New indices of the vertices, <tt>NULL</tt> keeps them.
+ *  @param ep New indices of the edges, <tt>NULL</tt> keeps them.
+ *  @param tp New indices of the triangles, <tt>NULL</tt> keeps them. */
+HEADER_PREFIX void
+permute_tri2d(ptri2d t2, const uint *xp, const uint *ep, const uint *tp);
+
+/** @brief Renumber a mesh to improve the locality of its entities.
+ *
+ *  The vertices are ordered by @ref rcm_reorder or
+ *  @ref morton_reorder, edges and triangles are sorted by their
+ *  smallest vertex or edge, respectively.
+ *  Should be called before refining the mesh and setting up
+ *  discretizations, so that all derived structures inherit the order.
+ *
+ *  @param t2 Mesh, will be renumbered.
+ *  @param mode Ordering strategy for the vertices.
+ *  @param vperm Array of <tt>t2->vertices</tt> entries, will be
+ *    overwritten by the new indices of the vertices, or <tt>NULL</tt>. */
+HEADER_PREFIX void
+reorder_tri2d(ptri2d t2, reordermode mode, uint *vperm);
+
 /* ------------------------------------------------------------
    Check structure for inconsistencies
    ------------------------------------------------------------ */
@@ -38,52 +38,86 @@ new_tri2dp1(pctri2d t2)
   dc->ndof = ndof;
   dc->nfix = nfix;
 
+  dc->slotgen = 0;
+  dc->slot = NULL;
+  dc->fslotgen = 0;
+  dc->fslot = NULL;
+
+  dc->colours = colour_tri2d(t2, &dc->cstart, &dc->celem);
+
   return dc;
 }
 
 void
 del_tri2dp1(ptri2dp1 dc)
 {
+  setslots_tri2dp1(dc, NULL, NULL);
+
+  freemem(dc->celem);
+  freemem(dc->cstart);
+
   freemem(dc->is_dof);
   freemem(dc->idx2dof);
   freemem(dc);
 }
 
-psparsematrix
-build_tri2dp1_sparsematrix(pctri2dp1 dc)
+/* Get the vertices of a triangle in the order used by the assembly
+ * routines */
+static void
+element_vertices(pctri2d t2, uint d, uint xt[3])
+{
+  const     uint(*e)[2] = (const uint(*)[2]) t2->e;
+  const     uint(*t)[3] = (const uint(*)[3]) t2->t;
+
+  xt[0] = e[t[d][0]][0];
+  xt[1] = e[t[d][0]][1];
+  if (e[t[d][1]][0] == e[t[d][0]][0] || e[t[d][1]][0] == e[t[d][0]][1])
+    xt[2] = e[t[d][1]][1];
+  else
+    xt[2] = e[t[d][1]][0];
+
+  assert(xt[0] != xt[1] && xt[0] != xt[2] && xt[1] != xt[2]);
+}
+
+/* Collect the degrees of freedom of all triangles in dof, fixed vertices
+ * are marked by ndof. If fix is not null, the indices of fixed vertices
+ * are collected there and degrees of freedom are marked by nfix. */
+static void
+element_dofs(pctri2dp1 dc, uint *dof, uint *fix)
 {
   pctri2d   t2 = dc->t2;
   const bool *is_dof = dc->is_dof;
   const uint *idx2dof = dc->idx2dof;
   uint      ndof = dc->ndof;
-  uint      triangles = dc->t2->triangles;
-  psparsepattern sp;
-  psparsematrix A;
-  uint      i, j, ii, jj, d, xt[3];
-
-  sp = new_sparsepattern(ndof, ndof);
+  uint      nfix = dc->nfix;
+  uint      i, d, xt[3];
 
-  for (d = 0; d < triangles; d++) {
-    /* Get vertices */
-    getvertices_tri2d(t2, d, xt);
-    /* Build sparsepattern */
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,xt)
+#endif
+  for (d = 0; d < t2->triangles; d++) {
+    element_vertices(t2, d, xt);
     for (i = 0; i < 3; i++) {
-      if (is_dof[xt[i]]) {
-	ii = idx2dof[xt[i]];
-	for (j = 0; j < 3; j++) {
-	  if (is_dof[xt[j]]) {
-	    jj = idx2dof[xt[j]];
-	    addnz_sparsepattern(sp, ii, jj);
-	  }
-	}
-      }
+      dof[3 * d + i] = (is_dof[xt[i]] ? idx2dof[xt[i]] : ndof);
+      if (fix)
+	fix[3 * d + i] = (is_dof[xt[i]] ? nfix : idx2dof[xt[i]]);
     }
   }
+}
+
+psparsematrix
+build_tri2dp1_sparsematrix(pctri2dp1 dc)
+{
+  uint      elements = dc->t2->triangles;
+  psparsematrix A;
+  uint     *dof;
+
+  dof = allocuint((size_t) 3 * elements);
+  element_dofs(dc, dof, NULL);
 
-  /* Build sparsematrix from sparsepattern */
-  A = new_zero_sparsematrix(sp);
+  A = new_elements_sparsematrix(dc->ndof, dc->ndof, elements, 3, dof, 3, dof);
 
-  del_sparsepattern(sp);
+  freemem(dof);
 
   return A;
 }
@@ -91,44 +125,73 @@ build_tri2dp1_sparsematrix(pctri2dp1 dc)
 psparsematrix
 build_tri2dp1_interaction_sparsematrix(pctri2dp1 dc)
 {
-  pctri2d   t2 = dc->t2;
-  const bool *is_dof = dc->is_dof;
-  const uint *idx2dof = dc->idx2dof;
-  uint      ndof = dc->ndof;
-  uint      nfix = dc->nfix;
-  psparsepattern sp;
+  uint      elements = dc->t2->triangles;
   psparsematrix Af;
-  uint      i, j, ii, jj, t, xt[3];
+  uint     *rdof, *cdof;
 
-  sp = new_sparsepattern(ndof, nfix);
+  /* Rows correspond to free, columns to fixed vertices */
+  rdof = allocuint((size_t) 3 * elements);
+  cdof = allocuint((size_t) 3 * elements);
+  element_dofs(dc, rdof, cdof);
 
-  for (t = 0; t < t2->triangles; t++) {
-    /* Get vertices */
-    getvertices_tri2d(t2, t, xt);
-    /* Build sparsepattern */
-    for (i = 0; i < 3; i++) {
-      if (is_dof[xt[i]]) {
-	ii = idx2dof[xt[i]];
-	assert(ii < ndof);
+  Af = new_elements_sparsematrix(dc->ndof, dc->nfix, elements, 3, rdof, 3,
+				 cdof);
 
-	for (j = 0; j < 3; j++) {
-	  if (!is_dof[xt[j]]) {
-	    jj = idx2dof[xt[j]];
-	    assert(jj < nfix);
+  freemem(cdof);
+  freemem(rdof);
 
-	    addnz_sparsepattern(sp, ii, jj);
-	  }
-	}
-      }
-    }
+  return Af;
+}
+
+void
+setslots_tri2dp1(ptri2dp1 dc, pcsparsematrix A, pcsparsematrix Af)
+{
+  uint      elements = dc->t2->triangles;
+  uint     *rdof, *cdof;
+
+  if (dc->slot)
+    freemem(dc->slot);
+  if (dc->fslot)
+    freemem(dc->fslot);
+  dc->slotgen = 0;
+  dc->slot = NULL;
+  dc->fslotgen = 0;
+  dc->fslot = NULL;
+
+  if (A == NULL && Af == NULL)
+    return;
+
+  rdof = allocuint((size_t) 3 * elements);
+  cdof = allocuint((size_t) 3 * elements);
+  element_dofs(dc, rdof, cdof);
+
+  if (A) {
+    assert(A->rows == dc->ndof && A->cols == dc->ndof);
+    dc->slot = new_elements_slots_sparsematrix(A, elements, 3, rdof, 3, rdof);
+    dc->slotgen = A->gen;
+  }
+
+  if (Af) {
+    assert(Af->rows == dc->ndof && Af->cols == dc->nfix);
+    dc->fslot = new_elements_slots_sparsematrix(Af, elements, 3, rdof, 3,
+						cdof);
+    dc->fslotgen = Af->gen;
   }
 
-  /* Build sparsematrix from sparsepattern */
-  Af = new_zero_sparsematrix(sp);
+  freemem(cdof);
+  freemem(rdof);
+}
 
-  del_sparsepattern(sp);
+/* Add an element matrix using precomputed positions */
+static void
+addslots(psparsematrix A, const uint *slot, const real At[3][3])
+{
+  uint      i, j;
 
-  return Af;
+  for (i = 0; i < 3; i++)
+    for (j = 0; j < 3; j++)
+      if (slot[3 * i + j] < A->nz)
+	A->coeff[slot[3 * i + j]] += At[i][j];
 }
 
 psparsematrix
@@ -143,47 +206,52 @@ build_tri2dp1_prolongation_sparsematrix(pctri2dp1 dfine, pctri2dp1 dcoarse,
   const uint *coarse_idx2dof = dcoarse->idx2dof;
   uint      nfine = dfine->ndof;
   uint      ncoarse = dcoarse->ndof;
-  psparsepattern sp;
   psparsematrix P;
+  uint     *rdof, *cdof;
   uint      i, j, k, ii, jj;
 
-  sp = new_sparsepattern(nfine, ncoarse);
+  /* Every fine vertex is an element coupling its degree of freedom with
+     at most two coarse ones, fixed vertices are marked by nfine or
+     ncoarse, respectively */
+  rdof = allocuint(gr->vertices);
+  cdof = allocuint((size_t) 2 * gr->vertices);
 
-  for (i = 0; i < gr->vertices; i++)
+  for (i = 0; i < gr->vertices; i++) {
+    rdof[i] = nfine;
+    cdof[2 * i] = ncoarse;
+    cdof[2 * i + 1] = ncoarse;
     if (fine_dof[i]) {
-      ii = fine_idx2dof[i];
+      rdof[i] = fine_idx2dof[i];
       switch (rf->xt[i]) {
       case 0:
 	j = rf->xf[i];
-	if (coarse_dof[j]) {
-	  jj = coarse_idx2dof[j];
-	  addnz_sparsepattern(sp, ii, jj);
-	}
+	if (coarse_dof[j])
+	  cdof[2 * i] = coarse_idx2dof[j];
 	break;
       case 1:
 	k = rf->xf[i];
 	j = e[k][0];
-	if (coarse_dof[j]) {
-	  jj = coarse_idx2dof[j];
-	  addnz_sparsepattern(sp, ii, jj);
-	}
+	if (coarse_dof[j])
+	  cdof[2 * i] = coarse_idx2dof[j];
 	j = e[k][1];
-	if (coarse_dof[j]) {
-	  jj = coarse_idx2dof[j];
-	  addnz_sparsepattern(sp, ii, jj);
-	}
+	if (coarse_dof[j])
+	  cdof[2 * i + 1] = coarse_idx2dof[j];
 	break;
       default:
 	(void) fprintf(stderr,
 		       "Unknown father type %u of vertex %u\n", rf->xf[i], i);
-	del_sparsepattern(sp);
+	freemem(cdof);
+	freemem(rdof);
 	return 0;
       }
     }
+  }
 
-  P = new_zero_sparsematrix(sp);
+  P = new_elements_sparsematrix(nfine, ncoarse, gr->vertices, 1, rdof, 2,
+				cdof);
 
-  del_sparsepattern(sp);
+  freemem(cdof);
+  freemem(rdof);
 
   for (i = 0; i < gr->vertices; i++)
     if (fine_dof[i]) {
@@ -225,79 +293,80 @@ assemble_tri2dp1_laplace_sparsematrix(pctri2dp1 dc, psparsematrix A,
 				      psparsematrix Af)
 {
   const     real(*x)[2] = (const real(*)[2]) dc->t2->x;
-  const     uint(*e)[2] = (const uint(*)[2]) dc->t2->e;
-  const     uint(*t)[3] = (const uint(*)[3]) dc->t2->t;
   const bool *is_dof = dc->is_dof;
   const uint *idx2dof = dc->idx2dof;
-  uint      triangles = dc->t2->triangles;
   uint      ndof = dc->ndof;
   uint      nfix = dc->nfix;
-  uint      i, j, ii, jj, d;
+  uint      c, n, i, j, ii, jj, d;
   real      det;
   real      gr[3][2];
   real      At[3][3];
   uint      xt[3];
 
-  for (d = 0; d < triangles; d++) {
-    /* Get vertices */
-    xt[0] = e[t[d][0]][0];
-    xt[1] = e[t[d][0]][1];
-    if (e[t[d][1]][0] == e[t[d][0]][0] || e[t[d][1]][0] == e[t[d][0]][1])
-      xt[2] = e[t[d][1]][1];
-    else
-      xt[2] = e[t[d][1]][0];
-
-    assert(xt[0] != xt[1] && xt[0] != xt[2] && xt[1] != xt[2]);
-
-    det = (x[xt[0]][0] - x[xt[1]][0]) * (x[xt[2]][1] - x[xt[1]][1])
-      - (x[xt[0]][1] - x[xt[1]][1]) * (x[xt[2]][0] - x[xt[1]][0]);
-
-    gr[0][0] = (x[xt[2]][1] - x[xt[1]][1]);
-    gr[0][1] = (x[xt[1]][0] - x[xt[2]][0]);
-
-    gr[1][0] = (x[xt[0]][1] - x[xt[2]][1]);
-    gr[1][1] = (x[xt[2]][0] - x[xt[0]][0]);
-
-    gr[2][0] = (x[xt[1]][1] - x[xt[0]][1]);
-    gr[2][1] = (x[xt[0]][0] - x[xt[1]][0]);
-
-    /* Compute element matrix */
-    for (i = 0; i < 3; i++)
-      for (j = 0; j < 3; j++)
-	At[i][j] =
-	  (gr[i][0] * gr[j][0] + gr[i][1] * gr[j][1]) / fabs(det) / 2.0;
-
-    /* Add to system matrix */
-    for (i = 0; i < 3; i++) {
-      if (is_dof[xt[i]]) {
-	ii = idx2dof[xt[i]];
-	for (j = 0; j < 3; j++) {
-	  if (is_dof[xt[j]]) {
-	    jj = idx2dof[xt[j]];
-	    addentry_sparsematrix(A, ii, jj, At[i][j]);
+  for (c = 0; c < dc->colours; c++) {
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,j,ii,jj,d,det,gr,At,xt)
+#endif
+    for (n = dc->cstart[c]; n < dc->cstart[c + 1]; n++) {
+      d = dc->celem[n];
+      /* Get vertices */
+      element_vertices(dc->t2, d, xt);
+
+      det = (x[xt[0]][0] - x[xt[1]][0]) * (x[xt[2]][1] - x[xt[1]][1])
+	- (x[xt[0]][1] - x[xt[1]][1]) * (x[xt[2]][0] - x[xt[1]][0]);
+
+      gr[0][0] = (x[xt[2]][1] - x[xt[1]][1]);
+      gr[0][1] = (x[xt[1]][0] - x[xt[2]][0]);
+
+      gr[1][0] = (x[xt[0]][1] - x[xt[2]][1]);
+      gr[1][1] = (x[xt[2]][0] - x[xt[0]][0]);
+
+      gr[2][0] = (x[xt[1]][1] - x[xt[0]][1]);
+      gr[2][1] = (x[xt[0]][0] - x[xt[1]][0]);
+
+      /* Compute element matrix */
+      for (i = 0; i < 3; i++)
+	for (j = 0; j < 3; j++)
+	  At[i][j] =
+	    (gr[i][0] * gr[j][0] + gr[i][1] * gr[j][1]) / fabs(det) / 2.0;
+
+      /* Add to system matrix */
+      if (A && A->gen == dc->slotgen)
+	addslots(A, dc->slot + (size_t) 9 * d, At);
+      else
+	for (i = 0; i < 3; i++) {
+	  if (is_dof[xt[i]]) {
+	    ii = idx2dof[xt[i]];
+	    for (j = 0; j < 3; j++) {
+	      if (is_dof[xt[j]]) {
+		jj = idx2dof[xt[j]];
+		addentry_sparsematrix(A, ii, jj, At[i][j]);
+	      }
+	    }
 	  }
 	}
-      }
-    }
-
-    /* Add to interaction matrix */
-    if (Af) {
-      for (i = 0; i < 3; i++) {
-	if (is_dof[xt[i]]) {
-	  ii = idx2dof[xt[i]];
-	  assert(ii < ndof);
 
-	  for (j = 0; j < 3; j++) {
-	    if (!is_dof[xt[j]]) {
-	      jj = idx2dof[xt[j]];
-	      assert(jj < nfix);
-	      addentry_sparsematrix(Af, ii, jj, At[i][j]);
+      /* Add to interaction matrix */
+      if (Af && Af->gen == dc->fslotgen)
+	addslots(Af, dc->fslot + (size_t) 9 * d, At);
+      else if (Af) {
+	for (i = 0; i < 3; i++) {
+	  if (is_dof[xt[i]]) {
+	    ii = idx2dof[xt[i]];
+	    assert(ii < ndof);
+
+	    for (j = 0; j < 3; j++) {
+	      if (!is_dof[xt[j]]) {
+		jj = idx2dof[xt[j]];
+		assert(jj < nfix);
+		addentry_sparsematrix(Af, ii, jj, At[i][j]);
+	      }
 	    }
 	  }
 	}
       }
-    }
 
+    }
   }
 }
 
@@ -306,74 +375,75 @@ assemble_tri2dp1_mass_sparsematrix(pctri2dp1 dc, psparsematrix M,
 				   psparsematrix Mf)
 {
   const     real(*x)[2] = (const real(*)[2]) dc->t2->x;
-  const     uint(*e)[2] = (const uint(*)[2]) dc->t2->e;
-  const     uint(*t)[3] = (const uint(*)[3]) dc->t2->t;
   const bool *is_dof = dc->is_dof;
   const uint *idx2dof = dc->idx2dof;
-  uint      triangles = dc->t2->triangles;
   uint      ndof = dc->ndof;
   uint      nfix = dc->nfix;
-  uint      i, j, ii, jj, d;
+  uint      c, n, i, j, ii, jj, d;
   real      det;
   real      Mt[3][3];
   uint      xt[3];
 
-  for (d = 0; d < triangles; d++) {
-    /* Get vertices */
-    xt[0] = e[t[d][0]][0];
-    xt[1] = e[t[d][0]][1];
-    if (e[t[d][1]][0] == e[t[d][0]][0] || e[t[d][1]][0] == e[t[d][0]][1])
-      xt[2] = e[t[d][1]][1];
-    else
-      xt[2] = e[t[d][1]][0];
+  for (c = 0; c < dc->colours; c++) {
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,j,ii,jj,d,det,Mt,xt)
+#endif
+    for (n = dc->cstart[c]; n < dc->cstart[c + 1]; n++) {
+      d = dc->celem[n];
+      /* Get vertices */
+      element_vertices(dc->t2, d, xt);
 
-    assert(xt[0] != xt[1] && xt[0] != xt[2] && xt[1] != xt[2]);
-
-    det = (x[xt[1]][0] - x[xt[0]][0]) * (x[xt[2]][1] - x[xt[0]][1])
-      - (x[xt[1]][1] - x[xt[0]][1]) * (x[xt[2]][0] - x[xt[0]][0]);
-
-    /* Compute element matrix */
-    for (i = 0; i < 3; i++) {
-      for (j = 0; j < 3; j++) {
-	if (i == j)
-	  Mt[i][j] = fabs(det) / 12.0;
-	else
-	  Mt[i][j] = fabs(det) / 24.0;
-      }
-    }
+      det = (x[xt[1]][0] - x[xt[0]][0]) * (x[xt[2]][1] - x[xt[0]][1])
+	- (x[xt[1]][1] - x[xt[0]][1]) * (x[xt[2]][0] - x[xt[0]][0]);
 
-    /* Add to system matrix */
-    for (i = 0; i < 3; i++) {
-      if (is_dof[xt[i]]) {
-	ii = idx2dof[xt[i]];
+      /* Compute element matrix */
+      for (i = 0; i < 3; i++) {
 	for (j = 0; j < 3; j++) {
-	  if (is_dof[xt[j]]) {
-	    jj = idx2dof[xt[j]];
-	    addentry_sparsematrix(M, ii, jj, Mt[i][j]);
-	  }
+	  if (i == j)
+	    Mt[i][j] = fabs(det) / 12.0;
+	  else
+	    Mt[i][j] = fabs(det) / 24.0;
 	}
       }
-    }
-
-    /* Add to interaction matrix */
-    if (Mf) {
-      for (i = 0; i < 3; i++) {
-	if (is_dof[xt[i]]) {
-	  ii = idx2dof[xt[i]];
-	  assert(ii < ndof);
 
-	  for (j = 0; j < 3; j++) {
-	    if (!is_dof[xt[j]]) {
-	      jj = idx2dof[xt[j]];
-	      assert(jj < nfix);
+      /* Add to system matrix */
+      if (M && M->gen == dc->slotgen)
+	addslots(M, dc->slot + (size_t) 9 * d, Mt);
+      else
+	for (i = 0; i < 3; i++) {
+	  if (is_dof[xt[i]]) {
+	    ii = idx2dof[xt[i]];
+	    for (j = 0; j < 3; j++) {
+	      if (is_dof[xt[j]]) {
+		jj = idx2dof[xt[j]];
+		addentry_sparsematrix(M, ii, jj, Mt[i][j]);
+	      }
+	    }
+	  }
+	}
 
-	      addentry_sparsematrix(Mf, ii, jj, Mt[i][j]);
+      /* Add to interaction matrix */
+      if (Mf && Mf->gen == dc->fslotgen)
+	addslots(Mf, dc->fslot + (size_t) 9 * d, Mt);
+      else if (Mf) {
+	for (i = 0; i < 3; i++) {
+	  if (is_dof[xt[i]]) {
+	    ii = idx2dof[xt[i]];
+	    assert(ii < ndof);
+
+	    for (j = 0; j < 3; j++) {
+	      if (!is_dof[xt[j]]) {
+		jj = idx2dof[xt[j]];
+		assert(jj < nfix);
+
+		addentry_sparsematrix(Mf, ii, jj, Mt[i][j]);
+	      }
 	    }
 	  }
 	}
       }
-    }
 
+    }
   }
 }
 
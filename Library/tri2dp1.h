@@ -60,6 +60,32 @@ struct _tri2dp1
   /** @brief Consecutive indices for all degrees of freedom and all 
    *fixed vertices.*/
   uint *idx2dof; 
+
+  /** @brief Generation @ref sparsematrix.gen of the matrix for the
+   *  degrees of freedom <tt>slot</tt> refers to, zero if none,
+   *  see @ref setslots_tri2dp1.*/
+  size_t slotgen;
+
+  /** @brief Positions of the element matrices in the matrix with
+   *  generation <tt>slotgen</tt>, nine per triangle, or <tt>NULL</tt>.*/
+  uint *slot;
+
+  /** @brief Generation of the interaction matrix <tt>fslot</tt>
+   *  refers to, zero if none.*/
+  size_t fslotgen;
+
+  /** @brief Positions of the element matrices in the matrix with
+   *  generation <tt>fslotgen</tt>, nine per triangle, or <tt>NULL</tt>.*/
+  uint *fslot;
+  /** @brief Number of colours of the triangles, see @ref colour_tri2d. */
+  uint colours;
+
+  /** @brief Start of each colour in <tt>celem</tt>. */
+  uint *cstart;
+
+  /** @brief Triangles sorted by colour, used to assemble
+   *  matrices in parallel. */
+  uint *celem;
 };
 
 /** @brief Create a @ref tri2dp1 object using a @ref tri2d mesh.
@@ -129,6 +155,28 @@ HEADER_PREFIX psparsematrix
 build_tri2dp1_prolongation_sparsematrix(pctri2dp1 dfine, pctri2dp1 dcoarse,
                                pctri2dref rf);
    
+/** @brief Prepare repeated assembly into fixed matrices.
+ *
+ *  Finds the positions of all element matrix entries in the patterns
+ *  of <tt>A</tt> and <tt>Af</tt> and stores them in <tt>dc</tt>.
+ *  If one of these matrices is passed to
+ *  @ref assemble_tri2dp1_laplace_sparsematrix or
+ *  @ref assemble_tri2dp1_mass_sparsematrix later on, the element
+ *  matrices are added without searching the rows.
+ *  Matrices are recognized by their generation @ref sparsematrix.gen,
+ *  so a new matrix at the address of a deleted one or a matrix
+ *  reordered by @ref sort_sparsematrix falls back to searching.
+ *
+ *  Calling the function with two null pointers releases the positions.
+ *
+ *  @param dc @ref tri2dp1 object describing the space.
+ *  @param A Matrix created by @ref build_tri2dp1_sparsematrix or
+ *    <tt>NULL</tt>.
+ *  @param Af Matrix created by
+ *    @ref build_tri2dp1_interaction_sparsematrix or <tt>NULL</tt>. */
+HEADER_PREFIX void
+setslots_tri2dp1(ptri2dp1 dc, pcsparsematrix A, pcsparsematrix Af);
+
 /** @brief Assemble stiffness matrix.
  *
  *  Element matrices for all triangles are computed and added
@@ -40,6 +40,8 @@ new_tri2drt0(pctri2d t2)
   dc->ndof = ndof;
   dc->nfix = nfix;
 
+  dc->colours = colour_tri2d(t2, &dc->cstart, &dc->celem);
+
   return dc;  
 }
 
@@ -71,6 +73,8 @@ void update_tri2drt0(ptri2drt0 rt0){
 void
 del_tri2drt0(ptri2drt0 dc)
 {
+  freemem(dc->celem);
+  freemem(dc->cstart);
   freemem(dc->is_dof);
   freemem(dc->idx2dof);
   freemem(dc);
@@ -85,36 +89,28 @@ build_tri2drt0_A_sparsematrix(pctri2drt0 dc)
   const uint *idx2dof = dc->idx2dof;
   uint ndof = dc->ndof;
   uint triangles  = dc->t2->triangles;
-  psparsepattern sp;
   psparsematrix A;
-  uint i, j, ii, jj, d, et[3];
-  
-  sp = new_sparsepattern(ndof, ndof);
+  uint *dof;
+  uint i, d, e;
+
+  /* Inner and Dirichlet edges of all triangles, Neumann edges are
+     marked by ndof */
+  dof = allocuint((size_t) 3 * triangles);
 
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,e)
+#endif
   for(d=0; d<triangles; d++){
-    /* Get edges */
-    et[0] = t2->t[d][0];
-    et[1] = t2->t[d][1];
-    et[2] = t2->t[d][2];
-    /* Build sparsepattern */
     for(i=0; i<3; i++){
-      if((is_dof[et[i]] == 0) || (is_dof[et[i]]==1)){ /*inner edge or Dirichlet edge*/
-	ii = idx2dof[et[i]];
-	for(j=0; j<3; j++){
-	  if((is_dof[et[j]] == 0) || (is_dof[et[j]] == 1)){ /*inner or Dirichlet*/
-	    jj = idx2dof[et[j]];
-	    addnz_sparsepattern(sp,ii,jj);
-	  }
-	}
-      }
+      e = t2->t[d][i];
+      dof[3*d+i] = (is_dof[e] == 0 || is_dof[e] == 1 ? idx2dof[e] : ndof);
     }
   }
-  
-  /* Build sparsematrix from sparsepattern */
-  A = new_zero_sparsematrix(sp);
-  
-  del_sparsepattern(sp);
-  
+
+  A = new_elements_sparsematrix(ndof, ndof, triangles, 3, dof, 3, dof);
+
+  freemem(dof);
+
   return A;
 }
 
@@ -126,39 +122,31 @@ build_tri2drt0_A_interaction_sparsematrix(pctri2drt0 dc)
   const uint *idx2dof = dc->idx2dof;
   uint      ndof = dc->ndof;
   uint      nfix = dc->nfix;
-  psparsepattern sp;
+  uint      triangles = t2->triangles;
   psparsematrix Af;
-  uint      i, j, ii, jj, t, et[3];
+  uint     *rdof, *cdof;
+  uint      i, t, e;
 
-  sp = new_sparsepattern(ndof, nfix);
+  /* Rows correspond to inner or Dirichlet, columns to Neumann edges */
+  rdof = allocuint((size_t) 3 * triangles);
+  cdof = allocuint((size_t) 3 * triangles);
 
-  for (t = 0; t < t2->triangles; t++) {
-    /* Get edges */
-    et[0] = t2->t[t][0];
-    et[1] = t2->t[t][1];
-    et[2] = t2->t[t][2];
-    /* Build sparsepattern */
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,e)
+#endif
+  for (t = 0; t < triangles; t++) {
     for (i = 0; i < 3; i++) {
-      if ((is_dof[et[i]] == 0) || (is_dof[et[i]] == 1)) { /*inner or Dirichlet*/
-	ii = idx2dof[et[i]];
-	assert(ii < ndof);
-
-	for (j = 0; j < 3; j++) {
-	  if (is_dof[et[j]] == 2) { /*Neumann*/
-	    jj = idx2dof[et[j]];
-	    assert(jj < nfix);
-
-	    addnz_sparsepattern(sp, ii, jj);
-	  }
-	}
-      }
+      e = t2->t[t][i];
+      rdof[3 * t + i] = (is_dof[e] == 0
+			 || is_dof[e] == 1 ? idx2dof[e] : ndof);
+      cdof[3 * t + i] = (is_dof[e] == 2 ? idx2dof[e] : nfix);
     }
   }
 
-  /* Build sparsematrix from sparsepattern */
-  Af = new_zero_sparsematrix(sp);
+  Af = new_elements_sparsematrix(ndof, nfix, triangles, 3, rdof, 3, cdof);
 
-  del_sparsepattern(sp);
+  freemem(cdof);
+  freemem(rdof);
 
   return Af;
 }
@@ -171,32 +159,30 @@ build_tri2drt0_B_sparsematrix(pctri2drt0 dc)
   const uint *idx2dof = dc->idx2dof;
   uint ndof = dc->ndof;
   uint triangles  = dc->t2->triangles;
-  psparsepattern sp;
   psparsematrix A;
-  uint i, ii, d, et[3], nt;
-  
-  nt = dc->t2->triangles;
-  sp = new_sparsepattern(nt, ndof);
+  uint *rdof, *cdof;
+  uint i, d, e;
+
+  /* Every triangle couples with its inner and Dirichlet edges */
+  rdof = allocuint(triangles);
+  cdof = allocuint((size_t) 3 * triangles);
 
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,e)
+#endif
   for(d=0; d<triangles; d++){
-    /* Get edges */
-    et[0] = t2->t[d][0];
-    et[1] = t2->t[d][1];
-    et[2] = t2->t[d][2];
-    /* Build sparsepattern */
+    rdof[d] = d;
     for(i=0; i<3; i++){
-      if((is_dof[et[i]] == 0) || (is_dof[et[i]] == 1)){ /*Dirichlet or inner*/
-	ii = idx2dof[et[i]];
-	addnz_sparsepattern(sp,d,ii);
-      }
+      e = t2->t[d][i];
+      cdof[3*d+i] = (is_dof[e] == 0 || is_dof[e] == 1 ? idx2dof[e] : ndof);
     }
   }
-  
-  /* Build sparsematrix from sparsepattern */
-  A = new_zero_sparsematrix(sp);
-  
-  del_sparsepattern(sp);
-  
+
+  A = new_elements_sparsematrix(triangles, ndof, triangles, 1, rdof, 3, cdof);
+
+  freemem(cdof);
+  freemem(rdof);
+
   return A;
 }
 
@@ -206,35 +192,32 @@ build_tri2drt0_B_interaction_sparsematrix(pctri2drt0 dc)
   pctri2d t2 = dc->t2;
   const uint *is_dof = dc->is_dof;
   const uint *idx2dof = dc->idx2dof;
- // uint ndof = dc->ndof;
   uint nfix = dc->nfix;
   uint triangles  = dc->t2->triangles;
-  psparsepattern sp;
   psparsematrix A;
-  uint i, ii, d, et[3], nt;
-  
-  nt = dc->t2->triangles;
-  sp = new_sparsepattern(nt, nfix);
+  uint *rdof, *cdof;
+  uint i, d, e;
 
+  /* Every triangle couples with its Neumann edges */
+  rdof = allocuint(triangles);
+  cdof = allocuint((size_t) 3 * triangles);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,e)
+#endif
   for(d=0; d<triangles; d++){
-    /* Get edges */
-    et[0] = t2->t[d][0];
-    et[1] = t2->t[d][1];
-    et[2] = t2->t[d][2];
-    /* Build sparsepattern */
+    rdof[d] = d;
     for(i=0; i<3; i++){
-      if(is_dof[et[i]]==2){
-	ii = idx2dof[et[i]];
-	addnz_sparsepattern(sp,d,ii);
-      }
+      e = t2->t[d][i];
+      cdof[3*d+i] = (is_dof[e] == 2 ? idx2dof[e] : nfix);
     }
   }
-  
-  /* Build sparsematrix from sparsepattern */
-  A = new_zero_sparsematrix(sp);
-  
-  del_sparsepattern(sp);
-  
+
+  A = new_elements_sparsematrix(triangles, nfix, triangles, 1, rdof, 3, cdof);
+
+  freemem(cdof);
+  freemem(rdof);
+
   return A;
 }
 #if  0
@@ -329,11 +312,10 @@ assemble_tri2drt0_darcy_A_sparsematrix(pctri2drt0 dc, psparsematrix A, psparsema
   const uint (*t)[3] = (const uint (*)[3]) dc->t2->t;
   const uint *is_dof = dc->is_dof;
   const uint *idx2dof = dc->idx2dof;
-  uint triangles  = dc->t2->triangles;
   
   uint ndof = dc->ndof;
   uint nfix = dc->nfix;
-  uint i, j, ii, jj, d, k;
+  uint c, n, i, j, ii, jj, d, k;
   real At[3][3];
   uint et[3],v[3];
   real T, signum_i, signum_j;
@@ -341,97 +323,84 @@ assemble_tri2drt0_darcy_A_sparsematrix(pctri2drt0 dc, psparsematrix A, psparsema
 
   //triangles = 1;
   
-  for(d=0; d<triangles; d++){
-     /*Get edges of triangle d*/
-    et[0] = t[d][0];
-    et[1] = t[d][1];
-    et[2] = t[d][2];
-    /*Get vertices of triangle d*/
-    getvertices_tri2d(dc->t2, d, v); //printf("vertices %u %u %u \n", v[0], v[1], v[2]);
-    /*get area of T*/
-    T = (1.0/2)* fabs( ((x[v[2]][0]-x[v[0]][0])*(x[v[1]][1]-x[v[0]][1]))
-		      -((x[v[2]][1]-x[v[0]][1])*(x[v[1]][0]-x[v[0]][0])) ); 
-    /*Initialise At with zero*/
-    for(i=0;i<3;i++)
-      for(j=0;j<3;j++)
-	At[i][j] = 0.0;
-    /* Compute element matrix */
-    for(i=0;i<3;i++){
-      for(j=0;j<3;j++){
-	/*non diagonal entry*/
-	if (i!=j){
-	   if((i==0 && j==1) || (i==1 && j==0)) k=2;
-	   else if((i==0 && j==2) || (i==2 && j==0)) k=1;
-           else k=0;
-	   x_ij[0] = x[v[i]][0] - x[v[j]][0]; x_ij[1] = x[v[i]][1] - x[v[j]][1]; 
-	   x_jk[0] = x[v[j]][0] - x[v[k]][0]; x_jk[1] = x[v[j]][1] - x[v[k]][1]; 
-	   x_ki[0] = x[v[k]][0] - x[v[i]][0]; x_ki[1] = x[v[k]][1] - x[v[i]][1];
-	   At[i][j] = - scalar(x_ij,x_ij) + scalar(x_jk,x_ij) 
-	              - 2 * scalar(x_jk,x_ki) + scalar(x_ij,x_ki);
-           //printf("At[%u][%u] = %f \n", i, j, At[i][j]);
-	   signum_i = compute_type_of_edge_tri2d(dc->t2, d, i);
-	   signum_j = compute_type_of_edge_tri2d(dc->t2, d, j);
-	   At[i][j] = (signum_i * signum_j * At[i][j] * K->v[d]) / (48 * T); /*Faktor k fehlt noch*/
-        }
-	else {/*i=j*/ /*j is the vertex opposite of edge j*/
-	  i = ((j+1)%3);
-	  k = ((j+2)%3);
-	 // printf("i = %u, j = %u, k = %u\n", i, j, k);
-	 // printf("v[i] = %u, v[j] = %u, v[k] = %u\n", v[i], v[j], v[k]);
-	  x_ij[0] = x[v[i]][0] - x[v[j]][0]; x_ij[1] = x[v[i]][1] - x[v[j]][1]; 
-	  x_jk[0] = x[v[j]][0] - x[v[k]][0]; x_jk[1] = x[v[j]][1] - x[v[k]][1]; 
-	  x_ki[0] = x[v[k]][0] - x[v[i]][0]; x_ki[1] = x[v[k]][1] - x[v[i]][1];
-	  At[j][j] = scalar(x_ij, x_ij) + scalar(x_jk,x_jk) - scalar(x_jk,x_ij);
-	  //printf("At[%u][%u] = %f \n", j, j, At[j][j]);
-	  At[j][j] = (At[j][j] *K->v[d])/ (24*T); /*Faktor k fehlt noch*/
-	  i = j;
-        }
-      } 
-    }
-
-   // printf("At = \n");
-   // for(i=0;i<3;i++){
-   //   for(j=0;j<3;j++)
-   //     printf("At[%u][%u] = %f \t",i, j,  At[i][j]);
-   //  printf("\n"); 
-  //  }
-      
-    /* Add to system matrix */
-    for(i=0;i<3;i++){
-      if(is_dof[et[i]] == 0 || is_dof[et[i]] == 1){
-	ii = idx2dof[et[i]];
+  for (c = 0; c < dc->colours; c++) {
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,j,ii,jj,d,k,At,et,v,T,signum_i,signum_j,x_ij,x_jk,x_ki)
+#endif
+    for (n = dc->cstart[c]; n < dc->cstart[c + 1]; n++) {
+      d = dc->celem[n];
+       /*Get edges of triangle d*/
+      et[0] = t[d][0];
+      et[1] = t[d][1];
+      et[2] = t[d][2];
+      /*Get vertices of triangle d*/
+      getvertices_tri2d(dc->t2, d, v);
+      /*get area of T*/
+      T = (1.0/2)* fabs( ((x[v[2]][0]-x[v[0]][0])*(x[v[1]][1]-x[v[0]][1]))
+			-((x[v[2]][1]-x[v[0]][1])*(x[v[1]][0]-x[v[0]][0])) ); 
+      /*Initialise At with zero*/
+      for(i=0;i<3;i++)
+	for(j=0;j<3;j++)
+	  At[i][j] = 0.0;
+      /* Compute element matrix */
+      for(i=0;i<3;i++){
 	for(j=0;j<3;j++){
-	  if(is_dof[et[j]] == 0 || is_dof[et[j]] == 1){
-	  jj = idx2dof[et[j]];
-	// printf("ii = %u jj = %u\n", ii, jj);
-	  addentry_sparsematrix(A, ii, jj, At[i][j]);
-	 // print_sparsematrix(A);
+	  /*non diagonal entry*/
+	  if (i!=j){
+	     if((i==0 && j==1) || (i==1 && j==0)) k=2;
+	     else if((i==0 && j==2) || (i==2 && j==0)) k=1;
+	     else k=0;
+	     x_ij[0] = x[v[i]][0] - x[v[j]][0]; x_ij[1] = x[v[i]][1] - x[v[j]][1]; 
+	     x_jk[0] = x[v[j]][0] - x[v[k]][0]; x_jk[1] = x[v[j]][1] - x[v[k]][1]; 
+	     x_ki[0] = x[v[k]][0] - x[v[i]][0]; x_ki[1] = x[v[k]][1] - x[v[i]][1];
+	     At[i][j] = - scalar(x_ij,x_ij) + scalar(x_jk,x_ij) 
+			- 2 * scalar(x_jk,x_ki) + scalar(x_ij,x_ki);
+	     signum_i = compute_type_of_edge_tri2d(dc->t2, d, i);
+	     signum_j = compute_type_of_edge_tri2d(dc->t2, d, j);
+	     At[i][j] = (signum_i * signum_j * At[i][j] * K->v[d]) / (48 * T); /*Faktor k fehlt noch*/
 	  }
-        }
+	  else {/*i=j*/ /*j is the vertex opposite of edge j*/
+	    i = ((j+1)%3);
+	    k = ((j+2)%3);
+	    x_ij[0] = x[v[i]][0] - x[v[j]][0]; x_ij[1] = x[v[i]][1] - x[v[j]][1]; 
+	    x_jk[0] = x[v[j]][0] - x[v[k]][0]; x_jk[1] = x[v[j]][1] - x[v[k]][1]; 
+	    x_ki[0] = x[v[k]][0] - x[v[i]][0]; x_ki[1] = x[v[k]][1] - x[v[i]][1];
+	    At[j][j] = scalar(x_ij, x_ij) + scalar(x_jk,x_jk) - scalar(x_jk,x_ij);
+	    At[j][j] = (At[j][j] *K->v[d])/ (24*T); /*Faktor k fehlt noch*/
+	    i = j;
+	  }
+	} 
       }
-    }
-    /* Add to interaction matrix */
-    if(Af){
-      for(i=0; i<3; i++){
+
+      /* Add to system matrix */
+      for(i=0;i<3;i++){
 	if(is_dof[et[i]] == 0 || is_dof[et[i]] == 1){
 	  ii = idx2dof[et[i]];
-	  assert(ii < ndof);
-	   for(j=0; j<3; j++){
-            if(is_dof[et[j]] == 2){
-	      jj = idx2dof[et[j]];
-	      assert(jj < nfix);
-	      addentry_sparsematrix(Af, ii, jj, At[i][j]);
+	  for(j=0;j<3;j++){
+	    if(is_dof[et[j]] == 0 || is_dof[et[j]] == 1){
+	    jj = idx2dof[et[j]];
+	    addentry_sparsematrix(A, ii, jj, At[i][j]);
 	    }
 	  }
-        }
+	}
+      }
+      /* Add to interaction matrix */
+      if(Af){
+	for(i=0; i<3; i++){
+	  if(is_dof[et[i]] == 0 || is_dof[et[i]] == 1){
+	    ii = idx2dof[et[i]];
+	    assert(ii < ndof);
+	     for(j=0; j<3; j++){
+	      if(is_dof[et[j]] == 2){
+		jj = idx2dof[et[j]];
+		assert(jj < nfix);
+		addentry_sparsematrix(Af, ii, jj, At[i][j]);
+	      }
+	    }
+	  }
+	}
       }
     }
-    
-    //printf("triangle %u\n", d);
-    //printf("with edges %u %u %u\n", et[0], et[1], et[2]);
-   // print_sparsematrix(A);
-   // print_sparsematrix(Af);	
-
   }
 
 }
@@ -453,6 +422,10 @@ assemble_tri2drt0_darcy_B_sparsematrix(pctri2drt0 dc, psparsematrix A, psparsema
  // real x1[2], x2[2];
   //real a,b, sigma_i;
   
+  /* Every triangle only contributes to its own row */
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i,ii,signum,At,et)
+#endif
   for(d=0; d<triangles; d++){
     /*Get edges of triangle d*/
     et[0] = t[d][0];
@@ -75,6 +75,15 @@ struct _tri2drt0
   /** @brief Consecutive indices for all degrees of freedom and all fixed 
    *edges.*/
   uint *idx2dof;  
+  /** @brief Number of colours of the triangles, see @ref colour_tri2d. */
+  uint colours;
+
+  /** @brief Start of each colour in <tt>celem</tt>. */
+  uint *cstart;
+
+  /** @brief Triangles sorted by colour, used to assemble
+   *  matrices in parallel. */
+  uint *celem;
 };
 
 /* ------------------------------------------------------------
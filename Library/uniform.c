@@ -28,6 +28,9 @@ new_uniform(pclusterbasis rb, pclusterbasis cb)
 
   init_amatrix(&u->S, rb->k, cb->k);
 
+  u->coupling = NULL;
+  u->cdata = NULL;
+
   return u;
 }
 
@@ -151,6 +154,46 @@ getsize_uniform(pcuniform u)
   return sz;
 }
 
+/* ------------------------------------------------------------
+   Implicitly represented coupling matrices
+   ------------------------------------------------------------ */
+
+void
+setimplicit_uniform(puniform u, uniformcoupling_t coupling, void *data)
+{
+  assert(coupling != NULL);
+
+  resize_amatrix(&u->S, 0, 0);
+
+  u->coupling = coupling;
+  u->cdata = data;
+}
+
+void
+setexplicit_uniform(puniform u)
+{
+  if (u->coupling == NULL)
+    return;
+
+  resize_amatrix(&u->S, u->rb->k, u->cb->k);
+  u->coupling(u->rb, u->cb, u->cdata, &u->S);
+
+  u->coupling = NULL;
+  u->cdata = NULL;
+}
+
+pcamatrix
+getcoupling_uniform(pcuniform u, pamatrix tmp)
+{
+  if (u->coupling == NULL)
+    return &u->S;
+
+  resize_amatrix(tmp, u->rb->k, u->cb->k);
+  u->coupling(u->rb, u->cb, u->cdata, tmp);
+
+  return tmp;
+}
+
 /* ------------------------------------------------------------
    Arithmetic operations
    ------------------------------------------------------------ */
@@ -158,24 +201,40 @@ getsize_uniform(pcuniform u)
 void
 clear_uniform(puniform u)
 {
+  if (u->coupling) {
+    resize_amatrix(&u->S, u->rb->k, u->cb->k);
+    u->coupling = NULL;
+    u->cdata = NULL;
+  }
+
   clear_amatrix(&u->S);
 }
 
 void
 copy_uniform(bool trans, pcuniform src, puniform trg)
 {
+  amatrix   tmp;
+  pcamatrix S;
+
+  assert(trg->coupling == NULL);
+
+  init_amatrix(&tmp, 0, 0);
+  S = getcoupling_uniform(src, &tmp);
+
   if (trans) {
     assert(trg->rb == src->cb);
     assert(trg->cb == src->rb);
 
-    copy_amatrix(true, &src->S, &trg->S);
+    copy_amatrix(true, S, &trg->S);
   }
   else {
     assert(trg->rb == src->rb);
     assert(trg->cb == src->cb);
 
-    copy_amatrix(false, &src->S, &trg->S);
+    copy_amatrix(false, S, &trg->S);
   }
+
+  uninit_amatrix(&tmp);
 }
 
 puniform
@@ -192,12 +251,16 @@ clone_uniform(pcuniform src)
 void
 scale_uniform(field alpha, puniform u)
 {
+  setexplicit_uniform(u);
+
   scale_amatrix(alpha, &u->S);
 }
 
 void
 random_uniform(puniform u)
 {
+  setexplicit_uniform(u);
+
   random_amatrix(&u->S);
 }
 
@@ -210,8 +273,13 @@ mvm_uniform_avector(field alpha, bool trans, pcuniform u,
 		    pcavector x, pavector y)
 {
   avector   tmp1, tmp2;
+  amatrix   tmp3;
+  pcamatrix S;
   pavector  xt, yt;
 
+  init_amatrix(&tmp3, 0, 0);
+  S = getcoupling_uniform(u, &tmp3);
+
   if (trans) {
     xt = init_avector(&tmp1, u->rb->kbranch);
     yt = init_avector(&tmp2, u->cb->kbranch);
@@ -220,7 +288,7 @@ mvm_uniform_avector(field alpha, bool trans, pcuniform u,
 
     clear_avector(yt);
 
-    mvm_amatrix_avector(alpha, true, &u->S, xt, yt);
+    mvm_amatrix_avector(alpha, true, S, xt, yt);
 
     expand_clusterbasis_avector(u->cb, yt, y);
 
@@ -235,13 +303,15 @@ mvm_uniform_avector(field alpha, bool trans, pcuniform u,
 
     clear_avector(yt);
 
-    mvm_amatrix_avector(alpha, false, &u->S, xt, yt);
+    mvm_amatrix_avector(alpha, false, S, xt, yt);
 
     expand_clusterbasis_avector(u->rb, yt, y);
 
     uninit_avector(yt);
     uninit_avector(xt);
   }
+
+  uninit_amatrix(&tmp3);
 }
 
 /* ------------------------------------------------------------
@@ -253,17 +323,22 @@ add_projected_uniform(pcuniform u,
 		      pcclusteroperator ro, pcclusteroperator co,
 		      puniform unew)
 {
-  amatrix   tmp;
+  amatrix   tmp, tmp2;
   pamatrix  XS;
+  pcamatrix S;
+
+  assert(unew->coupling == NULL);
+
+  S = getcoupling_uniform(u, init_amatrix(&tmp2, 0, 0));
 
   if (u->rb == unew->rb) {
     if (u->cb == unew->cb)
-      add_amatrix(1.0, false, &u->S, &unew->S);
+      add_amatrix(1.0, false, S, &unew->S);
     else {
       assert(co->krow == unew->cb->k);
       assert(co->kcol == u->cb->k);
 
-      addmul_amatrix(1.0, false, &u->S, true, &co->C, &unew->S);
+      addmul_amatrix(1.0, false, S, true, &co->C, &unew->S);
     }
   }
   else {
@@ -271,7 +346,7 @@ add_projected_uniform(pcuniform u,
       assert(ro->krow == unew->rb->k);
       assert(ro->kcol == u->rb->k);
 
-      addmul_amatrix(1.0, false, &ro->C, false, &u->S, &unew->S);
+      addmul_amatrix(1.0, false, &ro->C, false, S, &unew->S);
     }
     else {
       assert(ro->krow == unew->rb->k);
@@ -281,11 +356,13 @@ add_projected_uniform(pcuniform u,
 
       XS = init_amatrix(&tmp, unew->rb->k, u->cb->k);
       clear_amatrix(XS);
-      addmul_amatrix(1.0, false, &ro->C, false, &u->S, XS);
+      addmul_amatrix(1.0, false, &ro->C, false, S, XS);
       addmul_amatrix(1.0, false, XS, true, &co->C, &unew->S);
       uninit_amatrix(XS);
     }
   }
+
+  uninit_amatrix(&tmp2);
 }
 
 void
@@ -296,6 +373,8 @@ project_inplace_uniform(puniform u,
   amatrix   tmp;
   pamatrix  X;
 
+  setexplicit_uniform(u);
+
   if (u->rb == rb) {
     if (u->cb == cb) {
       /* Nothing to do */
@@ -370,6 +449,7 @@ add_rkmatrix_uniform(pcrkmatrix r, puniform unew)
   uint      k;
 
   assert(r->A.cols == r->B.cols);
+  assert(unew->coupling == NULL);
 
   k = r->A.cols;
 
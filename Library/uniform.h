@@ -49,6 +49,17 @@ typedef const uniform *pcuniform;
 /* PARTICLES */
 /* BEM */
 
+/** @brief Callback computing the coupling matrix of an implicitly
+ *  represented @ref _uniform "uniform" block.
+ *
+ *  @param rb Row @ref _clusterbasis "clusterbasis".
+ *  @param cb Column @ref _clusterbasis "clusterbasis".
+ *  @param data Additional data, e.g., the BEM object.
+ *  @param S Target matrix of size <tt>rb->k</tt> @f$\times@f$
+ *         <tt>cb->k</tt>, will be overwritten by the coupling matrix. */
+typedef void (*uniformcoupling_t)(pcclusterbasis rb, pcclusterbasis cb,
+				  void *data, pamatrix S);
+
 /** @brief Representation of an admissible block for
  *  @f$ \mathcal H^2 @f$-matrices.
  *
@@ -65,6 +76,11 @@ typedef const uniform *pcuniform;
  *  If it is necessary to update these lists, please use the functions
  *  @ref ref_row_uniform, @ref ref_col_uniform,  @ref unref_row_uniform
  *  and @ref unref_col_uniform to perform this task.
+ *
+ *  If <tt>coupling</tt> is not <tt>NULL</tt>, the block is represented
+ *  implicitly: <tt>S</tt> is empty and the coupling matrix is recomputed
+ *  by <tt>coupling</tt> every time it is needed, see
+ *  @ref setimplicit_uniform and @ref getcoupling_uniform.
  */
 struct _uniform {
   /** @brief Row @ref _clusterbasis "clusterbasis" */
@@ -81,6 +97,10 @@ struct _uniform {
   puniform cnext;
   /** @brief Previous column block in list */
   puniform cprev;
+  /** @brief Callback for implicit coupling matrix, or <tt>NULL</tt> */
+  uniformcoupling_t coupling;
+  /** @brief Data for the callback <tt>coupling</tt> */
+  void *cdata;
 };
 
 /* ------------------------------------------------------------
@@ -182,6 +202,54 @@ unref_col_uniform(puniform u);
 HEADER_PREFIX size_t
 getsize_uniform(pcuniform u);
 
+/* ------------------------------------------------------------
+ * Implicitly represented coupling matrices
+ * ------------------------------------------------------------ */
+
+/** @brief Switch a @ref _uniform "uniform" block to an implicit
+ *  representation.
+ *
+ *  The stored coupling matrix is released, and the callback
+ *  <tt>coupling</tt> is used to recompute it on demand, e.g., during
+ *  matrix-vector multiplications. This trades storage for computation
+ *  time, since the coupling matrices of an @f$\mathcal H^2@f$-matrix
+ *  usually dominate its storage requirements.
+ *
+ *  Matrix-vector multiplications, conversions and projections handle
+ *  implicit blocks. Recompression, @f$\mathcal H^2@f$-matrix arithmetic
+ *  and low-rank updates modify or factorize <tt>S</tt> directly and
+ *  require explicit blocks, so call @ref setexplicit_uniform first;
+ *  this is checked by assertions.
+ *
+ *  @param u @ref _uniform "Uniform" object.
+ *  @param coupling Callback computing the coupling matrix.
+ *  @param data Additional data passed to <tt>coupling</tt>. */
+HEADER_PREFIX void
+setimplicit_uniform(puniform u, uniformcoupling_t coupling, void *data);
+
+/** @brief Switch an implicitly represented @ref _uniform "uniform"
+ *  block back to an explicit representation.
+ *
+ *  Evaluates the callback once and stores the result in <tt>u->S</tt>.
+ *  Does nothing if the block is already explicit.
+ *
+ *  @param u @ref _uniform "Uniform" object. */
+HEADER_PREFIX void
+setexplicit_uniform(puniform u);
+
+/** @brief Get the coupling matrix of a @ref _uniform "uniform" block.
+ *
+ *  For an explicit block, a pointer to <tt>u->S</tt> is returned.
+ *  For an implicit block, the coupling matrix is computed in
+ *  <tt>tmp</tt>, which is resized if necessary, and a pointer to
+ *  <tt>tmp</tt> is returned.
+ *
+ *  @param u @ref _uniform "Uniform" object.
+ *  @param tmp Auxiliary matrix, can be reused across calls.
+ *  @returns Coupling matrix @f$S_b@f$. */
+HEADER_PREFIX pcamatrix
+getcoupling_uniform(pcuniform u, pamatrix tmp);
+
 /* ------------------------------------------------------------
  * Simple utility functions
  * ------------------------------------------------------------ */
@@ -400,6 +468,9 @@ getcols_uniform(pcuniform u)
 }
 
 /** @brief Get the factor S of a @ref uniform matrix @f$G=V S W^*@f$.
+ *
+ * @remark For implicitly represented blocks, the returned matrix is
+ * empty, use @ref getcoupling_uniform instead.
  *
  * @param u Matrix @f$G@f$.
  * @returns Factor @f$S@f$. */
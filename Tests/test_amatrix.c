@@ -573,6 +573,82 @@ check_clear_copy_lower(pcamatrix a)
   uninit_amatrix(a3);
 }
 
+static void
+check_fused(uint n)
+{
+  avector   xtmp, ytmp, ztmp, wtmp;
+  pavector  x, y, z, w;
+  pcavector yz[3];
+  field     beta, d[3], e[3];
+  real      error, norm;
+  uint      j;
+
+  x = init_avector(&xtmp, n);
+  y = init_avector(&ytmp, n);
+  z = init_avector(&ztmp, n);
+  w = init_avector(&wtmp, n);
+
+  random_avector(x);
+  random_avector(y);
+  random_avector(z);
+  beta = -0.5 * alpha;
+
+  /* w = alpha x + beta y by separate operations */
+  copy_avector(y, w);
+  scale_avector(beta, w);
+  add_avector(alpha, x, w);
+  norm = norm2_avector(w);
+
+  scaleadd_avector(alpha, x, beta, y);
+  add_avector(-1.0, w, y);
+  error = norm2_avector(y) / norm;
+  (void) printf("Checking fused operations for n=%u\n"
+		"  scaleadd accuracy %g, %sokay\n", n, error,
+		(IS_IN_RANGE(0.0, error, tolerance) ? "" : "    NOT "));
+  if (!IS_IN_RANGE(0.0, error, tolerance))
+    problems++;
+
+  copy_avector(w, y);
+  add_avector(alpha, x, w);
+  d[0] = dotprod_avector(z, w);
+  e[0] = adddotprod_avector(alpha, x, y, z);
+  add_avector(-1.0, w, y);
+  error = norm2_avector(y) / norm2_avector(w)
+    + ABS(d[0] - e[0]) / (norm2_avector(z) * norm2_avector(w));
+  (void) printf("  adddotprod accuracy %g, %sokay\n", error,
+		(IS_IN_RANGE(0.0, error, tolerance) ? "" : "    NOT "));
+  if (!IS_IN_RANGE(0.0, error, tolerance))
+    problems++;
+
+  copy_avector(w, y);
+  add_avector(alpha, x, w);
+  norm = norm2_avector(w);
+  error = ABS(addnorm2_avector(alpha, x, y) - norm) / norm;
+  (void) printf("  addnorm2 accuracy %g, %sokay\n", error,
+		(IS_IN_RANGE(0.0, error, tolerance) ? "" : "    NOT "));
+  if (!IS_IN_RANGE(0.0, error, tolerance))
+    problems++;
+
+  yz[0] = y;
+  yz[1] = z;
+  yz[2] = w;
+  dotprodmulti_avector(x, 3, yz, d);
+  error = 0.0;
+  for (j = 0; j < 3; j++) {
+    e[j] = dotprod_avector(x, yz[j]);
+    error += ABS(d[j] - e[j]) / (norm2_avector(x) * norm2_avector(yz[j]));
+  }
+  (void) printf("  dotprodmulti accuracy %g, %sokay\n", error,
+		(IS_IN_RANGE(0.0, error, tolerance) ? "" : "    NOT "));
+  if (!IS_IN_RANGE(0.0, error, tolerance))
+    problems++;
+
+  uninit_avector(w);
+  uninit_avector(z);
+  uninit_avector(y);
+  uninit_avector(x);
+}
+
 static void
 set_unit(pamatrix R)
 {
@@ -1052,6 +1128,10 @@ main()
   check_triangularaddmul(false, true, true, true);
   check_triangularaddmul(true, true, true, true);
 
+  /* Checking fused vector operations */
+  check_fused(rows);
+  check_fused(3 * AVECTOR_PARALLEL_DIM + 5);
+
   /* Checking QR factorization */
   (void) printf("----------------------------------------\n"
 		"Check square QR factorization\n");
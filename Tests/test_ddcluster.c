@@ -14,6 +14,7 @@
 #include "tri2dp1.h"
 #include "ddcluster.h"
 #include "hmatrix.h"
+#include "harith.h"
 #include "matrixnorms.h"
 
 static uint problems = 0;
@@ -36,7 +37,9 @@ main(int argc, char **argv)
   uint      dim;		/* Dimension for splitting ddcluster */
   uint     *flag;		/* Auxiliary array for dd-cluster */
   phmatrix  hm;			/* Hierarchical matrix */
-  real      error;
+  ptruncmode tm;		/* Truncation mode */
+  pstopwatch sw;
+  real      error, t_run;
 
   init_h2lib(&argc, &argv);
 
@@ -118,6 +121,22 @@ main(int argc, char **argv)
   if (!IS_IN_RANGE(0.0, error, 1.0e-16))
     problems++;
 
+  printf("========================================\n"
+	 "  Domain decomposition H-LU decomposition\n");
+  tm = new_releucl_truncmode();
+  sw = new_stopwatch();
+  start_stopwatch(sw);
+  lrdecomp_dd_hmatrix(hm, tm, 1.0e-10);
+  t_run = stop_stopwatch(sw);
+  error = norm2diff_lr_sparsematrix_hmatrix(sp, hm);
+  printf("  %.2f seconds, |I - (LR)^{-1} A| = %.4e\n", t_run, error);
+
+  if (!IS_IN_RANGE(0.0, error, 1.0e-6))
+    problems++;
+
+  del_stopwatch(sw);
+  del_truncmode(tm);
+
   printf("========================================\n" "  Cleaning up\n");
   for (i = 0; i <= L; i++) {
     j = L - i;
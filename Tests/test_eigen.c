@@ -5,26 +5,87 @@
 
 #include "eigensolvers.h"
 #include "factorizations.h"
+#include "krylovschur.h"
+#include "laplacebem2d.h"
 
 static uint problems = 0;
 
 #ifdef USE_FLOAT
 static const real tolerance = 5.0e-5;
+static const real ktolerance = 1.0e-3;
 #else
 static const real tolerance = 1.0e-12;
+static const real ktolerance = 1.0e-8;
 #endif
 
+static void
+lrsolve(void *data, pavector x)
+{
+  lrsolve_amatrix_avector(false, (pcamatrix) data, x);
+}
+
+/* Largest column of A X - X Lambda or, for an invariant subspace,
+ * of A X - X (X^* A X), relative to the first eigenvalue.
+ * Uses the vector multiplication of the matrix. */
+static real
+check_eigenpairs(void *A, addeval_t addeval_A, pcrealavector lambda,
+		 bool subspace, pamatrix X)
+{
+  avector   tmp1, tmp2;
+  pamatrix  Y, T;
+  pavector  x, y;
+  real      error;
+  uint      j;
+
+  Y = new_zero_amatrix(X->rows, X->cols);
+  for (j = 0; j < X->cols; j++) {
+    x = init_column_avector(&tmp1, X, j);
+    y = init_column_avector(&tmp2, Y, j);
+    addeval_A(1.0, A, x, y);
+    if (!subspace)
+      add_avector(-lambda->v[j], x, y);
+    uninit_avector(y);
+    uninit_avector(x);
+  }
+
+  if (subspace) {
+    T = new_zero_amatrix(X->cols, X->cols);
+    addmul_amatrix(1.0, true, X, false, Y, T);
+    addmul_amatrix(-1.0, false, X, false, T, Y);
+    del_amatrix(T);
+  }
+
+  error = 0.0;
+  for (j = 0; j < Y->cols; j++) {
+    y = init_column_avector(&tmp2, Y, j);
+    error = REAL_MAX(error, norm2_avector(y));
+    uninit_avector(y);
+  }
+  del_amatrix(Y);
+
+  return error / REAL_ABS(lambda->v[0]);
+}
+
 int
 main()
 {
   ptridiag  T, Tcopy;
   pamatrix  A, Acopy, Q, U, Vt;
   pavector  work;
-  prealavector sigma, lambda;
-  real      error;
+  pamatrix  X, D, LR;
+  prealavector sigma, lambda, lambda_re, lambda_im, ref;
+  pcurve2d  gr;
+  pbem2d    bem;
+  pcluster  root;
+  pblock    broot;
+  pclusterbasis rb, cb;
+  phmatrix  Hm;
+  ph2matrix H2;
+  real      error, shift, eta;
   uint      rows, cols, mid;
-  uint      i, n, iter;
+  uint      i, j, n, iter, nconv;
   int       info;
+  bool      ok;
 
   /* ------------------------------------------------------------
    * Testing symmetric tridiagonal eigenvalue solver
@@ -890,6 +951,262 @@ main()
   del_amatrix(Acopy);
   del_amatrix(A);
 
+  /* ------------------------------------------------------------
+   * Testing Krylov-Schur eigensolvers
+   * ------------------------------------------------------------ */
+
+  n = 200;
+
+  (void) printf("==================================================\n"
+		"Testing thick-restart Lanczos method\n"
+		"==================================================\n");
+  A = new_amatrix(n, n);
+  random_amatrix(A);
+  for (j = 0; j < n; j++)
+    for (i = 0; i < j; i++)
+      A->a[j + i * A->ld] = CONJ(A->a[i + j * A->ld]);
+  for (i = 0; i < n; i++)
+    A->a[i + i * A->ld] = REAL(A->a[i + i * A->ld]);
+
+  Acopy = new_amatrix(n, n);
+  copy_amatrix(false, A, Acopy);
+  Q = new_amatrix(n, n);
+  ref = new_realavector(n);
+  eig_amatrix(Acopy, ref, Q);
+
+  lambda = new_realavector(4);
+  X = new_amatrix(n, 4);
+  nconv = eig_lanczos_amatrix(A, 2, 30, H2_EIG_LARGEST_REAL, ktolerance, 0,
+			      lambda, X);
+  error = 0.0;
+  for (i = 0; i < 4; i++)
+    error = REAL_MAX(error, REAL_ABS(lambda->v[i] - ref->v[n - 1 - i]));
+  (void) printf("  %u converged, largest eigenvalues %g, %sokay\n", nconv,
+		error, (error < ktolerance * ref->v[n - 1] ? "" : "NOT "));
+  if (error >= ktolerance * ref->v[n - 1] || nconv != 4)
+    problems++;
+
+  error = check_ortho_amatrix(false, X);
+  (void) printf("  Orthogonality X %g, %sokay\n", error,
+		(error < tolerance * n ? "" : "NOT "));
+  if (error >= tolerance * n)
+    problems++;
+
+  (void) printf("Shift-invert Lanczos method\n");
+  shift = 0.5 * (ref->v[n / 2] + ref->v[n / 2 + 1]);
+  LR = new_amatrix(n, n);
+  copy_amatrix(false, A, LR);
+  for (i = 0; i < n; i++)
+    LR->a[i + i * LR->ld] -= shift;
+  lrdecomp_amatrix(LR);
+  nconv = eig_shiftinvert_lanczos(lrsolve, LR, n, shift, 30, ktolerance, 0,
+				  lambda, X);
+  error = REAL_MIN(REAL_ABS(lambda->v[0] - ref->v[n / 2])
+		   + REAL_ABS(lambda->v[1] - ref->v[n / 2 + 1]),
+		   REAL_ABS(lambda->v[1] - ref->v[n / 2])
+		   + REAL_ABS(lambda->v[0] - ref->v[n / 2 + 1]));
+  (void) printf("  %u converged, eigenvalues next to shift %g, %sokay\n",
+		nconv, error, (error < ktolerance ? "" : "NOT "));
+  if (error >= ktolerance || nconv != 4)
+    problems++;
+
+  del_amatrix(X);
+  del_realavector(lambda);
+  del_realavector(ref);
+  del_amatrix(Q);
+  del_amatrix(Acopy);
+
+  (void) printf("==================================================\n"
+		"Testing Krylov-Schur method\n"
+		"==================================================\n");
+
+  /* A = Q D Q^*, with eigenvalues 10+2i, 10-2i, 9.5 and 8 of largest
+   * absolute value, followed by 5-i/100 */
+  Q = new_amatrix(n, n);
+  random_amatrix(Q);
+  work = new_avector(n);
+  qrdecomp_amatrix(Q, work);
+  U = new_amatrix(n, n);
+  qrexpand_amatrix(Q, work, U);
+  del_avector(work);
+
+  D = new_zero_amatrix(n, n);
+  for (j = 0; j < n; j++) {
+    D->a[j + j * D->ld] = 5.0 - 0.01 * j;
+    for (i = 0; i < j; i++)
+      D->a[i + j * D->ld] = 0.01 * FIELD_RAND();
+  }
+  D->a[0] = 10.0;
+  D->a[1 + D->ld] = 10.0;
+  D->a[D->ld] = 2.0;
+  D->a[1] = -2.0;
+  D->a[2 + 2 * D->ld] = 9.5;
+  D->a[3 + 3 * D->ld] = 8.0;
+
+  clear_amatrix(Q);
+  addmul_amatrix(1.0, false, U, false, D, Q);
+  clear_amatrix(A);
+  addmul_amatrix(1.0, false, Q, true, U, A);
+
+  lambda_re = new_realavector(4);
+  lambda_im = new_realavector(4);
+  X = new_amatrix(n, 4);
+  nconv = eig_krylovschur_amatrix(A, 1, 30, H2_EIG_LARGEST_MAGNITUDE,
+				  ktolerance, 0, lambda_re, lambda_im, X);
+  error = REAL_ABS(lambda_re->v[0] - 10.0) + REAL_ABS(lambda_re->v[1] - 10.0)
+    + REAL_ABS(REAL_ABS(lambda_im->v[0]) - 2.0)
+    + REAL_ABS(lambda_im->v[0] + lambda_im->v[1])
+    + REAL_ABS(lambda_re->v[2] - 9.5) + REAL_ABS(lambda_im->v[2])
+    + REAL_ABS(lambda_re->v[3] - 8.0) + REAL_ABS(lambda_im->v[3]);
+  (void) printf("  %u converged, largest eigenvalues %g, %sokay\n", nconv,
+		error, (error < 10.0 * ktolerance ? "" : "NOT "));
+  if (error >= 10.0 * ktolerance || nconv != 4)
+    problems++;
+
+  /* Invariance of the subspace, A X = X (X^* A X) */
+  Vt = new_zero_amatrix(n, 4);
+  addmul_amatrix(1.0, false, A, false, X, Vt);
+  Acopy = new_zero_amatrix(4, 4);
+  addmul_amatrix(1.0, true, X, false, Vt, Acopy);
+  addmul_amatrix(-1.0, false, X, false, Acopy, Vt);
+  error = normfrob_amatrix(Vt);
+  del_amatrix(Acopy);
+  (void) printf("  Invariance of subspace %g, %sokay\n", error,
+		(error < 10.0 * ktolerance ? "" : "NOT "));
+  if (error >= 10.0 * ktolerance)
+    problems++;
+  del_amatrix(Vt);
+
+  (void) printf("Schur basis of a small matrix\n");
+  ok = schurbasis_amatrix(A, H2_EIG_LARGEST_MAGNITUDE, X);
+  error = check_ortho_amatrix(false, X);
+  Vt = new_zero_amatrix(n, 4);
+  addmul_amatrix(1.0, false, A, false, X, Vt);
+  Acopy = new_zero_amatrix(4, 4);
+  addmul_amatrix(1.0, true, X, false, Vt, Acopy);
+  addmul_amatrix(-1.0, false, X, false, Acopy, Vt);
+  error += normfrob_amatrix(Vt);
+  del_amatrix(Acopy);
+  del_amatrix(Vt);
+  (void) printf("  Orthogonality and invariance %g, %sokay\n", error,
+		(ok && error < tolerance ? "" : "NOT "));
+  if (!ok || error >= tolerance)
+    problems++;
+
+  (void) printf("Shift-invert Krylov-Schur method\n");
+  copy_amatrix(false, A, LR);
+  for (i = 0; i < n; i++)
+    LR->a[i + i * LR->ld] -= 9.4;
+  lrdecomp_amatrix(LR);
+  nconv = eig_shiftinvert_krylovschur(lrsolve, LR, n, 9.4, 30, ktolerance,
+				      0, lambda_re, lambda_im, X);
+  error = REAL_ABS(lambda_re->v[0] - 9.5) + REAL_ABS(lambda_im->v[0])
+    + REAL_ABS(lambda_re->v[1] - 8.0) + REAL_ABS(lambda_im->v[1]);
+  (void) printf("  %u converged, eigenvalues next to shift %g, %sokay\n",
+		nconv, error, (error < ktolerance ? "" : "NOT "));
+  if (error >= ktolerance || nconv != 4)
+    problems++;
+
+  del_amatrix(X);
+  del_realavector(lambda_im);
+  del_realavector(lambda_re);
+  del_amatrix(LR);
+  del_amatrix(D);
+  del_amatrix(U);
+  del_amatrix(Q);
+  del_amatrix(A);
+
+  /* ------------------------------------------------------------
+   * Testing Krylov-Schur eigensolvers for H- and H^2-matrices
+   * ------------------------------------------------------------ */
+
+  (void) printf("==================================================\n"
+		"Testing eigensolvers for H- and H^2-matrices\n"
+		"==================================================\n");
+
+  /* Single layer potential on a circle, self-adjoint up to the
+   * approximation error. Apart from the largest one, the eigenvalues
+   * have multiplicity two, so five of them do not split a pair.
+   * Krylov-Schur only provides a basis of the invariant subspace. */
+  n = 400;
+  gr = new_circle_curve2d(n, 0.333);
+  bem = new_slp_laplace_bem2d(gr, 2, BASIS_CONSTANT_BEM2D);
+  root = build_bem2d_cluster(bem, 16, BASIS_CONSTANT_BEM2D);
+  eta = 1.0;
+
+  broot = build_nonstrict_block(root, root, &eta, admissible_max_cluster);
+  setup_hmatrix_aprx_greenhybrid_row_bem2d(bem, root, root, broot, 6, 1,
+					   1.0, 1.0e-12,
+					   build_bem2d_rect_quadpoints);
+  Hm = build_from_block_hmatrix(broot, 0);
+  assemble_bem2d_hmatrix(bem, broot, Hm);
+  del_block(broot);
+
+  broot = build_strict_block(root, root, &eta, admissible_max_cluster);
+  rb = build_from_cluster_clusterbasis(root);
+  cb = build_from_cluster_clusterbasis(root);
+  setup_h2matrix_aprx_greenhybrid_bem2d(bem, rb, cb, broot, 6, 1, 1.0,
+					1.0e-12, build_bem2d_rect_quadpoints);
+  assemble_bem2d_h2matrix_row_clusterbasis(bem, rb);
+  assemble_bem2d_h2matrix_col_clusterbasis(bem, cb);
+  H2 = build_from_block_h2matrix(broot, rb, cb);
+  assemble_bem2d_h2matrix(bem, broot, H2);
+
+  lambda = new_realavector(5);
+  lambda_im = new_realavector(5);
+  X = new_amatrix(n, 5);
+
+  (void) printf("Lanczos method for H-matrix\n");
+  nconv = eig_lanczos_hmatrix(Hm, 2, 30, H2_EIG_LARGEST_REAL, ktolerance, 0,
+			      lambda, X);
+  error = check_eigenpairs(Hm, (addeval_t) addeval_hmatrix_avector, lambda,
+			   false, X);
+  (void) printf("  %u converged, residual %g, %sokay\n", nconv, error,
+		(error < 10.0 * ktolerance ? "" : "NOT "));
+  if (error >= 10.0 * ktolerance || nconv != 5)
+    problems++;
+
+  (void) printf("Lanczos method for H^2-matrix\n");
+  nconv = eig_lanczos_h2matrix(H2, 2, 30, H2_EIG_LARGEST_REAL, ktolerance,
+			       0, lambda, X);
+  error = check_eigenpairs(H2, (addeval_t) addeval_h2matrix_avector, lambda,
+			   false, X);
+  (void) printf("  %u converged, residual %g, %sokay\n", nconv, error,
+		(error < 10.0 * ktolerance ? "" : "NOT "));
+  if (error >= 10.0 * ktolerance || nconv != 5)
+    problems++;
+
+  (void) printf("Krylov-Schur method for H-matrix\n");
+  nconv = eig_krylovschur_hmatrix(Hm, 2, 30, H2_EIG_LARGEST_MAGNITUDE,
+				  ktolerance, 0, lambda, lambda_im, X);
+  error = check_eigenpairs(Hm, (addeval_t) addeval_hmatrix_avector, lambda,
+			   true, X);
+  (void) printf("  %u converged, residual %g, %sokay\n", nconv, error,
+		(error < 10.0 * ktolerance ? "" : "NOT "));
+  if (error >= 10.0 * ktolerance || nconv != 5)
+    problems++;
+
+  (void) printf("Krylov-Schur method for H^2-matrix\n");
+  nconv = eig_krylovschur_h2matrix(H2, 2, 30, H2_EIG_LARGEST_MAGNITUDE,
+				   ktolerance, 0, lambda, lambda_im, X);
+  error = check_eigenpairs(H2, (addeval_t) addeval_h2matrix_avector, lambda,
+			   true, X);
+  (void) printf("  %u converged, residual %g, %sokay\n", nconv, error,
+		(error < 10.0 * ktolerance ? "" : "NOT "));
+  if (error >= 10.0 * ktolerance || nconv != 5)
+    problems++;
+
+  del_amatrix(X);
+  del_realavector(lambda_im);
+  del_realavector(lambda);
+  del_h2matrix(H2);
+  del_block(broot);
+  del_hmatrix(Hm);
+  del_bem2d(bem);
+  freemem(root->idx);
+  del_cluster(root);
+  del_curve2d(gr);
+
   printf("----------------------------------------\n"
 	 "  %u matrices and\n"
 	 "  %u vectors still active\n"
@@ -5,6 +5,7 @@
 #include "h2matrix.h"
 #include "h2arith.h"
 #include "truncation.h"
+#include "matrixnorms.h"
 
 #include "laplacebem2d.h"
 
@@ -36,8 +37,11 @@ main()
   pclusteroperator rwf, cwf, rwflow, cwflow, rwfup, cwfup, rwfh2, cwfh2;
   ptruncmode tm;
 
-  pavector  x, b;
-  uint      n;
+  pavector  x, b, xc, yc;
+  pamatrix  X, Y;
+  avector   xtmp, ytmp;
+  uint      n, j, t;
+  bool      trans;
   real      error;
   pcurve2d  gr2;
   pbem2d    bem2;
@@ -81,6 +85,32 @@ main()
   clear_avector(b);
   mvm_h2matrix_avector(alpha, false, h2, x, b);
 
+  (void) printf("Checking block multiplication\n");
+  X = new_amatrix(n, 3);
+  Y = new_amatrix(n, 3);
+  random_amatrix(X);
+  for (t = 0; t < 2; t++) {
+    trans = (t == 1);
+    clear_amatrix(Y);
+    mvmblock_h2matrix(alpha, trans, h2, X, Y);
+    error = 0.0;
+    for (j = 0; j < 3; j++) {
+      xc = init_column_avector(&xtmp, X, j);
+      yc = init_column_avector(&ytmp, Y, j);
+      mvm_h2matrix_avector(-alpha, trans, h2, xc, yc);
+      error = REAL_MAX(error, norm2_avector(yc) / norm2_avector(xc));
+      uninit_avector(yc);
+      uninit_avector(xc);
+    }
+    (void) printf("  %s: accuracy %g, %sokay\n",
+		  (trans ? "Adjoint" : "Matrix"), error,
+		  IS_IN_RANGE(0.0, error, tol) ? "" : "    NOT ");
+    if (!IS_IN_RANGE(0.0, error, tol))
+      problems++;
+  }
+  del_amatrix(Y);
+  del_amatrix(X);
+
   (void) printf("Copying matrix\n");
 
   rbcopy = clone_clusterbasis(h2->rb);
@@ -610,6 +610,12 @@ test_suite(pcsurface3d gr, field k, uint q, uint clf, real eta,
 	      V, brootKM, bem_dlp, KM, row_basis, col_basis, exterior,
 	      error_min, error_max);
 
+  setup_hmatrix_aprx_bpaca_bem3d(bem_slp, rootn, rootn, brootV, eps_aca, 4);
+  setup_hmatrix_aprx_bpaca_bem3d(bem_dlp, rootn, rootd, brootKM, eps_aca, 4);
+  test_system(HMATRIX, "ACA blocked partial pivoting", Vfull, KMfull, brootV,
+	      bem_slp, V, brootKM, bem_dlp, KM, row_basis, col_basis, exterior,
+	      error_min, error_max);
+
   setup_hmatrix_aprx_hca_bem3d(bem_slp, rootn, rootn, brootV, m, eps_aca);
   setup_hmatrix_aprx_hca_bem3d(bem_dlp, rootn, rootd, brootKM, m, eps_aca);
   test_system(HMATRIX, "HCA2", Vfull, KMfull, brootV, bem_slp, V, brootKM,
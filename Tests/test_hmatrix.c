@@ -3,6 +3,8 @@
 #include "hmatrix.h"
 #include "harith.h"
 #include "hcoarsen.h"
+#include "mixedprec.h"
+#include "matrixnorms.h"
 
 #include "laplacebem2d.h"
 
@@ -377,11 +379,12 @@ set_unit_amatrix(pamatrix R)
 int
 main(int argc, char **argv)
 {
-  phmatrix  a, acopy, L, R, work;
-  pamatrix  La, Ra;
+  phmatrix  a, acopy, L, R, work, LPa;
+  plphmatrix LP;
+  pamatrix  La, Ra, Ad, Ai;
   pavector  x, b, b2;
-  uint      n;
-  real      error;
+  uint      n, iter;
+  real      error, est, bound;
   pcurve2d  gr2;
   pbem2d    bem2;
   pcluster  root2;
@@ -606,6 +609,40 @@ main(int argc, char **argv)
   if (!IS_IN_RANGE(0.0, error, 10.0 * tol))
     problems++;
 
+  (void) printf("Estimating norms by randomized block iteration\n");
+  error = norm2_hmatrix(acopy);
+  est = norm2_randomized_hmatrix(acopy, 8, 4, &bound);
+  (void) printf("  Power iteration %.4e, randomized %.4e, bound %.4e, %sokay\n",
+		error, est, bound,
+		IS_IN_RANGE(0.99 * error, est, bound) ? "" : "    NOT ");
+  if (!IS_IN_RANGE(0.99 * error, est, bound))
+    problems++;
+
+  error = norm2diff_id_lr_hmatrix(acopy, a);
+  est = norm2diff_id_lr_randomized_hmatrix(acopy, a, 8, 4, &bound);
+  (void) printf("  Factorization error %.4e, randomized %.4e, bound %.4e, "
+		"%sokay\n", error, est, bound,
+		IS_IN_RANGE(0.99 * error, est, bound) ? "" : "    NOT ");
+  if (!IS_IN_RANGE(0.99 * error, est, bound))
+    problems++;
+
+  (void) printf("Estimating condition number\n");
+  Ad = new_zero_amatrix(n, n);
+  add_hmatrix_amatrix(1.0, false, acopy, Ad);
+  Ai = new_identity_amatrix(n, n);
+  lrdecomp_amatrix(Ad);
+  lrsolve_amatrix(Ad, Ai);
+  clear_amatrix(Ad);
+  add_hmatrix_amatrix(1.0, false, acopy, Ad);
+  error = norm1_amatrix(Ad) * norm1_amatrix(Ai);
+  est = condest1_lr_hmatrix(acopy, a);
+  (void) printf("  Condition number %.4e, estimate %.4e, %sokay\n", error, est,
+		IS_IN_RANGE(error / 3.0, est, 1.01 * error) ? "" : "    NOT ");
+  if (!IS_IN_RANGE(error / 3.0, est, 1.01 * error))
+    problems++;
+  del_amatrix(Ai);
+  del_amatrix(Ad);
+
   (void) printf("Building triangular factors\n");
   L = clone_lower_hmatrix(true, a);
   R = clone_upper_hmatrix(false, a);
@@ -650,6 +687,65 @@ main(int argc, char **argv)
   if (!IS_IN_RANGE(0.0, error, 10.0 * tol))
     problems++;
 
+  (void) printf("Converting factorization to low precision\n");
+  LP = new_hmatrix_lphmatrix(a);
+  LPa = new_lphmatrix_hmatrix(LP);
+  (void) printf("  %.2f MB instead of %.2f MB\n",
+		getsize_lphmatrix(LP) / 1048576.0,
+		getsize_hmatrix(a) / 1048576.0);
+
+  (void) printf("Solving in low precision\n");
+  random_avector(b);
+  copy_avector(b, b2);
+  lrsolve_lphmatrix_avector(false, LP, b);
+  lrsolve_hmatrix_avector(false, LPa, b2);
+  add_avector(-1.0, b2, b);
+  error = norm2_avector(b) / norm2_avector(b2);
+  (void) printf("  Accuracy %g, %sokay\n", error,
+		IS_IN_RANGE(0.0, error, 10.0 * tol) ? "" : "    NOT ");
+  if (!IS_IN_RANGE(0.0, error, 10.0 * tol))
+    problems++;
+
+  (void) printf("Solving adjoint in low precision\n");
+  random_avector(b);
+  copy_avector(b, b2);
+  lrsolve_lphmatrix_avector(true, LP, b);
+  lrsolve_hmatrix_avector(true, LPa, b2);
+  add_avector(-1.0, b2, b);
+  error = norm2_avector(b) / norm2_avector(b2);
+  (void) printf("  Accuracy %g, %sokay\n", error,
+		IS_IN_RANGE(0.0, error, 10.0 * tol) ? "" : "    NOT ");
+  if (!IS_IN_RANGE(0.0, error, 10.0 * tol))
+    problems++;
+
+  del_hmatrix(LPa);
+
+  (void) printf("Mixed-precision iterative refinement\n");
+  clear_avector(b);
+  mvm_hmatrix_avector(1.0, false, acopy, x, b);
+  clear_avector(b2);
+  iter = solve_irefine_hmatrix_avector(acopy, LP, b, b2, tol, 100);
+  mvm_hmatrix_avector(-1.0, false, acopy, b2, b);
+  error = norm2_avector(b) / norm2_hmatrix(acopy) / norm2_avector(b2);
+  (void) printf("  %u steps, residual %g, %sokay\n", iter, error,
+		IS_IN_RANGE(0.0, error, tol) ? "" : "    NOT ");
+  if (!IS_IN_RANGE(0.0, error, tol))
+    problems++;
+
+  (void) printf("Mixed-precision GMRES\n");
+  clear_avector(b);
+  mvm_hmatrix_avector(1.0, false, acopy, x, b);
+  clear_avector(b2);
+  iter = solve_mpgmres_hmatrix_avector(acopy, LP, b, b2, tol, 100, 10);
+  mvm_hmatrix_avector(-1.0, false, acopy, b2, b);
+  error = norm2_avector(b) / norm2_hmatrix(acopy) / norm2_avector(b2);
+  (void) printf("  %u steps, residual %g, %sokay\n", iter, error,
+		IS_IN_RANGE(0.0, error, tol) ? "" : "    NOT ");
+  if (!IS_IN_RANGE(0.0, error, tol))
+    problems++;
+
+  del_lphmatrix(LP);
+
   (void) printf("Checking factorization\n");
   error = norm2_hmatrix(acopy);
   addmul_hmatrix(alpha, false, L, false, R, 0, tol, acopy);
@@ -2,6 +2,8 @@
 #include <stdio.h>
 #include "amatrix.h"
 #include "krylov.h"
+#include "matrixnorms.h"
+#include "eigensolvers.h"
 
 static void
 jacobi(void *pdata, pavector r)
@@ -19,6 +21,26 @@ gauss_seidel(void *pdata, pavector r)
   triangularsolve_amatrix_avector(true, false, false, A, r);
 }
 
+static real
+exact_norm2(pcamatrix A)
+{
+  pamatrix  Ac;
+  prealavector sigma;
+  real      norm;
+  uint      i;
+
+  Ac = clone_amatrix(A);
+  sigma = new_realavector(UINT_MIN(A->rows, A->cols));
+  svd_amatrix(Ac, sigma, 0, 0);
+  norm = 0.0;
+  for (i = 0; i < sigma->dim; i++)
+    norm = REAL_MAX(norm, sigma->v[i]);
+  del_realavector(sigma);
+  del_amatrix(Ac);
+
+  return norm;
+}
+
 int
 main()
 {
@@ -30,6 +52,8 @@ main()
   uint      n, kmax;
   uint      k, steps;
   uint      problems;
+  pamatrix  B, LR, M;
+  real      norm, est, bound;
 
   problems = 0;
 
@@ -177,6 +201,75 @@ main()
   del_avector(b);
   del_amatrix(A);
 
+  (void) printf("Testing randomized norm estimators\n");
+  n = 47;
+  A = new_amatrix(n, n);
+  B = new_amatrix(n, n);
+  random_invertible_amatrix(A, 2.0);
+  random_amatrix(B);
+  scale_amatrix(1e-3, B);
+  add_amatrix(1.0, false, A, B);
+
+  norm = exact_norm2(A);
+  est = norm2_randomized_amatrix(A, 10, 6, &bound);
+  (void) printf("  ||A||_2 %.4e, estimate %.4e, bound %.4e:", norm, est,
+		bound);
+  if (est <= norm * (1.0 + 1e-10) && est >= 0.95 * norm && bound >= norm)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  M = clone_amatrix(A);
+  add_amatrix(-1.0, false, B, M);
+  norm = exact_norm2(M);
+  est = norm2diff_randomized_amatrix(A, B, 10, 6, &bound);
+  (void) printf("  ||A-B||_2 %.4e, estimate %.4e, bound %.4e:", norm, est,
+		bound);
+  if (est <= norm * (1.0 + 1e-10) && est >= 0.95 * norm && bound >= norm)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  LR = clone_amatrix(B);
+  lrdecomp_amatrix(LR);
+  copy_amatrix(false, A, M);
+  lrsolve_amatrix(LR, M);
+  scale_amatrix(-1.0, M);
+  for (k = 0; k < n; k++)
+    M->a[k + k * M->ld] += 1.0;
+  norm = exact_norm2(M);
+  est = norm2diff_id_lr_randomized_amatrix(A, LR, 10, 6, &bound);
+  (void) printf("  ||I-B^{-1}A||_2 %.4e, estimate %.4e, bound %.4e:", norm,
+		est, bound);
+  if (est <= norm * (1.0 + 1e-8) && est >= 0.95 * norm && bound >= norm)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  (void) printf("Testing 1-norm condition estimator\n");
+  identity_amatrix(M);
+  lrsolve_amatrix(LR, M);
+  norm = norm1_amatrix(B) * norm1_amatrix(M);
+  est = condest1_lr_amatrix(B, LR);
+  (void) printf("  cond_1(B) %.4e, estimate %.4e:", norm, est);
+  if (est <= norm * (1.0 + 1e-8) && est >= norm / 3.0)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  del_amatrix(M);
+  del_amatrix(LR);
+  del_amatrix(B);
+  del_amatrix(A);
+
   printf("----------------------------------------\n"
 	 "  %u matrices and\n"
 	 "  %u vectors still active\n"
@@ -2,6 +2,8 @@
 #include <stdio.h>
 #include "amatrix.h"
 #include "krylovsolvers.h"
+#include "gcrodr.h"
+#include "laplacebem2d.h"
 
 static void
 jacobi(void *pdata, pavector r)
@@ -19,15 +21,146 @@ gauss_seidel(void *pdata, pavector r)
   triangularsolve_amatrix_avector(true, false, false, A, r);
 }
 
+/* Variable preconditioner, alternates between Gauss-Seidel and Jacobi */
+static void
+alternating(void *pdata, pavector r)
+{
+  static uint calls = 0;
+
+  if (calls++ % 2 == 0)
+    gauss_seidel(pdata, r);
+  else
+    jacobi(pdata, r);
+}
+
+static    real
+max_relresidual(pcamatrix A, pcamatrix B, pcamatrix X)
+{
+  pamatrix  R;
+  avector   tmp1, tmp2;
+  pavector  r, b;
+  real      error, maxerror;
+  uint      j;
+
+  R = new_amatrix(B->rows, B->cols);
+  copy_amatrix(false, B, R);
+  addmul_amatrix(-1.0, false, A, false, X, R);
+
+  maxerror = 0.0;
+  for (j = 0; j < B->cols; j++) {
+    r = init_column_avector(&tmp1, R, j);
+    b = init_column_avector(&tmp2, (pamatrix) B, j);
+    error = norm2_avector(r) / norm2_avector(b);
+    if (error > maxerror)
+      maxerror = error;
+    uninit_avector(b);
+    uninit_avector(r);
+  }
+
+  del_amatrix(R);
+
+  return maxerror;
+}
+
+static void
+prepare_block(pcamatrix A, pamatrix B, pamatrix X)
+{
+  avector   tmp1, tmp2;
+  pavector  x, b;
+  uint      i, j, s;
+
+  s = B->cols;
+
+  /* The second column duplicates the first one */
+  random_amatrix(B);
+  for (i = 0; i < B->rows; i++)
+    B->a[i + B->ld] = B->a[i];
+
+  /* The last column is solved by the initial guess */
+  random_amatrix(X);
+  for (j = 0; j + 1 < s; j++)
+    for (i = 0; i < X->rows; i++)
+      X->a[i + j * X->ld] = 0.0;
+  x = init_column_avector(&tmp1, X, s - 1);
+  b = init_column_avector(&tmp2, B, s - 1);
+  clear_avector(b);
+  addeval_amatrix_avector(1.0, A, x, b);
+  uninit_avector(b);
+  uninit_avector(x);
+}
+
+/* Upwind discretization of -Laplace u + c (u_x + u_y) on an m x m grid */
+static    psparsematrix
+convection_diffusion(uint m, real c)
+{
+  psparsematrix A;
+  real      h;
+  uint      i, j, k, nz;
+
+  h = 1.0 / (m + 1);
+
+  A = new_raw_sparsematrix(m * m, m * m, 5 * m * m - 4 * m);
+  nz = 0;
+  for (j = 0; j < m; j++)
+    for (i = 0; i < m; i++) {
+      k = i + j * m;
+      A->row[k] = nz;
+
+      A->col[nz] = k;
+      A->coeff[nz] = 4.0 + 2.0 * c * h;
+      nz++;
+      if (i > 0) {
+	A->col[nz] = k - 1;
+	A->coeff[nz] = -1.0 - c * h;
+	nz++;
+      }
+      if (i + 1 < m) {
+	A->col[nz] = k + 1;
+	A->coeff[nz] = -1.0;
+	nz++;
+      }
+      if (j > 0) {
+	A->col[nz] = k - m;
+	A->coeff[nz] = -1.0 - c * h;
+	nz++;
+      }
+      if (j + 1 < m) {
+	A->col[nz] = k + m;
+	A->coeff[nz] = -1.0;
+	nz++;
+      }
+    }
+  A->row[m * m] = nz;
+  assert(nz == A->nz);
+
+  return A;
+}
+
 int
 main()
 {
-  pamatrix  A;
+  pamatrix  A, B, X, Bh, Xh, L;
+  psparsematrix S;
+  pavector  bs, xs;
+  pavector  bl, xl;
+  pcurve2d  gr;
+  pbem2d    bem;
+  pcluster  root;
+  pblock    broot;
+  pclusterbasis rb, cb;
+  ph2matrix V;
+  avector   xtmp, btmp;
+  pavector  xh, bh;
+  real      eta;
+  pgcrodr   gd;
+  pkrylovwork w;
   pavector  b, x;
   pavector  r;
   real      eps, norm, error;
   uint      n, kmax;
-  uint      iter;
+  uint      iter, iter0, iterg;
+  uint      i, s;
+  bool      ok;
   uint      problems;
 
   problems = 0;
@@ -126,6 +259,422 @@ main()
     problems++;
   }
 
+  (void) printf("Testing flexible GMRES method\n");
+  random_invertible_amatrix(A, 1.0);
+  random_avector(b);
+  norm = norm2_avector(b);
+
+  clear_avector(x);
+  iter = solve_fgmres_amatrix_avector(A, alternating, A, b, x, eps, 0, kmax);
+  copy_avector(b, r);
+  addeval_amatrix_avector(-1.0, A, x, r);
+  error = norm2_avector(r);
+  (void) printf("  %u steps\n"
+		"  Residual %.2e (%.2e)", iter, error, error / norm);
+
+  if (iter <= n && error <= eps * norm)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  (void) printf("Testing biconjugate gradient method\n");
+  random_invertible_amatrix(A, 1.0);
+  random_avector(b);
+  norm = norm2_avector(b);
+
+  clear_avector(x);
+  iter = solve_bicg_amatrix_avector(A, b, x, eps, 0);
+  copy_avector(b, r);
+  addeval_amatrix_avector(-1.0, A, x, r);
+  error = norm2_avector(r);
+  (void) printf("  %u steps\n"
+		"  Residual %.2e (%.2e)", iter, error, error / norm);
+
+  if (iter <= 2 * n && error <= eps * norm)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  (void) printf("Testing stabilized biconjugate gradient method\n");
+  random_invertible_amatrix(A, 1.0);
+  random_avector(b);
+  norm = norm2_avector(b);
+
+  clear_avector(x);
+  iter = solve_bicgstab_amatrix_avector(A, b, x, eps, 0);
+  copy_avector(b, r);
+  addeval_amatrix_avector(-1.0, A, x, r);
+  error = norm2_avector(r);
+  (void) printf("  %u steps\n"
+		"  Residual %.2e (%.2e)", iter, error, error / norm);
+
+  if (iter <= 2 * n && error <= eps * norm)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  (void) printf("Testing preconditioned stabilized biconjugate gradient method\n");
+  random_invertible_amatrix(A, 1.0);
+  random_avector(b);
+  norm = norm2_avector(b);
+
+  clear_avector(x);
+  iter = solve_pbicgstab_amatrix_avector(A, gauss_seidel, A, b, x, eps,
+					 0);
+  copy_avector(b, r);
+  addeval_amatrix_avector(-1.0, A, x, r);
+  error = norm2_avector(r);
+  (void) printf("  %u steps\n"
+		"  Residual %.2e (%.2e)", iter, error, error / norm);
+
+  if (iter <= 2 * n && error <= eps * norm)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  (void) printf("Testing IDR(s) method\n");
+  random_invertible_amatrix(A, 1.0);
+  random_avector(b);
+  norm = norm2_avector(b);
+
+  clear_avector(x);
+  iter = solve_idrs_amatrix_avector(A, b, x, eps, 0, 4);
+  copy_avector(b, r);
+  addeval_amatrix_avector(-1.0, A, x, r);
+  error = norm2_avector(r);
+  (void) printf("  %u steps\n"
+		"  Residual %.2e (%.2e)", iter, error, error / norm);
+
+  if (iter <= 2 * n && error <= eps * norm)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  (void) printf("Testing preconditioned IDR(s) method\n");
+  random_invertible_amatrix(A, 1.0);
+  random_avector(b);
+  norm = norm2_avector(b);
+
+  clear_avector(x);
+  iter = solve_pidrs_amatrix_avector(A, gauss_seidel, A, b, x, eps, 0,
+				     4);
+  copy_avector(b, r);
+  addeval_amatrix_avector(-1.0, A, x, r);
+  error = norm2_avector(r);
+  (void) printf("  %u steps\n"
+		"  Residual %.2e (%.2e)", iter, error, error / norm);
+
+  if (iter <= 2 * n && error <= eps * norm)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  (void) printf("Testing pipelined conjugate gradient method\n");
+  random_spd_amatrix(A, 1.0);
+  random_avector(b);
+  norm = norm2_avector(b);
+
+  clear_avector(x);
+  iter = solve_pipecg_amatrix_avector(A, jacobi, A, b, x, eps, 0);
+  copy_avector(b, r);
+  addeval_amatrix_avector(-1.0, A, x, r);
+  error = norm2_avector(r);
+  (void) printf("  %u steps\n"
+		"  Residual %.2e (%.2e)", iter, error, error / norm);
+
+  if (iter <= n && error <= eps * norm)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  (void) printf("Testing pipelined CG for an ill-conditioned matrix\n");
+  L = new_zero_amatrix(300, 300);
+  for (i = 0; i < 300; i++) {
+    L->a[i + i * L->ld] = 2.0;
+    if (i > 0)
+      L->a[i + (i - 1) * L->ld] = -1.0;
+    if (i + 1 < 300)
+      L->a[i + (i + 1) * L->ld] = -1.0;
+  }
+  bl = new_avector(300);
+  xl = new_avector(300);
+  random_avector(bl);
+  norm = norm2_avector(bl);
+
+  clear_avector(xl);
+  iter = solve_pipecg_amatrix_avector(L, NULL, NULL, bl, xl, 1.0e-8, 0);
+  addeval_amatrix_avector(-1.0, L, xl, bl);
+  error = norm2_avector(bl);
+  (void) printf("  %u steps\n"
+		"  True residual %.2e (%.2e)", iter, error, error / norm);
+
+  if (error <= 1.0e-8 * norm)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+  del_avector(xl);
+  del_avector(bl);
+  del_amatrix(L);
+
+  (void) printf("Testing s-step GMRES method\n");
+  random_invertible_amatrix(A, 1.0);
+  random_avector(b);
+  norm = norm2_avector(b);
+
+  clear_avector(x);
+  iter = solve_sgmres_amatrix_avector(A, b, x, eps, 0, 2 * kmax, 3);
+  copy_avector(b, r);
+  addeval_amatrix_avector(-1.0, A, x, r);
+  error = norm2_avector(r);
+  (void) printf("  %u steps\n"
+		"  Residual %.2e (%.2e)", iter, error, error / norm);
+
+  if (iter <= n && error <= eps * norm)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  (void) printf("Testing block conjugate gradient method\n");
+  B = new_amatrix(n, 4);
+  X = new_amatrix(n, 4);
+  random_spd_amatrix(A, 1.0);
+  prepare_block(A, B, X);
+
+  iter = solve_blockcg_amatrix_amatrix(A, B, X, eps, 0);
+  error = max_relresidual(A, B, X);
+  (void) printf("  %u steps\n"
+		"  Maximal relative residual %.2e", iter, error);
+
+  if (iter <= n && error <= eps)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  (void) printf("Testing block GMRES method\n");
+  random_invertible_amatrix(A, 1.0);
+  prepare_block(A, B, X);
+
+  iter = solve_blockgmres_amatrix_amatrix(A, B, X, eps, 0, 3 * kmax);
+  error = max_relresidual(A, B, X);
+  (void) printf("  %u steps\n"
+		"  Maximal relative residual %.2e", iter, error);
+
+  if (iter <= n && error <= eps)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  (void) printf("Testing block GMRES method with kmax below the block size\n");
+  prepare_block(A, B, X);
+
+  iter = solve_blockgmres_amatrix_amatrix(A, B, X, eps, 100, 1);
+  error = max_relresidual(A, B, X);
+  (void) printf("  %u steps\n"
+		"  Maximal relative residual %.2e", iter, error);
+
+  if (iter <= 100 && error <= eps)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  (void) printf("Testing GCRO-DR method for a sequence of systems\n");
+  S = convection_diffusion(30, 10.0);
+  bs = new_avector(S->rows);
+  xs = new_avector(S->rows);
+  gd = new_gcrodr(S->rows, 30, 10);
+  iter0 = 0;
+  ok = true;
+  for (s = 0; s < 4; s++) {
+    for (i = 0; i < S->rows; i++)
+      S->coeff[S->row[i]] += 0.01;
+    random_avector(bs);
+    norm = norm2_avector(bs);
+
+    /* Restarted GMRES with the same search space for comparison */
+    clear_avector(xs);
+    iterg = solve_gmres_sparsematrix_avector(S, bs, xs, 1.0e-8, 0, 30);
+
+    clear_avector(xs);
+    iter = solve_gcrodr_sparsematrix_avector(gd, S, bs, xs, 1.0e-8, 0);
+    addeval_sparsematrix_avector(-1.0, S, xs, bs);
+    error = norm2_avector(bs);
+    (void) printf("  %u steps, %u for GMRES(30)\n"
+		  "  Residual %.2e (%.2e)\n", iter, iterg, error, error / norm);
+
+    /* Several restart cycles, later systems profit from recycling */
+    if (s == 0)
+      iter0 = iter;
+    if (error > 1.0e-8 * norm || iter >= iterg || iter0 <= 60
+	|| (s > 0 && iter >= iter0))
+      ok = false;
+
+    /* The recycled space has to satisfy A U = C after the solve */
+    error = 0.0;
+    for (i = 0; i < gd->kr; i++) {
+      xh = init_column_avector(&xtmp, gd->U, i);
+      bh = init_column_avector(&btmp, gd->C, i);
+      copy_avector(bh, bs);
+      addeval_sparsematrix_avector(-1.0, S, xh, bs);
+      error = REAL_MAX(error, norm2_avector(bs));
+      uninit_avector(bh);
+      uninit_avector(xh);
+    }
+    (void) printf("  Recycled space: |A U - C| %.2e\n", error);
+    if (gd->kr == 0 || error > 1.0e-10)
+      ok = false;
+  }
+  del_gcrodr(gd);
+  del_avector(xs);
+  del_avector(bs);
+  del_sparsematrix(S);
+
+  if (ok)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  (void) printf("Testing Krylov methods with a shared workspace\n");
+  random_invertible_amatrix(A, 1.0);
+  w = new_krylovwork(n, kmax, true);
+  ok = true;
+  for (s = 0; s < 3; s++) {
+    random_avector(b);
+    norm = norm2_avector(b);
+
+    clear_avector(x);
+    switch (s) {
+    case 0:
+      iter = solve_gmres_work_avector(w, A,
+				      (addeval_t) addeval_amatrix_avector,
+				      b, x, eps, 0);
+      break;
+    case 1:
+      iter = solve_fgmres_work_avector(w, A,
+				       (addeval_t) addeval_amatrix_avector,
+				       gauss_seidel, A, b, x, eps, 0);
+      break;
+    default:
+      iter = solve_pbicgstab_work_avector(w, A,
+					  (addeval_t) addeval_amatrix_avector,
+					  gauss_seidel, A, b, x, eps, 0);
+    }
+    copy_avector(b, r);
+    addeval_amatrix_avector(-1.0, A, x, r);
+    error = norm2_avector(r);
+    (void) printf("  %u steps\n"
+		  "  Residual %.2e (%.2e)\n", iter, error, error / norm);
+
+    if (error > eps * norm)
+      ok = false;
+  }
+  del_krylovwork(w);
+
+  if (ok)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  (void) printf("Testing block GMRES method for an H^2-matrix\n");
+  gr = new_circle_curve2d(400, 0.333);
+  bem = new_slp_laplace_bem2d(gr, 2, BASIS_CONSTANT_BEM2D);
+  root = build_bem2d_cluster(bem, 16, BASIS_CONSTANT_BEM2D);
+  eta = 1.0;
+  broot = build_strict_block(root, root, &eta, admissible_max_cluster);
+  rb = build_from_cluster_clusterbasis(root);
+  cb = build_from_cluster_clusterbasis(root);
+  setup_h2matrix_aprx_greenhybrid_bem2d(bem, rb, cb, broot, 4, 1, 1.0,
+					1.0e-12, build_bem2d_rect_quadpoints);
+  assemble_bem2d_h2matrix_row_clusterbasis(bem, rb);
+  assemble_bem2d_h2matrix_col_clusterbasis(bem, cb);
+  V = build_from_block_h2matrix(broot, rb, cb);
+  assemble_bem2d_h2matrix(bem, broot, V);
+
+  /* The block callback has to agree with the vector multiplication */
+  Bh = new_amatrix(400, 4);
+  Xh = new_amatrix(400, 4);
+  random_amatrix(Xh);
+  clear_amatrix(Bh);
+  addevalblock_h2matrix(1.0, V, Xh, Bh);
+  error = 0.0;
+  norm = 0.0;
+  for (s = 0; s < 4; s++) {
+    xh = init_column_avector(&xtmp, Xh, s);
+    bh = init_column_avector(&btmp, Bh, s);
+    norm = REAL_MAX(norm, norm2_avector(bh));
+    addeval_h2matrix_avector(-1.0, V, xh, bh);
+    error = REAL_MAX(error, norm2_avector(bh));
+    uninit_avector(bh);
+    uninit_avector(xh);
+  }
+  (void) printf("  Block product: rel. error %.2e", error / norm);
+  if (error <= 1.0e-13 * norm)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  random_amatrix(Bh);
+  clear_amatrix(Xh);
+  iter = solve_blockgmres_h2matrix_amatrix(V, Bh, Xh, eps, 0, 3 * kmax);
+  error = 0.0;
+  for (s = 0; s < 4; s++) {
+    xh = init_column_avector(&xtmp, Xh, s);
+    bh = init_column_avector(&btmp, Bh, s);
+    norm = norm2_avector(bh);
+    addeval_h2matrix_avector(-1.0, V, xh, bh);
+    error = REAL_MAX(error, norm2_avector(bh) / norm);
+    uninit_avector(bh);
+    uninit_avector(xh);
+  }
+  (void) printf("  %u steps\n"
+		"  Maximal relative residual %.2e", iter, error);
+  if (error <= eps)
+    printf("    Okay\n");
+  else {
+    printf("    NOT Okay\n");
+    problems++;
+  }
+
+  del_amatrix(Xh);
+  del_amatrix(Bh);
+  del_h2matrix(V);
+  del_block(broot);
+  del_bem2d(bem);
+  freemem(root->idx);
+  del_cluster(root);
+  del_curve2d(gr);
+
+  del_amatrix(X);
+  del_amatrix(B);
   del_avector(r);
   del_avector(x);
   del_avector(b);
@@ -1,3 +1,5 @@
+#include <stdint.h>
+
 #include "basic.h"
 #include "krylov.h"
 #include "krylovsolvers.h"
@@ -164,6 +166,90 @@ test_system(matrixtype mattype, const char *apprxtype,
   del_avector(b);
 }
 
+static void
+test_potential(pbem3d bem, pcluster root, real eta)
+{
+  pcluster  tc;
+  pblock    b;
+  phmatrix  P;
+  ph2matrix P2;
+  pclusterbasis rb, cb;
+  pamatrix  B;
+  pavector  x, y, yref;
+  real(*Z)[3];
+  real      error, phi, r;
+  uint      points, i;
+
+  /* Field points on two spheres enclosing the unit sphere */
+  points = 512;
+  Z = (real(*)[3]) allocreal(3 * points);
+  for (i = 0; i < points; i++) {
+    r = (i % 2 == 0 ? 1.5 : 3.0);
+    Z[i][2] = 1.0 - (2.0 * i + 1.0) / points;
+    phi = 2.399963229728653 * i;
+    Z[i][0] = r * REAL_SQRT(1.0 - REAL_SQR(Z[i][2])) * REAL_COS(phi);
+    Z[i][1] = r * REAL_SQRT(1.0 - REAL_SQR(Z[i][2])) * REAL_SIN(phi);
+    Z[i][2] *= r;
+  }
+
+  tc = build_bem3d_points_cluster(points, (const real(*)[3]) Z, 16);
+  b = build_nonstrict_block(tc, root, &eta, admissible_max_cluster);
+
+  B = new_amatrix(root->size, points);
+  bem->kernels->kernel_col(NULL, (const real(*)[3]) Z, bem, B);
+
+  x = new_avector(root->size);
+  y = new_avector(points);
+  yref = new_avector(points);
+  random_avector(x);
+  clear_avector(yref);
+  mvm_amatrix_avector(1.0, true, B, x, yref);
+
+  printf("Testing: potential evaluation\n"
+	 "====================================\n\n");
+
+  setup_hmatrix_aprx_inter_row_bem3d(bem, tc, root, b, 4);
+  P = build_from_block_hmatrix(b, 0);
+  assemble_bem3d_potential_hmatrix(bem, (const real(*)[3]) Z, P);
+  clear_avector(y);
+  addeval_parallel_hmatrix_avector(1.0, P, x, y, max_pardepth);
+  add_avector(-1.0, yref, y);
+  error = norm2_avector(y) / norm2_avector(yref);
+  printf("rel. error Hmatrix : %.5e       %s\n", error,
+	 (error <= 1.0e-3 ? "    okay" : "NOT okay"));
+  if (error > 1.0e-3)
+    problems++;
+
+  del_block(b);
+  b = build_strict_block(tc, root, &eta, admissible_max_cluster);
+  rb = build_from_cluster_clusterbasis(tc);
+  cb = build_from_cluster_clusterbasis(root);
+  setup_h2matrix_aprx_inter_bem3d(bem, rb, cb, b, 4);
+  assemble_bem3d_potential_row_clusterbasis(bem, (const real(*)[3]) Z, rb);
+  assemble_bem3d_h2matrix_col_clusterbasis(bem, cb);
+  P2 = build_from_block_h2matrix(b, rb, cb);
+  assemble_bem3d_potential_h2matrix(bem, (const real(*)[3]) Z, P2);
+  clear_avector(y);
+  addeval_parallel_h2matrix_avector(1.0, P2, x, y, max_pardepth);
+  add_avector(-1.0, yref, y);
+  error = norm2_avector(y) / norm2_avector(yref);
+  printf("rel. error H2matrix: %.5e       %s\n\n", error,
+	 (error <= 1.0e-3 ? "    okay" : "NOT okay"));
+  if (error > 1.0e-3)
+    problems++;
+
+  del_h2matrix(P2);
+  del_hmatrix(P);
+  del_avector(yref);
+  del_avector(y);
+  del_avector(x);
+  del_amatrix(B);
+  del_block(b);
+  freemem(tc->idx);
+  del_cluster(tc);
+  freemem(Z);
+}
+
 void
 test_suite(pcsurface3d gr, uint q, uint clf, real eta,
 	   basisfunctionbem3d row_basis, basisfunctionbem3d col_basis,
@@ -182,6 +268,8 @@ test_suite(pcsurface3d gr, uint q, uint clf, real eta,
   uint      l;
   real      delta;
   real      eps_aca;
+  pavector  x, y, y2;
+  real      errorV;
 
   nn = row_basis == BASIS_LINEAR_BEM3D ? gr->vertices : gr->triangles;
   nd = col_basis == BASIS_LINEAR_BEM3D ? gr->vertices : gr->triangles;
@@ -316,6 +404,12 @@ test_suite(pcsurface3d gr, uint q, uint clf, real eta,
 	      V, brootKM, bem_dlp, KM, row_basis, col_basis, exterior,
 	      error_min, error_max);
 
+  setup_hmatrix_aprx_bpaca_bem3d(bem_slp, rootn, rootn, brootV, eps_aca, 4);
+  setup_hmatrix_aprx_bpaca_bem3d(bem_dlp, rootn, rootd, brootKM, eps_aca, 4);
+  test_system(HMATRIX, "ACA blocked partial pivoting", Vfull, KMfull, brootV,
+	      bem_slp, V, brootKM, bem_dlp, KM, row_basis, col_basis, exterior,
+	      error_min, error_max);
+
   setup_hmatrix_aprx_hca_bem3d(bem_slp, rootn, rootn, brootV, m, eps_aca);
   setup_hmatrix_aprx_hca_bem3d(bem_dlp, rootn, rootd, brootKM, m, eps_aca);
   test_system(HMATRIX, "HCA2", Vfull, KMfull, brootV, bem_slp, V, brootKM,
@@ -353,6 +447,31 @@ test_suite(pcsurface3d gr, uint q, uint clf, real eta,
 	      brootKM, bem_dlp, KM2, row_basis, col_basis, exterior,
 	      error_min, error_max);
 
+  /*
+   * Test implicit farfield, must reproduce the stored coupling matrices
+   */
+
+  x = new_avector(Vfull->cols);
+  y = new_avector(Vfull->rows);
+  y2 = new_avector(Vfull->rows);
+  random_avector(x);
+  clear_avector(y);
+  addeval_h2matrix_avector(1.0, V2, x, y);
+  assemble_bem3d_implicit_farfield_h2matrix(bem_slp, V2);
+  clear_avector(y2);
+  addeval_h2matrix_avector(1.0, V2, x, y2);
+  add_avector(-1.0, y, y2);
+  errorV = norm2_avector(y2) / norm2_avector(y);
+  printf("Testing: implicit farfield\n"
+	 "====================================\n\n"
+	 "rel. change V*x    : %.5e       %s\n\n", errorV,
+	 (errorV <= 1.0e-12 ? "    okay" : "NOT okay"));
+  if (errorV > 1.0e-12)
+    problems++;
+  del_avector(y2);
+  del_avector(y);
+  del_avector(x);
+
   /*
    * Test Greenhybrid
    */
@@ -382,6 +501,12 @@ test_suite(pcsurface3d gr, uint q, uint clf, real eta,
 	      V2, brootKM, bem_dlp, KM2, row_basis, col_basis, exterior,
 	      error_min, error_max);
 
+  /*
+   * Test evaluation of the double layer potential in field points
+   */
+
+  test_potential(bem_dlp, rootd, eta);
+
   del_h2matrix(V2);
   del_h2matrix(KM2);
   del_block(brootV);
@@ -396,6 +521,113 @@ test_suite(pcsurface3d gr, uint q, uint clf, real eta,
   del_laplace_bem3d(bem_dlp);
 }
 
+static    uint
+edgewidth(pcsurface3d gr)
+{
+  uint      i, w;
+
+  w = 0;
+  for (i = 0; i < gr->edges; i++)
+    w = UINT_MAX(w, (gr->e[i][0] > gr->e[i][1] ?
+		     gr->e[i][0] - gr->e[i][1] : gr->e[i][1] - gr->e[i][0]));
+
+  return w;
+}
+
+/* Renumbering a surface has to permute the Galerkin matrix of the
+ * single layer operator with piecewise linear basis functions */
+/* Morton ordering only promises that the vertices traverse the
+ * subboxes of the first two levels of the bounding box in Z order */
+static bool
+check_zorder(uint n, uint dim, const real *x)
+{
+  real      xmin[3], xmax[3], scale[3];
+  uint64_t  q;
+  uint      bits, key, last, i, j;
+
+  bits = UINT_MIN(63 / dim, 31);
+  for (j = 0; j < dim; j++) {
+    xmin[j] = xmax[j] = x[j];
+    for (i = 1; i < n; i++) {
+      xmin[j] = REAL_MIN(xmin[j], x[i * dim + j]);
+      xmax[j] = REAL_MAX(xmax[j], x[i * dim + j]);
+    }
+    scale[j] = (xmax[j] > xmin[j] ?
+		((real) ((1u << bits) - 1)) / (xmax[j] - xmin[j]) : 0.0);
+  }
+
+  last = 0;
+  for (i = 0; i < n; i++) {
+    key = 0;
+    for (j = 0; j < dim; j++) {
+      q = (uint64_t) ((x[i * dim + j] - xmin[j]) * scale[j]);
+      key |= ((q >> (bits - 1)) & 1) << (dim + j);
+      key |= ((q >> (bits - 2)) & 1) << j;
+    }
+    if (key < last)
+      return false;
+    last = key;
+  }
+
+  return true;
+}
+
+static void
+check_reorder(pcmacrosurface3d mg, uint split, uint q)
+{
+  psurface3d g[2];
+  pbem3d    bem;
+  pamatrix  V[2];
+  uint     *vperm;
+  uint      w[2];
+  real      error, norm;
+  bool      local;
+  uint      mode, i, j, k;
+
+  for (mode = 0; mode < 2; mode++) {
+    g[0] = build_from_macrosurface3d_surface3d(mg, split);
+    g[1] = build_from_macrosurface3d_surface3d(mg, split);
+    w[0] = edgewidth(g[0]);
+    vperm = allocuint(g[1]->vertices);
+    reorder_surface3d(g[1], (mode == 0 ? H2_REORDER_RCM : H2_REORDER_MORTON),
+		      vperm);
+    w[1] = edgewidth(g[1]);
+
+    for (k = 0; k < 2; k++) {
+      bem = new_slp_laplace_bem3d(g[k], q, q + 2, BASIS_LINEAR_BEM3D,
+				  BASIS_LINEAR_BEM3D);
+      V[k] = new_amatrix(g[k]->vertices, g[k]->vertices);
+      bem->nearfield(NULL, NULL, bem, false, V[k]);
+      del_bem3d(bem);
+    }
+
+    error = 0.0;
+    for (j = 0; j < g[0]->vertices; j++)
+      for (i = 0; i < g[0]->vertices; i++)
+	error += ABSSQR(V[0]->a[i + j * V[0]->ld]
+			- V[1]->a[vperm[i] + vperm[j] * V[1]->ld]);
+    norm = normfrob_amatrix(V[0]);
+    error = REAL_SQRT(error) / norm;
+
+    /* RCM reduces the bandwidth, Morton only sorts along the Z curve */
+    local = (mode == 0 ? w[1] < w[0] :
+	     check_zorder(g[1]->vertices, 3, (const real *) g[1]->x));
+    (void) printf("%s ordering: vertex distance %u instead of %u,"
+		  " rel. error %.4e     %s\n",
+		  (mode == 0 ? "RCM" : "Morton"), w[1], w[0], error,
+		  (check_surface3d(g[1]) == 0 && local
+		   && error <= 1.0e-13 ? "    okay" : "NOT okay"));
+    if (check_surface3d(g[1]) != 0 || !local || error > 1.0e-13)
+      problems++;
+
+    for (k = 0; k < 2; k++) {
+      del_amatrix(V[k]);
+      del_surface3d(g[k]);
+    }
+    freemem(vperm);
+  }
+}
+
 int
 main(int argc, char **argv)
 {
@@ -416,6 +648,12 @@ main(int argc, char **argv)
   printf("Testing unit sphere with %d triangles and %d vertices\n",
 	 gr->triangles, gr->vertices);
 
+  printf("----------------------------------------\n");
+  printf("Reordering the surface:\n");
+  printf("----------------------------------------\n\n");
+
+  check_reorder(mg, REAL_SQRT(n * 0.125), q);
+
   /****************************************************
    * Neumann: constant, Dirichlet: constant
    ****************************************************/
@@ -3,6 +3,7 @@
 #include "tet3drt0.h"		/* discretisation with Raviart-Thomas functions */
 #include "sparsematrix.h"	/* Sparsematrices */
 #include "krylov.h"		/* Iterative solvers of Krylov type */
+#include "saddlepoint.h"		/* Saddle point solvers */
 
 #include <stdio.h>
 
@@ -223,7 +224,7 @@ main (int argc, char **argv){
   ptet3d *gr;		/* 3d mesh hierarchy */
   ptet3drt0 *dc;	/* Raviart-Tomas basis function in 3d */
   psparsematrix sp_A, sp_Af, sp_B, sp_Bf;/* Sparsematrix objects */
-  uint i;		/* Auxiliary variable for loops */
+  uint i, j;		/* Auxiliary variables for loops */
   uint L;		/* Numberof grid refinements */
   pavector k;		/* Vector for storing the permeabilities */
   pstopwatch sw;	/* Stopwatch for time measuring */
@@ -235,6 +236,10 @@ main (int argc, char **argv){
   uint max_steps;	/* Maximal number of steps */
   pavector b1, b2, g;	/* Vectors for the right-hand sides and the Neumann values */
   pavector x1, x2;	/* Vectors for the calculated solution */
+  pclustergeometry cg;	/* Geometry of the pressure degrees of freedom */
+  uint *idx;		/* Index array for the clustergeometry */
+  ptruncmode tm;	/* Truncation mode for the H-Cholesky factorization */
+  psaddlepoint sp;	/* Saddle point solver */
   
   init_h2lib(&argc, &argv);
   
@@ -351,6 +356,52 @@ main (int argc, char **argv){
     if (!IS_IN_RANGE(1.0e-13, error, 5.0e-10))
       problems++;
     
+    (void) printf("  Setting up Schur complement preconditioner\n");
+    idx = allocuint(rows_B);
+    for (j = 0; j < rows_B; j++)
+      idx[j] = j;
+    cg = build_tet3drt0_B_clustergeometry(dc[i], idx);
+    tm = new_releucl_truncmode();
+    start_stopwatch(sw);
+    sp = new_saddlepoint(sp_A, sp_B, cg, 32, 2.0, tm, 1.0e-6);
+    time = stop_stopwatch(sw);
+    (void) printf("  %.2f seconds\n", time);
+
+    (void) printf("  Preconditioned Uzawa iteration\n");
+    random_avector(x2);
+    start_stopwatch(sw);
+    steps = solve_uzawa_saddlepoint(sp, b1, b2, x1, x2, 1.0e-12, max_steps);
+    time = stop_stopwatch(sw);
+    error = norml2_pressure_centroid_tet3drt0(dc[i], function_pressure, 0, x2);
+    (void) printf("  %u iterations, %.2f seconds\n"
+		  "  rel. L^2 error pressure %.4e %s\n", steps, time, error,
+		  (IS_IN_RANGE(0.0, error, 1.0e-10) && steps <= 30 ?
+		   "    okay" : "NOT okay"));
+    if (!IS_IN_RANGE(0.0, error, 1.0e-10) || steps > 30)
+      problems++;
+
+    (void) printf("  Preconditioned MINRES iteration\n");
+    clear_avector(x1);
+    random_avector(x2);
+    start_stopwatch(sw);
+    steps = solve_minres_saddlepoint(sp, b1, b2, x1, x2, 1.0e-12, max_steps);
+    time = stop_stopwatch(sw);
+    error = norml2_pressure_centroid_tet3drt0(dc[i], function_pressure, 0, x2);
+    (void) printf("  %u iterations, %.2f seconds\n"
+		  "  rel. L^2 error pressure %.4e %s\n", steps, time, error,
+		  (IS_IN_RANGE(0.0, error, 1.0e-10) ? "    okay" : "NOT okay"));
+    if (!IS_IN_RANGE(0.0, error, 1.0e-10))
+      problems++;
+    error = norml2_flux_centroid_tet3drt0(dc[i], function_flux, 0, x1, g);
+    (void) printf("  rel. L^2 error flux %.4e     %s\n", error,
+		  (IS_IN_RANGE(0.0, error, 1.0e-8) ? "    okay" : "NOT okay"));
+    if (!IS_IN_RANGE(0.0, error, 1.0e-8))
+      problems++;
+
+    del_saddlepoint(sp);
+    del_truncmode(tm);
+    del_clustergeometry(cg);
+    freemem(idx);
     del_sparsematrix(sp_A);
     del_sparsematrix(sp_B);
     del_sparsematrix(sp_Af);
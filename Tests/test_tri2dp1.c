@@ -5,6 +5,7 @@
 #include "krylovsolvers.h"
 #include "basic.h"
 
+#include <stdint.h>
 #include <stdio.h>
 
 static uint problems = 0;
@@ -28,6 +29,243 @@ sin_rhs(const real * x, void *data)
   return 2.0 * M_PI * M_PI * sin(M_PI * x[0]) * sin(M_PI * x[1]);
 }
 
+static void
+check_slots(ptri2dp1 dc, psparsematrix A, psparsematrix Af)
+{
+  pfield    a, af;
+  real      error;
+  uint      k;
+
+  a = allocfield(A->nz);
+  af = allocfield(Af->nz);
+  for (k = 0; k < A->nz; k++)
+    a[k] = A->coeff[k];
+  for (k = 0; k < Af->nz; k++)
+    af[k] = Af->coeff[k];
+
+  clear_sparsematrix(A);
+  clear_sparsematrix(Af);
+  setslots_tri2dp1(dc, A, Af);
+  assemble_tri2dp1_laplace_sparsematrix(dc, A, Af);
+  setslots_tri2dp1(dc, NULL, NULL);
+
+  error = 0.0;
+  for (k = 0; k < A->nz; k++)
+    error = REAL_MAX(error, ABS(A->coeff[k] - a[k]));
+  for (k = 0; k < Af->nz; k++)
+    error = REAL_MAX(error, ABS(Af->coeff[k] - af[k]));
+  (void) printf("  Precomputed slots: max. error %.4e     %s\n", error,
+		(error <= 1.0e-12 ? "    okay" : "NOT okay"));
+  if (error > 1.0e-12)
+    problems++;
+
+  /* Reordering a matrix has to invalidate its positions */
+  setslots_tri2dp1(dc, A, Af);
+  sort_sparsematrix(A);
+  (void) printf("  Slots after reordering %s\n",
+		(dc->slotgen != A->gen && dc->fslotgen == Af->gen ?
+		 "discarded, okay" : "kept, NOT okay"));
+  if (dc->slotgen == A->gen || dc->fslotgen != Af->gen)
+    problems++;
+  setslots_tri2dp1(dc, NULL, NULL);
+
+  freemem(af);
+  freemem(a);
+}
+
+static void
+check_colours(pctri2dp1 dc)
+{
+  pctri2d   gr = dc->t2;
+  uint     *mark;
+  uint      c, n, i, t, v[3], errors;
+
+  mark = allocuint(gr->vertices);
+  for (i = 0; i < gr->vertices; i++)
+    mark[i] = dc->colours;
+
+  /* Triangles of one colour must not share vertices */
+  errors = 0;
+  for (c = 0; c < dc->colours; c++)
+    for (n = dc->cstart[c]; n < dc->cstart[c + 1]; n++) {
+      t = dc->celem[n];
+      getvertices_tri2d(gr, t, v);
+      for (i = 0; i < 3; i++) {
+	if (mark[v[i]] == c)
+	  errors++;
+	mark[v[i]] = c;
+      }
+    }
+  if (dc->cstart[dc->colours] != gr->triangles)
+    errors++;
+
+  (void) printf("  %u colours, %u conflicts     %s\n", dc->colours, errors,
+		(errors == 0 ? "    okay" : "NOT okay"));
+  if (errors > 0)
+    problems++;
+
+  freemem(mark);
+}
+
+static uint
+bandwidth(pcsparsematrix a)
+{
+  uint      i, j, w;
+
+  w = 0;
+  for (i = 0; i < a->rows; i++)
+    for (j = a->row[i]; j < a->row[i + 1]; j++)
+      w = UINT_MAX(w, (a->col[j] > i ? a->col[j] - i : i - a->col[j]));
+
+  return w;
+}
+
+static real
+normfrob(pcsparsematrix a)
+{
+  real      sum;
+  uint      j;
+
+  sum = 0.0;
+  for (j = 0; j < a->nz; j++)
+    sum += ABSSQR(a->coeff[j]);
+
+  return REAL_SQRT(sum);
+}
+
+/* Frobenius norm of P A P^* - B, row and column i of A are mapped
+ * to perm[i] */
+static real
+normfrobdiff_permuted(pcsparsematrix a, const uint *perm, pcsparsematrix b)
+{
+  bool     *hit;
+  real      sum;
+  uint      i, j, k, pi, pj;
+
+  hit = (bool *) allocmem(sizeof(bool) * b->nz);
+  for (k = 0; k < b->nz; k++)
+    hit[k] = false;
+
+  /* Differences for the pattern of the permuted matrix A */
+  sum = 0.0;
+  for (i = 0; i < a->rows; i++) {
+    pi = perm[i];
+    for (j = a->row[i]; j < a->row[i + 1]; j++) {
+      pj = perm[a->col[j]];
+
+      for (k = b->row[pi]; k < b->row[pi + 1] && b->col[k] != pj; k++);
+
+      if (k < b->row[pi + 1]) {
+	sum += ABSSQR(b->coeff[k] - a->coeff[j]);
+	hit[k] = true;
+      }
+      else
+	sum += ABSSQR(a->coeff[j]);
+    }
+  }
+
+  /* Entries of B outside of the permuted pattern */
+  for (k = 0; k < b->nz; k++)
+    if (!hit[k])
+      sum += ABSSQR(b->coeff[k]);
+
+  freemem(hit);
+
+  return REAL_SQRT(sum);
+}
+
+/* Morton ordering only promises that the vertices traverse the
+ * subboxes of the first two levels of the bounding box in Z order */
+static bool
+check_zorder(uint n, uint dim, const real *x)
+{
+  real      xmin[3], xmax[3], scale[3];
+  uint64_t  q;
+  uint      bits, key, last, i, j;
+
+  bits = UINT_MIN(63 / dim, 31);
+  for (j = 0; j < dim; j++) {
+    xmin[j] = xmax[j] = x[j];
+    for (i = 1; i < n; i++) {
+      xmin[j] = REAL_MIN(xmin[j], x[i * dim + j]);
+      xmax[j] = REAL_MAX(xmax[j], x[i * dim + j]);
+    }
+    scale[j] = (xmax[j] > xmin[j] ?
+		((real) ((1u << bits) - 1)) / (xmax[j] - xmin[j]) : 0.0);
+  }
+
+  last = 0;
+  for (i = 0; i < n; i++) {
+    key = 0;
+    for (j = 0; j < dim; j++) {
+      q = (uint64_t) ((x[i * dim + j] - xmin[j]) * scale[j]);
+      key |= ((q >> (bits - 1)) & 1) << (dim + j);
+      key |= ((q >> (bits - 2)) & 1) << j;
+    }
+    if (key < last)
+      return false;
+    last = key;
+  }
+
+  return true;
+}
+
+static void
+check_reorder(pctri2d gr)
+{
+  ptri2d    g[2];
+  ptri2dp1  d[2];
+  psparsematrix A[2];
+  uint     *vperm, *perm;
+  uint      bw[2];
+  real      error;
+  bool      local;
+  uint      mode, i, k;
+
+  for (mode = 0; mode < 2; mode++) {
+    g[0] = refine_tri2d(gr, NULL);
+    g[1] = refine_tri2d(gr, NULL);
+    vperm = allocuint(g[1]->vertices);
+    reorder_tri2d(g[1], (mode == 0 ? H2_REORDER_RCM : H2_REORDER_MORTON),
+		  vperm);
+    check_tri2d(g[1]);
+
+    /* The Laplace matrix has to be a symmetric permutation */
+    for (k = 0; k < 2; k++) {
+      d[k] = new_tri2dp1(g[k]);
+      A[k] = build_tri2dp1_sparsematrix(d[k]);
+      assemble_tri2dp1_laplace_sparsematrix(d[k], A[k], NULL);
+      bw[k] = bandwidth(A[k]);
+    }
+    error = 1.0;
+    if (d[0]->ndof == d[1]->ndof) {
+      perm = allocuint(d[0]->ndof);
+      for (i = 0; i < g[0]->vertices; i++)
+	if (d[0]->is_dof[i])
+	  perm[d[0]->idx2dof[i]] = d[1]->idx2dof[vperm[i]];
+      error = normfrobdiff_permuted(A[0], perm, A[1]) / normfrob(A[0]);
+      freemem(perm);
+    }
+    /* RCM reduces the bandwidth, Morton only sorts along the Z curve */
+    local = (mode == 0 ? bw[1] < bw[0] :
+	     check_zorder(g[1]->vertices, 2, (const real *) g[1]->x));
+    (void) printf("  %s ordering: bandwidth %u instead of %u,"
+		  " rel. error %.4e     %s\n",
+		  (mode == 0 ? "RCM" : "Morton"), bw[1], bw[0], error,
+		  (A[0]->nz == A[1]->nz && local
+		   && error <= 1.0e-12 ? "    okay" : "NOT okay"));
+    if (A[0]->nz != A[1]->nz || !local || error > 1.0e-12)
+      problems++;
+
+    freemem(vperm);
+    for (k = 0; k < 2; k++) {
+      del_sparsematrix(A[k]);
+      del_tri2dp1(d[k]);
+      del_tri2d(g[k]);
+    }
+  }
+}
+
 int
 main(int argc, char **argv)
 {
@@ -71,6 +309,9 @@ main(int argc, char **argv)
   printf("Draw grid Level %u\n", 3);
   draw_cairo_tri2d(gr[3], "mesh", 0, 0);
 
+  (void) printf("Reordering meshes\n");
+  check_reorder(gr[L - 2]);
+
   (void) printf("Creating discretizations\n");
   dc = (ptri2dp1 *) allocmem(sizeof(ptri2dp1) * (L + 1));
   for (i = 0; i <= L; i++) {
@@ -97,6 +338,9 @@ main(int argc, char **argv)
 		  getsize_sparsematrix(Af) / 1024.0 / dc[i]->ndof,
 		  A->nz, Af->nz);
 
+    check_slots(dc[i], A, Af);
+    check_colours(dc[i]);
+
     (void) printf("  Setting up Dirichlet data\n");
     xd = new_avector(dc[i]->nfix);
     assemble_tri2dp1_dirichlet_avector(dc[i], sin_solution, 0, xd);